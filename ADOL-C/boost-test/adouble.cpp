@@ -1,7 +1,17 @@
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+namespace tt = boost::test_tools;
+
 #include <adolc/adolc.h>
+#include <memory>
+
+#include "const.h"
+
+#if defined(_OPENMP)
+#include <adolc/adolc_openmp.h>
+#include <omp.h>
+#endif
 
 // Check that the specialization of std::numeric_limits for adouble exists
 // and does something reasonable.
@@ -10,3 +20,226 @@ BOOST_AUTO_TEST_CASE(std_numeric_limits_adouble) {
   BOOST_TEST(std::numeric_limits<adouble>::max() ==
              std::numeric_limits<double>::max());
 }
+
+// advector(n) reserves the locations of its elements as one contiguous block
+// and frees them as blocks, also after elements were moved from
+BOOST_AUTO_TEST_CASE(advector_contiguous_locations) {
+  const size_t n = 5;
+  {
+    advector v(n);
+    for (size_t i = 1; i < n; ++i)
+      BOOST_TEST(v[i].loc() == v[0].loc() + i);
+
+    adouble moved = std::move(v[2]);
+    advector w(v);
+    for (size_t i = 1; i < n; ++i)
+      BOOST_TEST(w[i].loc() == w[0].loc() + i);
+  }
+
+  // freeing twice would hand out locations twice
+  std::vector<adouble> live(3 * n);
+  for (size_t i = 0; i < live.size(); ++i)
+    for (size_t j = 0; j < i; ++j)
+      BOOST_TEST(live[i].loc() != live[j].loc());
+}
+
+BOOST_AUTO_TEST_CASE(advector_vec_axpy_gradient) {
+  const short tapeId = 1;
+  const size_t n = 4;
+  std::vector<double> x{1.0, 2.0, 3.0, 4.0};
+  std::vector<double> grad(n);
+  double y = 0.0;
+
+  trace_on(tapeId);
+  {
+    advector ax(n), ab(n), res(n);
+    for (size_t i = 0; i < n; ++i) {
+      ax[i] <<= x[i];
+      ab[i] = 1.0;
+    }
+    adouble a = 2.0;
+    adolc_vec_axpy(res, a, ax, ab, n);
+
+    adouble sum = 0.0;
+    for (size_t i = 0; i < n; ++i)
+      sum += res[i] * res[i];
+    sum >>= y;
+  }
+  trace_off();
+
+  double expected = 0.0;
+  for (size_t i = 0; i < n; ++i)
+    expected += (2.0 * x[i] + 1.0) * (2.0 * x[i] + 1.0);
+  BOOST_TEST(y == expected, tt::tolerance(tol));
+
+  gradient(tapeId, n, x.data(), grad.data());
+  for (size_t i = 0; i < n; ++i)
+    BOOST_TEST(grad[i] == 4.0 * (2.0 * x[i] + 1.0), tt::tolerance(tol));
+}
+
+// The segregated store manager hands out the same contiguous blocks and
+// reuses freed locations
+BOOST_AUTO_TEST_CASE(segregated_store_manager) {
+  setStoreManagerType(ADOLC_LOCATION_SEGREGATED);
+  {
+    const short tapeId = 1;
+    const size_t n = 8;
+    std::vector<double> x{1.0, -2.0, 3.0, 0.5, 4.0, -1.5, 2.5, 0.25};
+    std::vector<double> grad(n);
+    double y = 0.0;
+
+    // scatter free locations over the store
+    std::vector<std::unique_ptr<adouble>> churn(64);
+    for (size_t i = 0; i < 4 * churn.size(); ++i)
+      churn[(7 * i) % churn.size()].reset(new adouble(1.0 * i));
+
+    trace_on(tapeId);
+    {
+      advector ax(n);
+      for (size_t i = 0; i < n; ++i) {
+        ax[i] <<= x[i];
+        churn[(3 * i) % churn.size()].reset();
+      }
+      for (size_t i = 1; i < n; ++i)
+        BOOST_TEST(ax[i].loc() == ax[0].loc() + i);
+
+      ensureContiguousLocations(3);
+      adouble a, b, c;
+      BOOST_TEST(b.loc() == a.loc() + 1);
+      BOOST_TEST(c.loc() == a.loc() + 2);
+
+      advector sq(n);
+      for (size_t i = 0; i < n; ++i)
+        sq[i] = ax[i] * ax[i];
+      adouble sum = 0.0;
+      for (size_t i = 0; i < n; ++i)
+        sum += sq[i];
+      sum >>= y;
+    }
+    trace_off();
+
+    double expected = 0.0;
+    for (size_t i = 0; i < n; ++i)
+      expected += x[i] * x[i];
+    BOOST_TEST(y == expected, tt::tolerance(tol));
+
+    gradient(tapeId, n, x.data(), grad.data());
+    for (size_t i = 0; i < n; ++i)
+      BOOST_TEST(grad[i] == 2.0 * x[i], tt::tolerance(tol));
+
+    churn.clear();
+    std::vector<adouble> live(256);
+    for (size_t i = 0; i < live.size(); ++i)
+      for (size_t j = 0; j < i; ++j)
+        BOOST_TEST(live[i].loc() != live[j].loc());
+  }
+  setStoreManagerType(ADOLC_LOCATION_BLOCKS);
+}
+
+// The singleton store hands out no blocks, advector then takes its element
+// locations one by one
+BOOST_AUTO_TEST_CASE(singleton_store_manager_advector) {
+  setStoreManagerType(ADOLC_LOCATION_SINGLETONS);
+  {
+    const short tapeId = 1;
+    const size_t n = 6;
+    std::vector<double> x{1.0, -2.0, 3.0, 0.5, 4.0, -1.5};
+    std::vector<double> grad(n);
+    double y = 0.0;
+
+    adouble live = 7.0;
+    trace_on(tapeId);
+    {
+      advector ax(n);
+      for (size_t i = 0; i < n; ++i) {
+        BOOST_TEST(ax[i].loc() != live.loc());
+        for (size_t j = 0; j < i; ++j)
+          BOOST_TEST(ax[i].loc() != ax[j].loc());
+        ax[i] <<= x[i];
+      }
+      adouble sum = 0.0;
+      for (size_t i = 0; i < n; ++i)
+        sum += ax[i] * ax[i];
+      sum >>= y;
+    }
+    trace_off();
+    BOOST_TEST(live.value() == 7.0);
+
+    gradient(tapeId, n, x.data(), grad.data());
+    for (size_t i = 0; i < n; ++i)
+      BOOST_TEST(grad[i] == 2.0 * x[i], tt::tolerance(tol));
+  }
+  setStoreManagerType(ADOLC_LOCATION_BLOCKS);
+}
+
+#if defined(_OPENMP)
+// Workers of a parallel region see the values of the serial adoubles, while
+// their writes to them stay private to the worker
+BOOST_AUTO_TEST_CASE(openmp_store_copy_on_write) {
+  // large enough for the store to be mapped rather than copied
+  const size_t n = 20000;
+  {
+    std::vector<adouble> serial(n);
+    for (size_t i = 0; i < n; ++i)
+      serial[i] = 1.0 * i;
+
+    int wrong = 0;
+#pragma omp parallel firstprivate(ADOLC_OpenMP_Handler) reduction(+ : wrong)
+    {
+      const int thread = omp_get_thread_num();
+      for (size_t i = 0; i < n; i += 10)
+        wrong += serial[i].value() != 1.0 * i;
+      serial[1] = -1.0 * thread;
+      adouble sum = serial[2] + serial[3];
+      wrong += sum.value() != 5.0;
+      wrong += serial[1].value() != -1.0 * thread;
+    }
+    BOOST_TEST(wrong == 0);
+    BOOST_TEST(serial[1].value() == 1.0);
+  }
+
+  // a worker copied at most its whole store, whose size is below 2 n, the
+  // master also wrote the snapshot of the serial store
+  for (int thread = 0; thread < omp_get_max_threads(); ++thread)
+    BOOST_TEST(getStoreCopyBytes(thread) <=
+               (thread == 0 ? 4 : 2) * n * sizeof(double));
+#if defined(__linux__)
+  // the workers copied only the few pages they wrote to
+  for (int thread = 1; thread < omp_get_max_threads(); ++thread)
+    BOOST_TEST(getStoreCopyBytes(thread) < n * sizeof(double));
+#endif
+
+  // stores never shrink, the following tests start with a small one again
+  setStoreManagerType(ADOLC_LOCATION_SINGLETONS);
+  setStoreManagerType(ADOLC_LOCATION_BLOCKS);
+}
+
+// Serial writes after a region do not reach the stores the workers keep for a
+// later region that does not copy
+BOOST_AUTO_TEST_CASE(openmp_store_reuse_without_copy) {
+  const size_t n = 20000;
+  {
+    std::vector<adouble> serial(n);
+    for (size_t i = 0; i < n; ++i)
+      serial[i] = 1.0 * i;
+
+    int wrong = 0;
+#pragma omp parallel firstprivate(ADOLC_OpenMP_Handler) reduction(+ : wrong)
+    { wrong += serial[1].value() != 1.0; }
+
+    for (size_t i = 0; i < n; ++i)
+      serial[i] = -1.0;
+
+#pragma omp parallel firstprivate(ADOLC_OpenMP_Handler_NC) reduction(+ : wrong)
+    {
+      if (omp_get_thread_num() != 0)
+        for (size_t i = 1; i < n; ++i)
+          wrong += serial[i].value() != 1.0 * i;
+    }
+    BOOST_TEST(wrong == 0);
+    BOOST_TEST(serial[1].value() == -1.0);
+  }
+  setStoreManagerType(ADOLC_LOCATION_SINGLETONS);
+  setStoreManagerType(ADOLC_LOCATION_BLOCKS);
+}
+#endif
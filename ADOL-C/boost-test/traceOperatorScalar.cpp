@@ -5619,6 +5619,93 @@ BOOST_AUTO_TEST_CASE(TraceCompGeOperatorPrimal) {
   BOOST_TEST(k == l, tt::tolerance(tol));
 }
 
+/* Sums of products are taped by expression templates as mult_a_a followed
+ * by eq_plus_prod/eq_min_prod into the assigned adouble. */
+BOOST_AUTO_TEST_CASE(ProdSumOperator_FOS_Reverse) {
+  double x[4] = {1.5, -0.5, 2.0, 3.0};
+  double out, g[4];
+  adouble ax[4];
+  adouble ay;
+
+  trace_on(1);
+  for (int i = 0; i < 4; ++i)
+    ax[i] <<= x[i];
+  ay = ax[0] * ax[1] + ax[2] * ax[3] - ax[0] * ax[2];
+  ay >>= out;
+  trace_off();
+
+  BOOST_TEST(out == x[0] * x[1] + x[2] * x[3] - x[0] * x[2],
+             tt::tolerance(tol));
+
+  gradient(1, 4, x, g);
+  BOOST_TEST(g[0] == x[1] - x[2], tt::tolerance(tol));
+  BOOST_TEST(g[1] == x[0], tt::tolerance(tol));
+  BOOST_TEST(g[2] == x[3] - x[0], tt::tolerance(tol));
+  BOOST_TEST(g[3] == x[2], tt::tolerance(tol));
+
+#if defined(ADOLC_PROD_SUM_TEMPLATES)
+  size_t stats[STAT_SIZE];
+  tapestats(1, stats);
+  BOOST_TEST(stats[NUM_EQ_PROD] == 2);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(ProdSumOperator_Aliasing_FOS_Reverse) {
+  double x[3] = {0.7, -1.3, 2.2};
+  double out, g[3];
+  adouble ax[3];
+  adouble ay;
+
+  /* y = -(x0 * x1) - x1 * x2, then y = y * x0 + x2 * y, then
+   * y += x0 * x2 and y -= x1 * x1 */
+  trace_on(1);
+  for (int i = 0; i < 3; ++i)
+    ax[i] <<= x[i];
+  ay = -(ax[0] * ax[1]) - ax[1] * ax[2];
+  ay = ay * ax[0] + ax[2] * ay;
+  ay += ax[0] * ax[2];
+  ay -= ax[1] * ax[1];
+  ay >>= out;
+  trace_off();
+
+  const double u = -x[0] * x[1] - x[1] * x[2];
+  const double du[3] = {-x[1], -x[0] - x[2], -x[1]};
+  const double expected = u * (x[0] + x[2]) + x[0] * x[2] - x[1] * x[1];
+  BOOST_TEST(out == expected, tt::tolerance(tol));
+
+  gradient(1, 3, x, g);
+  BOOST_TEST(g[0] == du[0] * (x[0] + x[2]) + u + x[2], tt::tolerance(tol));
+  BOOST_TEST(g[1] == du[1] * (x[0] + x[2]) - 2.0 * x[1], tt::tolerance(tol));
+  BOOST_TEST(g[2] == du[2] * (x[0] + x[2]) + u + x[0], tt::tolerance(tol));
+}
+
+/* y = x * y must keep the dependence of y on itself in the index domains */
+BOOST_AUTO_TEST_CASE(ProdSumOperator_Aliasing_IndoPro) {
+  double x[2] = {1.5, -0.5};
+  double out;
+  adouble ax, ay;
+
+  trace_on(1);
+  ax <<= x[0];
+  ay <<= x[1];
+  ay = ax * ay;
+  ay >>= out;
+  trace_off();
+
+  BOOST_TEST(out == x[0] * x[1], tt::tolerance(tol));
+
+  unsigned int *crs[1];
+  indopro_forward_safe(1, 1, 2, x, crs);
+  BOOST_TEST(crs[0][0] == 2U);
+  BOOST_TEST(crs[0][1] == 0U);
+  BOOST_TEST(crs[0][2] == 1U);
+  delete[] crs[0];
+
+  indopro_forward_tight(1, 1, 2, x, crs);
+  BOOST_TEST(crs[0][0] == 2U);
+  delete[] crs[0];
+}
+
 /* Implementation of PowOperator_FOS_Reverse_1 does not work.  Why?
  * Apparently, PowOperator_FOS_Reverse_3 works fine (for some reason...).
  * Also, the implementations for LdexpOperator_1 and LdexpOperator_3 do
@@ -4,6 +4,7 @@
 namespace tt = boost::test_tools;
 
 #include <adolc/adolc.h>
+#include <adolc/adtl_kernels.h>
 
 #include "const.h"
 
@@ -3815,4 +3816,168 @@ BOOST_AUTO_TEST_CASE(CondeqassignOperator_FOV_Forward) {
   myfree2(yd);
 }
 
+/* With more directions than ADTL_KERNEL_MIN_DIRS the vector modes run the
+ * SIMD kernels, which must agree bit for bit with the scalar modes for every
+ * instruction set of this CPU, also where a result is one of its arguments. */
+BOOST_AUTO_TEST_CASE(Kernels_FOV_HOV_Forward_Reverse) {
+  const short tag = 1;
+  const int n = 3, m = 2, p = 11, q = 11, d = 4, ph = 3;
+  double xp[n] = {0.7, -1.3, 0.4}, yp[m];
+  adouble x[n], y[m];
+
+  trace_on(tag);
+  for (int i = 0; i < n; i++)
+    x[i] <<= xp[i];
+  adouble a = x[0] * x[1];
+  a *= a;
+  adouble b = exp(x[2]) - sin(x[0]);
+  adouble c = cos(x[1]) / (x[2] + 2.0);
+  b += a;
+  b *= 2.5;
+  c += x[0] * x[2];
+  c -= 3.0 * b;
+  c += c;
+  adouble e = x[1] / x[0];
+  for (int i = 0; i < n; i++) {
+    e += x[i] * c;
+    e -= x[(i + 1) % n] * b;
+    e = e / (x[i] + 3.0);
+  }
+  y[0] = b - c;
+  y[1] = -c * a + e;
+  for (int j = 0; j < m; j++)
+    y[j] >>= yp[j];
+  trace_off();
+
+  double **X = myalloc2(n, p), **Y = myalloc2(m, p);
+  double **U = myalloc2(q, m), **Z = myalloc2(q, n);
+  double ***XH = myalloc3(n, ph, d), ***YH = myalloc3(m, ph, d);
+  double xd[n], yd[m], u[m], z[n], XS[n * d], YS[m * d];
+  double *XSp[n], *YSp[m];
+
+  for (int i = 0; i < n; i++) {
+    XSp[i] = XS + i * d;
+    for (int l = 0; l < p; l++)
+      X[i][l] = std::sin(1.0 + i + 0.5 * l);
+    for (int l = 0; l < ph; l++)
+      for (int k = 0; k < d; k++)
+        XH[i][l][k] = std::cos(0.3 * (i + 1) * (l + 1) + k);
+  }
+  for (int j = 0; j < m; j++)
+    YSp[j] = YS + j * d;
+  for (int l = 0; l < q; l++)
+    for (int j = 0; j < m; j++)
+      U[l][j] = 1.0 + 0.5 * l - j;
+
+  const adtl::KernelISA saved = adtl::getKernelISA();
+  for (int isa = adtl::ADTL_ISA_SCALAR; isa <= adtl::getBestKernelISA();
+       isa++) {
+    BOOST_TEST(adtl::setKernelISA(static_cast<adtl::KernelISA>(isa)));
+
+    fov_forward(tag, m, n, p, xp, X, yp, Y);
+    for (int l = 0; l < p; l++) {
+      for (int i = 0; i < n; i++)
+        xd[i] = X[i][l];
+      fos_forward(tag, m, n, 0, xp, xd, yp, yd);
+      for (int j = 0; j < m; j++)
+        BOOST_TEST(Y[j][l] == yd[j]);
+    }
+
+    zos_forward(tag, m, n, 1, xp, yp);
+    fov_reverse(tag, m, n, q, U, Z);
+    for (int l = 0; l < q; l++) {
+      for (int j = 0; j < m; j++)
+        u[j] = U[l][j];
+      zos_forward(tag, m, n, 1, xp, yp);
+      fos_reverse(tag, m, n, u, z);
+      for (int i = 0; i < n; i++)
+        BOOST_TEST(Z[l][i] == z[i]);
+    }
+
+    hov_forward(tag, m, n, d, ph, xp, XH, yp, YH);
+    for (int l = 0; l < ph; l++) {
+      for (int i = 0; i < n; i++)
+        for (int k = 0; k < d; k++)
+          XSp[i][k] = XH[i][l][k];
+      hos_forward(tag, m, n, d, 0, xp, XSp, yp, YSp);
+      for (int j = 0; j < m; j++)
+        for (int k = 0; k < d; k++)
+          BOOST_TEST(YH[j][l][k] == YSp[j][k]);
+    }
+  }
+  adtl::setKernelISA(saved);
+
+  myfree2(X);
+  myfree2(Y);
+  myfree2(U);
+  myfree2(Z);
+  myfree3(XH);
+  myfree3(YH);
+}
+
+BOOST_AUTO_TEST_CASE(Batch_ZOS_Forward) {
+  const short tag = 1;
+  const int n = 2, m = 3, K = 37;
+  double xp[n] = {0.5, -0.25}, yp[m];
+  adouble x[n], y[m];
+
+  trace_on(tag);
+  for (int i = 0; i < n; i++)
+    x[i] <<= xp[i];
+  adouble a = x[0] * x[1] + exp(x[0]) / (x[1] + 2.0);
+  adouble b = sqrt(x[0] * x[0] + 1.0) - atan(x[1]);
+  condassign(y[0], x[0] - x[1], a, b);
+  y[1] = fmax(x[0], x[1]) + fabs(sin(x[1]) - 0.1);
+  condeqassign(y[2], x[1], cos(a), pow(b, 3.0));
+  for (int j = 0; j < m; j++)
+    y[j] >>= yp[j];
+  trace_off();
+
+  double **X = myalloc2(K, n), **Y = myalloc2(K, m);
+  double z[m];
+
+  /* the points take either branch of the conditional assignments */
+  for (int k = 0; k < K; k++) {
+    X[k][0] = -1.0 + 0.05 * k;
+    X[k][1] = 0.8 - 0.045 * k;
+  }
+
+  int rcBatch = zos_forward_batch(tag, m, n, K, X, Y);
+  int rc = 3;
+  for (int k = 0; k < K; k++) {
+    rc = std::min(rc, zos_forward(tag, m, n, 0, X[k], z));
+    for (int j = 0; j < m; j++)
+      BOOST_TEST(Y[k][j] == z[j], tt::tolerance(tol));
+  }
+  BOOST_TEST(rcBatch == rc);
+
+  /* active subscripts are left to zos_forward point by point */
+  trace_on(tag);
+  for (int i = 0; i < n; i++)
+    x[i] <<= xp[i];
+  advector v(3);
+  v[0] = x[0];
+  v[1] = x[1];
+  v[2] = x[0] * x[1];
+  adouble index = 1.0 + 0.0 * x[0];
+  y[0] = v[index];
+  y[1] = v[0] * 2.0;
+  y[2] = sin(v[2]);
+  for (int j = 0; j < m; j++)
+    y[j] >>= yp[j];
+  trace_off();
+
+  rcBatch = zos_forward_batch(tag, m, n, K, X, Y);
+  rc = 3;
+  for (int k = 0; k < K; k++) {
+    rc = std::min(rc, zos_forward(tag, m, n, 0, X[k], z));
+    for (int j = 0; j < m; j++)
+      BOOST_TEST(Y[k][j] == z[j], tt::tolerance(tol));
+  }
+  BOOST_TEST(rcBatch == rc);
+
+  myfree2(X);
+  myfree2(Y);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,1112 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+#include <adolc/dvlparms.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <sys/stat.h>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_tape_io)
+
+/**************************************************************/
+/* Tests for the different storage options of the tape files  */
+/**************************************************************/
+
+/* Small buffers force the operations, locations and values tapes to be
+ * written to disk in many blocks, so that the block reads of the sweeps are
+ * exercised. */
+const uint smallBufferSize = 128;
+const int numIndeps = 4;
+const int numIterations = 200;
+
+template <typename T> static T tapeIOFunction(const T *x) {
+  T y = 0.0;
+  for (int i = 0; i < numIterations; ++i)
+    y = 0.9 * y + 1.1 * sin(x[i % numIndeps]) * x[(i + 1) % numIndeps];
+  return y;
+}
+
+static void traceTapeIOFunction(short tapeId, int tapeIOFlags,
+                                const double *x) {
+  adouble ax[numIndeps];
+  adouble ay;
+  double y;
+
+  trace_on(tapeId, 0, smallBufferSize, smallBufferSize, smallBufferSize,
+           smallBufferSize, 0, tapeIOFlags);
+  for (int i = 0; i < numIndeps; ++i)
+    ax[i] <<= x[i];
+  ay = tapeIOFunction(ax);
+  ay >>= y;
+  trace_off(1);
+}
+
+static void removeTapeIOTapes(short tapeStdio, short tapeOther) {
+  removeTape(tapeStdio, ADOLC_REMOVE_COMPLETELY);
+  removeTape(tapeOther, ADOLC_REMOVE_COMPLETELY);
+}
+
+BOOST_AUTO_TEST_CASE(MmapTape_zos_forward) {
+  const short tapeStdio = 11, tapeMmap = 12;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double yStdio, yMmap;
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeMmap, ADOLC_TAPE_IO_MMAP, x);
+
+  zos_forward(tapeStdio, 1, numIndeps, 0, x, &yStdio);
+  zos_forward(tapeMmap, 1, numIndeps, 0, x, &yMmap);
+
+  BOOST_TEST(yMmap == tapeIOFunction(x), tt::tolerance(tol));
+  BOOST_TEST(yMmap == yStdio, tt::tolerance(tol));
+
+  /* the tape files have to be mapped again for a second sweep */
+  x[0] = 1.5;
+  zos_forward(tapeMmap, 1, numIndeps, 0, x, &yMmap);
+  BOOST_TEST(yMmap == tapeIOFunction(x), tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeMmap);
+}
+
+BOOST_AUTO_TEST_CASE(MmapTape_fos_forward) {
+  const short tapeStdio = 13, tapeMmap = 14;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double xd[numIndeps] = {1.0, 0.5, -0.25, 2.0};
+  double yStdio, yMmap, ydStdio, ydMmap;
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeMmap, ADOLC_TAPE_IO_MMAP, x);
+
+  fos_forward(tapeStdio, 1, numIndeps, 0, x, xd, &yStdio, &ydStdio);
+  fos_forward(tapeMmap, 1, numIndeps, 0, x, xd, &yMmap, &ydMmap);
+
+  BOOST_TEST(yMmap == yStdio, tt::tolerance(tol));
+  BOOST_TEST(ydMmap == ydStdio, tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeMmap);
+}
+
+BOOST_AUTO_TEST_CASE(MmapTape_fos_reverse) {
+  const short tapeStdio = 15, tapeMmap = 16;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double gStdio[numIndeps], gMmap[numIndeps];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeMmap, ADOLC_TAPE_IO_MMAP, x);
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeMmap, numIndeps, x, gMmap);
+
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gMmap[i] == gStdio[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeMmap);
+}
+
+BOOST_AUTO_TEST_CASE(MmapTape_hos_reverse) {
+  const short tapeStdio = 17, tapeMmap = 18;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double **hStdio = myalloc2(numIndeps, numIndeps);
+  double **hMmap = myalloc2(numIndeps, numIndeps);
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeMmap, ADOLC_TAPE_IO_MMAP, x);
+
+  hessian(tapeStdio, numIndeps, x, hStdio);
+  hessian(tapeMmap, numIndeps, x, hMmap);
+
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hMmap[i][j] == hStdio[i][j], tt::tolerance(tol));
+
+  myfree2(hStdio);
+  myfree2(hMmap);
+  removeTapeIOTapes(tapeStdio, tapeMmap);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncTape_fos_reverse) {
+  const short tapeStdio = 19, tapeAsync = 20;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double yStdio, yAsync;
+  double gStdio[numIndeps], gAsync[numIndeps];
+  size_t statsStdio[STAT_SIZE], statsAsync[STAT_SIZE];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeAsync, ADOLC_TAPE_IO_ASYNC, x);
+
+  tapestats(tapeStdio, statsStdio);
+  tapestats(tapeAsync, statsAsync);
+  BOOST_TEST(statsAsync[NUM_OPERATIONS] == statsStdio[NUM_OPERATIONS]);
+  BOOST_TEST(statsAsync[NUM_LOCATIONS] == statsStdio[NUM_LOCATIONS]);
+  BOOST_TEST(statsAsync[NUM_VALUES] == statsStdio[NUM_VALUES]);
+
+  zos_forward(tapeStdio, 1, numIndeps, 0, x, &yStdio);
+  zos_forward(tapeAsync, 1, numIndeps, 0, x, &yAsync);
+  BOOST_TEST(yAsync == tapeIOFunction(x), tt::tolerance(tol));
+  BOOST_TEST(yAsync == yStdio, tt::tolerance(tol));
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeAsync, numIndeps, x, gAsync);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gAsync[i] == gStdio[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeAsync);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncMmapTape_fos_reverse) {
+  const short tapeStdio = 21, tapeAsync = 22;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double gStdio[numIndeps], gAsync[numIndeps];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeAsync, ADOLC_TAPE_IO_ASYNC | ADOLC_TAPE_IO_MMAP,
+                      x);
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeAsync, numIndeps, x, gAsync);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gAsync[i] == gStdio[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeAsync);
+}
+
+BOOST_AUTO_TEST_CASE(PrefetchTape_fos_reverse) {
+  const short tapeStdio = 23, tapePrefetch = 24;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double xd[numIndeps] = {1.0, 0.5, -0.25, 2.0};
+  double yStdio, yPrefetch, ydStdio, ydPrefetch;
+  double gStdio[numIndeps], gPrefetch[numIndeps];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapePrefetch, ADOLC_TAPE_IO_PREFETCH, x);
+
+  fos_forward(tapeStdio, 1, numIndeps, 0, x, xd, &yStdio, &ydStdio);
+  fos_forward(tapePrefetch, 1, numIndeps, 0, x, xd, &yPrefetch, &ydPrefetch);
+  BOOST_TEST(yPrefetch == yStdio, tt::tolerance(tol));
+  BOOST_TEST(ydPrefetch == ydStdio, tt::tolerance(tol));
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapePrefetch, numIndeps, x, gPrefetch);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gPrefetch[i] == gStdio[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapePrefetch);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncPrefetchTape_hos_reverse) {
+  const short tapeStdio = 25, tapePrefetch = 26;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double **hStdio = myalloc2(numIndeps, numIndeps);
+  double **hPrefetch = myalloc2(numIndeps, numIndeps);
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapePrefetch,
+                      ADOLC_TAPE_IO_ASYNC | ADOLC_TAPE_IO_PREFETCH, x);
+
+  hessian(tapeStdio, numIndeps, x, hStdio);
+  hessian(tapePrefetch, numIndeps, x, hPrefetch);
+
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hPrefetch[i][j] == hStdio[i][j], tt::tolerance(tol));
+
+  myfree2(hStdio);
+  myfree2(hPrefetch);
+  removeTapeIOTapes(tapeStdio, tapePrefetch);
+}
+
+BOOST_AUTO_TEST_CASE(CompressTape_fos_reverse) {
+  const short tapeStdio = 27, tapeCompress = 28;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double yStdio, yCompress;
+  double gStdio[numIndeps], gCompress[numIndeps];
+  size_t statsStdio[STAT_SIZE], statsCompress[STAT_SIZE];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeCompress, ADOLC_TAPE_IO_COMPRESS, x);
+
+  tapestats(tapeStdio, statsStdio);
+  tapestats(tapeCompress, statsCompress);
+  BOOST_TEST(statsCompress[NUM_OPERATIONS] == statsStdio[NUM_OPERATIONS]);
+  BOOST_TEST(statsCompress[NUM_LOCATIONS] == statsStdio[NUM_LOCATIONS]);
+  BOOST_TEST(statsCompress[NUM_VALUES] == statsStdio[NUM_VALUES]);
+  BOOST_TEST(statsStdio[LOC_FILE_INDEX] == 0);
+  BOOST_TEST(statsCompress[OP_FILE_INDEX] != 0);
+  BOOST_TEST(statsCompress[LOC_FILE_INDEX] != 0);
+  BOOST_TEST(statsCompress[VAL_FILE_INDEX] != 0);
+
+  zos_forward(tapeStdio, 1, numIndeps, 0, x, &yStdio);
+  zos_forward(tapeCompress, 1, numIndeps, 0, x, &yCompress);
+  BOOST_TEST(yCompress == tapeIOFunction(x), tt::tolerance(tol));
+  BOOST_TEST(yCompress == yStdio, tt::tolerance(tol));
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeCompress, numIndeps, x, gCompress);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gCompress[i] == gStdio[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeCompress);
+}
+
+BOOST_AUTO_TEST_CASE(CompressTape_hos_reverse_from_disk) {
+  const short tapeStdio = 29, tapeCompress = 30;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double **hStdio = myalloc2(numIndeps, numIndeps);
+  double **hCompress = myalloc2(numIndeps, numIndeps);
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeCompress, ADOLC_TAPE_IO_COMPRESS, x);
+
+  /* the block index has to be read back from the tape files */
+  removeTape(tapeCompress, ADOLC_REMOVE_FROM_CORE);
+
+  hessian(tapeStdio, numIndeps, x, hStdio);
+  hessian(tapeCompress, numIndeps, x, hCompress);
+
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hCompress[i][j] == hStdio[i][j], tt::tolerance(tol));
+
+  myfree2(hStdio);
+  myfree2(hCompress);
+  removeTapeIOTapes(tapeStdio, tapeCompress);
+}
+
+BOOST_AUTO_TEST_CASE(AsyncPrefetchCompressTape_fos_reverse) {
+  const short tapeStdio = 31, tapeCompress = 32;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double gStdio[numIndeps], gCompress[numIndeps];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeCompress,
+                      ADOLC_TAPE_IO_ASYNC | ADOLC_TAPE_IO_PREFETCH |
+                          ADOLC_TAPE_IO_COMPRESS | ADOLC_TAPE_IO_MMAP,
+                      x);
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeCompress, numIndeps, x, gCompress);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gCompress[i] == gStdio[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeCompress);
+}
+
+BOOST_AUTO_TEST_CASE(ContainerTape_hos_reverse) {
+  const short tapeStdio = 33, tapeContainer = 34;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double **hStdio = myalloc2(numIndeps, numIndeps);
+  double **hContainer = myalloc2(numIndeps, numIndeps);
+  size_t statsContainer[STAT_SIZE];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeContainer, ADOLC_TAPE_IO_CONTAINER, x);
+
+  tapestats(tapeContainer, statsContainer);
+  BOOST_TEST(statsContainer[FILE_CONTAINER] == 1);
+
+  hessian(tapeStdio, numIndeps, x, hStdio);
+  hessian(tapeContainer, numIndeps, x, hContainer);
+
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hContainer[i][j] == hStdio[i][j], tt::tolerance(tol));
+
+  myfree2(hStdio);
+  myfree2(hContainer);
+  removeTapeIOTapes(tapeStdio, tapeContainer);
+}
+
+BOOST_AUTO_TEST_CASE(ContainerTape_fos_reverse_from_disk) {
+  const short tapeStdio = 35, tapeContainer = 36;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double gStdio[numIndeps], gContainer[numIndeps];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeContainer,
+                      ADOLC_TAPE_IO_CONTAINER | ADOLC_TAPE_IO_COMPRESS |
+                          ADOLC_TAPE_IO_ASYNC | ADOLC_TAPE_IO_PREFETCH,
+                      x);
+  removeTape(tapeContainer, ADOLC_REMOVE_FROM_CORE);
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeContainer, numIndeps, x, gContainer);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gContainer[i] == gStdio[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeContainer);
+}
+
+BOOST_AUTO_TEST_CASE(ContainerTape_params_from_disk) {
+  const short tapeContainer = 37;
+  const int numParams = 300;
+  double x = 0.7, y, yExpected = 0.0;
+  adouble ax, ay;
+
+  /* the parameters fill several blocks at the end of the values stream */
+  trace_on(tapeContainer, 0, smallBufferSize, smallBufferSize,
+           smallBufferSize, smallBufferSize, 0,
+           ADOLC_TAPE_IO_CONTAINER | ADOLC_TAPE_IO_COMPRESS);
+  ax <<= x;
+  ay = 0.0;
+  for (int i = 0; i < numParams; ++i) {
+    ay += pdouble::mkparam(0.01 * i) * ax;
+    yExpected += 0.01 * i * x;
+  }
+  ay >>= y;
+  trace_off(1);
+  removeTape(tapeContainer, ADOLC_REMOVE_FROM_CORE);
+
+  zos_forward(tapeContainer, 1, 1, 0, &x, &y);
+  BOOST_TEST(y == yExpected, tt::tolerance(tol));
+
+  removeTape(tapeContainer, ADOLC_REMOVE_COMPLETELY);
+}
+
+static std::string tapeIOFileName(const char *baseName, short tapeId) {
+  return std::string(TAPE_DIR) + PATHSEPARATOR + baseName +
+         std::to_string(tapeId) + ".tap";
+}
+
+BOOST_AUTO_TEST_CASE(TapePool_gradient_without_files) {
+  const short tapeStdio = 38, tapePool = 39;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double gStdio[numIndeps], gPool[numIndeps];
+
+  setTapePoolSize(1 << 20);
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapePool, ADOLC_TAPE_IO_COMPRESS, x);
+
+  /* the first sweep reads the tape into the pool, later ones do not need
+   * the tape files any more */
+  gradient(tapePool, numIndeps, x, gPool);
+  BOOST_TEST(
+      std::remove(tapeIOFileName(ADOLC_OPERATIONS_NAME, tapePool).c_str()) ==
+      0);
+  BOOST_TEST(
+      std::remove(tapeIOFileName(ADOLC_LOCATIONS_NAME, tapePool).c_str()) ==
+      0);
+  BOOST_TEST(std::remove(tapeIOFileName(ADOLC_VALUES_NAME, tapePool).c_str()) ==
+             0);
+
+  x[2] = -0.4;
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapePool, numIndeps, x, gPool);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gPool[i] == gStdio[i], tt::tolerance(tol));
+
+  setTapePoolSize(0);
+  removeTapeIOTapes(tapeStdio, tapePool);
+}
+
+static void traceTapeIOInCore(short tapeId, const double *x) {
+  const uint bufferSize = 4096;
+  adouble ax[numIndeps];
+  adouble ay;
+  double y;
+
+  trace_on(tapeId, 0, bufferSize, bufferSize, bufferSize, bufferSize, 0,
+           ADOLC_TAPE_IO_STDIO);
+  for (int i = 0; i < numIndeps; ++i)
+    ax[i] <<= x[i];
+  ay = tapeIOFunction(ax);
+  ay >>= y;
+  trace_off();
+}
+
+BOOST_AUTO_TEST_CASE(TapePool_evicts_least_recently_used) {
+  const short tapeA = 40, tapeB = 41, tapeC = 42, tapeStdio = 43;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double g[numIndeps], gStdio[numIndeps];
+  size_t statsA[STAT_SIZE], statsB[STAT_SIZE], statsC[STAT_SIZE];
+
+  /* the budget holds the buffers of two tapes kept in core */
+  setTapePoolSize(150000);
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  traceTapeIOInCore(tapeA, x);
+  traceTapeIOInCore(tapeB, x);
+  gradient(tapeA, numIndeps, x, g);
+  traceTapeIOInCore(tapeC, x);
+
+  tapestats(tapeA, statsA);
+  tapestats(tapeB, statsB);
+  tapestats(tapeC, statsC);
+  BOOST_TEST(statsA[OP_FILE_ACCESS] == 0);
+  BOOST_TEST(statsB[OP_FILE_ACCESS] == 1);
+  BOOST_TEST(statsC[OP_FILE_ACCESS] == 0);
+
+  /* the evicted tape is read back from disk */
+  gradient(tapeB, numIndeps, x, g);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(g[i] == gStdio[i], tt::tolerance(tol));
+
+  setTapePoolSize(0);
+  removeTapeIOTapes(tapeA, tapeB);
+  removeTapeIOTapes(tapeC, tapeStdio);
+}
+
+static void removeTapeIOFiles(short tapeId) {
+  std::remove(tapeIOFileName(ADOLC_OPERATIONS_NAME, tapeId).c_str());
+  std::remove(tapeIOFileName(ADOLC_LOCATIONS_NAME, tapeId).c_str());
+  std::remove(tapeIOFileName(ADOLC_VALUES_NAME, tapeId).c_str());
+}
+
+BOOST_AUTO_TEST_CASE(PackedTape_hos_reverse) {
+  const short tapeStdio = 44, tapePacked = 45;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double xd[numIndeps] = {1.0, 0.5, -0.25, 2.0};
+  double yStdio, yPacked, ydStdio, ydPacked;
+  double gStdio[numIndeps], gPacked[numIndeps];
+  double **hStdio = myalloc2(numIndeps, numIndeps);
+  double **hPacked = myalloc2(numIndeps, numIndeps);
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapePacked, ADOLC_TAPE_IO_PACKED, x);
+  /* sweeps read the records only */
+  removeTapeIOFiles(tapePacked);
+
+  fos_forward(tapeStdio, 1, numIndeps, 0, x, xd, &yStdio, &ydStdio);
+  fos_forward(tapePacked, 1, numIndeps, 0, x, xd, &yPacked, &ydPacked);
+  BOOST_TEST(yPacked == tapeIOFunction(x), tt::tolerance(tol));
+  BOOST_TEST(ydPacked == ydStdio, tt::tolerance(tol));
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapePacked, numIndeps, x, gPacked);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gPacked[i] == gStdio[i], tt::tolerance(tol));
+
+  hessian(tapeStdio, numIndeps, x, hStdio);
+  hessian(tapePacked, numIndeps, x, hPacked);
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hPacked[i][j] == hStdio[i][j], tt::tolerance(tol));
+
+  myfree2(hStdio);
+  myfree2(hPacked);
+  removeTapeIOTapes(tapeStdio, tapePacked);
+}
+
+BOOST_AUTO_TEST_CASE(PackedTape_live_adoubles_and_params) {
+  const short tapeInCore = 46, tapePacked = 47;
+  const int numParams = 50;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double p[numParams];
+  double yInCore, yPacked, yExpected;
+  double gInCore[numIndeps], gPacked[numIndeps];
+  /* more live adoubles than fit into a values buffer are recorded when
+   * taping starts */
+  adouble live[3 * smallBufferSize];
+  adouble ax[numIndeps];
+  adouble ay;
+  double y;
+
+  /* the reference tape stays in core to keep the parameters set below */
+  trace_on(tapeInCore);
+  for (int i = 0; i < numIndeps; ++i)
+    ax[i] <<= x[i];
+  ay = tapeIOFunction(ax);
+  for (int i = 0; i < numParams; ++i)
+    ay += pdouble::mkparam(0.01 * i) * ax[i % numIndeps];
+  ay >>= y;
+  trace_off();
+
+  trace_on(tapePacked, 0, smallBufferSize, smallBufferSize, smallBufferSize,
+           smallBufferSize, 0, ADOLC_TAPE_IO_PACKED);
+  for (int i = 0; i < numIndeps; ++i)
+    ax[i] <<= x[i];
+  ay = tapeIOFunction(ax);
+  for (int i = 0; i < numParams; ++i)
+    ay += pdouble::mkparam(0.01 * i) * ax[i % numIndeps];
+  ay >>= y;
+  trace_off();
+
+  yExpected = tapeIOFunction(x);
+  for (int i = 0; i < numParams; ++i) {
+    p[i] = -0.02 * i;
+    yExpected += p[i] * x[i % numIndeps];
+  }
+  set_param_vec(tapeInCore, numParams, p);
+  set_param_vec(tapePacked, numParams, p);
+
+  zos_forward(tapeInCore, 1, numIndeps, 0, x, &yInCore);
+  zos_forward(tapePacked, 1, numIndeps, 0, x, &yPacked);
+  BOOST_TEST(yInCore == yExpected, tt::tolerance(tol));
+  BOOST_TEST(yPacked == yExpected, tt::tolerance(tol));
+
+  gradient(tapeInCore, numIndeps, x, gInCore);
+  gradient(tapePacked, numIndeps, x, gPacked);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gPacked[i] == gInCore[i], tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeInCore, tapePacked);
+}
+
+static long tapeIOFileSize(const char *baseName, short tapeId) {
+  FILE *file = std::fopen(tapeIOFileName(baseName, tapeId).c_str(), "rb");
+  long size = -1;
+
+  if (file != nullptr) {
+    if (std::fseek(file, 0, SEEK_END) == 0)
+      size = std::ftell(file);
+    std::fclose(file);
+  }
+  return size;
+}
+
+BOOST_AUTO_TEST_CASE(NarrowTape_hos_reverse_from_disk) {
+  const short tapeStdio = 48, tapeNarrow = 49;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double gStdio[numIndeps], gNarrow[numIndeps];
+  double **hStdio = myalloc2(numIndeps, numIndeps);
+  double **hNarrow = myalloc2(numIndeps, numIndeps);
+  size_t statsNarrow[STAT_SIZE];
+
+  traceTapeIOFunction(tapeStdio, ADOLC_TAPE_IO_STDIO, x);
+  traceTapeIOFunction(tapeNarrow, ADOLC_TAPE_IO_NARROW, x);
+
+  /* only the locations are narrowed, all of them fit into 16 bits */
+  tapestats(tapeNarrow, statsNarrow);
+  BOOST_TEST(statsNarrow[NUM_MAX_LIVES] < 65536);
+  BOOST_TEST(statsNarrow[LOC_FILE_INDEX] != 0);
+  BOOST_TEST(statsNarrow[NUM_LOCATIONS] > 0);
+  BOOST_TEST(tapeIOFileSize(ADOLC_LOCATIONS_NAME, tapeNarrow) <
+             tapeIOFileSize(ADOLC_LOCATIONS_NAME, tapeStdio));
+
+  /* the narrow blocks have to be widened when read back from disk */
+  removeTape(tapeNarrow, ADOLC_REMOVE_FROM_CORE);
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeNarrow, numIndeps, x, gNarrow);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gNarrow[i] == gStdio[i], tt::tolerance(tol));
+
+  hessian(tapeStdio, numIndeps, x, hStdio);
+  hessian(tapeNarrow, numIndeps, x, hNarrow);
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hNarrow[i][j] == hStdio[i][j], tt::tolerance(tol));
+
+  myfree2(hStdio);
+  myfree2(hNarrow);
+  removeTapeIOTapes(tapeStdio, tapeNarrow);
+}
+
+static void traceTapeIORepeated(short tapeId, int repeat, const double *x) {
+  adouble ax[numIndeps];
+  adouble ay = 0.0;
+  double y;
+
+  trace_on(tapeId);
+  for (int i = 0; i < numIndeps; ++i)
+    ax[i] <<= x[i];
+  for (int i = 0; i < repeat; ++i)
+    ay += tapeIOFunction(ax);
+  ay >>= y;
+  trace_off();
+}
+
+BOOST_AUTO_TEST_CASE(AdaptiveBuffers_fit_previous_recording) {
+  const short tapeAdaptive = 50;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double g[numIndeps], gExpected[numIndeps];
+  size_t statsFirst[STAT_SIZE], statsSecond[STAT_SIZE], statsLarge[STAT_SIZE];
+  size_t numOps, numLocs, numVals;
+
+  setAdaptiveBufferSize(ADAPTIVEBUFMAX);
+  traceTapeIORepeated(tapeAdaptive, 1, x);
+  tapestats(tapeAdaptive, statsFirst);
+
+  /* the second recording gets buffers fitting the first one */
+  traceTapeIORepeated(tapeAdaptive, 1, x);
+  tapestats(tapeAdaptive, statsSecond);
+  numOps = statsFirst[NUM_OPERATIONS];
+  numLocs = statsFirst[NUM_LOCATIONS];
+  numVals = statsFirst[NUM_VALUES];
+  BOOST_TEST(statsSecond[OP_BUFFER_SIZE] ==
+             std::max(numOps + numOps / 4,
+                      std::min(statsFirst[OP_BUFFER_SIZE],
+                               (size_t)ADAPTIVEBUFMIN)));
+  BOOST_TEST(statsSecond[LOC_BUFFER_SIZE] ==
+             std::max(numLocs + numLocs / 4,
+                      std::min(statsFirst[LOC_BUFFER_SIZE],
+                               (size_t)ADAPTIVEBUFMIN)));
+  BOOST_TEST(statsSecond[VAL_BUFFER_SIZE] ==
+             std::max(numVals + numVals / 4,
+                      std::min(statsFirst[VAL_BUFFER_SIZE],
+                               (size_t)ADAPTIVEBUFMIN)));
+  BOOST_TEST(statsSecond[OP_FILE_ACCESS] == 0);
+  BOOST_TEST(statsSecond[LOC_FILE_ACCESS] == 0);
+  BOOST_TEST(statsSecond[VAL_FILE_ACCESS] == 0);
+
+  /* a larger recording outgrows the adapted buffers */
+  traceTapeIORepeated(tapeAdaptive, 50, x);
+  tapestats(tapeAdaptive, statsLarge);
+  BOOST_TEST(statsLarge[NUM_OPERATIONS] > statsLarge[OP_BUFFER_SIZE]);
+  BOOST_TEST(statsLarge[OP_FILE_ACCESS] == 1);
+  gradient(tapeAdaptive, numIndeps, x, g);
+
+  traceTapeIOFunction(tapeAdaptive, ADOLC_TAPE_IO_STDIO, x);
+  gradient(tapeAdaptive, numIndeps, x, gExpected);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(g[i] == 50 * gExpected[i], tt::tolerance(tol));
+
+  /* without adaptive sizing the default sizes are used again */
+  setAdaptiveBufferSize(0);
+  traceTapeIORepeated(tapeAdaptive, 1, x);
+  traceTapeIORepeated(tapeAdaptive, 1, x);
+  tapestats(tapeAdaptive, statsSecond);
+  BOOST_TEST(statsSecond[OP_BUFFER_SIZE] == statsFirst[OP_BUFFER_SIZE]);
+  BOOST_TEST(statsSecond[LOC_BUFFER_SIZE] == statsFirst[LOC_BUFFER_SIZE]);
+  BOOST_TEST(statsSecond[VAL_BUFFER_SIZE] == statsFirst[VAL_BUFFER_SIZE]);
+  setAdaptiveBufferSize(ADAPTIVEBUFMAX);
+
+  removeTape(tapeAdaptive, ADOLC_REMOVE_COMPLETELY);
+}
+
+BOOST_AUTO_TEST_CASE(TaylorArena_spills_to_disk) {
+  const short tapeArena = 51;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double gInCore[numIndeps], gSpilled[numIndeps];
+  double **hInCore = myalloc2(numIndeps, numIndeps);
+  double **hSpilled = myalloc2(numIndeps, numIndeps);
+
+  /* the small taylor buffer of the tape is pushed onto the stack in many
+   * blocks, which stay in core below the arena ceiling */
+  traceTapeIOFunction(tapeArena, ADOLC_TAPE_IO_STDIO, x);
+  setTaylorArenaSize(TAYLORARENASIZE);
+  gradient(tapeArena, numIndeps, x, gInCore);
+  hessian(tapeArena, numIndeps, x, hInCore);
+  BOOST_TEST(tapeIOFileSize(ADOLC_TAYLORS_NAME, tapeArena) == -1);
+
+  /* without an arena all blocks are written to the taylor file */
+  setTaylorArenaSize(0);
+  gradient(tapeArena, numIndeps, x, gSpilled);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gSpilled[i] == gInCore[i], tt::tolerance(tol));
+  hessian(tapeArena, numIndeps, x, hSpilled);
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hSpilled[i][j] == hInCore[i][j], tt::tolerance(tol));
+  BOOST_TEST(tapeIOFileSize(ADOLC_TAYLORS_NAME, tapeArena) > 0);
+  setTaylorArenaSize(TAYLORARENASIZE);
+
+  myfree2(hInCore);
+  myfree2(hSpilled);
+  removeTape(tapeArena, ADOLC_REMOVE_COMPLETELY);
+}
+
+template <typename T> static T compactFunction(const T *x, const T &c) {
+  T y = tapeIOFunction(x);
+  T z = atan(x[0] * c) + fmin(x[1], x[2]);
+  condassign(z, x[3] - c, z * z, z);
+  y += z;
+  y *= c;
+  return y;
+}
+
+static void traceTapeIOCompact(short tapeId, int tapeIOFlags, const double *x,
+                               const adouble &c) {
+  adouble ax[numIndeps];
+  adouble ay;
+  double y;
+
+  trace_on(tapeId, 0, OBUFSIZE, LBUFSIZE, VBUFSIZE, TBUFSIZE, 0, tapeIOFlags);
+  for (int i = 0; i < numIndeps; ++i)
+    ax[i] <<= x[i];
+  ay = compactFunction(ax, c);
+  ay >>= y;
+  trace_off();
+}
+
+BOOST_AUTO_TEST_CASE(CompactTape_hos_reverse) {
+  const short tapeStdio = 52, tapeCompact = 53, tapePacked = 54;
+  const int numHoles = 64;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double yStdio, yCompact, yPacked;
+  double gStdio[numIndeps], gCompact[numIndeps], gPacked[numIndeps];
+  double **hStdio = myalloc2(numIndeps, numIndeps);
+  double **hCompact = myalloc2(numIndeps, numIndeps);
+  size_t statsStdio[STAT_SIZE], statsCompact[STAT_SIZE];
+  adouble *holes[numHoles];
+
+  /* adoubles freed before taping leave holes in the store, the tapes read
+   * the value of an adouble created before */
+  for (int i = 0; i < numHoles; ++i)
+    holes[i] = new adouble(1.0 * i);
+  for (int i = 0; i < numHoles; i += 2)
+    delete holes[i];
+  adouble c = 1.5;
+
+  traceTapeIOCompact(tapeStdio, ADOLC_TAPE_IO_STDIO, x, c);
+  traceTapeIOCompact(tapeCompact, ADOLC_TAPE_IO_COMPACT, x, c);
+  traceTapeIOCompact(tapePacked, ADOLC_TAPE_IO_COMPACT | ADOLC_TAPE_IO_PACKED,
+                     x, c);
+  for (int i = 1; i < numHoles; i += 2)
+    delete holes[i];
+
+  tapestats(tapeStdio, statsStdio);
+  tapestats(tapeCompact, statsCompact);
+  BOOST_TEST(statsCompact[NUM_MAX_LIVES] < statsStdio[NUM_MAX_LIVES]);
+  BOOST_TEST(statsCompact[NUM_OPERATIONS] == statsStdio[NUM_OPERATIONS]);
+  BOOST_TEST(statsCompact[NUM_LOCATIONS] == statsStdio[NUM_LOCATIONS]);
+
+  zos_forward(tapeStdio, 1, numIndeps, 0, x, &yStdio);
+  zos_forward(tapeCompact, 1, numIndeps, 0, x, &yCompact);
+  zos_forward(tapePacked, 1, numIndeps, 0, x, &yPacked);
+  BOOST_TEST(yStdio == compactFunction(x, 1.5), tt::tolerance(tol));
+  BOOST_TEST(yCompact == yStdio, tt::tolerance(tol));
+  BOOST_TEST(yPacked == yStdio, tt::tolerance(tol));
+
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeCompact, numIndeps, x, gCompact);
+  gradient(tapePacked, numIndeps, x, gPacked);
+  for (int i = 0; i < numIndeps; ++i) {
+    BOOST_TEST(gCompact[i] == gStdio[i], tt::tolerance(tol));
+    BOOST_TEST(gPacked[i] == gStdio[i], tt::tolerance(tol));
+  }
+
+  hessian(tapeStdio, numIndeps, x, hStdio);
+  hessian(tapeCompact, numIndeps, x, hCompact);
+  for (int i = 0; i < numIndeps; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(hCompact[i][j] == hStdio[i][j], tt::tolerance(tol));
+
+  myfree2(hStdio);
+  myfree2(hCompact);
+  removeTapeIOTapes(tapeStdio, tapeCompact);
+  removeTape(tapePacked, ADOLC_REMOVE_COMPLETELY);
+}
+
+template <typename T, typename P> static T threadedFunction(const T *x, P c) {
+  T y = 0.0, t;
+  for (int i = 0; i < numIterations; ++i) {
+    const T &u = x[i % numIndeps];
+    const T &v = x[(i + 1) % numIndeps];
+    t = u * v - 2.0 / (1.5 + v * v) + exp(0.1 * u) * c;
+    t += sqrt(1.0 + u * u) - log(2.0 + cos(v)) + atan(u);
+    y = 0.9 * y + sin(t) / (3.0 - u) - (-t);
+    y *= 0.5;
+    y -= 1.0;
+  }
+  return y;
+}
+
+static void traceTapeIOThreaded(short tapeId, int tapeIOFlags, const double *x,
+                                bool withAbs) {
+  adouble ax[numIndeps];
+  adouble ay;
+  double y;
+
+  trace_on(tapeId, 0, 1 << 16, 1 << 16, 1 << 16, 1 << 16, 0, tapeIOFlags);
+  for (int i = 0; i < numIndeps; ++i)
+    ax[i] <<= x[i];
+  ay = threadedFunction(ax, pdouble::mkparam(0.5));
+  if (withAbs)
+    ay += fabs(ax[0]);
+  ay >>= y;
+  trace_off();
+}
+
+BOOST_AUTO_TEST_CASE(ThreadedTape_zos_fos_forward) {
+  const short tapeStdio = 55, tapeThreaded = 56, tapePacked = 57,
+              tapeAbs = 58;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double xd[numIndeps] = {1.0, 0.5, -0.25, 2.0};
+  double p = -0.75;
+  double yStdio, ydStdio, yThreaded, ydThreaded, yPacked, ydPacked, yAbs;
+  double gStdio[numIndeps], gThreaded[numIndeps];
+
+  traceTapeIOThreaded(tapeStdio, ADOLC_TAPE_IO_STDIO, x, false);
+  traceTapeIOThreaded(tapeThreaded, ADOLC_TAPE_IO_THREADED, x, false);
+  traceTapeIOThreaded(tapePacked,
+                      ADOLC_TAPE_IO_THREADED | ADOLC_TAPE_IO_PACKED, x, false);
+  /* abs_val has no threaded handler, the switch sweeps the tape */
+  traceTapeIOThreaded(tapeAbs, ADOLC_TAPE_IO_THREADED, x, true);
+
+  /* the second round of sweeps runs the decoded tapes with new parameters */
+  for (int round = 0; round < 2; ++round) {
+    zos_forward(tapeStdio, 1, numIndeps, 0, x, &yStdio);
+    zos_forward(tapeThreaded, 1, numIndeps, 0, x, &yThreaded);
+    zos_forward(tapePacked, 1, numIndeps, 0, x, &yPacked);
+    zos_forward(tapeAbs, 1, numIndeps, 0, x, &yAbs);
+    BOOST_TEST(yStdio == threadedFunction(x, round == 0 ? 0.5 : p),
+               tt::tolerance(tol));
+    BOOST_TEST(yThreaded == yStdio, tt::tolerance(tol));
+    BOOST_TEST(yPacked == yStdio, tt::tolerance(tol));
+    BOOST_TEST(yAbs == yStdio + fabs(x[0]), tt::tolerance(tol));
+
+    fos_forward(tapeStdio, 1, numIndeps, 0, x, xd, &yStdio, &ydStdio);
+    fos_forward(tapeThreaded, 1, numIndeps, 0, x, xd, &yThreaded,
+                &ydThreaded);
+    fos_forward(tapePacked, 1, numIndeps, 0, x, xd, &yPacked, &ydPacked);
+    BOOST_TEST(yThreaded == yStdio, tt::tolerance(tol));
+    BOOST_TEST(ydThreaded == ydStdio, tt::tolerance(tol));
+    BOOST_TEST(yPacked == yStdio, tt::tolerance(tol));
+    BOOST_TEST(ydPacked == ydStdio, tt::tolerance(tol));
+
+    set_param_vec(tapeStdio, 1, &p);
+    set_param_vec(tapeThreaded, 1, &p);
+    set_param_vec(tapePacked, 1, &p);
+    set_param_vec(tapeAbs, 1, &p);
+  }
+
+  /* sweeps keeping taylors for the reverse mode use the switch */
+  gradient(tapeStdio, numIndeps, x, gStdio);
+  gradient(tapeThreaded, numIndeps, x, gThreaded);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(gThreaded[i] == gStdio[i], tt::tolerance(tol));
+
+  /* retaping drops the decoded tape */
+  x[1] = 0.4;
+  traceTapeIOThreaded(tapeThreaded, ADOLC_TAPE_IO_THREADED, x, true);
+  zos_forward(tapeThreaded, 1, numIndeps, 0, x, &yThreaded);
+  BOOST_TEST(yThreaded == threadedFunction(x, 0.5) + fabs(x[0]),
+             tt::tolerance(tol));
+
+  removeTapeIOTapes(tapeStdio, tapeThreaded);
+  removeTapeIOTapes(tapePacked, tapeAbs);
+}
+
+/* Creates an empty directory for native code readable by the user only and
+ * returns its path. */
+static std::string nativeTestDir() {
+  std::string dir =
+      (std::filesystem::temp_directory_path() / "adolc-native-XXXXXX")
+          .string();
+  BOOST_REQUIRE(mkdtemp(&dir[0]) != nullptr);
+  return dir;
+}
+
+static size_t numNativeObjects(const std::string &dir) {
+  size_t num = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(dir))
+    num += entry.path().extension() == ".so";
+  return num;
+}
+
+BOOST_AUTO_TEST_CASE(NativeTape_forward_reverse) {
+  const short tapeStdio = 59, tapeNative = 60, tapeAbs = 61;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double xd[numIndeps] = {1.0, 0.5, -0.25, 2.0};
+  double p = -0.75, u = 1.5;
+  double yStdio, ydStdio, yNative, ydNative, yAbs;
+  double zStdio[numIndeps], zNative[numIndeps];
+  double **X = myalloc2(numIndeps, 2), **Yd = myalloc2(1, 2);
+  double **U = myalloc2(2, 1), **Z = myalloc2(2, numIndeps);
+  double ydv[2], zv[2][numIndeps];
+
+  for (int i = 0; i < numIndeps; ++i) {
+    X[i][0] = xd[i];
+    X[i][1] = 1.0 - i;
+  }
+  U[0][0] = 1.0;
+  U[1][0] = -2.0;
+
+  const std::string dir = nativeTestDir();
+  setNativeDir(dir.c_str());
+  traceTapeIOThreaded(tapeStdio, ADOLC_TAPE_IO_STDIO, x, false);
+  traceTapeIOThreaded(tapeNative, ADOLC_TAPE_IO_NATIVE, x, false);
+  /* abs_val cannot be compiled, the switch sweeps the tape */
+  traceTapeIOThreaded(tapeAbs, ADOLC_TAPE_IO_NATIVE, x, true);
+
+  /* the second round of sweeps runs the compiled tape with new parameters */
+  for (int round = 0; round < 2; ++round) {
+    zos_forward(tapeStdio, 1, numIndeps, 0, x, &yStdio);
+    zos_forward(tapeNative, 1, numIndeps, 0, x, &yNative);
+    zos_forward(tapeAbs, 1, numIndeps, 0, x, &yAbs);
+    BOOST_TEST(yNative == yStdio, tt::tolerance(tol));
+    BOOST_TEST(yAbs == yStdio + fabs(x[0]), tt::tolerance(tol));
+
+    fos_forward(tapeStdio, 1, numIndeps, 0, x, xd, &yStdio, &ydStdio);
+    fos_forward(tapeNative, 1, numIndeps, 0, x, xd, &yNative, &ydNative);
+    BOOST_TEST(yNative == yStdio, tt::tolerance(tol));
+    BOOST_TEST(ydNative == ydStdio, tt::tolerance(tol));
+
+    fov_forward(tapeStdio, 1, numIndeps, 2, x, X, &yStdio, Yd);
+    ydv[0] = Yd[0][0];
+    ydv[1] = Yd[0][1];
+    fov_forward(tapeNative, 1, numIndeps, 2, x, X, &yNative, Yd);
+    BOOST_TEST(yNative == yStdio, tt::tolerance(tol));
+    BOOST_TEST(Yd[0][0] == ydv[0], tt::tolerance(tol));
+    BOOST_TEST(Yd[0][1] == ydv[1], tt::tolerance(tol));
+    BOOST_TEST(Yd[0][0] == ydStdio, tt::tolerance(tol));
+
+    /* the reverse sweeps start from the base point of the sweep keeping
+     * taylors */
+    zos_forward(tapeStdio, 1, numIndeps, 1, x, &yStdio);
+    zos_forward(tapeNative, 1, numIndeps, 1, x, &yNative);
+    fos_reverse(tapeStdio, 1, numIndeps, &u, zStdio);
+    /* the second sweep finds no adjoints left by the first */
+    for (int k = 0; k < 2; ++k) {
+      fos_reverse(tapeNative, 1, numIndeps, &u, zNative);
+      for (int i = 0; i < numIndeps; ++i)
+        BOOST_TEST(zNative[i] == zStdio[i], tt::tolerance(tol));
+    }
+
+    fov_reverse(tapeStdio, 1, numIndeps, 2, U, Z);
+    for (int i = 0; i < numIndeps; ++i) {
+      zv[0][i] = Z[0][i];
+      zv[1][i] = Z[1][i];
+    }
+    fov_reverse(tapeNative, 1, numIndeps, 2, U, Z);
+    for (int i = 0; i < numIndeps; ++i) {
+      BOOST_TEST(Z[0][i] == zv[0][i], tt::tolerance(tol));
+      BOOST_TEST(Z[1][i] == zv[1][i], tt::tolerance(tol));
+      BOOST_TEST(Z[1][i] == -2.0 * zStdio[i] / u, tt::tolerance(tol));
+    }
+
+    set_param_vec(tapeStdio, 1, &p);
+    set_param_vec(tapeNative, 1, &p);
+    set_param_vec(tapeAbs, 1, &p);
+  }
+
+  /* retaping drops the compiled tape */
+  x[1] = 0.4;
+  traceTapeIOThreaded(tapeNative, ADOLC_TAPE_IO_NATIVE, x, true);
+  zos_forward(tapeNative, 1, numIndeps, 0, x, &yNative);
+  BOOST_TEST(yNative == threadedFunction(x, 0.5) + fabs(x[0]),
+             tt::tolerance(tol));
+
+  myfree2(X);
+  myfree2(Yd);
+  myfree2(U);
+  myfree2(Z);
+  removeTapeIOTapes(tapeStdio, tapeNative);
+  removeTape(tapeAbs, ADOLC_REMOVE_COMPLETELY);
+
+  /* the four objects of the first recording stay for later runs */
+  BOOST_TEST(numNativeObjects(dir) == 4);
+  setNativeDir("");
+  std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(NativeTape_removeTape) {
+  const short tapeNative = 67;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double xd[numIndeps] = {1.0, 0.5, -0.25, 2.0};
+  double y, yd;
+
+  const std::string dir = nativeTestDir();
+  setNativeDir(dir.c_str());
+  traceTapeIOThreaded(tapeNative, ADOLC_TAPE_IO_NATIVE, x, false);
+  zos_forward(tapeNative, 1, numIndeps, 0, x, &y);
+  fos_forward(tapeNative, 1, numIndeps, 0, x, xd, &y, &yd);
+  BOOST_TEST(numNativeObjects(dir) == 2);
+
+  /* removing the tape completely deletes its objects */
+  removeTape(tapeNative, ADOLC_REMOVE_COMPLETELY);
+  BOOST_TEST(numNativeObjects(dir) == 0);
+  setNativeDir("");
+  std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(NativeTape_shared_dir) {
+  const short tapeStdio = 65, tapeNative = 66;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double yStdio, yNative;
+
+  /* objects in a directory others can read are not trusted, the switch
+   * sweeps the tape */
+  const std::string dir = nativeTestDir();
+  BOOST_REQUIRE(chmod(dir.c_str(), 0755) == 0);
+  setNativeDir(dir.c_str());
+  traceTapeIOThreaded(tapeStdio, ADOLC_TAPE_IO_STDIO, x, false);
+  traceTapeIOThreaded(tapeNative, ADOLC_TAPE_IO_NATIVE, x, false);
+  zos_forward(tapeStdio, 1, numIndeps, 0, x, &yStdio);
+  zos_forward(tapeNative, 1, numIndeps, 0, x, &yNative);
+  BOOST_TEST(yNative == yStdio, tt::tolerance(tol));
+  BOOST_TEST(numNativeObjects(dir) == 0);
+
+  removeTapeIOTapes(tapeStdio, tapeNative);
+  setNativeDir("");
+  std::filesystem::remove_all(dir);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelTape_fov_forward_reverse) {
+  const short tapeStdio = 62, tapeParallel = 63, tapeAbs = 64;
+  const int p = 5, q = 3;
+  double x[numIndeps] = {0.3, -1.2, 0.7, 2.1};
+  double yStdio, yParallel, yAbs;
+  double **X = myalloc2(numIndeps, p), **Y = myalloc2(1, p);
+  double **U = myalloc2(q, 1), **Z = myalloc2(q, numIndeps);
+  double **J = myalloc2(1, numIndeps);
+  double yd[p], z[q][numIndeps];
+
+  for (int i = 0; i < numIndeps; ++i)
+    for (int l = 0; l < p; ++l)
+      X[i][l] = 1.0 / (1.0 + i + l) - (l == i ? 1.0 : 0.0);
+  for (int l = 0; l < q; ++l)
+    U[l][0] = 1.0 - l;
+
+  /* more threads than cores, the slices still run concurrently */
+  setSweepThreads(3);
+  traceTapeIOThreaded(tapeStdio, ADOLC_TAPE_IO_STDIO, x, false);
+  traceTapeIOThreaded(tapeParallel, ADOLC_TAPE_IO_PARALLEL, x, false);
+  /* abs_val cannot be swept in parallel, the switch sweeps the tape */
+  traceTapeIOThreaded(tapeAbs, ADOLC_TAPE_IO_PARALLEL, x, true);
+
+  fov_forward(tapeStdio, 1, numIndeps, p, x, X, &yStdio, Y);
+  for (int l = 0; l < p; ++l)
+    yd[l] = Y[0][l];
+  fov_forward(tapeParallel, 1, numIndeps, p, x, X, &yParallel, Y);
+  BOOST_TEST(yParallel == yStdio, tt::tolerance(tol));
+  for (int l = 0; l < p; ++l)
+    BOOST_TEST(Y[0][l] == yd[l], tt::tolerance(tol));
+  fov_forward(tapeAbs, 1, numIndeps, p, x, X, &yAbs, Y);
+  BOOST_TEST(yAbs == yStdio + fabs(x[0]), tt::tolerance(tol));
+
+  zos_forward(tapeStdio, 1, numIndeps, 1, x, &yStdio);
+  fov_reverse(tapeStdio, 1, numIndeps, q, U, Z);
+  for (int l = 0; l < q; ++l)
+    for (int i = 0; i < numIndeps; ++i)
+      z[l][i] = Z[l][i];
+  zos_forward(tapeParallel, 1, numIndeps, 1, x, &yParallel);
+  fov_reverse(tapeParallel, 1, numIndeps, q, U, Z);
+  for (int l = 0; l < q; ++l)
+    for (int i = 0; i < numIndeps; ++i)
+      BOOST_TEST(Z[l][i] == z[l][i], tt::tolerance(tol));
+
+  /* the reverse sweep agrees with the forward sweep in all directions */
+  jacobian(tapeParallel, 1, numIndeps, x, J);
+  for (int i = 0; i < numIndeps; ++i)
+    BOOST_TEST(J[0][i] == z[0][i], tt::tolerance(tol));
+  for (int l = 0; l < p; ++l) {
+    double jx = 0.0;
+    for (int i = 0; i < numIndeps; ++i)
+      jx += J[0][i] * X[i][l];
+    BOOST_TEST(jx == yd[l], tt::tolerance(tol));
+  }
+
+  /* the partial derivatives follow a new base point */
+  x[2] = -0.4;
+  zos_forward(tapeStdio, 1, numIndeps, 1, x, &yStdio);
+  fov_reverse(tapeStdio, 1, numIndeps, q, U, Z);
+  for (int l = 0; l < q; ++l)
+    for (int i = 0; i < numIndeps; ++i)
+      z[l][i] = Z[l][i];
+  zos_forward(tapeParallel, 1, numIndeps, 1, x, &yParallel);
+  fov_reverse(tapeParallel, 1, numIndeps, q, U, Z);
+  for (int l = 0; l < q; ++l)
+    for (int i = 0; i < numIndeps; ++i)
+      BOOST_TEST(Z[l][i] == z[l][i], tt::tolerance(tol));
+  setSweepThreads(0);
+
+  myfree2(X);
+  myfree2(Y);
+  myfree2(U);
+  myfree2(Z);
+  myfree2(J);
+  removeTapeIOTapes(tapeStdio, tapeParallel);
+  removeTape(tapeAbs, ADOLC_REMOVE_COMPLETELY);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,9 @@
 #define BOOST_TEST_DYN_LINK
 
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -7,6 +11,11 @@
 namespace tt = boost::test_tools;
 
 #include <adolc/adtl.h>
+#include <adolc/adtl_fixed.h>
+#include <adolc/adtl_indo.h>
+#include <adolc/adtl_kernels.h>
+#include <adolc/adtl_pool.h>
+#include <adolc/adtl_sparse.h>
 typedef adtl::adouble adouble;
 
 #include "const.h"
@@ -1027,3 +1036,427 @@ BOOST_AUTO_TEST_CASE(SetADValueOperatorVectorMode) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(traceless_fixed_vector)
+
+/* The fixed direction type keeps its derivatives in the object. */
+BOOST_AUTO_TEST_CASE(FixedStorageLayout) {
+  typedef adtl_fixed::adouble<8> fadouble;
+
+  BOOST_TEST(sizeof(fadouble) % ADTL_FIXED_ALIGN == 0);
+  BOOST_TEST(alignof(fadouble) == ADTL_FIXED_ALIGN);
+  BOOST_TEST(alignof(adtl_fixed::adouble<3>) == alignof(double));
+
+  fadouble ad[4];
+  BOOST_TEST(reinterpret_cast<size_t>(ad[1].getADValue()) % ADTL_FIXED_ALIGN ==
+             0);
+}
+
+BOOST_AUTO_TEST_CASE(FixedMultOperatorDerivative) {
+  typedef adtl_fixed::adouble<2> fadouble;
+  double a = 2.5, b = 4.;
+  fadouble ad = a, bd = b;
+
+  ad.setADValue(0, 1.);
+  bd.setADValue(1, 1.);
+
+  fadouble cd = ad * bd;
+
+  BOOST_TEST(cd.getValue() == a * b, tt::tolerance(tol));
+  BOOST_TEST(cd.getADValue(0) == b, tt::tolerance(tol));
+  BOOST_TEST(cd.getADValue(1) == a, tt::tolerance(tol));
+}
+
+/* A composite function must give the same derivatives as adtl::adouble. */
+template <typename T> T fixedTestFunction(const T &x, const T &y) {
+  T z = sin(x * y) + exp(x / y) - sqrt(pow(x, 2.) + y * y);
+  z *= atan2(x, y);
+  z /= cosh(y) - log(x);
+  return fmax(z, tanh(z) - 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(FixedCompositeMatchesDynamic) {
+  const size_t numDir = adtl::getNumDir();
+  typedef adtl_fixed::adouble<5> fadouble;
+  const double a = 1.3, b = 0.7;
+  adouble ad = a, bd = b;
+  fadouble fa = a, fb = b;
+
+  for (size_t j = 0; j < 5; j++) {
+    const double da = 1. + j, db = 0.5 - j;
+    fa.setADValue(j, da);
+    fb.setADValue(j, db);
+    if (j < numDir) {
+      ad.setADValue(j, da);
+      bd.setADValue(j, db);
+    }
+  }
+
+  adouble res = fixedTestFunction(ad, bd);
+  fadouble fres = fixedTestFunction(fa, fb);
+
+  BOOST_TEST(fres.getValue() == res.getValue(), tt::tolerance(tol));
+  for (size_t j = 0; j < numDir && j < 5; j++)
+    BOOST_TEST(fres.getADValue(j) == res.getADValue(j), tt::tolerance(tol));
+}
+
+BOOST_AUTO_TEST_CASE(FixedOutOfBoundsAccess) {
+  adtl_fixed::adouble<3> ad = 1.0;
+
+  BOOST_CHECK_THROW(ad.getADValue(3), std::logic_error);
+  BOOST_CHECK_THROW(ad.setADValue(3, 1.0), std::logic_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(traceless_pool)
+
+BOOST_AUTO_TEST_CASE(PoolAdvalAligned) {
+  const adtl::PoolStats before = adtl::getPoolStats();
+  adouble ad[3];
+
+  /* getADValue() skips the primal value in front of the derivatives */
+  for (int i = 0; i < 3; i++)
+    BOOST_TEST(reinterpret_cast<size_t>(ad[i].getADValue() - 1) %
+                   ADTL_POOL_ALIGN ==
+               0);
+  BOOST_TEST(adtl::getPoolStats().allocations - before.allocations == 3);
+}
+
+BOOST_AUTO_TEST_CASE(PoolRecyclesLargerBlocks) {
+  void *big = adtl::poolMalloc(3000);
+  adtl::poolFree(big);
+
+  const adtl::PoolStats before = adtl::getPoolStats();
+  void *small = adtl::poolMalloc(2900);
+  const adtl::PoolStats after = adtl::getPoolStats();
+
+  BOOST_TEST(small == big);
+  BOOST_TEST(after.recycled == before.recycled + 1);
+  BOOST_TEST(after.slabs == before.slabs);
+
+  /* the block goes back to its own size class */
+  adtl::poolFree(small);
+  BOOST_TEST(adtl::poolMalloc(3000) == big);
+  adtl::poolFree(big);
+}
+
+BOOST_AUTO_TEST_CASE(PoolLargeBlocksReturned) {
+  const adtl::PoolStats before = adtl::getPoolStats();
+  double *p = static_cast<double *>(adtl::poolMalloc(1 << 20));
+
+  BOOST_TEST(reinterpret_cast<size_t>(p) % ADTL_POOL_ALIGN == 0);
+  p[(1 << 17) - 1] = 1.0;
+  BOOST_TEST(adtl::getPoolStats().reservedBytes > before.reservedBytes);
+  adtl::poolFree(p);
+  BOOST_TEST(adtl::getPoolStats().reservedBytes == before.reservedBytes);
+
+  /* just above the largest size class, it takes little more than its size */
+  const size_t bytes = 8192 + ADTL_POOL_ALIGN;
+  p = static_cast<double *>(adtl::poolMalloc(bytes));
+  BOOST_TEST(reinterpret_cast<size_t>(p) % ADTL_POOL_ALIGN == 0);
+  BOOST_TEST(adtl::getPoolStats().reservedBytes - before.reservedBytes <=
+             bytes + ADTL_POOL_ALIGN);
+  adtl::poolFree(p);
+  BOOST_TEST(adtl::getPoolStats().reservedBytes == before.reservedBytes);
+}
+
+/* A consumer thread freeing the blocks of a producer hands them back to it,
+ * so that the producer carves no new slabs round after round. */
+BOOST_AUTO_TEST_CASE(PoolRemoteFreesReturned) {
+  const size_t n = 4096, bytes = 256;
+  std::vector<void *> blocks(n), handed;
+  std::mutex mutex;
+  std::condition_variable changed;
+  bool stop = false;
+  size_t slabs = 0;
+
+  std::thread consumer([&] {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      changed.wait(lock, [&] { return stop || !handed.empty(); });
+      if (stop)
+        return;
+      for (void *p : handed)
+        adtl::poolFree(p);
+      handed.clear();
+      changed.notify_all();
+    }
+  });
+
+  const adtl::PoolStats before = adtl::getPoolStats();
+  for (int round = 0; round < 8; round++) {
+    for (size_t i = 0; i < n; i++)
+      blocks[i] = adtl::poolMalloc(bytes);
+    std::unique_lock<std::mutex> lock(mutex);
+    handed = blocks;
+    changed.notify_all();
+    changed.wait(lock, [&] { return handed.empty(); });
+    if (round == 0)
+      slabs = adtl::getPoolStats().slabs;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  changed.notify_all();
+  consumer.join();
+
+  BOOST_TEST(adtl::getPoolStats().slabs == slabs);
+  BOOST_TEST(adtl::getPoolStats().returned - before.returned >= 7 * n);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(traceless_kernels)
+
+/* Every kernel available on this CPU must agree with the portable loops,
+ * including the remainder after the last full vector. Products and sums are
+ * not fused, so axpby and axpy round exactly like the portable loops. */
+BOOST_AUTO_TEST_CASE(KernelsMatchScalarLoops) {
+  const adtl::KernelISA saved = adtl::getKernelISA();
+  const size_t n = 19;
+  std::vector<double> a(n), b(n), ref(n), res(n), axpbyRef(n), axpyRef(n);
+
+  for (size_t i = 0; i < n; i++) {
+    a[i] = 1.5 + 0.25 * i;
+    b[i] = -2.0 + std::sin(1.0 * i);
+  }
+
+  BOOST_TEST(adtl::setKernelISA(adtl::ADTL_ISA_SCALAR));
+  adtl::fovKernels->axpby(n, axpbyRef.data(), 0.1, b.data(), -0.3, a.data());
+  axpyRef = a;
+  adtl::fovKernels->axpy(n, axpyRef.data(), 0.1, b.data());
+
+  for (int isa = adtl::ADTL_ISA_SCALAR; isa <= adtl::getBestKernelISA();
+       isa++) {
+    BOOST_TEST(adtl::setKernelISA(static_cast<adtl::KernelISA>(isa)));
+    const adtl::FovKernels *k = adtl::fovKernels;
+
+    k->add(n, res.data(), a.data(), b.data());
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == a[i] + b[i], tt::tolerance(tol));
+
+    k->sub(n, res.data(), a.data(), b.data());
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == a[i] - b[i], tt::tolerance(tol));
+
+    k->scale(n, res.data(), 3.0, a.data());
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == 3.0 * a[i], tt::tolerance(tol));
+
+    k->div(n, res.data(), a.data(), 3.0);
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == a[i] / 3.0, tt::tolerance(tol));
+
+    k->axpby(n, res.data(), 2.0, a.data(), -0.5, b.data());
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == 2.0 * a[i] - 0.5 * b[i], tt::tolerance(tol));
+    k->axpby(n, res.data(), 0.1, b.data(), -0.3, a.data());
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == axpbyRef[i]);
+
+    /* in place, as in operator*= */
+    ref = a;
+    res = a;
+    k->axpy(n, res.data(), 2.0, b.data());
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == ref[i] + 2.0 * b[i], tt::tolerance(tol));
+    res = a;
+    k->axpy(n, res.data(), 0.1, b.data());
+    for (size_t i = 0; i < n; i++)
+      BOOST_TEST(res[i] == axpyRef[i]);
+  }
+
+  adtl::setKernelISA(saved);
+  BOOST_TEST(!adtl::setKernelISA(
+      static_cast<adtl::KernelISA>(adtl::getBestKernelISA() + 1)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(traceless_sparse_vector)
+
+/* y_i = x_i * sin(x_{i+1}) + exp(x_{i-1}), so row i has at most 3 entries */
+class Banded : public func_ad<adtl_sparse::adouble> {
+public:
+  int operator()(int n, adtl_sparse::adouble *x, int m,
+                 adtl_sparse::adouble *y) {
+    for (int i = 0; i < m; i++) {
+      y[i] = x[i] * sin(x[(i + 1) % n]);
+      if (i > 0)
+        y[i] += exp(x[i - 1]);
+    }
+    return 0;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(SparseJacobianBanded) {
+  const int n = 40;
+  std::vector<double> x(n);
+  for (int i = 0; i < n; i++)
+    x[i] = 0.1 * (i + 1);
+
+  Banded f;
+  int nnz = 0;
+  unsigned int *rind = NULL, *cind = NULL;
+  double *values = NULL;
+  BOOST_TEST(ADOLC_get_sparse_jacobian(&f, n, n, x.data(), &nnz, &rind, &cind,
+                                       &values) == 0);
+
+  BOOST_TEST(nnz == 3 * n - 1);
+  for (int k = 0; k < nnz; k++) {
+    const int i = rind[k], j = cind[k];
+    double expected = 0.0;
+    if (j == i)
+      expected += std::sin(x[(i + 1) % n]);
+    if (j == (i + 1) % n)
+      expected += x[i] * std::cos(x[j]);
+    if (i > 0 && j == i - 1)
+      expected += std::exp(x[j]);
+    BOOST_TEST(values[k] == expected, tt::tolerance(tol));
+  }
+  free(rind);
+  free(cind);
+  free(values);
+}
+
+/* Past the threshold the derivatives are stored densely, with the same
+ * values as the vector mode of adtl.h. */
+BOOST_AUTO_TEST_CASE(SparseSwitchesToDense) {
+  const size_t n = 16;
+  adtl_sparse::setNumDir(n);
+  adtl::setNumDir(n);
+
+  adtl_sparse::adouble s = 0.0;
+  adtl::adouble d = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    adtl_sparse::adouble xs = 1.0 + 0.1 * i;
+    adtl::adouble xd = 1.0 + 0.1 * i;
+    xs.setADValue(i, 1.0);
+    for (size_t j = 0; j < n; j++)
+      xd.setADValue(j, i == j ? 1.0 : 0.0);
+
+    s = s * cos(xs) + xs / (1.0 + xs * xs);
+    d = d * cos(xd) + xd / (1.0 + xd * xd);
+    BOOST_TEST(s.isDense() == (i + 1 > n * adtl_sparse::getDenseThreshold()));
+  }
+
+  BOOST_TEST(s.getValue() == d.getValue(), tt::tolerance(tol));
+  for (size_t j = 0; j < n; j++)
+    BOOST_TEST(s.getADValue(j) == d.getADValue(j), tt::tolerance(tol));
+  adtl::setNumDir(2);
+}
+
+BOOST_AUTO_TEST_CASE(SparseSetADValueKeepsOrder) {
+  adtl_sparse::setNumDir(100);
+  adtl_sparse::adouble a = 2.0;
+  const unsigned int dirs[] = {7, 3, 42, 5, 3};
+  for (size_t k = 0; k < 5; k++)
+    a.setADValue(dirs[k], 1.0 + k);
+
+  BOOST_TEST(!a.isDense());
+  BOOST_TEST(a.getNumNonzeros() == 4u);
+  for (size_t k = 1; k < a.getNumNonzeros(); k++)
+    BOOST_TEST(a.getADIndices()[k - 1] < a.getADIndices()[k]);
+  BOOST_TEST(a.getADValue(3) == 5.0);
+  BOOST_TEST(a.getADValue(42) == 3.0);
+  BOOST_TEST(a.getADValue(4) == 0.0);
+
+  adtl_sparse::adouble b = 3.0 * a - a;
+  BOOST_TEST(b.getValue() == 4.0);
+  BOOST_TEST(b.getADValue(7) == 2.0);
+  BOOST_TEST(adtl_sparse::adouble(1.0).getNumNonzeros() == 0u);
+  BOOST_CHECK_THROW(a.getADValue(100), std::logic_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(traceless_index_domain)
+
+static std::vector<unsigned int>
+domainIndices(const adtl_indo::index_domain &d) {
+  std::vector<unsigned int> v(d.size());
+  if (!v.empty())
+    d.to_array(v.data());
+  return v;
+}
+
+BOOST_AUTO_TEST_CASE(IndexDomainForms) {
+  adtl_indo::index_domain d;
+  for (unsigned int i = 0; i < ADTL_INDO_INLINE; i++)
+    d.insert(10 * i);
+  BOOST_TEST(d.get_kind() == adtl_indo::index_domain::INLINE);
+
+  d.insert(100000);
+  BOOST_TEST(d.get_kind() == adtl_indo::index_domain::ARRAY);
+
+  adtl_indo::index_domain dense;
+  for (unsigned int i = 0; i < 200; i += 2)
+    dense.insert(i);
+  BOOST_TEST(dense.get_kind() == adtl_indo::index_domain::BITSET);
+  BOOST_TEST(dense.size() == 100u);
+
+  /* a far away index makes the bitset larger than the array */
+  adtl_indo::index_domain far = dense;
+  far.insert(1u << 30);
+  BOOST_TEST(far.get_kind() == adtl_indo::index_domain::ARRAY);
+  BOOST_TEST(far.size() == 101u);
+  BOOST_TEST((dense != far));
+  BOOST_TEST((dense == adtl_indo::index_domain(dense)));
+}
+
+/* Unions of every pair of forms against std::set */
+BOOST_AUTO_TEST_CASE(IndexDomainUnion) {
+  const unsigned int strides[] = {1, 3, 70, 1000};
+  const unsigned int counts[] = {3, 40, 300};
+  for (unsigned int sa : strides)
+    for (unsigned int ca : counts)
+      for (unsigned int sb : strides)
+        for (unsigned int cb : counts) {
+          adtl_indo::index_domain a, b;
+          std::set<unsigned int> ref;
+          for (unsigned int k = 0; k < ca; k++) {
+            a.insert(5 + sa * k);
+            ref.insert(5 + sa * k);
+          }
+          for (unsigned int k = 0; k < cb; k++) {
+            b.insert(17 + sb * k);
+            ref.insert(17 + sb * k);
+          }
+          a.merge(b);
+          BOOST_TEST(domainIndices(a) ==
+                         std::vector<unsigned int>(ref.begin(), ref.end()),
+                     tt::per_element());
+        }
+}
+
+BOOST_AUTO_TEST_CASE(IndexDomainSparsePattern) {
+  const int n = 300;
+  adtl_indo::adouble x[n], y[2];
+  for (int i = 0; i < n; i++)
+    x[i] = 1.0 + i;
+  adtl_indo::ADOLC_Init_sparse_pattern(x, n, 0);
+
+  /* y0 depends on every third variable, y1 on all of them */
+  y[0] = 0.0;
+  y[1] = 1.0;
+  for (int i = 0; i < n; i += 3)
+    y[0] += sin(x[i]);
+  for (int i = n - 1; i >= 0; i--)
+    y[1] *= x[i];
+
+  unsigned int **pat = NULL;
+  adtl_indo::ADOLC_get_sparse_pattern(y, 2, pat);
+  BOOST_TEST(pat[0][0] == unsigned(n / 3));
+  BOOST_TEST(pat[1][0] == unsigned(n));
+  for (int k = 1; k <= n / 3; k++)
+    BOOST_TEST(pat[0][k] == unsigned(3 * (k - 1)));
+  for (int k = 1; k <= n; k++)
+    BOOST_TEST(pat[1][k] == unsigned(k - 1));
+  free(pat[0]);
+  free(pat[1]);
+  free(pat);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
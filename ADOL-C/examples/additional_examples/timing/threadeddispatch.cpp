@@ -0,0 +1,121 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     threadeddispatch.cpp
+ Revision: $Id$
+ Contents: Timing of zos_forward and fos_forward on a tape of cheap
+           operations held in core, swept by the switch and as threaded
+           code (ADOLC_TAPE_IO_THREADED)
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+---------------------------------------------------------------------------*/
+
+/****************************************************************************/
+/*                                                                 INCLUDES */
+#include "../clock/myclock.h"
+#include <adolc/adolc.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+/****************************************************************************/
+/*                                                                 FUNCTION */
+/* About 5 operations per iteration, picked by a hash of the iteration so
+ * that the order of the operations on the tape is irregular */
+static void traceFunction(short tag, int tapeIOFlags, int n, long iters) {
+  const uint bufferSize = 6 * iters + 1024;
+  adouble *x = new adouble[n];
+  adouble y = 0.0;
+  double yp;
+
+  trace_on(tag, 0, bufferSize, 3 * bufferSize, bufferSize, bufferSize, 0,
+           tapeIOFlags);
+  for (int i = 0; i < n; i++)
+    x[i] <<= 1.0 + 0.001 * i;
+  for (long i = 0; i < iters; i++) {
+    adouble &u = x[i % n];
+    const adouble &v = x[(i * 7 + 3) % n];
+    switch ((unsigned int)(i * 2654435761u) >> 30) {
+    case 0:
+      y = y * 0.5 + u * v;
+      break;
+    case 1:
+      y -= v / (u + 2.0);
+      break;
+    case 2:
+      u = 0.999 * u + 0.001 * y;
+      break;
+    default:
+      y += u - v * v;
+    }
+  }
+  y >>= yp;
+  trace_off();
+  delete[] x;
+}
+
+/****************************************************************************/
+/*                                                                     MAIN */
+int main(int argc, char *argv[]) {
+  const int n = 100;
+  const short tags[] = {1, 2};
+  const int flags[] = {ADOLC_TAPE_IO_STDIO, ADOLC_TAPE_IO_THREADED};
+  const char *names[] = {"switch", "threaded"};
+  long iters = 2000000;
+  int sweeps = 10;
+  double times[2][2], y[2], yd[2];
+  size_t stats[STAT_SIZE];
+
+  if (argc > 1)
+    iters = atol(argv[1]);
+  if (argc > 2)
+    sweeps = atoi(argv[2]);
+
+  double *x = new double[n];
+  double *xd = new double[n];
+  for (int i = 0; i < n; i++) {
+    x[i] = 1.0 + 0.001 * i;
+    xd[i] = (i % 3) - 1.0;
+  }
+
+  for (int k = 0; k < 2; k++) {
+    traceFunction(tags[k], flags[k], n, iters);
+    /* the first sweep decodes the threaded tape */
+    zos_forward(tags[k], 1, n, 0, x, &y[k]);
+
+    double t0 = myclock();
+    for (int s = 0; s < sweeps; s++)
+      zos_forward(tags[k], 1, n, 0, x, &y[k]);
+    times[k][0] = (myclock() - t0) / sweeps;
+    t0 = myclock();
+    for (int s = 0; s < sweeps; s++)
+      fos_forward(tags[k], 1, n, 0, x, xd, &y[k], &yd[k]);
+    times[k][1] = (myclock() - t0) / sweeps;
+  }
+  tapestats(tags[0], stats);
+
+  fprintf(stdout, "Tape of %zu operations held in core, %d sweeps\n",
+          stats[NUM_OPERATIONS], sweeps);
+  fprintf(stdout, "%10s %14s %14s\n", "dispatch", "zos_forward", "fos_forward");
+  for (int k = 0; k < 2; k++)
+    fprintf(stdout, "%10s %14.6E %14.6E\n", names[k], times[k][0],
+            times[k][1]);
+  fprintf(stdout, "%10s %14.2f %14.2f\n", "speedup", times[0][0] / times[1][0],
+          times[0][1] / times[1][1]);
+
+  delete[] x;
+  delete[] xd;
+  if (std::fabs(y[0] - y[1]) > 1e-10 * std::fabs(y[0]) ||
+      std::fabs(yd[0] - yd[1]) > 1e-10 * std::fabs(yd[0])) {
+    fprintf(stdout, "results differ: %e %e != %e %e\n", y[0], yd[0], y[1],
+            yd[1]);
+    return 1;
+  }
+  return 0;
+}
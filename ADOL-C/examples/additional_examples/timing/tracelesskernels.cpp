@@ -0,0 +1,86 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     tracelesskernels.cpp
+ Revision: $Id$
+ Contents: Timing of the traceless forward vector mode with the portable
+           loops and the SIMD kernels for several numbers of directions
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+---------------------------------------------------------------------------*/
+
+/****************************************************************************/
+/*                                                                 INCLUDES */
+#include "../clock/myclock.h"
+#include <adolc/adtl.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+/****************************************************************************/
+/*                                                                 FUNCTION */
+/* Chained products, quotients and elementary functions of n variables */
+static adtl::adouble evaluate(int n, const adtl::adouble *x) {
+  adtl::adouble y = 0.0;
+  for (int i = 0; i + 1 < n; i++) {
+    adtl::adouble t = x[i] * x[i + 1] - sin(x[i]) / x[i + 1];
+    y += exp(0.01 * t) * t;
+  }
+  return y;
+}
+
+/****************************************************************************/
+/*                                                                     MAIN */
+int main(int argc, char *argv[]) {
+  const int n = 200;
+  const size_t dirs[] = {4, 16, 64, 256};
+  const char *names[] = {"loops", "AVX2", "AVX-512"};
+  int evals = 200;
+  if (argc > 1)
+    evals = atoi(argv[1]);
+
+  fprintf(stdout, "Traceless vector mode, %d variables, %d evaluations\n", n,
+          evals);
+  fprintf(stdout, "%8s %10s %14s %10s\n", "numDir", "kernels", "seconds",
+          "speedup");
+
+  for (size_t d = 0; d < sizeof(dirs) / sizeof(dirs[0]); d++) {
+    adtl::setNumDir(dirs[d]);
+    double loops = 0.0;
+    double check = 0.0;
+    for (int isa = adtl::ADTL_ISA_SCALAR; isa <= adtl::getBestKernelISA();
+         isa++) {
+      adtl::setKernelISA(static_cast<adtl::KernelISA>(isa));
+      adtl::adouble *x = new adtl::adouble[n];
+      for (int i = 0; i < n; i++) {
+        x[i] = 1.0 + 0.001 * i;
+        for (size_t j = 0; j < dirs[d]; j++)
+          x[i].setADValue(j, (i + j) % 7 == 0 ? 1.0 : 0.0);
+      }
+
+      double sum = 0.0;
+      double t0 = myclock();
+      for (int e = 0; e < evals; e++)
+        sum += evaluate(n, x).getADValue(dirs[d] - 1);
+      double t1 = myclock() - t0;
+      delete[] x;
+
+      if (isa == adtl::ADTL_ISA_SCALAR) {
+        loops = t1;
+        check = sum;
+      } else if (sum != check) {
+        fprintf(stdout, "derivatives differ: %e != %e\n", sum, check);
+        return 1;
+      }
+      fprintf(stdout, "%8zu %10s %14.6E %10.2f\n", dirs[d], names[isa], t1,
+              loops / t1);
+    }
+  }
+  adtl::setKernelISA(adtl::getBestKernelISA());
+  return 0;
+}
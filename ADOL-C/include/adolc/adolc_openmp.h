@@ -29,6 +29,15 @@ extern void endParallel();
 
 extern int ADOLC_parallel_doCopy;
 
+/* Bytes of the serial store the worker "thread" copied in the last parallel
+ * region. Where the system allows it, entering a region copies a large
+ * serial store once into a snapshot, counted for the master (thread 0),
+ * which the workers map copy-on-write. Then only the pages a worker writes
+ * to are copied, or all of them once it has to grow its store. Smaller
+ * stores are copied by every worker. Call outside parallel regions.
+ */
+extern size_t getStoreCopyBytes(int thread);
+
 typedef struct ADOLC_OpenMP {
   inline ADOLC_OpenMP() {}
   inline ADOLC_OpenMP(const ADOLC_OpenMP &arg) {
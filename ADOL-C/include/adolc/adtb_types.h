@@ -35,6 +35,13 @@ struct tape_location {
 
 class pdouble;
 
+/* Sums of adouble products are taped by expression templates, see
+ * adouble_prod_sum. The activity tracking tapes them one by one. */
+#if defined(ADOLC_EXPRESSION_TEMPLATES) && !defined(ADOLC_TRACK_ACTIVITY)
+#define ADOLC_PROD_SUM_TEMPLATES 1
+template <size_t N> class adouble_prod_sum;
+#endif
+
 /**
  * @brief The `adouble` class is leveraged to compute tape-based derivatives. It
  * is represented by a location on the tape and the value that is stored on the
@@ -82,6 +89,15 @@ public:
     a.valid = 0;
   }
 
+#if defined(ADOLC_PROD_SUM_TEMPLATES)
+  /**
+   * @brief Constructor taping a sum of products into a new location without
+   * allocating locations for the products.
+   * @param p The sum of products, e.g. `a * b + c * d`.
+   */
+  template <size_t N> adouble(const adouble_prod_sum<N> &p);
+#endif
+
   /** @brief Destructor. Releases the location from the tape.
    * The destructor is used to remove unused locations (tape_loc_.loc_) from the
    * tape. A location is only removed (free_loc), if the destructed adouble owns
@@ -139,6 +155,16 @@ public:
    */
   adouble &operator=(const pdouble &p);
 
+#if defined(ADOLC_PROD_SUM_TEMPLATES)
+  /**
+   * @brief Tapes a sum of products into the location of `this` as one
+   * `mult_a_a` followed by `eq_plus_prod`/`eq_min_prod` operations.
+   * @param p The sum of products, e.g. `a * b - c * d`.
+   * @return Reference to `this`.
+   */
+  template <size_t N> adouble &operator=(const adouble_prod_sum<N> &p);
+#endif
+
   // Accessors
 
   /**
@@ -204,6 +230,11 @@ public:
   adouble &operator-=(adouble &&a);
   inline adouble &operator-=(const pdouble &p);
 
+#if defined(ADOLC_PROD_SUM_TEMPLATES)
+  template <size_t N> adouble &operator+=(const adouble_prod_sum<N> &p);
+  template <size_t N> adouble &operator-=(const adouble_prod_sum<N> &p);
+#endif
+
   adouble &operator*=(const double coval);
   adouble &operator*=(const adouble &a);
   // adouble &operator*=(adouble &&a);
@@ -247,6 +278,9 @@ public:
   void declareDependent();
 
 private:
+  /* advector reserves and frees the locations of its elements as blocks */
+  friend class advector;
+
   /** @brief Stores the location of the `adouble` on the tape. */
   tape_location tape_loc_;
 
@@ -425,7 +459,11 @@ inline adouble operator-(adouble &&a, const double coval) {
 
 /*--------------------------------------------------------------------------*/
 
+#if defined(ADOLC_PROD_SUM_TEMPLATES)
+inline adouble_prod_sum<1> operator*(const adouble &a, const adouble &b);
+#else
 ADOLC_DLL_EXPORT adouble operator*(const adouble &a, const adouble &b);
+#endif
 ADOLC_DLL_EXPORT adouble operator*(adouble &&a, const adouble &b);
 inline adouble operator*(const adouble &a, adouble &&b) {
   return std::move(b) * a;
@@ -440,6 +478,108 @@ inline adouble operator*(adouble &&a, const double coval) {
   return coval * std::move(a);
 }
 
+#if defined(ADOLC_PROD_SUM_TEMPLATES)
+/*--------------------------------------------------------------------------*/
+/* Sums of products */
+
+/**
+ * @brief Tapes the sum of the products `signs[i] * factors[2 * i] *
+ * factors[2 * i + 1]` into the location of `res`. `increment` 0 assigns the
+ * sum, 1 adds it to and -1 subtracts it from `res`.
+ */
+ADOLC_DLL_EXPORT void adolc_prod_sum(adouble &res, size_t numTerms,
+                                     const adouble *const *factors,
+                                     const int *signs, int increment);
+
+/**
+ * @brief The `adouble_prod_sum` class is the expression template of a sum of
+ * `N` signed products of `adouble`s. It results from `a * b` of two lvalue
+ * `adouble`s and from sums and differences of such expressions. Nothing is
+ * taped until the expression is assigned to, added to or converted into an
+ * `adouble`. Then `y = a * b + c * d` is recorded as `mult_a_a` and
+ * `eq_plus_prod` into the location of `y`, without locations for the
+ * products, the sum or a temporary of the right-hand side.
+ *
+ * The expression refers to its factors and is evaluated when it is used, so
+ * it must not outlive them or be kept in an `auto` variable.
+ */
+template <size_t N> class adouble_prod_sum {
+public:
+  const adouble *factors[2 * N];
+  int signs[N];
+
+  /** @brief Evaluates the sum in the order in which it is taped. */
+  double value() const {
+    double sum = 0.0;
+    for (size_t i = 0; i < N; ++i)
+      sum += signs[i] * factors[2 * i]->value() * factors[2 * i + 1]->value();
+    return sum;
+  }
+};
+
+inline adouble_prod_sum<1> operator*(const adouble &a, const adouble &b) {
+  return adouble_prod_sum<1>{{&a, &b}, {1}};
+}
+
+template <size_t N>
+inline const adouble_prod_sum<N> &operator+(const adouble_prod_sum<N> &p) {
+  return p;
+}
+
+template <size_t N>
+inline adouble_prod_sum<N> operator-(const adouble_prod_sum<N> &p) {
+  adouble_prod_sum<N> ret = p;
+  for (size_t i = 0; i < N; ++i)
+    ret.signs[i] = -ret.signs[i];
+  return ret;
+}
+
+template <size_t N, size_t M>
+inline adouble_prod_sum<N + M> operator+(const adouble_prod_sum<N> &p,
+                                         const adouble_prod_sum<M> &q) {
+  adouble_prod_sum<N + M> ret;
+  for (size_t i = 0; i < 2 * N; ++i)
+    ret.factors[i] = p.factors[i];
+  for (size_t i = 0; i < 2 * M; ++i)
+    ret.factors[2 * N + i] = q.factors[i];
+  for (size_t i = 0; i < N; ++i)
+    ret.signs[i] = p.signs[i];
+  for (size_t i = 0; i < M; ++i)
+    ret.signs[N + i] = q.signs[i];
+  return ret;
+}
+
+template <size_t N, size_t M>
+inline adouble_prod_sum<N + M> operator-(const adouble_prod_sum<N> &p,
+                                         const adouble_prod_sum<M> &q) {
+  return p + (-q);
+}
+
+template <size_t N>
+inline adouble::adouble(const adouble_prod_sum<N> &p)
+    : tape_loc_{next_loc()} {
+  adolc_prod_sum(*this, N, p.factors, p.signs, 0);
+}
+
+template <size_t N>
+inline adouble &adouble::operator=(const adouble_prod_sum<N> &p) {
+  adolc_prod_sum(*this, N, p.factors, p.signs, 0);
+  return *this;
+}
+
+template <size_t N>
+inline adouble &adouble::operator+=(const adouble_prod_sum<N> &p) {
+  adolc_prod_sum(*this, N, p.factors, p.signs, 1);
+  return *this;
+}
+
+template <size_t N>
+inline adouble &adouble::operator-=(const adouble_prod_sum<N> &p) {
+  adolc_prod_sum(*this, N, p.factors, p.signs, -1);
+  return *this;
+}
+#endif
+
 /*--------------------------------------------------------------------------*/
 
 ADOLC_DLL_EXPORT adouble operator/(const adouble &a, const adouble &b);
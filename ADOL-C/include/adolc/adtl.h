@@ -17,6 +17,8 @@
 #ifndef ADOLC_ADTL_H
 #define ADOLC_ADTL_H
 
+#include <adolc/adtl_kernels.h>
+#include <adolc/adtl_pool.h>
 #include <adolc/internal/common.h>
 #include <list>
 #include <ostream>
@@ -280,7 +282,7 @@ inline adouble::adouble() : adval(NULL) {
 #if USE_BOOST_POOL
   adval = reinterpret_cast<double *>(advalpool->malloc());
 #else
-  adval = new double[adouble::numDir + 1];
+  adval = poolMallocDoubles(adouble::numDir + 1);
 #endif
   PRIMAL_VALUE = 0.;
 }
@@ -289,7 +291,7 @@ inline adouble::adouble(const double v) : adval(NULL) {
 #if USE_BOOST_POOL
   adval = reinterpret_cast<double *>(advalpool->malloc());
 #else
-  adval = new double[adouble::numDir + 1];
+  adval = poolMallocDoubles(adouble::numDir + 1);
 #endif
   PRIMAL_VALUE = v;
   FOR_I_EQ_1_LTEQ_NUMDIR
@@ -300,7 +302,7 @@ inline adouble::adouble(const double v, const double *adv) : adval(NULL) {
 #if USE_BOOST_POOL
   adval = reinterpret_cast<double *>(advalpool->malloc());
 #else
-  adval = new double[adouble::numDir + 1];
+  adval = poolMallocDoubles(adouble::numDir + 1);
 #endif
   PRIMAL_VALUE = v;
   FOR_I_EQ_1_LTEQ_NUMDIR
@@ -311,7 +313,7 @@ inline adouble::adouble(const adouble &a) : adval(NULL) {
 #if USE_BOOST_POOL
   adval = reinterpret_cast<double *>(advalpool->malloc());
 #else
-  adval = new double[adouble::numDir + 1];
+  adval = poolMallocDoubles(adouble::numDir + 1);
 #endif
   FOR_I_EQ_0_LTEQ_NUMDIR
   ADVAL_I = a.ADVAL_I;
@@ -323,7 +325,7 @@ inline adouble::~adouble() {
 #if USE_BOOST_POOL
     advalpool->free(adval);
 #else
-    delete[] adval;
+    poolFree(adval);
 #endif
 }
 
@@ -331,8 +333,7 @@ inline adouble::~adouble() {
 // sign
 inline adouble adouble::operator-() const {
   adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = -ADVAL_I;
+  fovScale(numDir + 1, tmp.adval, -1.0, adval);
   return tmp;
 }
 
@@ -346,8 +347,7 @@ inline adouble adouble::operator+(const double v) const {
 
 inline adouble adouble::operator+(const adouble &a) const {
   adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I + a.ADVAL_I;
+  fovAdd(numDir + 1, tmp.adval, adval, a.adval);
   return tmp;
 }
 
@@ -364,64 +364,61 @@ inline adouble adouble::operator-(const double v) const {
 
 inline adouble adouble::operator-(const adouble &a) const {
   adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I - a.ADVAL_I;
+  fovSub(numDir + 1, tmp.adval, adval, a.adval);
   return tmp;
 }
 
 inline adouble operator-(const double v, const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = v - a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = -a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, -1.0, a.adval + 1);
   return tmp;
 }
 
 // multiplication
 inline adouble adouble::operator*(const double v) const {
   adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I * v;
+  fovScale(numDir + 1, tmp.adval, v, adval);
   return tmp;
 }
 
 inline adouble adouble::operator*(const adouble &a) const {
   adouble tmp;
   tmp.PRIMAL_VALUE = PRIMAL_VALUE * a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I * a.PRIMAL_VALUE + PRIMAL_VALUE * a.ADVAL_I;
+  fovAxpby(numDir, tmp.adval + 1, a.PRIMAL_VALUE, adval + 1, PRIMAL_VALUE,
+           a.adval + 1);
   return tmp;
 }
 
 inline adouble operator*(const double v, const adouble &a) {
   adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = v * a.ADVAL_I;
+  fovScale(adouble::numDir + 1, tmp.adval, v, a.adval);
   return tmp;
 }
 
 // division
 inline adouble adouble::operator/(const double v) const {
   adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I / v;
+  fovDiv(numDir + 1, tmp.adval, adval, v);
   return tmp;
 }
 
 inline adouble adouble::operator/(const adouble &a) const {
   adouble tmp;
   tmp.PRIMAL_VALUE = PRIMAL_VALUE / a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = (ADVAL_I * a.PRIMAL_VALUE - PRIMAL_VALUE * a.ADVAL_I) /
-                (a.PRIMAL_VALUE * a.PRIMAL_VALUE);
+  fovAxpby(numDir, tmp.adval + 1, a.PRIMAL_VALUE, adval + 1, -PRIMAL_VALUE,
+           a.adval + 1);
+  fovDiv(numDir, tmp.adval + 1, tmp.adval + 1,
+         a.PRIMAL_VALUE * a.PRIMAL_VALUE);
   return tmp;
 }
 
 inline adouble operator/(const double v, const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = v / a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = (-v * a.ADVAL_I) / (a.PRIMAL_VALUE * a.PRIMAL_VALUE);
+  fovScale(adouble::numDir, tmp.adval + 1, -v, a.adval + 1);
+  fovDiv(adouble::numDir, tmp.adval + 1, tmp.adval + 1,
+         a.PRIMAL_VALUE * a.PRIMAL_VALUE);
   return tmp;
 }
 
@@ -459,26 +456,25 @@ inline adouble tan(const adouble &a) {
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::tan(a.PRIMAL_VALUE);
   tmp2 = ADOLC_MATH_NSP::cos(a.PRIMAL_VALUE);
   tmp2 *= tmp2;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
 inline adouble exp(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::exp(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp.PRIMAL_VALUE * a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp.PRIMAL_VALUE, a.adval + 1);
   return tmp;
 }
 
 inline adouble log(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::log(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
   if (a.PRIMAL_VALUE > 0)
-    tmp.ADVAL_I = a.ADVAL_I / a.PRIMAL_VALUE;
-  else if (a.PRIMAL_VALUE == 0 && a.ADVAL_I != 0.0) {
+    fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, a.PRIMAL_VALUE);
+  else
+    FOR_I_EQ_1_LTEQ_NUMDIR
+  if (a.PRIMAL_VALUE == 0 && a.ADVAL_I != 0.0) {
     int sign = (a.ADVAL_I < 0) ? -1 : 1;
     tmp.ADVAL_I = sign * makeInf();
   } else
@@ -489,10 +485,11 @@ inline adouble log(const adouble &a) {
 inline adouble sqrt(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::sqrt(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
   if (a.PRIMAL_VALUE > 0)
-    tmp.ADVAL_I = a.ADVAL_I / (tmp.PRIMAL_VALUE * 2);
-  else if (a.PRIMAL_VALUE == 0.0 && a.ADVAL_I != 0.0) {
+    fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp.PRIMAL_VALUE * 2);
+  else
+    FOR_I_EQ_1_LTEQ_NUMDIR
+  if (a.PRIMAL_VALUE == 0.0 && a.ADVAL_I != 0.0) {
     int sign = (a.ADVAL_I < 0) ? -1 : 1;
     tmp.ADVAL_I = sign * makeInf();
   } else
@@ -503,10 +500,12 @@ inline adouble sqrt(const adouble &a) {
 inline adouble cbrt(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::cbrt(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
   if (a.PRIMAL_VALUE != 0.0)
-    tmp.ADVAL_I = a.ADVAL_I / (tmp.PRIMAL_VALUE * tmp.PRIMAL_VALUE * 3);
-  else if (a.PRIMAL_VALUE == 0.0 && a.ADVAL_I != 0.0) {
+    fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1,
+           tmp.PRIMAL_VALUE * tmp.PRIMAL_VALUE * 3);
+  else
+    FOR_I_EQ_1_LTEQ_NUMDIR
+  if (a.ADVAL_I != 0.0) {
     int sign = (a.ADVAL_I < 0) ? -1 : 1;
     tmp.ADVAL_I = sign * makeInf();
   } else
@@ -519,8 +518,7 @@ inline adouble sin(const adouble &a) {
   double tmp2;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::sin(a.PRIMAL_VALUE);
   tmp2 = ADOLC_MATH_NSP::cos(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp2 * a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -529,8 +527,7 @@ inline adouble cos(const adouble &a) {
   double tmp2;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::cos(a.PRIMAL_VALUE);
   tmp2 = -ADOLC_MATH_NSP::sin(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp2 * a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -538,8 +535,7 @@ inline adouble asin(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::asin(a.PRIMAL_VALUE);
   double tmp2 = ADOLC_MATH_NSP::sqrt(1 - a.PRIMAL_VALUE * a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
@@ -547,8 +543,7 @@ inline adouble acos(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::acos(a.PRIMAL_VALUE);
   double tmp2 = -ADOLC_MATH_NSP::sqrt(1 - a.PRIMAL_VALUE * a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
@@ -558,9 +553,10 @@ inline adouble atan(const adouble &a) {
   double tmp2 = 1 + a.PRIMAL_VALUE * a.PRIMAL_VALUE;
   tmp2 = 1 / tmp2;
   if (tmp2 != 0)
+    fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
+  else
     FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I * tmp2;
-  else FOR_I_EQ_1_LTEQ_NUMDIR tmp.ADVAL_I = 0.0;
+  tmp.ADVAL_I = 0.0;
   return tmp;
 }
 
@@ -570,11 +566,14 @@ inline adouble atan2(const adouble &a, const adouble &b) {
   double tmp2 = a.PRIMAL_VALUE * a.PRIMAL_VALUE;
   double tmp3 = b.PRIMAL_VALUE * b.PRIMAL_VALUE;
   double tmp4 = tmp3 / (tmp2 + tmp3);
-  if (tmp4 != 0)
+  if (tmp4 != 0) {
+    fovAxpby(adouble::numDir, tmp.adval + 1, b.PRIMAL_VALUE, a.adval + 1,
+             -a.PRIMAL_VALUE, b.adval + 1);
+    fovDiv(adouble::numDir, tmp.adval + 1, tmp.adval + 1, tmp3);
+    fovScale(adouble::numDir, tmp.adval + 1, tmp4, tmp.adval + 1);
+  } else
     FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I =
-      (a.ADVAL_I * b.PRIMAL_VALUE - a.PRIMAL_VALUE * b.ADVAL_I) / tmp3 * tmp4;
-  else FOR_I_EQ_1_LTEQ_NUMDIR tmp.ADVAL_I = 0.0;
+  tmp.ADVAL_I = 0.0;
   return tmp;
 }
 
@@ -582,8 +581,7 @@ inline adouble pow(const adouble &a, double v) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::pow(a.PRIMAL_VALUE, v);
   double tmp2 = v * ADOLC_MATH_NSP::pow(a.PRIMAL_VALUE, v - 1);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp2 * a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -593,8 +591,8 @@ inline adouble pow(const adouble &a, const adouble &b) {
   double tmp2 =
       b.PRIMAL_VALUE * ADOLC_MATH_NSP::pow(a.PRIMAL_VALUE, b.PRIMAL_VALUE - 1);
   double tmp3 = ADOLC_MATH_NSP::log(a.PRIMAL_VALUE) * tmp.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp2 * a.ADVAL_I + tmp3 * b.ADVAL_I;
+  fovAxpby(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1, tmp3,
+           b.adval + 1);
   return tmp;
 }
 
@@ -602,8 +600,7 @@ inline adouble pow(double v, const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::pow(v, a.PRIMAL_VALUE);
   double tmp2 = tmp.PRIMAL_VALUE * ADOLC_MATH_NSP::log(v);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp2 * a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -611,8 +608,7 @@ inline adouble log10(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::log10(a.PRIMAL_VALUE);
   double tmp2 = ADOLC_MATH_NSP::log((double)10) * a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
@@ -620,8 +616,7 @@ inline adouble sinh(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::sinh(a.PRIMAL_VALUE);
   double tmp2 = ADOLC_MATH_NSP::cosh(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I * tmp2;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -629,8 +624,7 @@ inline adouble cosh(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::cosh(a.PRIMAL_VALUE);
   double tmp2 = ADOLC_MATH_NSP::sinh(a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I * tmp2;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -639,8 +633,7 @@ inline adouble tanh(const adouble &a) {
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP::tanh(a.PRIMAL_VALUE);
   double tmp2 = ADOLC_MATH_NSP::cosh(a.PRIMAL_VALUE);
   tmp2 *= tmp2;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
@@ -648,8 +641,7 @@ inline adouble asinh(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP_ERF::asinh(a.PRIMAL_VALUE);
   double tmp2 = ADOLC_MATH_NSP::sqrt(a.PRIMAL_VALUE * a.PRIMAL_VALUE + 1);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
@@ -657,8 +649,7 @@ inline adouble acosh(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP_ERF::acosh(a.PRIMAL_VALUE);
   double tmp2 = ADOLC_MATH_NSP::sqrt(a.PRIMAL_VALUE * a.PRIMAL_VALUE - 1);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
@@ -666,8 +657,7 @@ inline adouble atanh(const adouble &a) {
   adouble tmp;
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP_ERF::atanh(a.PRIMAL_VALUE);
   double tmp2 = 1 - a.PRIMAL_VALUE * a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = a.ADVAL_I / tmp2;
+  fovDiv(adouble::numDir, tmp.adval + 1, a.adval + 1, tmp2);
   return tmp;
 }
 
@@ -876,8 +866,7 @@ inline adouble erf(const adouble &a) {
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP_ERF::erf(a.PRIMAL_VALUE);
   double tmp2 = 2.0 / ADOLC_MATH_NSP_ERF::sqrt(ADOLC_MATH_NSP::acos(-1.0)) *
                 ADOLC_MATH_NSP_ERF::exp(-a.PRIMAL_VALUE * a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp2 * a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -886,8 +875,7 @@ inline adouble erfc(const adouble &a) {
   tmp.PRIMAL_VALUE = ADOLC_MATH_NSP_ERF::erfc(a.PRIMAL_VALUE);
   double tmp2 = -2.0 / ADOLC_MATH_NSP_ERF::sqrt(ADOLC_MATH_NSP::acos(-1.0)) *
                 ADOLC_MATH_NSP_ERF::exp(-a.PRIMAL_VALUE * a.PRIMAL_VALUE);
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = tmp2 * a.ADVAL_I;
+  fovScale(adouble::numDir, tmp.adval + 1, tmp2, a.adval + 1);
   return tmp;
 }
 
@@ -938,8 +926,7 @@ inline adouble &adouble::operator+=(const double v) {
 }
 
 inline adouble &adouble::operator+=(const adouble &a) {
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  ADVAL_I += a.ADVAL_I;
+  fovAdd(numDir + 1, adval, adval, a.adval);
   return *this;
 }
 
@@ -949,34 +936,31 @@ inline adouble &adouble::operator-=(const double v) {
 }
 
 inline adouble &adouble::operator-=(const adouble &a) {
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  ADVAL_I -= a.ADVAL_I;
+  fovSub(numDir + 1, adval, adval, a.adval);
   return *this;
 }
 
 inline adouble &adouble::operator*=(const double v) {
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  ADVAL_I *= v;
+  fovScale(numDir + 1, adval, v, adval);
   return *this;
 }
 
 inline adouble &adouble::operator*=(const adouble &a) {
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  ADVAL_I = ADVAL_I * a.PRIMAL_VALUE + PRIMAL_VALUE * a.ADVAL_I;
+  fovAxpby(numDir, adval + 1, a.PRIMAL_VALUE, adval + 1, PRIMAL_VALUE,
+           a.adval + 1);
   PRIMAL_VALUE *= a.PRIMAL_VALUE;
   return *this;
 }
 
 inline adouble &adouble::operator/=(const double v) {
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  ADVAL_I /= v;
+  fovDiv(numDir + 1, adval, adval, v);
   return *this;
 }
 
 inline adouble &adouble::operator/=(const adouble &a) {
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  ADVAL_I = (ADVAL_I * a.PRIMAL_VALUE - PRIMAL_VALUE * a.ADVAL_I) /
-            (a.PRIMAL_VALUE * a.PRIMAL_VALUE);
+  fovAxpby(numDir, adval + 1, a.PRIMAL_VALUE, adval + 1, -PRIMAL_VALUE,
+           a.adval + 1);
+  fovDiv(numDir, adval + 1, adval + 1, a.PRIMAL_VALUE * a.PRIMAL_VALUE);
   PRIMAL_VALUE = PRIMAL_VALUE / a.PRIMAL_VALUE;
   return *this;
 }
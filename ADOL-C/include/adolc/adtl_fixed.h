@@ -0,0 +1,647 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_fixed.h
+ Revision: $Id$
+ Contents: adtl_fixed.h contains the traceless adouble with a number of
+           directions fixed at compile time.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_FIXED_H
+#define ADOLC_ADTL_FIXED_H
+
+#include <adolc/internal/common.h>
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+/* Alignment (bytes) of the derivative arrays, the width of AVX registers */
+#if !defined(ADTL_FIXED_ALIGN)
+#define ADTL_FIXED_ALIGN 32
+#endif
+
+namespace adtl_fixed {
+
+/****************************************************************************/
+/* Traceless forward mode with N directions fixed at compile time. Unlike   */
+/* adtl::adouble, whose directions are set by adtl::setNumDir for all       */
+/* objects and allocated on the heap, the value and the derivatives are     */
+/* stored in the object. Copies are plain memory copies and the loops over  */
+/* the directions have a constant trip count the compiler can vectorize.    */
+/* The derivative array comes first and is aligned to ADTL_FIXED_ALIGN      */
+/* bytes if its size is a multiple of it.                                   */
+/****************************************************************************/
+
+constexpr size_t derivativeAlignment(size_t n) {
+  return (n * sizeof(double)) % ADTL_FIXED_ALIGN == 0 ? ADTL_FIXED_ALIGN
+                                                      : alignof(double);
+}
+
+inline double makeNaN() { return std::numeric_limits<double>::quiet_NaN(); }
+
+inline double makeInf() { return std::numeric_limits<double>::infinity(); }
+
+#define FOR_I_EQ_0_LT_N for (size_t _i = 0; _i < N; ++_i)
+#define ADVAL_I adval[_i]
+
+template <size_t N> class alignas(derivativeAlignment(N)) adouble {
+  static_assert(N >= 1, "ADOL-C Error: Traceless: N < 1 not possible");
+
+public:
+  static constexpr size_t numDir = N;
+
+  /*******************************  ctors  **********************************/
+  adouble() : adval(), val(0.0) {}
+  adouble(const double v) : adval(), val(v) {}
+  adouble(const double v, const double *adv) : val(v) {
+    FOR_I_EQ_0_LT_N
+    ADVAL_I = adv[_i];
+  }
+  adouble(const adouble &a) = default;
+
+  /*************************  temporary results  ****************************/
+  // sign
+  adouble operator-() const {
+    adouble tmp;
+    tmp.val = -val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = -ADVAL_I;
+    return tmp;
+  }
+
+  adouble operator+() const { return *this; }
+
+  // addition
+  friend adouble operator+(const adouble &a, const adouble &b) {
+    adouble tmp;
+    tmp.val = a.val + b.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = a.ADVAL_I + b.ADVAL_I;
+    return tmp;
+  }
+
+  friend adouble operator+(const adouble &a, const double v) {
+    adouble tmp(a);
+    tmp.val += v;
+    return tmp;
+  }
+
+  friend adouble operator+(const double v, const adouble &a) {
+    adouble tmp(a);
+    tmp.val += v;
+    return tmp;
+  }
+
+  // subtraction
+  friend adouble operator-(const adouble &a, const adouble &b) {
+    adouble tmp;
+    tmp.val = a.val - b.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = a.ADVAL_I - b.ADVAL_I;
+    return tmp;
+  }
+
+  friend adouble operator-(const adouble &a, const double v) {
+    adouble tmp(a);
+    tmp.val -= v;
+    return tmp;
+  }
+
+  friend adouble operator-(const double v, const adouble &a) {
+    adouble tmp;
+    tmp.val = v - a.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = -a.ADVAL_I;
+    return tmp;
+  }
+
+  // multiplication
+  friend adouble operator*(const adouble &a, const adouble &b) {
+    adouble tmp;
+    tmp.val = a.val * b.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = a.ADVAL_I * b.val + a.val * b.ADVAL_I;
+    return tmp;
+  }
+
+  friend adouble operator*(const adouble &a, const double v) {
+    adouble tmp;
+    tmp.val = a.val * v;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = a.ADVAL_I * v;
+    return tmp;
+  }
+
+  friend adouble operator*(const double v, const adouble &a) { return a * v; }
+
+  // division
+  friend adouble operator/(const adouble &a, const adouble &b) {
+    adouble tmp;
+    const double r = 1.0 / b.val;
+    tmp.val = a.val * r;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = (a.ADVAL_I - tmp.val * b.ADVAL_I) * r;
+    return tmp;
+  }
+
+  friend adouble operator/(const adouble &a, const double v) {
+    adouble tmp;
+    tmp.val = a.val / v;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = a.ADVAL_I / v;
+    return tmp;
+  }
+
+  friend adouble operator/(const double v, const adouble &a) {
+    adouble tmp;
+    const double tmp2 = -v / (a.val * a.val);
+    tmp.val = v / a.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = tmp2 * a.ADVAL_I;
+    return tmp;
+  }
+
+  // inc/dec
+  adouble &operator++() {
+    ++val;
+    return *this;
+  }
+
+  adouble operator++(int) {
+    adouble tmp(*this);
+    ++val;
+    return tmp;
+  }
+
+  adouble &operator--() {
+    --val;
+    return *this;
+  }
+
+  adouble operator--(int) {
+    adouble tmp(*this);
+    --val;
+    return tmp;
+  }
+
+  // functions
+  friend adouble tan(const adouble &a) {
+    double tmp2 = std::cos(a.val);
+    tmp2 = 1.0 / (tmp2 * tmp2);
+    return chain(std::tan(a.val), tmp2, a);
+  }
+
+  friend adouble exp(const adouble &a) {
+    const double tmp2 = std::exp(a.val);
+    return chain(tmp2, tmp2, a);
+  }
+
+  friend adouble log(const adouble &a) {
+    adouble tmp;
+    tmp.val = std::log(a.val);
+    FOR_I_EQ_0_LT_N
+    if (a.val > 0)
+      tmp.ADVAL_I = a.ADVAL_I / a.val;
+    else if (a.val == 0 && a.ADVAL_I != 0.0) {
+      int sign = (a.ADVAL_I < 0) ? -1 : 1;
+      tmp.ADVAL_I = sign * makeInf();
+    } else
+      tmp.ADVAL_I = makeNaN();
+    return tmp;
+  }
+
+  friend adouble sqrt(const adouble &a) {
+    adouble tmp;
+    tmp.val = std::sqrt(a.val);
+    FOR_I_EQ_0_LT_N
+    if (a.val > 0)
+      tmp.ADVAL_I = a.ADVAL_I / (tmp.val * 2);
+    else if (a.val == 0.0 && a.ADVAL_I != 0.0) {
+      int sign = (a.ADVAL_I < 0) ? -1 : 1;
+      tmp.ADVAL_I = sign * makeInf();
+    } else
+      tmp.ADVAL_I = makeNaN();
+    return tmp;
+  }
+
+  friend adouble cbrt(const adouble &a) {
+    adouble tmp;
+    tmp.val = std::cbrt(a.val);
+    FOR_I_EQ_0_LT_N
+    if (a.val != 0.0)
+      tmp.ADVAL_I = a.ADVAL_I / (tmp.val * tmp.val * 3);
+    else if (a.ADVAL_I != 0.0) {
+      int sign = (a.ADVAL_I < 0) ? -1 : 1;
+      tmp.ADVAL_I = sign * makeInf();
+    } else
+      tmp.ADVAL_I = makeNaN();
+    return tmp;
+  }
+
+  friend adouble sin(const adouble &a) {
+    return chain(std::sin(a.val), std::cos(a.val), a);
+  }
+
+  friend adouble cos(const adouble &a) {
+    return chain(std::cos(a.val), -std::sin(a.val), a);
+  }
+
+  friend adouble asin(const adouble &a) {
+    return chain(std::asin(a.val), 1.0 / std::sqrt(1 - a.val * a.val), a);
+  }
+
+  friend adouble acos(const adouble &a) {
+    return chain(std::acos(a.val), -1.0 / std::sqrt(1 - a.val * a.val), a);
+  }
+
+  friend adouble atan(const adouble &a) {
+    return chain(std::atan(a.val), 1.0 / (1 + a.val * a.val), a);
+  }
+
+  friend adouble atan2(const adouble &a, const adouble &b) {
+    adouble tmp;
+    const double tmp2 = a.val * a.val;
+    const double tmp3 = b.val * b.val;
+    const double tmp4 = tmp3 / (tmp2 + tmp3);
+    tmp.val = std::atan2(a.val, b.val);
+    if (tmp4 != 0)
+      FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = (a.ADVAL_I * b.val - a.val * b.ADVAL_I) / tmp3 * tmp4;
+    return tmp;
+  }
+
+  friend adouble pow(const adouble &a, double v) {
+    return chain(std::pow(a.val, v), v * std::pow(a.val, v - 1), a);
+  }
+
+  friend adouble pow(const adouble &a, const adouble &b) {
+    adouble tmp;
+    tmp.val = std::pow(a.val, b.val);
+    const double tmp2 = b.val * std::pow(a.val, b.val - 1);
+    const double tmp3 = std::log(a.val) * tmp.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = tmp2 * a.ADVAL_I + tmp3 * b.ADVAL_I;
+    return tmp;
+  }
+
+  friend adouble pow(double v, const adouble &a) {
+    const double tmp2 = std::pow(v, a.val);
+    return chain(tmp2, tmp2 * std::log(v), a);
+  }
+
+  friend adouble log10(const adouble &a) {
+    return chain(std::log10(a.val), 1.0 / (std::log(10.0) * a.val), a);
+  }
+
+  friend adouble sinh(const adouble &a) {
+    return chain(std::sinh(a.val), std::cosh(a.val), a);
+  }
+
+  friend adouble cosh(const adouble &a) {
+    return chain(std::cosh(a.val), std::sinh(a.val), a);
+  }
+
+  friend adouble tanh(const adouble &a) {
+    double tmp2 = std::cosh(a.val);
+    tmp2 = 1.0 / (tmp2 * tmp2);
+    return chain(std::tanh(a.val), tmp2, a);
+  }
+
+  friend adouble asinh(const adouble &a) {
+    return chain(std::asinh(a.val), 1.0 / std::sqrt(a.val * a.val + 1), a);
+  }
+
+  friend adouble acosh(const adouble &a) {
+    return chain(std::acosh(a.val), 1.0 / std::sqrt(a.val * a.val - 1), a);
+  }
+
+  friend adouble atanh(const adouble &a) {
+    return chain(std::atanh(a.val), 1.0 / (1 - a.val * a.val), a);
+  }
+
+  friend adouble fabs(const adouble &a) {
+    adouble tmp;
+    tmp.val = std::fabs(a.val);
+    if (a.val != 0) {
+      const double as = a.val > 0 ? 1.0 : -1.0;
+      FOR_I_EQ_0_LT_N
+      tmp.ADVAL_I = a.ADVAL_I * as;
+    } else
+      FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = std::fabs(a.ADVAL_I);
+    return tmp;
+  }
+
+  friend adouble ceil(const adouble &a) { return adouble(std::ceil(a.val)); }
+
+  friend adouble floor(const adouble &a) {
+    return adouble(std::floor(a.val));
+  }
+
+  friend adouble fmax(const adouble &a, const adouble &b) {
+    adouble tmp;
+    const double tmp2 = a.val - b.val;
+    if (tmp2 < 0)
+      return b;
+    if (tmp2 > 0)
+      return a;
+    tmp.val = a.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = a.ADVAL_I < b.ADVAL_I ? b.ADVAL_I : a.ADVAL_I;
+    return tmp;
+  }
+
+  friend adouble fmax(double v, const adouble &a) {
+    return fmax(adouble(v), a);
+  }
+
+  friend adouble fmax(const adouble &a, double v) {
+    return fmax(a, adouble(v));
+  }
+
+  friend adouble fmin(const adouble &a, const adouble &b) {
+    adouble tmp;
+    const double tmp2 = a.val - b.val;
+    if (tmp2 < 0)
+      return a;
+    if (tmp2 > 0)
+      return b;
+    tmp.val = b.val;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = a.ADVAL_I < b.ADVAL_I ? a.ADVAL_I : b.ADVAL_I;
+    return tmp;
+  }
+
+  friend adouble fmin(double v, const adouble &a) {
+    return fmin(adouble(v), a);
+  }
+
+  friend adouble fmin(const adouble &a, double v) {
+    return fmin(a, adouble(v));
+  }
+
+  friend adouble ldexp(const adouble &a, const adouble &b) {
+    return a * pow(2., b);
+  }
+
+  friend adouble ldexp(const adouble &a, const double v) {
+    return a * std::pow(2., v);
+  }
+
+  friend adouble ldexp(const double v, const adouble &a) {
+    return v * pow(2., a);
+  }
+
+  friend double frexp(const adouble &a, int *v) { return std::frexp(a.val, v); }
+
+  friend adouble erf(const adouble &a) {
+    return chain(std::erf(a.val),
+                 2.0 / std::sqrt(std::acos(-1.0)) * std::exp(-a.val * a.val),
+                 a);
+  }
+
+  friend adouble erfc(const adouble &a) {
+    return chain(std::erfc(a.val),
+                 -2.0 / std::sqrt(std::acos(-1.0)) * std::exp(-a.val * a.val),
+                 a);
+  }
+
+  friend void condassign(adouble &res, const adouble &cond, const adouble &arg1,
+                         const adouble &arg2) {
+    if (cond.val > 0)
+      res = arg1;
+    else
+      res = arg2;
+  }
+
+  friend void condassign(adouble &res, const adouble &cond,
+                         const adouble &arg) {
+    if (cond.val > 0)
+      res = arg;
+  }
+
+  friend void condeqassign(adouble &res, const adouble &cond,
+                           const adouble &arg1, const adouble &arg2) {
+    if (cond.val >= 0)
+      res = arg1;
+    else
+      res = arg2;
+  }
+
+  friend void condeqassign(adouble &res, const adouble &cond,
+                           const adouble &arg) {
+    if (cond.val >= 0)
+      res = arg;
+  }
+
+  /*******************  nontemporary results  *******************************/
+  // assignment
+  adouble &operator=(const adouble &a) = default;
+
+  adouble &operator=(const double v) {
+    val = v;
+    FOR_I_EQ_0_LT_N
+    ADVAL_I = 0.0;
+    return *this;
+  }
+
+  // addition
+  adouble &operator+=(const double v) {
+    val += v;
+    return *this;
+  }
+
+  adouble &operator+=(const adouble &a) {
+    val += a.val;
+    FOR_I_EQ_0_LT_N
+    ADVAL_I += a.ADVAL_I;
+    return *this;
+  }
+
+  // subtraction
+  adouble &operator-=(const double v) {
+    val -= v;
+    return *this;
+  }
+
+  adouble &operator-=(const adouble &a) {
+    val -= a.val;
+    FOR_I_EQ_0_LT_N
+    ADVAL_I -= a.ADVAL_I;
+    return *this;
+  }
+
+  // multiplication
+  adouble &operator*=(const double v) {
+    val *= v;
+    FOR_I_EQ_0_LT_N
+    ADVAL_I *= v;
+    return *this;
+  }
+
+  adouble &operator*=(const adouble &a) {
+    FOR_I_EQ_0_LT_N
+    ADVAL_I = ADVAL_I * a.val + val * a.ADVAL_I;
+    val *= a.val;
+    return *this;
+  }
+
+  // division
+  adouble &operator/=(const double v) {
+    val /= v;
+    FOR_I_EQ_0_LT_N
+    ADVAL_I /= v;
+    return *this;
+  }
+
+  adouble &operator/=(const adouble &a) { return *this = *this / a; }
+
+  // not
+  bool operator!() const { return val == 0.0; }
+
+  // comparison
+  friend bool operator!=(const adouble &a, const adouble &b) {
+    return a.val != b.val;
+  }
+  friend bool operator!=(const adouble &a, const double v) {
+    return a.val != v;
+  }
+  friend bool operator!=(const double v, const adouble &a) {
+    return v != a.val;
+  }
+
+  friend bool operator==(const adouble &a, const adouble &b) {
+    return a.val == b.val;
+  }
+  friend bool operator==(const adouble &a, const double v) {
+    return a.val == v;
+  }
+  friend bool operator==(const double v, const adouble &a) {
+    return v == a.val;
+  }
+
+  friend bool operator<=(const adouble &a, const adouble &b) {
+    return a.val <= b.val;
+  }
+  friend bool operator<=(const adouble &a, const double v) {
+    return a.val <= v;
+  }
+  friend bool operator<=(const double v, const adouble &a) {
+    return v <= a.val;
+  }
+
+  friend bool operator>=(const adouble &a, const adouble &b) {
+    return a.val >= b.val;
+  }
+  friend bool operator>=(const adouble &a, const double v) {
+    return a.val >= v;
+  }
+  friend bool operator>=(const double v, const adouble &a) {
+    return v >= a.val;
+  }
+
+  friend bool operator>(const adouble &a, const adouble &b) {
+    return a.val > b.val;
+  }
+  friend bool operator>(const adouble &a, const double v) { return a.val > v; }
+  friend bool operator>(const double v, const adouble &a) { return v > a.val; }
+
+  friend bool operator<(const adouble &a, const adouble &b) {
+    return a.val < b.val;
+  }
+  friend bool operator<(const adouble &a, const double v) { return a.val < v; }
+  friend bool operator<(const double v, const adouble &a) { return v < a.val; }
+
+  /*******************  getter / setter  ************************************/
+  double getValue() const { return val; }
+  void setValue(const double v) { val = v; }
+  const double *getADValue() const { return adval; }
+  void setADValue(const double *v) {
+    FOR_I_EQ_0_LT_N
+    ADVAL_I = v[_i];
+  }
+
+  double getADValue(const unsigned int p) const {
+    if (p >= N) {
+      fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                        " while \"getADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    return adval[p];
+  }
+
+  void setADValue(const unsigned int p, const double v) {
+    if (p >= N) {
+      fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                        " while \"setADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    adval[p] = v;
+  }
+
+  explicit operator double const &() const { return val; }
+  explicit operator double() const { return val; }
+
+  /*******************  i/o operations  *************************************/
+  friend std::ostream &operator<<(std::ostream &out, const adouble &a) {
+    out << "Value: " << a.val;
+    out << " ADValues (" << N << "): ";
+    FOR_I_EQ_0_LT_N
+    out << a.ADVAL_I << " ";
+    out << "(a)";
+    return out;
+  }
+
+  friend std::istream &operator>>(std::istream &in, adouble &a) {
+    char c;
+    size_t num;
+    do
+      in >> c;
+    while (c != ':' && !in.eof());
+    in >> a.val;
+    do
+      in >> c;
+    while (c != '(' && !in.eof());
+    in >> num;
+    if (num > N)
+      throw std::logic_error("ADOL-C error: too many directions in input");
+    do
+      in >> c;
+    while (c != ':' && !in.eof());
+    FOR_I_EQ_0_LT_N
+    in >> a.ADVAL_I;
+    do
+      in >> c;
+    while (c != ')' && !in.eof());
+    return in;
+  }
+
+private:
+  /* result with value v and derivatives d * a.adval (chain rule) */
+  static adouble chain(const double v, const double d, const adouble &a) {
+    adouble tmp;
+    tmp.val = v;
+    FOR_I_EQ_0_LT_N
+    tmp.ADVAL_I = d * a.ADVAL_I;
+    return tmp;
+  }
+
+  double adval[N];
+  double val;
+};
+
+#undef FOR_I_EQ_0_LT_N
+#undef ADVAL_I
+
+} // namespace adtl_fixed
+#endif
@@ -17,7 +17,8 @@
 #ifndef ADOLC_ADTL_HOV_H
 #define ADOLC_ADTL_HOV_H
 
-#include <adolc/adalloc.h> //for myalloc2
+#include <adolc/adtl_kernels.h>
+#include <adolc/adtl_pool.h>
 #include <adolc/internal/common.h>
 #include <list>
 #include <ostream>
@@ -33,6 +34,9 @@ namespace adtl_hov {
 double makeNaN();
 double makeInf();
 
+/* index domains, allocated from the traceless pool */
+typedef list<unsigned int, adtl::PoolAllocator<unsigned int>> pattern_list;
+
 enum Mode {
   ADTL_ZOS = 0x1,
   ADTL_FOV = 0x3,
@@ -221,8 +225,8 @@ public:
   inline explicit operator double();
 
 protected:
-  inline const list<unsigned int> &get_pattern() const;
-  inline void add_to_pattern(const list<unsigned int> &v);
+  inline const pattern_list &get_pattern() const;
+  inline void add_to_pattern(const pattern_list &v);
   inline size_t get_pattern_size() const;
   inline void delete_pattern();
 
@@ -246,7 +250,7 @@ private:
   double val;
   double *adval;
   double **ho_deriv;
-  list<unsigned int> pattern;
+  pattern_list pattern;
 #ifdef USE_ADTL_REFCOUNTING
   refcounter __rcnt;
 #endif
@@ -254,6 +258,7 @@ private:
   inline static bool _do_adval();
   inline static bool _do_hoval();
   inline static bool _do_indo();
+  inline static double **newHoDeriv();
   ADOLC_DLL_EXPIMP static size_t numDir;
   ADOLC_DLL_EXPIMP static size_t degree;
   ADOLC_DLL_EXPIMP static enum Mode forward_mode;
@@ -381,10 +386,22 @@ inline double makeInf() {
 #define V_I v[_i]
 #define HO_DER_I_J ho_deriv[_j][_i]
 
+/* One pool block holding the row pointers, then the degree rows */
+inline double **adouble::newHoDeriv() {
+  const size_t ptrDoubles = (degree * sizeof(double *) + ADTL_POOL_ALIGN - 1) /
+                            ADTL_POOL_ALIGN * ADTL_POOL_ALIGN / sizeof(double);
+  double *block = adtl::poolMallocDoubles(ptrDoubles + degree * numDir);
+  double **rows = reinterpret_cast<double **>(block);
+  double *data = block + ptrDoubles;
+  for (size_t j = 0; j < degree; ++j)
+    rows[j] = data + j * numDir;
+  return rows;
+}
+
 /*******************************  ctors  ************************************/
-inline adouble::adouble() : val(0), adval(NULL) {
+inline adouble::adouble() : val(0), adval(NULL), ho_deriv(NULL) {
   if (do_adval())
-    adval = new double[adouble::numDir];
+    adval = adtl::poolMallocDoubles(adouble::numDir);
 
   //     ho_deriv= new double[adouble::degree][ adouble::numDir];
   // double** ho_deriv= new double*[adouble::degree];
@@ -393,7 +410,7 @@ inline adouble::adouble() : val(0), adval(NULL) {
   //    	std::cout << "constructing adtl:   degree: " << adouble::degree
   //    << "  numDir: " << adouble::numDir << std::endl;
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
   }
   /*
       for(int i=0;i< adouble::degree;i++)
@@ -407,15 +424,15 @@ inline adouble::adouble() : val(0), adval(NULL) {
   }
 }
 
-inline adouble::adouble(const double v) : val(v), adval(NULL) {
+inline adouble::adouble(const double v) : val(v), adval(NULL), ho_deriv(NULL) {
   if (do_adval()) {
-    adval = new double[adouble::numDir];
+    adval = adtl::poolMallocDoubles(adouble::numDir);
     FOR_I_EQ_0_LT_NUMDIR
     ADVAL_I = 0.0;
   }
   if (do_hoval()) // ADTL_HOV
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
     HO_DER_I_J = 0.0;
   }
@@ -426,9 +443,9 @@ inline adouble::adouble(const double v) : val(v), adval(NULL) {
 }
 
 inline adouble::adouble(const double v, const double *adv)
-    : val(v), adval(NULL) {
+    : val(v), adval(NULL), ho_deriv(NULL) {
   if (do_adval()) {
-    adval = new double[adouble::numDir];
+    adval = adtl::poolMallocDoubles(adouble::numDir);
     FOR_I_EQ_0_LT_NUMDIR
     ADVAL_I = ADV_I;
   }
@@ -444,10 +461,10 @@ inline adouble::adouble(const double v, const double *adv)
   }
 }
 inline adouble::adouble(const double v, const double **hov)
-    : val(v), ho_deriv(NULL) {
+    : val(v), adval(NULL), ho_deriv(NULL) {
   if (do_hoval()) // ADTL_HOV
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
     HO_DER_I_J = hov[_j][_i];
   }
@@ -462,15 +479,16 @@ inline adouble::adouble(const double v, const double **hov)
   }
 }
 
-inline adouble::adouble(const adouble &a) : val(a.val), adval(NULL) {
+inline adouble::adouble(const adouble &a)
+    : val(a.val), adval(NULL), ho_deriv(NULL) {
   if (do_adval()) {
-    adval = new double[adouble::numDir];
+    adval = adtl::poolMallocDoubles(adouble::numDir);
     FOR_I_EQ_0_LT_NUMDIR
     ADVAL_I = a.ADVAL_I;
   }
   if (do_hoval()) // ADTL_HOV
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
     HO_DER_I_J = a.HO_DER_I_J;
   }
@@ -484,10 +502,8 @@ inline adouble::adouble(const adouble &a) : val(a.val), adval(NULL) {
 
 /*******************************  dtors  ************************************/
 inline adouble::~adouble() {
-  if (adval != NULL)
-    delete[] adval;
-//    if(ho_deriv!=NULL)
-//    	delete[][]  ho_deriv;
+  adtl::poolFree(adval);
+  adtl::poolFree(ho_deriv);
 #if 0
     if ( !pattern.empty() )
 	pattern.clear();
@@ -501,8 +517,7 @@ inline adouble adouble::operator-() const {
   if (do_val())
     tmp.val = -val;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = -ADVAL_I;
+    adtl::fovScale(adouble::numDir, tmp.adval, -1.0, adval);
   if (do_hoval()) // ADTL_HOV
   {
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
@@ -528,8 +543,7 @@ inline adouble adouble::operator+(const adouble &a) const {
   if (do_val())
     tmp.val = val + a.val;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = ADVAL_I + a.ADVAL_I;
+    adtl::fovAdd(adouble::numDir, tmp.adval, adval, a.adval);
   if (do_hoval()) // ADTL_HOV
   {
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
@@ -583,8 +597,7 @@ inline adouble adouble::operator-(const adouble &a) const {
   if (do_val())
     tmp.val = val - a.val;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = ADVAL_I - a.ADVAL_I;
+    adtl::fovSub(adouble::numDir, tmp.adval, adval, a.adval);
   if (do_indo()) {
     tmp.add_to_pattern(get_pattern());
     tmp.add_to_pattern(a.get_pattern());
@@ -603,8 +616,7 @@ inline adouble operator-(const double v, const adouble &a) {
   if (do_val())
     tmp.val = v - a.val;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = -a.ADVAL_I;
+    adtl::fovScale(adouble::numDir, tmp.adval, -1.0, a.adval);
 
   if (do_hoval()) // ADTL_HOV
   {
@@ -622,8 +634,7 @@ inline adouble adouble::operator*(const double v) const {
   if (do_val())
     tmp.val = val * v;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = ADVAL_I * v;
+    adtl::fovScale(adouble::numDir, tmp.adval, v, adval);
   if (do_hoval()) // ADTL_HOV
   {
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
@@ -660,8 +671,7 @@ inline adouble adouble::operator*(const adouble &a) const {
     }
   }
   if (likely(adouble::_do_adval() && adouble::_do_val()))
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = ADVAL_I * a.val + val * a.ADVAL_I;
+    adtl::fovAxpby(adouble::numDir, tmp.adval, a.val, adval, val, a.adval);
   if (do_indo()) {
     tmp.add_to_pattern(get_pattern());
     tmp.add_to_pattern(a.get_pattern());
@@ -674,8 +684,7 @@ inline adouble operator*(const double v, const adouble &a) {
   if (do_val())
     tmp.val = v * a.val;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = v * a.ADVAL_I;
+    adtl::fovScale(adouble::numDir, tmp.adval, v, a.adval);
 
   if (do_hoval()) // ADTL_HOV
   {
@@ -694,8 +703,7 @@ inline adouble adouble::operator/(const double v) const {
   if (do_val())
     tmp.val = val / v;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = ADVAL_I / v;
+    adtl::fovDiv(adouble::numDir, tmp.adval, adval, v);
   if (do_hoval()) // ADTL_HOV
   {
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
@@ -733,9 +741,10 @@ inline adouble adouble::operator/(const adouble &a) const {
     }
   }
 
-  if (likely(adouble::_do_adval() && adouble::_do_val()))
-    FOR_I_EQ_0_LT_NUMDIR
-  tmp.ADVAL_I = (ADVAL_I * a.val - val * a.ADVAL_I) / (a.val * a.val);
+  if (likely(adouble::_do_adval() && adouble::_do_val())) {
+    adtl::fovAxpby(adouble::numDir, tmp.adval, a.val, adval, -val, a.adval);
+    adtl::fovDiv(adouble::numDir, tmp.adval, tmp.adval, a.val * a.val);
+  }
   if (do_indo()) {
     tmp.add_to_pattern(get_pattern());
     tmp.add_to_pattern(a.get_pattern());
@@ -2131,8 +2140,7 @@ inline adouble &adouble::operator+=(const adouble &a) {
   if (do_val())
     val = val + a.val;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  ADVAL_I += a.ADVAL_I;
+    adtl::fovAdd(adouble::numDir, adval, adval, a.adval);
 
   if (do_hoval()) // ADTL_HOV
   {
@@ -2155,8 +2163,7 @@ inline adouble &adouble::operator-=(const adouble &a) {
   if (do_val())
     val = val - a.val;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  ADVAL_I -= a.ADVAL_I;
+    adtl::fovSub(adouble::numDir, adval, adval, a.adval);
 
   if (do_hoval()) // ADTL_HOV
   {
@@ -2173,8 +2180,7 @@ inline adouble &adouble::operator*=(const double v) {
   if (do_val())
     val = val * v;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  ADVAL_I *= v;
+    adtl::fovScale(adouble::numDir, adval, v, adval);
   if (do_hoval()) // ADTL_HOV
   {
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
@@ -2190,8 +2196,7 @@ inline adouble &adouble::operator*=(const adouble &a) {
     throw logic_error("incorrect function call, errorcode=1");
   }
   if (likely(adouble::_do_adval() && adouble::_do_val()))
-    FOR_I_EQ_0_LT_NUMDIR
-  ADVAL_I = ADVAL_I * a.val + val * a.ADVAL_I;
+    adtl::fovAxpby(adouble::numDir, adval, a.val, adval, val, a.adval);
   if (do_val())
     val *= a.val;
 
@@ -2227,8 +2232,7 @@ inline adouble &adouble::operator/=(const double v) {
   if (do_val())
     val /= v;
   if (do_adval())
-    FOR_I_EQ_0_LT_NUMDIR
-  ADVAL_I /= v;
+    adtl::fovDiv(adouble::numDir, adval, adval, v);
 
   if (do_hoval()) // ADTL_HOV
   {
@@ -2550,7 +2554,7 @@ double *adouble::getOneADValue(int i) const {
 
 void adouble::setOneADValue(int i, double *v) { ho_deriv[i] = v; }
 
-inline const list<unsigned int> &adouble::get_pattern() const {
+inline const pattern_list &adouble::get_pattern() const {
   if (no_do_indo()) {
     fprintf(DIAG_OUT, "ADOL-C error: Traceless: Incorrect mode, call "
                       "setMode(enum Mode mode)\n");
@@ -2569,7 +2573,7 @@ inline void adouble::delete_pattern() {
     pattern.clear();
 }
 
-inline void adouble::add_to_pattern(const list<unsigned int> &v) {
+inline void adouble::add_to_pattern(const pattern_list &v) {
   if (no_do_indo()) {
     fprintf(DIAG_OUT, "ADOL-C error: Traceless: Incorrect mode, call "
                       "setMode(enum Mode mode)\n");
@@ -2577,7 +2581,7 @@ inline void adouble::add_to_pattern(const list<unsigned int> &v) {
   }
   if (likely(pattern != v)) {
     if (!v.empty()) {
-      list<unsigned int> cv = v;
+      pattern_list cv = v;
       // pattern.splice(pattern.end(), cv);
       pattern.merge(cv);
       // if (pattern.size() > refcounter::refcnt) {
@@ -0,0 +1,119 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_index_domain.h
+ Revision: $Id$
+ Contents: adtl_index_domain.h contains the index domains propagated by the
+           traceless sparsity pattern recognition of adtl_indo.h.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_INDEX_DOMAIN_H
+#define ADOLC_ADTL_INDEX_DOMAIN_H
+
+#include <adolc/internal/common.h>
+#include <cstddef>
+#include <cstdint>
+
+/* Domains of at most this many indices are stored inside the adouble */
+#if !defined(ADTL_INDO_INLINE)
+#define ADTL_INDO_INLINE 6
+#endif
+
+namespace adtl_indo {
+
+/****************************************************************************/
+/* A set of independent indices in one of three forms, chosen after every  */
+/* union by its size and the range it spans:                                */
+/*   INLINE  up to ADTL_INDO_INLINE sorted indices without allocation,      */
+/*   ARRAY   a sorted array from the traceless pool,                        */
+/*   BITSET  64-bit words covering only the words from the smallest to the  */
+/*           largest index, used once it takes no more memory than ARRAY.   */
+/* Unions of two bitsets OR whole words, so a dense domain costs one word   */
+/* operation per 64 indices. Unions of sorted forms are linear merges.      */
+/****************************************************************************/
+
+class index_domain {
+public:
+  enum kind_t { INLINE = 0, ARRAY = 1, BITSET = 2 };
+
+  inline index_domain() : count(0), kind(INLINE) {}
+  inline index_domain(const index_domain &d) : count(0), kind(INLINE) {
+    assign(d);
+  }
+  inline ~index_domain() { release(); }
+
+  inline index_domain &operator=(const index_domain &d) {
+    if (this != &d)
+      assign(d);
+    return *this;
+  }
+
+  inline bool empty() const { return count == 0; }
+  inline size_t size() const { return count; }
+  inline kind_t get_kind() const { return static_cast<kind_t>(kind); }
+
+  inline void clear() {
+    release();
+    count = 0;
+  }
+
+  /* this = this u d */
+  inline void merge(const index_domain &d) {
+    if (this == &d || d.count == 0)
+      return;
+    if (count == 0)
+      assign(d);
+    else
+      merge_nonempty(d);
+  }
+
+  ADOLC_DLL_EXPORT void insert(unsigned int i);
+  /* writes the indices in increasing order to dst[0 .. size()-1] */
+  ADOLC_DLL_EXPORT void to_array(unsigned int *dst) const;
+  ADOLC_DLL_EXPORT bool operator==(const index_domain &d) const;
+  inline bool operator!=(const index_domain &d) const { return !(*this == d); }
+
+private:
+  ADOLC_DLL_EXPORT void assign(const index_domain &d);
+  ADOLC_DLL_EXPORT void release();
+  ADOLC_DLL_EXPORT void merge_nonempty(const index_domain &d);
+  void merge_sorted(const index_domain &d);
+  void merge_bits(const index_domain &d, unsigned int lo, unsigned int hi);
+  /* takes idx over if owned, a pool block of cap indices */
+  void adopt_sorted(unsigned int *idx, unsigned int n, unsigned int cap,
+                    bool owned);
+  /* takes w over, nw pool words whose first and last word are not zero */
+  void adopt_bits(uint64_t *w, unsigned int first, unsigned int nw,
+                  unsigned int n);
+  unsigned int min_index() const;
+  unsigned int max_index() const;
+  const unsigned int *sorted() const {
+    return kind == INLINE ? data.small : data.array.idx;
+  }
+
+  unsigned int count;
+  unsigned char kind;
+  union {
+    unsigned int small[ADTL_INDO_INLINE];
+    struct {
+      unsigned int *idx;
+      unsigned int cap;
+    } array;
+    struct {
+      uint64_t *words;
+      unsigned int first; // index of the first word
+      unsigned int nwords;
+    } bits;
+  } data;
+};
+
+} // namespace adtl_indo
+
+#endif
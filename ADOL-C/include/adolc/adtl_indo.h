@@ -17,15 +17,14 @@
 #ifndef ADOLC_ADTL_INDO_H
 #define ADOLC_ADTL_INDO_H
 
+#include <adolc/adtl_index_domain.h>
 #include <adolc/internal/common.h>
-#include <list>
 #include <ostream>
 #include <stdexcept>
 
 #include <adolc/adtl.h>
 
 using std::istream;
-using std::list;
 using std::logic_error;
 using std::ostream;
 
@@ -54,6 +53,9 @@ namespace adtl_indo {
 double makeNaN();
 double makeInf();
 
+/* index domains, see adtl_index_domain.h */
+typedef index_domain pattern_list;
+
 class adouble {
 public:
   inline adouble();
@@ -199,8 +201,8 @@ public:
   inline explicit operator double();
 
 protected:
-  inline const list<unsigned int> &get_pattern() const;
-  inline void add_to_pattern(const list<unsigned int> &v);
+  inline const pattern_list &get_pattern() const;
+  inline void add_to_pattern(const pattern_list &v);
   inline size_t get_pattern_size() const;
   inline void delete_pattern();
 
@@ -215,7 +217,7 @@ public:
 
 private:
   double val;
-  list<unsigned int> pattern;
+  pattern_list pattern;
 };
 
 } // namespace adtl_indo
@@ -836,7 +838,7 @@ inline double adouble::getValue() const { return val; }
 
 inline void adouble::setValue(const double v) { val = v; }
 
-inline const list<unsigned int> &adouble::get_pattern() const {
+inline const pattern_list &adouble::get_pattern() const {
   return pattern;
 }
 
@@ -845,26 +847,12 @@ inline void adouble::delete_pattern() {
     pattern.clear();
 }
 
-inline void adouble::add_to_pattern(const list<unsigned int> &v) {
-  if (likely(pattern != v)) {
-    if (!v.empty()) {
-      list<unsigned int> cv = v;
-      // pattern.splice(pattern.end(), cv);
-      pattern.merge(cv);
-      // if (pattern.size() > refcounter::refcnt) {
-      // pattern.sort();
-      pattern.unique();
-      //}
-    }
-  }
+inline void adouble::add_to_pattern(const pattern_list &v) {
+  if (likely(pattern != v))
+    pattern.merge(v);
 }
 
-inline size_t adouble::get_pattern_size() const {
-  size_t s = 0;
-  if (!pattern.empty())
-    s = pattern.size();
-  return s;
-}
+inline size_t adouble::get_pattern_size() const { return pattern.size(); }
 
 } // namespace adtl_indo
 
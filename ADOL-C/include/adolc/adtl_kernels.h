@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_kernels.h
+ Revision: $Id$
+ Contents: adtl_kernels.h contains the elementwise kernels used by the
+           traceless forward vector mode for the loops over the directions.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_KERNELS_H
+#define ADOLC_ADTL_KERNELS_H
+
+#include <adolc/internal/common.h>
+#include <cstddef>
+
+/* Below this many directions the loops are inlined instead of dispatched */
+#if !defined(ADTL_KERNEL_MIN_DIRS)
+#define ADTL_KERNEL_MIN_DIRS 8
+#endif
+
+namespace adtl {
+
+/****************************************************************************/
+/* The kernels work on n contiguous doubles. The result may be the same     */
+/* array as an argument, but must not overlap it otherwise. The table is    */
+/* chosen once at load time from the instruction sets the CPU supports      */
+/* (AVX-512F, AVX2, or portable loops) and can be replaced by setKernelISA, */
+/* e.g. to compare them. No table fuses multiplications and additions, so   */
+/* all of them round like the inline loops below.                           */
+/****************************************************************************/
+
+enum KernelISA { ADTL_ISA_SCALAR = 0, ADTL_ISA_AVX2 = 1, ADTL_ISA_AVX512 = 2 };
+
+struct FovKernels {
+  void (*add)(size_t n, double *r, const double *a, const double *b);
+  void (*sub)(size_t n, double *r, const double *a, const double *b);
+  /* r = s * a */
+  void (*scale)(size_t n, double *r, double s, const double *a);
+  /* r = a / s */
+  void (*div)(size_t n, double *r, const double *a, double s);
+  /* r = alpha * a + beta * b */
+  void (*axpby)(size_t n, double *r, double alpha, const double *a,
+                double beta, const double *b);
+  /* r += s * a */
+  void (*axpy)(size_t n, double *r, double s, const double *a);
+};
+
+ADOLC_DLL_EXPIMP extern const FovKernels *fovKernels;
+
+/* Best instruction set of this CPU for which kernels were compiled */
+ADOLC_DLL_EXPORT KernelISA getBestKernelISA();
+ADOLC_DLL_EXPORT KernelISA getKernelISA();
+/* Returns false and keeps the current table if isa is not available */
+ADOLC_DLL_EXPORT bool setKernelISA(KernelISA isa);
+
+inline void fovAdd(size_t n, double *r, const double *a, const double *b) {
+  if (n < ADTL_KERNEL_MIN_DIRS)
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] + b[i];
+  else
+    fovKernels->add(n, r, a, b);
+}
+
+inline void fovSub(size_t n, double *r, const double *a, const double *b) {
+  if (n < ADTL_KERNEL_MIN_DIRS)
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] - b[i];
+  else
+    fovKernels->sub(n, r, a, b);
+}
+
+inline void fovScale(size_t n, double *r, double s, const double *a) {
+  if (n < ADTL_KERNEL_MIN_DIRS)
+    for (size_t i = 0; i < n; ++i)
+      r[i] = s * a[i];
+  else
+    fovKernels->scale(n, r, s, a);
+}
+
+inline void fovDiv(size_t n, double *r, const double *a, double s) {
+  if (n < ADTL_KERNEL_MIN_DIRS)
+    for (size_t i = 0; i < n; ++i)
+      r[i] = a[i] / s;
+  else
+    fovKernels->div(n, r, a, s);
+}
+
+inline void fovAxpby(size_t n, double *r, double alpha, const double *a,
+                     double beta, const double *b) {
+  if (n < ADTL_KERNEL_MIN_DIRS)
+    for (size_t i = 0; i < n; ++i)
+      r[i] = alpha * a[i] + beta * b[i];
+  else
+    fovKernels->axpby(n, r, alpha, a, beta, b);
+}
+
+inline void fovAxpy(size_t n, double *r, double s, const double *a) {
+  if (n < ADTL_KERNEL_MIN_DIRS)
+    for (size_t i = 0; i < n; ++i)
+      r[i] += s * a[i];
+  else
+    fovKernels->axpy(n, r, s, a);
+}
+
+} // namespace adtl
+
+#endif
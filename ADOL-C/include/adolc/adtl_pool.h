@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_pool.h
+ Revision: $Id$
+ Contents: adtl_pool.h contains the thread local slab allocator used for the
+           derivative arrays and index domains of the traceless adoubles.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_POOL_H
+#define ADOLC_ADTL_POOL_H
+
+#include <adolc/internal/common.h>
+#include <cstddef>
+
+namespace adtl {
+
+/****************************************************************************/
+/* Blocks are carved from 64 KiB slabs owned by the allocating thread and   */
+/* grouped in size classes: 16, 32 and 48 bytes for list nodes, then whole  */
+/* cache lines. Blocks of 64 bytes and more are 64-byte aligned. Each slab  */
+/* records its size class, so poolFree needs no size and a block may be     */
+/* freed after setNumDir changed the size of new blocks. A block freed by   */
+/* another thread goes back to the thread owning its slab, which takes it   */
+/* back once its own free blocks run out; the slabs of a finished thread    */
+/* pass to the next thread carving one. If a class has no free block, a     */
+/* free block of a larger class is reused before a new slab is carved.      */
+/* Requests larger than 8 KiB get a block of their own, rounded up to whole */
+/* cache lines, that is returned to the system when freed.                  */
+/****************************************************************************/
+
+#define ADTL_POOL_ALIGN 64
+
+struct PoolStats {
+  size_t allocations;   // blocks handed out by the calling thread
+  size_t deallocations; // blocks freed by the calling thread
+  size_t recycled;      // allocations served by a block of a larger class
+  size_t returned;      // blocks freed by other threads, taken back
+  size_t slabs;         // slabs carved by all threads
+  size_t reservedBytes; // bytes held by slabs and large blocks, all threads
+};
+
+ADOLC_DLL_EXPORT void *poolMalloc(size_t bytes);
+ADOLC_DLL_EXPORT void poolFree(void *p);
+ADOLC_DLL_EXPORT PoolStats getPoolStats();
+
+/* array of n doubles, rounded up to whole cache lines so it is aligned */
+inline double *poolMallocDoubles(size_t n) {
+  const size_t bytes = (n * sizeof(double) + ADTL_POOL_ALIGN - 1) &
+                       ~size_t(ADTL_POOL_ALIGN - 1);
+  return static_cast<double *>(poolMalloc(bytes));
+}
+
+/* std::allocator replacement for the containers of index domains */
+template <typename T> class PoolAllocator {
+public:
+  typedef T value_type;
+
+  PoolAllocator() noexcept {}
+  template <typename U> PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+  T *allocate(size_t n) { return static_cast<T *>(poolMalloc(n * sizeof(T))); }
+  void deallocate(T *p, size_t) noexcept { poolFree(p); }
+
+  template <typename U> bool operator==(const PoolAllocator<U> &) const {
+    return true;
+  }
+  template <typename U> bool operator!=(const PoolAllocator<U> &) const {
+    return false;
+  }
+};
+
+} // namespace adtl
+
+#endif
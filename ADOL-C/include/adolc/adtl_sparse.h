@@ -0,0 +1,1001 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_sparse.h
+ Revision: $Id$
+ Contents: adtl_sparse.h contains the traceless adouble that stores only the
+           nonzero directional derivatives until they become dense.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_SPARSE_H
+#define ADOLC_ADTL_SPARSE_H
+
+#include <adolc/adtl_indo.h> /* func_ad */
+#include <adolc/adtl_kernels.h>
+#include <adolc/adtl_pool.h>
+#include <adolc/internal/common.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace adtl_sparse {
+class adouble;
+} // namespace adtl_sparse
+
+/* The Jacobian of func at basepoints in coordinate format, computed in one
+ * sweep with all n directions seeded. Only structurally nonzero entries of
+ * sparse results are returned; dense results return their nonzero values. */
+ADOLC_DLL_EXPORT int
+ADOLC_get_sparse_jacobian(func_ad<adtl_sparse::adouble> *const func, int n,
+                          int m, double *basepoints, int *nnz,
+                          unsigned int **rind, unsigned int **cind,
+                          double **values);
+
+namespace adtl_sparse {
+
+/****************************************************************************/
+/* Traceless forward vector mode for sparse seeds. The derivatives are kept */
+/* as a sorted list of (direction, value) pairs. Directions that were never */
+/* touched take no memory and no work, so a function of n independents can */
+/* be differentiated in all n directions at once when every result depends */
+/* on a few of them. Once an adouble holds more than the dense threshold   */
+/* times numDir directions it switches to a dense array like adtl::adouble */
+/* and stays dense. Constants store no derivatives at all.                  */
+/****************************************************************************/
+
+double makeNaN();
+double makeInf();
+
+class adouble {
+public:
+  inline adouble();
+  inline adouble(const double v);
+  inline adouble(const double v, const double *adv);
+  inline adouble(const adouble &a);
+  inline adouble(adouble &&a) noexcept;
+  inline ~adouble();
+
+  // sign
+  inline adouble operator-() const;
+  inline adouble operator+() const;
+
+  // addition
+  inline adouble operator+(const double v) const;
+  inline adouble operator+(const adouble &a) const;
+  inline friend adouble operator+(const double v, const adouble &a);
+
+  // subtraction
+  inline adouble operator-(const double v) const;
+  inline adouble operator-(const adouble &a) const;
+  inline friend adouble operator-(const double v, const adouble &a);
+
+  // multiplication
+  inline adouble operator*(const double v) const;
+  inline adouble operator*(const adouble &a) const;
+  inline friend adouble operator*(const double v, const adouble &a);
+
+  // division
+  inline adouble operator/(const double v) const;
+  inline adouble operator/(const adouble &a) const;
+  inline friend adouble operator/(const double v, const adouble &a);
+
+  // inc/dec
+  inline adouble operator++();
+  inline adouble operator++(int);
+  inline adouble operator--();
+  inline adouble operator--(int);
+
+  // functions
+  inline friend adouble tan(const adouble &a);
+  inline friend adouble exp(const adouble &a);
+  inline friend adouble log(const adouble &a);
+  inline friend adouble sqrt(const adouble &a);
+  inline friend adouble cbrt(const adouble &a);
+  inline friend adouble sin(const adouble &a);
+  inline friend adouble cos(const adouble &a);
+  inline friend adouble asin(const adouble &a);
+  inline friend adouble acos(const adouble &a);
+  inline friend adouble atan(const adouble &a);
+
+  inline friend adouble atan2(const adouble &a, const adouble &b);
+  inline friend adouble pow(const adouble &a, double v);
+  inline friend adouble pow(const adouble &a, const adouble &b);
+  inline friend adouble pow(double v, const adouble &a);
+  inline friend adouble log10(const adouble &a);
+
+  inline friend adouble sinh(const adouble &a);
+  inline friend adouble cosh(const adouble &a);
+  inline friend adouble tanh(const adouble &a);
+  inline friend adouble asinh(const adouble &a);
+  inline friend adouble acosh(const adouble &a);
+  inline friend adouble atanh(const adouble &a);
+  inline friend adouble fabs(const adouble &a);
+  inline friend adouble ceil(const adouble &a);
+  inline friend adouble floor(const adouble &a);
+  inline friend adouble fmax(const adouble &a, const adouble &b);
+  inline friend adouble fmax(double v, const adouble &a);
+  inline friend adouble fmax(const adouble &a, double v);
+  inline friend adouble fmin(const adouble &a, const adouble &b);
+  inline friend adouble fmin(double v, const adouble &a);
+  inline friend adouble fmin(const adouble &a, double v);
+  inline friend adouble ldexp(const adouble &a, const adouble &b);
+  inline friend adouble ldexp(const adouble &a, const double v);
+  inline friend adouble ldexp(const double v, const adouble &a);
+  inline friend double frexp(const adouble &a, int *v);
+  inline friend adouble erf(const adouble &a);
+  inline friend adouble erfc(const adouble &a);
+
+  inline friend void condassign(adouble &res, const adouble &cond,
+                                const adouble &arg1, const adouble &arg2);
+  inline friend void condassign(adouble &res, const adouble &cond,
+                                const adouble &arg);
+  inline friend void condeqassign(adouble &res, const adouble &cond,
+                                  const adouble &arg1, const adouble &arg2);
+  inline friend void condeqassign(adouble &res, const adouble &cond,
+                                  const adouble &arg);
+
+  /*******************  nontemporary results  ***************************/
+  // assignment
+  inline adouble &operator=(const double v);
+  inline adouble &operator=(const adouble &a);
+  inline adouble &operator=(adouble &&a) noexcept;
+
+  // addition
+  inline adouble &operator+=(const double v);
+  inline adouble &operator+=(const adouble &a);
+
+  // subtraction
+  inline adouble &operator-=(const double v);
+  inline adouble &operator-=(const adouble &a);
+
+  // multiplication
+  inline adouble &operator*=(const double v);
+  inline adouble &operator*=(const adouble &a);
+
+  // division
+  inline adouble &operator/=(const double v);
+  inline adouble &operator/=(const adouble &a);
+
+  // not
+  inline bool operator!() const;
+
+  // comparison
+  inline bool operator!=(const adouble &) const;
+  inline bool operator!=(const double) const;
+  inline friend bool operator!=(const double, const adouble &);
+
+  inline bool operator==(const adouble &) const;
+  inline bool operator==(const double) const;
+  inline friend bool operator==(const double, const adouble &);
+
+  inline bool operator<=(const adouble &) const;
+  inline bool operator<=(const double) const;
+  inline friend bool operator<=(const double, const adouble &);
+
+  inline bool operator>=(const adouble &) const;
+  inline bool operator>=(const double) const;
+  inline friend bool operator>=(const double, const adouble &);
+
+  inline bool operator>(const adouble &) const;
+  inline bool operator>(const double) const;
+  inline friend bool operator>(const double, const adouble &);
+
+  inline bool operator<(const adouble &) const;
+  inline bool operator<(const double) const;
+  inline friend bool operator<(const double, const adouble &);
+
+  /*******************  getter / setter  ********************************/
+  inline double getValue() const;
+  inline void setValue(const double v);
+  /* switches to dense storage */
+  inline const double *getADValue() const;
+  inline void setADValue(const double *v);
+
+  inline double getADValue(const unsigned int p) const;
+  inline void setADValue(const unsigned int p, const double v);
+  inline explicit operator double const &() const;
+  inline explicit operator double &&();
+  inline explicit operator double();
+
+  /* stored directions: the first getNumNonzeros() entries of
+   * getADIndices() and getADNonzeros(), or all numDir directions of
+   * getADNonzeros() if isDense() */
+  inline bool isDense() const;
+  inline size_t getNumNonzeros() const;
+  inline const unsigned int *getADIndices() const;
+  inline const double *getADNonzeros() const;
+
+public:
+  /*******************  i/o operations  *********************************/
+  ADOLC_DLL_EXPORT friend std::ostream &operator<<(std::ostream &,
+                                                   const adouble &);
+  ADOLC_DLL_EXPORT friend std::istream &operator>>(std::istream &, adouble &);
+
+private:
+  inline void allocSparse(size_t c);
+  inline void allocDense();
+  inline void release();
+  inline void densify() const;
+  inline void copyDerivatives(const adouble &a);
+  inline void scaleDerivatives(const double s);
+  inline void divideDerivatives(const double s);
+  inline static size_t denseLimit();
+  inline static adouble chain(const double v, const double d,
+                              const adouble &a);
+  inline static adouble quotient(const double v, const adouble &a,
+                                 const double d);
+  inline static adouble combine(const double v, const double alpha,
+                                const adouble &a, const double beta,
+                                const adouble &b);
+  inline static adouble elementwise(const double v, const adouble &a,
+                                    const adouble &b,
+                                    double (*f)(double, double));
+
+  double val;
+  /* dense: adv holds numDir values and ind is NULL; sparse: nnz pairs of
+   * ind and adv, sorted by direction, in one pool block of cap pairs */
+  mutable size_t nnz;
+  mutable size_t cap;
+  mutable unsigned int *ind;
+  mutable double *adv;
+
+  ADOLC_DLL_EXPIMP static size_t numDir;
+  ADOLC_DLL_EXPIMP static double denseThreshold;
+  inline friend void setNumDir(const size_t p);
+  inline friend size_t getNumDir();
+  inline friend void setDenseThreshold(const double t);
+  inline friend double getDenseThreshold();
+};
+
+inline void setNumDir(const size_t p) {
+  if (p < 1) {
+    fprintf(DIAG_OUT, "ADOL-C Error: Traceless: p < 1 not possible\n");
+    abort();
+  }
+  adouble::numDir = p;
+}
+
+inline size_t getNumDir() { return adouble::numDir; }
+
+/* fraction of numDir above which derivatives are stored densely */
+inline void setDenseThreshold(const double t) { adouble::denseThreshold = t; }
+
+inline double getDenseThreshold() { return adouble::denseThreshold; }
+
+inline double makeNaN() { return std::numeric_limits<double>::quiet_NaN(); }
+
+inline double makeInf() { return std::numeric_limits<double>::infinity(); }
+
+/*******************************  storage  **********************************/
+inline size_t adouble::denseLimit() {
+  const size_t limit = static_cast<size_t>(denseThreshold * numDir);
+  return limit < 1 ? 1 : limit;
+}
+
+inline bool adouble::isDense() const { return ind == NULL && adv != NULL; }
+
+inline void adouble::allocSparse(size_t c) {
+  cap = c;
+  nnz = 0;
+  /* c doubles followed by c indices */
+  adv = adtl::poolMallocDoubles(c + (c * sizeof(unsigned int) + 7) / 8);
+  ind = reinterpret_cast<unsigned int *>(adv + c);
+}
+
+inline void adouble::allocDense() {
+  cap = nnz = numDir;
+  adv = adtl::poolMallocDoubles(numDir);
+  ind = NULL;
+}
+
+inline void adouble::release() {
+  adtl::poolFree(adv);
+  adv = NULL;
+  ind = NULL;
+  nnz = cap = 0;
+}
+
+inline void adouble::densify() const {
+  if (isDense())
+    return;
+  double *d = adtl::poolMallocDoubles(numDir);
+  std::memset(d, 0, numDir * sizeof(double));
+  for (size_t k = 0; k < nnz; ++k)
+    d[ind[k]] = adv[k];
+  adtl::poolFree(adv);
+  adv = d;
+  ind = NULL;
+  cap = nnz = numDir;
+}
+
+inline void adouble::copyDerivatives(const adouble &a) {
+  if (a.isDense()) {
+    if (!isDense()) {
+      release();
+      allocDense();
+    }
+  } else if (isDense() || cap < a.nnz) {
+    release();
+    if (a.nnz > 0)
+      allocSparse(a.nnz);
+  }
+  if (a.nnz > 0) {
+    std::memcpy(adv, a.adv, a.nnz * sizeof(double));
+    if (!a.isDense())
+      std::memcpy(ind, a.ind, a.nnz * sizeof(unsigned int));
+  }
+  nnz = a.nnz;
+}
+
+inline void adouble::scaleDerivatives(const double s) {
+  adtl::fovScale(nnz, adv, s, adv);
+}
+
+inline void adouble::divideDerivatives(const double s) {
+  adtl::fovDiv(nnz, adv, adv, s);
+}
+
+/* value v and derivatives d * a' */
+inline adouble adouble::chain(const double v, const double d,
+                              const adouble &a) {
+  adouble tmp(a);
+  tmp.val = v;
+  tmp.scaleDerivatives(d);
+  return tmp;
+}
+
+/* value v and derivatives a' / d */
+inline adouble adouble::quotient(const double v, const adouble &a,
+                                 const double d) {
+  adouble tmp(a);
+  tmp.val = v;
+  tmp.divideDerivatives(d);
+  return tmp;
+}
+
+/* value v and derivatives alpha * a' + beta * b' */
+inline adouble adouble::combine(const double v, const double alpha,
+                                const adouble &a, const double beta,
+                                const adouble &b) {
+  adouble tmp;
+  tmp.val = v;
+  if (a.isDense() || b.isDense()) {
+    tmp.allocDense();
+    if (a.isDense())
+      adtl::fovScale(numDir, tmp.adv, alpha, a.adv);
+    else {
+      std::memset(tmp.adv, 0, numDir * sizeof(double));
+      for (size_t k = 0; k < a.nnz; ++k)
+        tmp.adv[a.ind[k]] = alpha * a.adv[k];
+    }
+    if (b.isDense())
+      adtl::fovAxpy(numDir, tmp.adv, beta, b.adv);
+    else
+      for (size_t k = 0; k < b.nnz; ++k)
+        tmp.adv[b.ind[k]] += beta * b.adv[k];
+    return tmp;
+  }
+  if (a.nnz + b.nnz == 0)
+    return tmp;
+  tmp.allocSparse(a.nnz + b.nnz);
+  size_t i = 0, j = 0, k = 0;
+  while (i < a.nnz && j < b.nnz) {
+    if (a.ind[i] < b.ind[j]) {
+      tmp.ind[k] = a.ind[i];
+      tmp.adv[k++] = alpha * a.adv[i++];
+    } else if (b.ind[j] < a.ind[i]) {
+      tmp.ind[k] = b.ind[j];
+      tmp.adv[k++] = beta * b.adv[j++];
+    } else {
+      tmp.ind[k] = a.ind[i];
+      tmp.adv[k++] = alpha * a.adv[i++] + beta * b.adv[j++];
+    }
+  }
+  for (; i < a.nnz; ++i, ++k) {
+    tmp.ind[k] = a.ind[i];
+    tmp.adv[k] = alpha * a.adv[i];
+  }
+  for (; j < b.nnz; ++j, ++k) {
+    tmp.ind[k] = b.ind[j];
+    tmp.adv[k] = beta * b.adv[j];
+  }
+  tmp.nnz = k;
+  if (k > denseLimit())
+    tmp.densify();
+  return tmp;
+}
+
+/* value v and derivatives f(a'_i, b'_i); f(0, 0) must be 0 */
+inline adouble adouble::elementwise(const double v, const adouble &a,
+                                    const adouble &b,
+                                    double (*f)(double, double)) {
+  adouble tmp = combine(v, 1.0, a, 0.0, b);
+  if (tmp.isDense())
+    for (size_t i = 0; i < numDir; ++i)
+      tmp.adv[i] = f(a.getADValue(i), b.getADValue(i));
+  else
+    for (size_t k = 0; k < tmp.nnz; ++k)
+      tmp.adv[k] = f(a.getADValue(tmp.ind[k]), b.getADValue(tmp.ind[k]));
+  return tmp;
+}
+
+/*******************************  ctors  ************************************/
+inline adouble::adouble() : val(0.), nnz(0), cap(0), ind(NULL), adv(NULL) {}
+
+inline adouble::adouble(const double v)
+    : val(v), nnz(0), cap(0), ind(NULL), adv(NULL) {}
+
+inline adouble::adouble(const double v, const double *adv)
+    : val(v), nnz(0), cap(0), ind(NULL), adv(NULL) {
+  setADValue(adv);
+}
+
+inline adouble::adouble(const adouble &a)
+    : val(a.val), nnz(0), cap(0), ind(NULL), adv(NULL) {
+  copyDerivatives(a);
+}
+
+inline adouble::adouble(adouble &&a) noexcept
+    : val(a.val), nnz(a.nnz), cap(a.cap), ind(a.ind), adv(a.adv) {
+  a.nnz = a.cap = 0;
+  a.ind = NULL;
+  a.adv = NULL;
+}
+
+/*******************************  dtors  ************************************/
+inline adouble::~adouble() { adtl::poolFree(adv); }
+
+/*************************  temporary results  ******************************/
+// sign
+inline adouble adouble::operator-() const { return chain(-val, -1.0, *this); }
+
+inline adouble adouble::operator+() const { return *this; }
+
+// addition
+inline adouble adouble::operator+(const double v) const {
+  adouble tmp(*this);
+  tmp.val += v;
+  return tmp;
+}
+
+inline adouble adouble::operator+(const adouble &a) const {
+  return combine(val + a.val, 1.0, *this, 1.0, a);
+}
+
+inline adouble operator+(const double v, const adouble &a) {
+  adouble tmp(a);
+  tmp.val = v + a.val;
+  return tmp;
+}
+
+// subtraction
+inline adouble adouble::operator-(const double v) const {
+  adouble tmp(*this);
+  tmp.val -= v;
+  return tmp;
+}
+
+inline adouble adouble::operator-(const adouble &a) const {
+  return combine(val - a.val, 1.0, *this, -1.0, a);
+}
+
+inline adouble operator-(const double v, const adouble &a) {
+  return adouble::chain(v - a.val, -1.0, a);
+}
+
+// multiplication
+inline adouble adouble::operator*(const double v) const {
+  return chain(val * v, v, *this);
+}
+
+inline adouble adouble::operator*(const adouble &a) const {
+  return combine(val * a.val, a.val, *this, val, a);
+}
+
+inline adouble operator*(const double v, const adouble &a) {
+  return adouble::chain(v * a.val, v, a);
+}
+
+// division
+inline adouble adouble::operator/(const double v) const {
+  return quotient(val / v, *this, v);
+}
+
+inline adouble adouble::operator/(const adouble &a) const {
+  adouble tmp = combine(val / a.val, a.val, *this, -val, a);
+  tmp.divideDerivatives(a.val * a.val);
+  return tmp;
+}
+
+inline adouble operator/(const double v, const adouble &a) {
+  adouble tmp = adouble::chain(v / a.val, -v, a);
+  tmp.divideDerivatives(a.val * a.val);
+  return tmp;
+}
+
+// inc/dec
+inline adouble adouble::operator++() {
+  ++val;
+  return *this;
+}
+
+inline adouble adouble::operator++(int) {
+  adouble tmp(*this);
+  ++val;
+  return tmp;
+}
+
+inline adouble adouble::operator--() {
+  --val;
+  return *this;
+}
+
+inline adouble adouble::operator--(int) {
+  adouble tmp(*this);
+  --val;
+  return tmp;
+}
+
+// functions
+inline adouble tan(const adouble &a) {
+  double tmp2 = std::cos(a.val);
+  tmp2 *= tmp2;
+  return adouble::quotient(std::tan(a.val), a, tmp2);
+}
+
+inline adouble exp(const adouble &a) {
+  const double tmp2 = std::exp(a.val);
+  return adouble::chain(tmp2, tmp2, a);
+}
+
+/* Outside the domain the derivative of a zero direction is NaN as in adtl,
+ * so these results are dense. */
+inline adouble log(const adouble &a) {
+  if (a.val > 0)
+    return adouble::quotient(std::log(a.val), a, a.val);
+  adouble tmp(a);
+  tmp.val = std::log(a.val);
+  tmp.densify();
+  for (size_t i = 0; i < adouble::numDir; ++i)
+    if (a.val == 0 && tmp.adv[i] != 0.0)
+      tmp.adv[i] = (tmp.adv[i] < 0 ? -1 : 1) * makeInf();
+    else
+      tmp.adv[i] = makeNaN();
+  return tmp;
+}
+
+inline adouble sqrt(const adouble &a) {
+  const double tmp2 = std::sqrt(a.val);
+  if (a.val > 0)
+    return adouble::quotient(tmp2, a, tmp2 * 2);
+  adouble tmp(a);
+  tmp.val = tmp2;
+  tmp.densify();
+  for (size_t i = 0; i < adouble::numDir; ++i)
+    if (a.val == 0.0 && tmp.adv[i] != 0.0)
+      tmp.adv[i] = (tmp.adv[i] < 0 ? -1 : 1) * makeInf();
+    else
+      tmp.adv[i] = makeNaN();
+  return tmp;
+}
+
+inline adouble cbrt(const adouble &a) {
+  const double tmp2 = std::cbrt(a.val);
+  if (a.val != 0.0)
+    return adouble::quotient(tmp2, a, tmp2 * tmp2 * 3);
+  adouble tmp(a);
+  tmp.densify();
+  for (size_t i = 0; i < adouble::numDir; ++i)
+    if (tmp.adv[i] != 0.0)
+      tmp.adv[i] = (tmp.adv[i] < 0 ? -1 : 1) * makeInf();
+    else
+      tmp.adv[i] = makeNaN();
+  return tmp;
+}
+
+inline adouble sin(const adouble &a) {
+  return adouble::chain(std::sin(a.val), std::cos(a.val), a);
+}
+
+inline adouble cos(const adouble &a) {
+  return adouble::chain(std::cos(a.val), -std::sin(a.val), a);
+}
+
+inline adouble asin(const adouble &a) {
+  return adouble::quotient(std::asin(a.val), a,
+                           std::sqrt(1 - a.val * a.val));
+}
+
+inline adouble acos(const adouble &a) {
+  return adouble::quotient(std::acos(a.val), a,
+                           -std::sqrt(1 - a.val * a.val));
+}
+
+inline adouble atan(const adouble &a) {
+  return adouble::chain(std::atan(a.val), 1 / (1 + a.val * a.val), a);
+}
+
+inline adouble atan2(const adouble &a, const adouble &b) {
+  const double tmp2 = a.val * a.val;
+  const double tmp3 = b.val * b.val;
+  const double tmp4 = tmp3 / (tmp2 + tmp3);
+  adouble tmp = adouble::combine(std::atan2(a.val, b.val), b.val, a, -a.val, b);
+  if (tmp4 != 0) {
+    tmp.divideDerivatives(tmp3);
+    tmp.scaleDerivatives(tmp4);
+  } else
+    tmp.scaleDerivatives(0.0);
+  return tmp;
+}
+
+inline adouble pow(const adouble &a, double v) {
+  return adouble::chain(std::pow(a.val, v), v * std::pow(a.val, v - 1), a);
+}
+
+inline adouble pow(const adouble &a, const adouble &b) {
+  const double tmp = std::pow(a.val, b.val);
+  const double tmp2 = b.val * std::pow(a.val, b.val - 1);
+  const double tmp3 = std::log(a.val) * tmp;
+  return adouble::combine(tmp, tmp2, a, tmp3, b);
+}
+
+inline adouble pow(double v, const adouble &a) {
+  const double tmp = std::pow(v, a.val);
+  return adouble::chain(tmp, tmp * std::log(v), a);
+}
+
+inline adouble log10(const adouble &a) {
+  return adouble::quotient(std::log10(a.val), a,
+                           std::log((double)10) * a.val);
+}
+
+inline adouble sinh(const adouble &a) {
+  return adouble::chain(std::sinh(a.val), std::cosh(a.val), a);
+}
+
+inline adouble cosh(const adouble &a) {
+  return adouble::chain(std::cosh(a.val), std::sinh(a.val), a);
+}
+
+inline adouble tanh(const adouble &a) {
+  double tmp2 = std::cosh(a.val);
+  tmp2 *= tmp2;
+  return adouble::quotient(std::tanh(a.val), a, tmp2);
+}
+
+inline adouble asinh(const adouble &a) {
+  return adouble::quotient(std::asinh(a.val), a,
+                           std::sqrt(a.val * a.val + 1));
+}
+
+inline adouble acosh(const adouble &a) {
+  return adouble::quotient(std::acosh(a.val), a,
+                           std::sqrt(a.val * a.val - 1));
+}
+
+inline adouble atanh(const adouble &a) {
+  return adouble::quotient(std::atanh(a.val), a, 1 - a.val * a.val);
+}
+
+inline adouble fabs(const adouble &a) {
+  if (a.val != 0)
+    return adouble::chain(std::fabs(a.val), a.val > 0 ? 1.0 : -1.0, a);
+  adouble tmp(a);
+  for (size_t k = 0; k < tmp.nnz; ++k)
+    tmp.adv[k] = std::fabs(tmp.adv[k]);
+  return tmp;
+}
+
+inline adouble ceil(const adouble &a) { return adouble(std::ceil(a.val)); }
+
+inline adouble floor(const adouble &a) { return adouble(std::floor(a.val)); }
+
+inline adouble fmax(const adouble &a, const adouble &b) {
+  if (a.val < b.val)
+    return b;
+  if (a.val > b.val)
+    return a;
+  return adouble::elementwise(a.val, a, b, [](double x, double y) {
+    return x < y ? y : x;
+  });
+}
+
+inline adouble fmax(double v, const adouble &a) { return fmax(adouble(v), a); }
+
+inline adouble fmax(const adouble &a, double v) { return fmax(a, adouble(v)); }
+
+inline adouble fmin(const adouble &a, const adouble &b) {
+  if (a.val < b.val)
+    return a;
+  if (a.val > b.val)
+    return b;
+  return adouble::elementwise(b.val, a, b, [](double x, double y) {
+    return x < y ? x : y;
+  });
+}
+
+inline adouble fmin(double v, const adouble &a) { return fmin(adouble(v), a); }
+
+inline adouble fmin(const adouble &a, double v) { return fmin(a, adouble(v)); }
+
+inline adouble ldexp(const adouble &a, const adouble &b) {
+  return a * pow(2., b);
+}
+
+inline adouble ldexp(const adouble &a, const double v) {
+  return a * std::pow(2., v);
+}
+
+inline adouble ldexp(const double v, const adouble &a) {
+  return v * pow(2., a);
+}
+
+inline double frexp(const adouble &a, int *v) { return std::frexp(a.val, v); }
+
+inline adouble erf(const adouble &a) {
+  return adouble::chain(std::erf(a.val),
+                        2.0 / std::sqrt(std::acos(-1.0)) *
+                            std::exp(-a.val * a.val),
+                        a);
+}
+
+inline adouble erfc(const adouble &a) {
+  return adouble::chain(std::erfc(a.val),
+                        -2.0 / std::sqrt(std::acos(-1.0)) *
+                            std::exp(-a.val * a.val),
+                        a);
+}
+
+inline void condassign(adouble &res, const adouble &cond, const adouble &arg1,
+                       const adouble &arg2) {
+  if (cond.getValue() > 0)
+    res = arg1;
+  else
+    res = arg2;
+}
+
+inline void condassign(adouble &res, const adouble &cond, const adouble &arg) {
+  if (cond.getValue() > 0)
+    res = arg;
+}
+
+inline void condeqassign(adouble &res, const adouble &cond, const adouble &arg1,
+                         const adouble &arg2) {
+  if (cond.getValue() >= 0)
+    res = arg1;
+  else
+    res = arg2;
+}
+
+inline void condeqassign(adouble &res, const adouble &cond,
+                         const adouble &arg) {
+  if (cond.getValue() >= 0)
+    res = arg;
+}
+
+/*******************  nontemporary results  *********************************/
+inline adouble &adouble::operator=(const double v) {
+  val = v;
+  if (isDense())
+    std::memset(adv, 0, numDir * sizeof(double));
+  else
+    nnz = 0;
+  return *this;
+}
+
+inline adouble &adouble::operator=(const adouble &a) {
+  if (this != &a) {
+    val = a.val;
+    copyDerivatives(a);
+  }
+  return *this;
+}
+
+inline adouble &adouble::operator=(adouble &&a) noexcept {
+  val = a.val;
+  std::swap(nnz, a.nnz);
+  std::swap(cap, a.cap);
+  std::swap(ind, a.ind);
+  std::swap(adv, a.adv);
+  return *this;
+}
+
+inline adouble &adouble::operator+=(const double v) {
+  val += v;
+  return *this;
+}
+
+inline adouble &adouble::operator+=(const adouble &a) {
+  if (isDense() && a.isDense()) {
+    val += a.val;
+    adtl::fovAdd(numDir, adv, adv, a.adv);
+    return *this;
+  }
+  return *this = *this + a;
+}
+
+inline adouble &adouble::operator-=(const double v) {
+  val -= v;
+  return *this;
+}
+
+inline adouble &adouble::operator-=(const adouble &a) {
+  if (isDense() && a.isDense()) {
+    val -= a.val;
+    adtl::fovSub(numDir, adv, adv, a.adv);
+    return *this;
+  }
+  return *this = *this - a;
+}
+
+inline adouble &adouble::operator*=(const double v) {
+  val *= v;
+  scaleDerivatives(v);
+  return *this;
+}
+
+inline adouble &adouble::operator*=(const adouble &a) {
+  return *this = *this * a;
+}
+
+inline adouble &adouble::operator/=(const double v) {
+  val /= v;
+  divideDerivatives(v);
+  return *this;
+}
+
+inline adouble &adouble::operator/=(const adouble &a) {
+  return *this = *this / a;
+}
+
+// not
+inline bool adouble::operator!() const { return val == 0.0; }
+
+// comparison
+inline bool adouble::operator!=(const adouble &a) const {
+  return val != a.val;
+}
+
+inline bool adouble::operator!=(const double v) const { return val != v; }
+
+inline bool operator!=(const double v, const adouble &a) { return v != a.val; }
+
+inline bool adouble::operator==(const adouble &a) const {
+  return val == a.val;
+}
+
+inline bool adouble::operator==(const double v) const { return val == v; }
+
+inline bool operator==(const double v, const adouble &a) { return v == a.val; }
+
+inline bool adouble::operator<=(const adouble &a) const {
+  return val <= a.val;
+}
+
+inline bool adouble::operator<=(const double v) const { return val <= v; }
+
+inline bool operator<=(const double v, const adouble &a) { return v <= a.val; }
+
+inline bool adouble::operator>=(const adouble &a) const {
+  return val >= a.val;
+}
+
+inline bool adouble::operator>=(const double v) const { return val >= v; }
+
+inline bool operator>=(const double v, const adouble &a) { return v >= a.val; }
+
+inline bool adouble::operator>(const adouble &a) const { return val > a.val; }
+
+inline bool adouble::operator>(const double v) const { return val > v; }
+
+inline bool operator>(const double v, const adouble &a) { return v > a.val; }
+
+inline bool adouble::operator<(const adouble &a) const { return val < a.val; }
+
+inline bool adouble::operator<(const double v) const { return val < v; }
+
+inline bool operator<(const double v, const adouble &a) { return v < a.val; }
+
+/*******************  getter / setter  **************************************/
+inline adouble::operator double const &() const { return val; }
+
+inline adouble::operator double &&() { return (double &&)val; }
+
+inline adouble::operator double() { return val; }
+
+inline double adouble::getValue() const { return val; }
+
+inline void adouble::setValue(const double v) { val = v; }
+
+inline const double *adouble::getADValue() const {
+  densify();
+  return adv;
+}
+
+inline void adouble::setADValue(const double *v) {
+  size_t count = 0;
+  for (size_t i = 0; i < numDir; ++i)
+    if (v[i] != 0.0)
+      ++count;
+  release();
+  if (count > denseLimit()) {
+    allocDense();
+    std::memcpy(adv, v, numDir * sizeof(double));
+  } else if (count > 0) {
+    allocSparse(count);
+    for (size_t i = 0; i < numDir; ++i)
+      if (v[i] != 0.0) {
+        ind[nnz] = i;
+        adv[nnz++] = v[i];
+      }
+  }
+}
+
+inline double adouble::getADValue(const unsigned int p) const {
+  if (p >= numDir) {
+    fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                      " while \"getADValue(...)\"!!!\n");
+    throw std::logic_error("incorrect function call, errorcode=-1");
+  }
+  if (isDense())
+    return adv[p];
+  const unsigned int *pos = std::lower_bound(ind, ind + nnz, p);
+  return (pos != ind + nnz && *pos == p) ? adv[pos - ind] : 0.0;
+}
+
+inline void adouble::setADValue(const unsigned int p, const double v) {
+  if (p >= numDir) {
+    fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                      " while \"setADValue(...)\"!!!\n");
+    throw std::logic_error("incorrect function call, errorcode=-1");
+  }
+  if (isDense()) {
+    adv[p] = v;
+    return;
+  }
+  const size_t k = std::lower_bound(ind, ind + nnz, p) - ind;
+  if (k < nnz && ind[k] == p) {
+    adv[k] = v;
+    return;
+  }
+  if (nnz + 1 > denseLimit()) {
+    densify();
+    adv[p] = v;
+    return;
+  }
+  if (nnz == cap) {
+    adouble grown;
+    grown.allocSparse(cap < 2 ? 4 : 2 * cap);
+    std::memcpy(grown.adv, adv, nnz * sizeof(double));
+    std::memcpy(grown.ind, ind, nnz * sizeof(unsigned int));
+    grown.nnz = nnz;
+    std::swap(nnz, grown.nnz);
+    std::swap(cap, grown.cap);
+    std::swap(ind, grown.ind);
+    std::swap(adv, grown.adv);
+  }
+  std::memmove(adv + k + 1, adv + k, (nnz - k) * sizeof(double));
+  std::memmove(ind + k + 1, ind + k, (nnz - k) * sizeof(unsigned int));
+  ind[k] = p;
+  adv[k] = v;
+  ++nnz;
+}
+
+inline size_t adouble::getNumNonzeros() const { return nnz; }
+
+inline const unsigned int *adouble::getADIndices() const { return ind; }
+
+inline const double *adouble::getADNonzeros() const { return adv; }
+
+} // namespace adtl_sparse
+#endif
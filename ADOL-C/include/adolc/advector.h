@@ -118,17 +118,18 @@ void condeqassign(adubref &res, const adouble &cond, const adouble &arg);
 class advector {
 public:
   ADOLC_DLL_EXPORT advector() = default;
-  ADOLC_DLL_EXPORT explicit advector(size_t n)
-      : data(ensureContiguousLocations_(n)) {}
+  // reserves the n contiguous locations of the elements at once
+  ADOLC_DLL_EXPORT explicit advector(size_t n);
 
-  advector(const advector &ad_vec)
-      : data(ensureContiguousLocations_(ad_vec.size())) {
-    adolc_vec_copy(data.data(), ad_vec.data.data(), ad_vec.size());
+  advector(const advector &ad_vec) : advector(ad_vec.size()) {
+    if (ad_vec.size() > 0)
+      adolc_vec_copy(data.data(), ad_vec.data.data(), ad_vec.size());
   }
 
   // given adouble vector might not have contiguous locations
   advector(const std::vector<adouble> &v) : data(v) {};
-  ADOLC_DLL_EXPORT ~advector() {}
+  // frees runs of contiguous element locations at once
+  ADOLC_DLL_EXPORT ~advector();
 
   operator const std::vector<adouble> &() const { return data; }
   ADOLC_DLL_EXPORT operator std::vector<adouble> &() { return data; }
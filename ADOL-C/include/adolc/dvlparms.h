@@ -36,8 +36,11 @@
 
 /*--------------------------------------------------------------------------*/
 /* TAPE IDENTIFICATION (ADOLC & version check) */
-#define statSpace 42
+#define statSpace 48
 /* NOTE: ADOLC_ID and stats must fit in statSpace locints required!         */
+/* Layout of the tape files, to be increased whenever the stats or the      */
+/* encoding of the tapes change                                             */
+#define ADOLC_TAPE_FORMAT 2
 
 /*--------------------------------------------------------------------------*/
 /* ADOL-C configuration (never change this) */
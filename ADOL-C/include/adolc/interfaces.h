@@ -22,6 +22,7 @@
                                  hov_reverse.cpp
                                  hos_ti_reverse.cpp
                                  hov_ti_reverse.cpp
+                 forward_batch.cpp
                  interfacesc.cpp
                  interfacesf.cpp
 
@@ -196,6 +197,11 @@ ADOLC_DLL_EXPORT int zos_forward_nk(short, int, int, const double *, double *);
 ADOLC_DLL_EXPORT int zos_forward_partx(short, int, int, int *, double **,
                                        double *);
 
+/* zos_forward_batch(tag, m, n, K, x[K][n], y[K][m])                        */
+/* (zos_forward at K base points in one sweep, defined in forward_batch.cpp) */
+ADOLC_DLL_EXPORT int zos_forward_batch(short, int, int, int, double **,
+                                       double **);
+
 /*--------------------------------------------------------------------------*/
 /*                                                                      FOS */
 /* fos_forward(tag, m, n, keep, x[n], X[n], y[m], Y[m])                     */
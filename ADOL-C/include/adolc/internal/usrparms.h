@@ -25,6 +25,15 @@
 #define LBUFSIZE 524288 /* 16384 or  65536  */
 #define VBUFSIZE 524288 /* 16384 or  65536  */
 
+/*--------------------------------------------------------------------------*/
+/* Adaptive buffer sizes: a tape recorded again with the default buffer     */
+/* sizes gets buffers fitting its previous recording, of at least           */
+/* ADAPTIVEBUFMIN and at most ADAPTIVEBUFMAX entries. Larger tapes keep the */
+/* default sizes, ADAPTIVEBUFMAX 0 disables the adaptation; may be          */
+/* overwritten by "ADAPTIVEBUFMAX" in .adolcrc                              */
+#define ADAPTIVEBUFMIN 4096
+#define ADAPTIVEBUFMAX 2097152
+
 /*--------------------------------------------------------------------------*/
 /* Buffer size for temporary Taylor store */
 #define TBUFSIZE 524288 /* 16384 or  65536  */
@@ -33,6 +42,12 @@
 /* Number of temporary Taylor stores*/
 #define TBUFNUM 32
 
+/*--------------------------------------------------------------------------*/
+/* Memory ceiling (bytes) of the arena shared by all Taylor stacks. Blocks  */
+/* beyond it are written to the Taylor files in background; may be          */
+/* overwritten by "TAYLORARENASIZE" in .adolcrc                             */
+#define TAYLORARENASIZE 268435456
+
 /*--------------------------------------------------------------------------*/
 /* Data types used by Fortran callable versions of functions */
 #define fint long
@@ -67,5 +82,41 @@
 /* fread  --- power of 2 > 8 preferable ;-) ---                             */
 #define ADOLC_IO_CHUNK_SIZE 1073741824
 
+/*--------------------------------------------------------------------------*/
+/* Default combination of TapeIOFlags (see taping.h) for new tapes, may be  */
+/* overwritten by "TAPEIO" in .adolcrc or per tape in trace_on              */
+#define TAPEIO 0
+
+/*--------------------------------------------------------------------------*/
+/* Memory budget (bytes) of the tape pool, which keeps tapes in core across */
+/* sweeps and evicts the least recently used ones to disk, 0 disables the   */
+/* pool; may be overwritten by "TAPEPOOLSIZE" in .adolcrc                   */
+#define TAPEPOOLSIZE 0
+
+/*--------------------------------------------------------------------------*/
+/* Number of threads sharing the directions of fov_forward and fov_reverse  */
+/* over tapes taped with ADOLC_TAPE_IO_PARALLEL, 0 uses one thread per      */
+/* core; may be overwritten by "SWEEPTHREADS" in .adolcrc                   */
+#define SWEEPTHREADS 0
+
+/*--------------------------------------------------------------------------*/
+/* Command compiling the C source of a tape to a shared object for          */
+/* ADOLC_TAPE_IO_NATIVE, followed by -o <object> <source>. It is split at   */
+/* blanks and run without a shell; may be overwritten by "NATIVE_CC" in     */
+/* .adolcrc                                                                 */
+#define NATIVECC "cc -O1 -fPIC -shared -ffp-contract=off"
+
+/*--------------------------------------------------------------------------*/
+/* Directory of the shared objects compiled for ADOLC_TAPE_IO_NATIVE, which */
+/* is created with mode 0700 and has to be private to the user; empty       */
+/* leaves the tapes to the switch. May be overwritten by "NATIVE_DIR" in    */
+/* .adolcrc or setNativeDir()                                               */
+#define NATIVEDIR ""
+
+/*--------------------------------------------------------------------------*/
+/* Number of buffers per tape stream used for writing tapes in background   */
+/* (ADOLC_TAPE_IO_ASYNC), at least 2                                        */
+#define TAPEIOBUFNUM 2
+
 /*--------------------------------------------------------------------------*/
 #endif
@@ -70,7 +70,10 @@
 #endif
 #endif
 #include <adolc/internal/adolc_settings.h>
+#include <cstdint>
 #include <forward_list>
+#include <limits>
+#include <vector>
 
 #if USE_BOOST_POOL
 #include <boost/pool/pool_alloc.hpp>
@@ -97,6 +100,10 @@ public:
   virtual locint next_loc() = 0;
   virtual void free_loc(locint) = 0;
   virtual void ensure_block(size_t n) = 0;
+  // reserves n contiguous locations at once and returns the first one
+  virtual locint next_loc_block(size_t n) = 0;
+  // frees n contiguous locations starting at loc at once
+  virtual void free_loc_block(locint loc, size_t n) = 0;
   void setStoreManagerControl(double gcTriggerRatio, size_t gcTriggerMaxSize) {
     myGcTriggerRatio = gcTriggerRatio;
     myGcTriggerMaxSize = gcTriggerMaxSize;
@@ -149,6 +156,8 @@ public:
   virtual locint next_loc();
   virtual void free_loc(locint loc);
   virtual void ensure_block(size_t n);
+  virtual locint next_loc_block(size_t n);
+  virtual void free_loc_block(locint loc, size_t n);
 };
 
 class StoreManagerLocintBlock : public StoreManager {
@@ -212,6 +221,82 @@ public:
   virtual locint next_loc();
   virtual void free_loc(locint loc);
   virtual void ensure_block(size_t n);
+  virtual locint next_loc_block(size_t n);
+  virtual void free_loc_block(locint loc, size_t n);
+};
+
+/* StoreManagerLocintSegregated keeps free locations in bins of size classes
+ * 2^k <= size < 2^(k+1) together with a bitmap of all free locations. Single
+ * locations are taken from a current run of free locations, locations freed
+ * next to it extend it. Everything else goes to the bins without merging
+ * neighbours, the bitmap is only scanned for merged runs when a requested
+ * block is not found in the bins and locations were freed since the last
+ * scan. All operations but this coalescing and growing take constant time
+ * or time logarithmic in the number of size classes.
+ */
+class StoreManagerLocintSegregated : public StoreManager {
+protected:
+  double *&storePtr;
+#if defined(ADOLC_TRACK_ACTIVITY)
+  char activityTracking;
+  static char const *const nowhere;
+  char *&actStorePtr;
+#endif
+  struct FreeBlock {
+    locint next; // first location
+    size_t size; // number of free locations
+  };
+  static const size_t numBins = std::numeric_limits<size_t>::digits;
+
+  // bins[k] holds free blocks of 2^k <= size < 2^(k+1) locations
+  std::vector<struct FreeBlock> bins[numBins];
+  // bit k set iff bins[k] is not empty
+  size_t nonEmptyBins;
+  // one bit per location of the store, set iff the location is free
+  std::vector<uint64_t> freeBits;
+  // free locations handed out next
+  struct FreeBlock run;
+  // locations were freed since the last coalescing
+  bool freedSinceCoalesce;
+  size_t &maxsize;
+  size_t &currentfill;
+
+  static size_t binOf(size_t size);
+  void markFree(size_t loc, size_t n, bool isFree);
+  size_t findBit(size_t from, bool isFree) const;
+  void pushBlock(locint next, size_t size);
+  bool popBlock(size_t n, struct FreeBlock &block);
+  void retireRun();
+  void coalesce();
+  virtual void grow(size_t minGrow = 0);
+
+public:
+#if defined(ADOLC_TRACK_ACTIVITY)
+  StoreManagerLocintSegregated(double *&storePtr, char *&actStorePtr,
+                               size_t &size, size_t &numlives);
+  StoreManagerLocintSegregated(const StoreManagerLocintSegregated *const stm,
+                               double *&storePtr, char *&actStorePtr,
+                               size_t &size, size_t &numLives);
+#endif
+  StoreManagerLocintSegregated(double *&storePtr, size_t &size,
+                               size_t &numlives);
+  StoreManagerLocintSegregated(const StoreManagerLocintSegregated *const stm,
+                               double *&storePtr, size_t &size,
+                               size_t &numLives);
+
+  virtual ~StoreManagerLocintSegregated();
+  virtual inline size_t size() const { return currentfill; }
+
+  virtual inline size_t maxSize() const { return maxsize; }
+  virtual inline unsigned char storeType() const {
+    return ADOLC_LOCATION_SEGREGATED;
+  }
+
+  virtual locint next_loc();
+  virtual void free_loc(locint loc);
+  virtual void ensure_block(size_t n);
+  virtual locint next_loc_block(size_t n);
+  virtual void free_loc_block(locint loc, size_t n);
 };
 
 #if 0
@@ -312,6 +397,19 @@ private:
 };
 #endif /* 0 */
 
+// memory of location stores, private to their thread
+double *allocStore(size_t n);
+void freeStore(double *store);
+// keeps the first n entries of store until releaseStoreSnapshot, copies of
+// store then map them copy-on-write; returns the bytes written, 0 if the
+// store is left to be copied
+size_t snapshotStore(const double *store, size_t n);
+void releaseStoreSnapshot();
+// copy of the first n entries of store, copiedBytes are copied eagerly
+double *copyStore(const double *store, size_t n, size_t &copiedBytes);
+// bytes of the copy-on-write copy store of n entries written to so far
+size_t storeBytesWritten(const double *store, size_t n);
+
 void ensureContiguousLocations(size_t n);
 size_t ensureContiguousLocations_(size_t n);
 #endif /* ADOL_C__STOREMANAGER_H */
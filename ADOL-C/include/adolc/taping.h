@@ -39,14 +39,42 @@ enum StatEntries {
   NO_MIN_MAX,   /* no use of min_op, deferred to abs_op for piecewise stuff */
   NUM_SWITCHES, /* # of abs calls that can switch branch */
   NUM_PARAM, /* no of parameters (doubles) interchangeable without retaping */
-  STAT_SIZE  /* represents the size of the stats vector */
+  OP_FILE_INDEX,  /* offset of the block index in a compressed ops file */
+  LOC_FILE_INDEX, /* offset of the block index in a compressed locs file */
+  VAL_FILE_INDEX, /* offset of the block index in a compressed vals file */
+  FILE_CONTAINER, /* all streams stored in the locations file or not */
+  STAT_SIZE       /* represents the size of the stats vector */
 };
 
 enum TapeRemovalType { ADOLC_REMOVE_FROM_CORE, ADOLC_REMOVE_COMPLETELY };
 
+/* Storage options for the operations, locations and values tapes. A default
+ * is read from .adolcrc, a tape specific choice can be passed to trace_on. */
+enum TapeIOFlags {
+  ADOLC_TAPE_IO_DEFAULT = -1,   /* use the default set in .adolcrc */
+  ADOLC_TAPE_IO_STDIO = 0,      /* read/write tape blocks via fread/fwrite */
+  ADOLC_TAPE_IO_MMAP = 1,       /* map tape files read-only during sweeps */
+  ADOLC_TAPE_IO_ASYNC = 2,      /* write tape blocks in a background thread */
+  ADOLC_TAPE_IO_PREFETCH = 4,   /* read the next tape block ahead in sweeps */
+  ADOLC_TAPE_IO_COMPRESS = 8,   /* compress the blocks written to disk */
+  ADOLC_TAPE_IO_CONTAINER = 16, /* store a tape in a single file */
+  ADOLC_TAPE_IO_PACKED = 32,    /* keep packed operation records in core */
+  ADOLC_TAPE_IO_NARROW = 64,    /* store locations below 65536 in 16 bits */
+  ADOLC_TAPE_IO_COMPACT = 128,  /* renumber locations of tapes kept in core */
+  ADOLC_TAPE_IO_THREADED = 256, /* run zos/fos_forward of tapes kept in core
+                                   as threaded code */
+  ADOLC_TAPE_IO_NATIVE = 512,   /* compile tapes kept in core to native code
+                                   for zos/fos/fov_forward, fos/fov_reverse
+                                   in setNativeDir */
+  ADOLC_TAPE_IO_PARALLEL = 1024 /* split the directions of fov_forward and
+                                   fov_reverse of tapes kept in core across
+                                   threads */
+};
+
 enum LocationMgrType {
-  ADOLC_LOCATION_BLOCKS,    /* can allocate contiguous location blocks */
-  ADOLC_LOCATION_SINGLETONS /* only singleton locations, no blocks */
+  ADOLC_LOCATION_BLOCKS,     /* can allocate contiguous location blocks */
+  ADOLC_LOCATION_SINGLETONS, /* only singleton locations, no blocks */
+  ADOLC_LOCATION_SEGREGATED  /* location blocks in segregated size classes */
 };
 
 ADOLC_DLL_EXPORT void skip_tracefile_cleanup(short tnum);
@@ -78,6 +106,34 @@ ADOLC_DLL_EXPORT void cleanUp();
 
 ADOLC_DLL_EXPORT int removeTape(short tapeID, short type);
 
+/* Sets the memory budget (bytes) of the tape pool. The pool keeps complete
+ * tapes in core across sweeps, tapes written to disk are read in full on
+ * their first sweep. If the budget is exceeded, the least recently used
+ * tapes are written to disk and dropped from core. 0 disables the pool. */
+ADOLC_DLL_EXPORT void setTapePoolSize(size_t bytes);
+
+/* Sets the largest buffer size (# of entries) chosen by adaptive sizing.
+ * A tape recorded again by trace_on without explicit buffer sizes gets
+ * operations, locations and values buffers fitting its previous recording,
+ * if they stay below this limit. 0 disables the adaptive sizing. */
+ADOLC_DLL_EXPORT void setAdaptiveBufferSize(size_t maxEntries);
+
+/* Sets the memory ceiling (bytes) of the arena holding the taylor stacks
+ * written by forward sweeps with keep. Beyond it, the oldest blocks of a
+ * stack are written to its taylor file in background. */
+ADOLC_DLL_EXPORT void setTaylorArenaSize(size_t bytes);
+
+/* Sets the number of threads sharing the directions of fov_forward and
+ * fov_reverse over tapes taped with ADOLC_TAPE_IO_PARALLEL, 0 uses one
+ * thread per core. */
+ADOLC_DLL_EXPORT void setSweepThreads(int numThreads);
+
+/* Sets the directory of the shared objects compiled from tapes taped with
+ * ADOLC_TAPE_IO_NATIVE, which is created with mode 0700 if missing. It has
+ * to be private to the user, otherwise, or if it is empty as by default,
+ * the tapes are swept by the switch. */
+ADOLC_DLL_EXPORT void setNativeDir(const char *dir);
+
 ADOLC_DLL_EXPORT void enableBranchSwitchWarnings();
 ADOLC_DLL_EXPORT void disableBranchSwitchWarnings();
 
@@ -119,10 +175,12 @@ ADOLC_DLL_EXPORT int trace_on(short tnum, int keepTaylors = 0);
  *      lbs - size of the location buffer (number of elements)
  *      vbs - size of the value buffer (number of elements)
  *      tbs - size of the taylor buffer (number of elements)
+ *      tapeIOFlags - combination of TapeIOFlags used for this tape
  * trace_on is the last point in time we want to allow the change of buffer
  * sizes for a given tape */
 ADOLC_DLL_EXPORT int trace_on(short tnum, int keepTaylors, uint obs, uint lbs,
-                              uint vbs, uint tbs, int skipFileCleanup = 0);
+                              uint vbs, uint tbs, int skipFileCleanup = 0,
+                              int tapeIOFlags = ADOLC_TAPE_IO_DEFAULT);
 
 /* Stop Tracing. Cleans up, and turns off trace_flag. Flag not equal zero
  * enforces writing of the three main tape files (op+loc+val). */
@@ -54,6 +54,8 @@ typedef struct {
   short locint_size;
   short revreal_size;
   short address_size;
+  short tape_format; /* layout of the tape files, ADOLC_TAPE_FORMAT */
+  short stat_size;   /* number of stats following, STAT_SIZE */
 } ADOLC_ID;
 
 extern ADOLC_ID adolc_id;
@@ -74,6 +76,7 @@ enum ADOLC_ERRORS {
   ADOLC_VALUE_TAPE_FREAD_FAILED,
   ADOLC_TAPE_TO_OLD,
   ADOLC_WRONG_LOCINT_SIZE,
+  ADOLC_WRONG_TAPE_FORMAT,
   ADOLC_MORE_STAT_SPACE_REQUIRED,
 
   ADOLC_TAPING_BUFFER_ALLOCATION_FAILED,
@@ -196,6 +199,14 @@ typedef struct PersistantTapeInfos { /* survive tape re-usage */
    */
   int skipFileCleanup;
 
+  /* combination of TapeIOFlags chosen at taping time */
+  int tapeIOFlags;
+
+  /* counters of the block reads of all sweeps (see printTapeStats) */
+  size_t numBlocksLoaded;     /* blocks read from tape files */
+  size_t numBlocksPrefetched; /* thereof read ahead (ADOLC_TAPE_IO_PREFETCH) */
+  double prefetchWaitTime;    /* time spent waiting for read ahead blocks */
+
   revreal *paramstore;
 #ifdef __cplusplus
   PersistantTapeInfos();
@@ -241,8 +252,34 @@ typedef struct TapeInfos {
   locint *lastLocP1;
   size_t numLocs_Tape;
 
+  /* read-only mappings of the tape files (ADOLC_TAPE_IO_MMAP), the buffer
+   * pointers above then point into these mappings during a sweep */
+  unsigned char *op_map;
+  size_t op_mapSize;
+  locint *loc_map;
+  size_t loc_mapSize;
+  double *val_map;
+  size_t val_mapSize;
+  char mapsInPool; /* == 1 if the maps are copies kept by the tape pool */
+
+  /* background writer of full tape blocks (ADOLC_TAPE_IO_ASYNC) */
+  struct TapeWriter *tapeWriter;
+  /* read ahead of tape blocks in sweeps (ADOLC_TAPE_IO_PREFETCH) */
+  struct TapePrefetcher *tapePrefetcher;
+  /* file offsets of the blocks of compressed tapes (ADOLC_TAPE_IO_COMPRESS) */
+  struct TapeBlockIndex *blockIndex;
+  /* operations packed into records in core (ADOLC_TAPE_IO_PACKED) */
+  struct TapeRecords *records;
+  uint64_t *currRec; /* record position of a sweep, nullptr if the sweep
+                        reads the operations, locations and values tapes */
+  /* decoded operations for threaded sweeps (ADOLC_TAPE_IO_THREADED) */
+  struct ThreadedTape *threaded;
+  /* tape compiled to native code (ADOLC_TAPE_IO_NATIVE) */
+  struct NativeTape *native;
+
   /* taylor stack tape */
   FILE *tay_file;
+  struct TaylorStack *taylorStack; /* full blocks of the taylor buffer */
   revreal *tayBuffer;
   revreal *currTay;
   revreal *lastTayP1;
@@ -315,6 +352,11 @@ typedef struct GlobalTapeVarsCL {
   locint valueBufferSize;     /* in a local config file .adolcrc. */
   locint taylorBufferSize;
   int maxNumberTaylorBuffers;
+  int tapeIOFlags;     /* default TapeIOFlags for new tapes */
+  size_t tapePoolSize; /* memory budget of the tape pool in bytes */
+  size_t maxAdaptiveBufferSize; /* limit of adaptive buffer sizes */
+  size_t taylorArenaSize;       /* memory ceiling of the taylor stacks */
+  int sweepThreads; /* threads of the parallel fov sweeps, 0 for all cores */
 
   char inParallelRegion; /* set to 1 if in an OpenMP parallel region */
   char newTape;          /* signals: at least one tape created (0/1) */
@@ -325,6 +367,9 @@ typedef struct GlobalTapeVarsCL {
   size_t maxparam;
   double *pStore;
   size_t initialStoreSize;
+  size_t storeCopyBytes; /* bytes of the serial store copied eagerly */
+  double *storeView;     /* copy-on-write copy of the serial store */
+  size_t storeViewSize;  /* number of entries of storeView */
 #ifdef __cplusplus
   StoreManager *paramStoreMgrPtr;
   StoreManager *storeManagerPtr;
@@ -444,6 +489,12 @@ locint next_loc();
 void free_loc(locint loc);
 /* frees the specified location in "adouble" memory */
 
+locint next_loc_block(size_t n);
+/* returns the first of n contiguous free locations in "adouble" memory */
+
+void free_loc_block(locint loc, size_t n);
+/* frees n contiguous locations starting at loc in "adouble" memory */
+
 void taylor_begin(uint bufferSize, int degreeSave);
 /* set up statics for writing taylor data */
 
@@ -515,6 +566,9 @@ void get_taylors_p(locint loc, int degree, int numDir);
 void get_tay_block_r();
 /* gets the next (previous block) of the value stack */
 
+void releaseTaylorStack(TapeInfos *tapeInfos);
+/* frees the taylor stack blocks of a tape, waiting for pending writes */
+
 void initTapeBuffers();
 /* free/allocate memory for buffers, initialize pointers */
 
@@ -543,6 +597,82 @@ void init_rev_sweep(short tag);
 void end_sweep();
 /* finish a forward or reverse sweep */
 
+void unmapTapeFiles(TapeInfos *tapeInfos);
+/* release the tape file mappings of a sweep (ADOLC_TAPE_IO_MMAP) or the
+ * copies of the tape files kept by the tape pool */
+
+size_t tapeCoreSize(const TapeInfos *tapeInfos);
+/* bytes of the operations, locations and values of a tape held in core */
+
+void evictTape(TapeInfos *tapeInfos);
+/* write a tape held in core to disk and free its operations, locations
+ * and values, used by the tape pool */
+
+int reserveTapePool(size_t bytes);
+/* evict least recently used tapes until bytes more fit into the tape pool
+ * - returns 1 if they fit, 0 otherwise or if the tape pool is disabled */
+
+void flushTapeWriter(TapeInfos *tapeInfos);
+/* wait until all blocks queued by the background writer are written */
+
+void releaseTapeWriter(TapeInfos *tapeInfos);
+/* stop the background writer of a tape and free its spare buffers */
+
+void releaseTapePrefetcher(TapeInfos *tapeInfos);
+/* wait for outstanding read ahead of tape blocks and free its buffers */
+
+void releaseTapeBlockIndex(TapeInfos *tapeInfos);
+
+/* frees the packed records of a tape (ADOLC_TAPE_IO_PACKED) */
+void releaseTapeRecords(TapeInfos *tapeInfos);
+
+/* frees the decoded operations of a tape (ADOLC_TAPE_IO_THREADED) */
+void releaseThreadedTape(TapeInfos *tapeInfos);
+
+/* bytes of the decoded operations of a tape */
+size_t threadedTapeSize(const TapeInfos *tapeInfos);
+
+/* runs a zos_forward (dp_T == nullptr) or fos_forward sweep of the current
+ * tape as threaded code, returns 0 if the sweep is left to the switch */
+int threadedForward(double *dp_T0, double *dp_T, const double *basepoint,
+                    const double *argument, double *valuepoint,
+                    double *taylors);
+
+/* unloads the native code of a tape (ADOLC_TAPE_IO_NATIVE) */
+void releaseNativeTape(TapeInfos *tapeInfos);
+
+/* deletes the objects compiled from the native code of a tape */
+void removeNativeObjects(const TapeInfos *tapeInfos);
+
+/* bytes of the work arrays of the native code of a tape */
+size_t nativeTapeSize(const TapeInfos *tapeInfos);
+
+/* run a sweep of the current tape as native code, return 0 if the sweep is
+ * left to the switch; dp_T0, dp_T and dpp_T are the work arrays of the
+ * sweep */
+int nativeZosForward(const double *basepoint, double *valuepoint,
+                     double *dp_T0);
+int nativeFosForward(const double *basepoint, const double *argument,
+                     double *valuepoint, double *taylors, double *dp_T0,
+                     double *dp_T);
+int nativeFovForward(int p, const double *basepoint, double **argument,
+                     double *valuepoint, double **taylors, double *dp_T0,
+                     double **dpp_T);
+int nativeFosReverse(const double *lagrange, double *results);
+int nativeFovReverse(int q, double **lagrange, double **results);
+
+/* records the base point of a forward sweep keeping taylors for the native
+ * and parallel reverse sweeps, nullptr forgets it */
+void keepBasePoint(const double *basepoint);
+
+/* run fov_forward or fov_reverse over the current tape with the directions
+ * split across threads (ADOLC_TAPE_IO_PARALLEL), return 0 if the sweep is
+ * left to the switch */
+int parallelFovForward(int p, const double *basepoint, double **argument,
+                       double *valuepoint, double **taylors);
+int parallelFovReverse(int q, double **lagrange, double **results);
+/* free the block index of compressed tape files */
+
 void fail(int error);
 /* outputs an appropriate error message using DIAG_OUT and exits the running
  * program */
@@ -635,6 +765,47 @@ double make_nan();
 
 double make_inf();
 
+/*--------------------------------------------------------------------------*/
+/* Packed tape records (ADOLC_TAPE_IO_PACKED): each operation is stored as  */
+/* a sequence of 64 bit words, a head word holding the opcode (bits 0-7),   */
+/* the number of locations (bits 8-35) and the number of values (bits       */
+/* 36-63), the locations padded to full words, the values and a copy of the */
+/* head word to step back in reverse sweeps. Reading the opcode of a record */
+/* points currLoc and currVal into it, so that the locations and values are */
+/* read by the usual macros without any buffer boundaries.                  */
+#define ADOLC_RECORD_MAX_COUNT 0xFFFFFFFULL
+
+#ifdef __cplusplus
+inline size_t tapeRecordLocWords(uint64_t head) {
+  return (((head >> 8) & ADOLC_RECORD_MAX_COUNT) * sizeof(locint) + 7) / 8;
+}
+
+/* returns the opcode of the next record and steps over it */
+inline unsigned char nextTapeRecord(TapeInfos *tapeInfos) {
+  uint64_t *rec = tapeInfos->currRec;
+  const uint64_t head = *rec;
+
+  tapeInfos->currLoc = (locint *)(rec + 1);
+  tapeInfos->currVal = (double *)(rec + 1 + tapeRecordLocWords(head));
+  tapeInfos->currRec = (uint64_t *)(tapeInfos->currVal + (head >> 36)) + 1;
+  return (unsigned char)(head & 0xFF);
+}
+
+/* returns the opcode of the previous record and steps back over it, the
+ * locations and values are then read backwards from their ends */
+inline unsigned char prevTapeRecord(TapeInfos *tapeInfos) {
+  uint64_t *end = tapeInfos->currRec - 1;
+  const uint64_t head = *end;
+  uint64_t *rec = end - (head >> 36) - tapeRecordLocWords(head) - 1;
+
+  tapeInfos->currVal = (double *)end;
+  tapeInfos->currLoc =
+      (locint *)(rec + 1) + ((head >> 8) & ADOLC_RECORD_MAX_COUNT);
+  tapeInfos->currRec = rec;
+  return (unsigned char)(head & 0xFF);
+}
+#endif
+
 #if !defined(ADOLC_HARDDEBUG)
 /*--------------------------------------------------------------------------*/
 /*                                                        MACRO or FUNCTION
@@ -642,6 +813,11 @@ double make_inf();
 #define get_op_f() *ADOLC_CURRENT_TAPE_INFOS.currOp++
 #define get_op_r() *--ADOLC_CURRENT_TAPE_INFOS.currOp
 
+/* the operations of sweeps over packed records, a sweep reads them if
+ * currRec != nullptr after init_for_sweep or init_rev_sweep */
+#define get_rec_f() nextTapeRecord(&ADOLC_CURRENT_TAPE_INFOS)
+#define get_rec_r() prevTapeRecord(&ADOLC_CURRENT_TAPE_INFOS)
+
 #define get_locint_f() *ADOLC_CURRENT_TAPE_INFOS.currLoc++
 #define get_locint_r() *--ADOLC_CURRENT_TAPE_INFOS.currLoc
 
@@ -651,6 +827,9 @@ double make_inf();
 unsigned char get_op_f();
 unsigned char get_op_r();
 
+unsigned char get_rec_f();
+unsigned char get_rec_r();
+
 locint get_locint_f();
 locint get_locint_r();
 
@@ -690,6 +869,15 @@ void free_all_taping_params();
 
 END_C_DECLS
 
+#ifdef __cplusplus
+#include <string>
+
+/* the compiler command and the directory of the native code, "NATIVE_CC"
+ * and "NATIVE_DIR" in .adolcrc or setNativeDir */
+std::string &getNativeCompiler();
+std::string &getNativeDir();
+#endif
+
 /****************************************************************************/
 /* That's all                                                               */
 /****************************************************************************/
@@ -2270,6 +2270,87 @@ adouble operator-(const double coval, adouble &&a) {
   return a;
 }
 
+#if defined(ADOLC_PROD_SUM_TEMPLATES)
+void adolc_prod_sum(adouble &res, size_t numTerms,
+                    const adouble *const *factors, const int *signs,
+                    int increment) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  size_t first = numTerms;
+  double coval;
+  int sign;
+
+  /* an assigned sum starts with the product of its first positive term */
+  if (increment == 0)
+    for (size_t i = 0; i < numTerms && first == numTerms; ++i)
+      if (signs[i] > 0)
+        first = i;
+
+  /* no term may read the result, neither eq_plus_prod and eq_min_prod nor
+   * the mult_a_a of the first term, whose index domains would lose those of
+   * res. Sums using res are taped into a temporary */
+  for (size_t i = 0; i < numTerms; ++i)
+    if (factors[2 * i]->loc() == res.loc() ||
+        factors[2 * i + 1]->loc() == res.loc()) {
+      adouble tmp{tape_location{next_loc()}};
+      adolc_prod_sum(tmp, numTerms, factors, signs, 0);
+      if (increment > 0)
+        res += tmp;
+      else if (increment < 0)
+        res -= tmp;
+      else
+        res = tmp;
+      return;
+    }
+
+  coval = increment == 0 ? 0.0 : res.value();
+  if (first < numTerms) {
+    const adouble &a = *factors[2 * first];
+    const adouble &b = *factors[2 * first + 1];
+
+    if (ADOLC_CURRENT_TAPE_INFOS.traceFlag) {
+      put_op(mult_a_a);
+      ADOLC_PUT_LOCINT(a.loc());   // = arg1
+      ADOLC_PUT_LOCINT(b.loc());   // = arg2
+      ADOLC_PUT_LOCINT(res.loc()); // = res
+
+      ++ADOLC_CURRENT_TAPE_INFOS.numTays_Tape;
+      if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors)
+        ADOLC_WRITE_SCAYLOR(res.value());
+    }
+    coval = a.value() * b.value();
+  } else if (increment == 0 && ADOLC_CURRENT_TAPE_INFOS.traceFlag) {
+    put_op(assign_d_zero);
+    ADOLC_PUT_LOCINT(res.loc()); // = res
+
+    ++ADOLC_CURRENT_TAPE_INFOS.numTays_Tape;
+    if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors)
+      ADOLC_WRITE_SCAYLOR(res.value());
+  }
+
+  for (size_t i = 0; i < numTerms; ++i) {
+    if (i == first)
+      continue;
+    const adouble &a = *factors[2 * i];
+    const adouble &b = *factors[2 * i + 1];
+
+    sign = increment < 0 ? -signs[i] : signs[i];
+    if (ADOLC_CURRENT_TAPE_INFOS.traceFlag) {
+      put_op(sign > 0 ? eq_plus_prod : eq_min_prod);
+      ADOLC_PUT_LOCINT(a.loc());   // = arg1
+      ADOLC_PUT_LOCINT(b.loc());   // = arg2
+      ADOLC_PUT_LOCINT(res.loc()); // = res
+
+      ++ADOLC_CURRENT_TAPE_INFOS.num_eq_prod;
+    }
+    if (sign > 0)
+      coval += a.value() * b.value();
+    else
+      coval -= a.value() * b.value();
+  }
+  res.value(coval);
+}
+#else
 adouble operator*(const adouble &a, const adouble &b) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
@@ -2357,6 +2438,7 @@ adouble operator*(const adouble &a, const adouble &b) {
 #endif
   return ret_adouble;
 }
+#endif
 
 adouble operator*(adouble &&a, const adouble &b) {
   ADOLC_OPENMP_THREAD_NUMBER;
@@ -16,8 +16,11 @@ sparse patterns.
 ----------------------------------------------------------------------------*/
 
 #include <adolc/adtl_indo.h>
+#include <adolc/adtl_pool.h>
 #include <adolc/dvlparms.h>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
 
@@ -39,11 +42,254 @@ istream &operator>>(istream &in, adouble &a) {
   return in;
 }
 
+/*******************  index domains  ****************************************/
+namespace {
+
+inline unsigned int popcount64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(w);
+#else
+  unsigned int c = 0;
+  for (; w; w &= w - 1)
+    ++c;
+  return c;
+#endif
+}
+
+inline unsigned int ctz64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(w);
+#else
+  unsigned int c = 0;
+  for (; !(w & 1); w >>= 1)
+    ++c;
+  return c;
+#endif
+}
+
+inline unsigned int clz64(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(w);
+#else
+  unsigned int c = 0;
+  for (; !(w >> 63); w <<= 1)
+    ++c;
+  return c;
+#endif
+}
+
+/* the bitset takes no more memory than the sorted array */
+inline bool prefer_bits(size_t n, unsigned int lo, unsigned int hi) {
+  return (size_t)(hi / 64 - lo / 64 + 1) * 2 <= n;
+}
+
+inline unsigned int *alloc_indices(size_t n) {
+  return static_cast<unsigned int *>(
+      adtl::poolMalloc(n * sizeof(unsigned int)));
+}
+
+inline uint64_t *alloc_words(size_t n) {
+  uint64_t *w = static_cast<uint64_t *>(adtl::poolMalloc(n * sizeof(uint64_t)));
+  std::memset(w, 0, n * sizeof(uint64_t));
+  return w;
+}
+
+} // namespace
+
+void index_domain::release() {
+  if (kind == ARRAY)
+    adtl::poolFree(data.array.idx);
+  else if (kind == BITSET)
+    adtl::poolFree(data.bits.words);
+  kind = INLINE;
+}
+
+void index_domain::assign(const index_domain &d) {
+  release();
+  count = d.count;
+  kind = d.kind;
+  switch (kind) {
+  case INLINE:
+    std::memcpy(data.small, d.data.small, count * sizeof(unsigned int));
+    break;
+  case ARRAY:
+    data.array.cap = count;
+    data.array.idx = alloc_indices(count);
+    std::memcpy(data.array.idx, d.data.array.idx,
+                count * sizeof(unsigned int));
+    break;
+  case BITSET:
+    data.bits.first = d.data.bits.first;
+    data.bits.nwords = d.data.bits.nwords;
+    data.bits.words = static_cast<uint64_t *>(
+        adtl::poolMalloc(d.data.bits.nwords * sizeof(uint64_t)));
+    std::memcpy(data.bits.words, d.data.bits.words,
+                d.data.bits.nwords * sizeof(uint64_t));
+    break;
+  }
+}
+
+unsigned int index_domain::min_index() const {
+  if (kind != BITSET)
+    return sorted()[0];
+  return data.bits.first * 64 + ctz64(data.bits.words[0]);
+}
+
+unsigned int index_domain::max_index() const {
+  if (kind != BITSET)
+    return sorted()[count - 1];
+  const unsigned int last = data.bits.nwords - 1;
+  return (data.bits.first + last) * 64 + 63 - clz64(data.bits.words[last]);
+}
+
+void index_domain::insert(unsigned int i) {
+  index_domain single;
+  single.count = 1;
+  single.data.small[0] = i;
+  merge(single);
+}
+
+void index_domain::to_array(unsigned int *dst) const {
+  if (kind != BITSET) {
+    std::memcpy(dst, sorted(), count * sizeof(unsigned int));
+    return;
+  }
+  for (unsigned int j = 0; j < data.bits.nwords; ++j)
+    for (uint64_t w = data.bits.words[j]; w; w &= w - 1)
+      *dst++ = (data.bits.first + j) * 64 + ctz64(w);
+}
+
+/* The form is a function of the set, so equal sets have equal forms */
+bool index_domain::operator==(const index_domain &d) const {
+  if (count != d.count || kind != d.kind)
+    return false;
+  if (kind != BITSET)
+    return std::memcmp(sorted(), d.sorted(), count * sizeof(unsigned int)) ==
+           0;
+  return data.bits.first == d.data.bits.first &&
+         data.bits.nwords == d.data.bits.nwords &&
+         std::memcmp(data.bits.words, d.data.bits.words,
+                     data.bits.nwords * sizeof(uint64_t)) == 0;
+}
+
+void index_domain::adopt_sorted(unsigned int *idx, unsigned int n,
+                                unsigned int cap, bool owned) {
+  release();
+  count = n;
+  if (n <= ADTL_INDO_INLINE) {
+    std::memcpy(data.small, idx, n * sizeof(unsigned int));
+  } else if (prefer_bits(n, idx[0], idx[n - 1])) {
+    kind = BITSET;
+    data.bits.first = idx[0] / 64;
+    data.bits.nwords = idx[n - 1] / 64 - data.bits.first + 1;
+    data.bits.words = alloc_words(data.bits.nwords);
+    for (unsigned int k = 0; k < n; ++k)
+      data.bits.words[idx[k] / 64 - data.bits.first] |= uint64_t(1)
+                                                         << (idx[k] % 64);
+  } else {
+    kind = ARRAY;
+    if (owned) {
+      data.array.idx = idx;
+      data.array.cap = cap;
+      return;
+    }
+    data.array.idx = alloc_indices(n);
+    data.array.cap = n;
+    std::memcpy(data.array.idx, idx, n * sizeof(unsigned int));
+  }
+  if (owned)
+    adtl::poolFree(idx);
+}
+
+void index_domain::adopt_bits(uint64_t *w, unsigned int first,
+                              unsigned int nw, unsigned int n) {
+  if (prefer_bits(n, first * 64, (first + nw - 1) * 64)) {
+    release();
+    count = n;
+    kind = BITSET;
+    data.bits.words = w;
+    data.bits.first = first;
+    data.bits.nwords = nw;
+    return;
+  }
+  unsigned int *idx = alloc_indices(n);
+  unsigned int k = 0;
+  for (unsigned int j = 0; j < nw; ++j)
+    for (uint64_t b = w[j]; b; b &= b - 1)
+      idx[k++] = (first + j) * 64 + ctz64(b);
+  adtl::poolFree(w);
+  adopt_sorted(idx, n, n, true);
+}
+
+void index_domain::merge_sorted(const index_domain &d) {
+  unsigned int *tmp_a = NULL, *tmp_b = NULL;
+  const unsigned int *a = sorted(), *b = d.sorted();
+  if (kind == BITSET) {
+    tmp_a = alloc_indices(count);
+    to_array(tmp_a);
+    a = tmp_a;
+  }
+  if (d.kind == BITSET) {
+    tmp_b = alloc_indices(d.count);
+    d.to_array(tmp_b);
+    b = tmp_b;
+  }
+  const unsigned int cap = count + d.count;
+  unsigned int buf[2 * ADTL_INDO_INLINE];
+  unsigned int *r = cap <= 2 * ADTL_INDO_INLINE ? buf : alloc_indices(cap);
+  const unsigned int n = std::set_union(a, a + count, b, b + d.count, r) - r;
+  adtl::poolFree(tmp_a);
+  adtl::poolFree(tmp_b);
+  adopt_sorted(r, n, cap, r != buf);
+}
+
+void index_domain::merge_bits(const index_domain &d, unsigned int lo,
+                              unsigned int hi) {
+  const unsigned int first = lo / 64, nw = hi / 64 - first + 1;
+  uint64_t *w;
+  if (kind == BITSET && first == data.bits.first && nw == data.bits.nwords) {
+    /* d lies within the words of this domain */
+    w = data.bits.words;
+    data.bits.words = NULL;
+    kind = INLINE;
+  } else {
+    w = alloc_words(nw);
+    if (kind == BITSET)
+      for (unsigned int j = 0; j < data.bits.nwords; ++j)
+        w[data.bits.first - first + j] = data.bits.words[j];
+    else
+      for (unsigned int k = 0; k < count; ++k)
+        w[sorted()[k] / 64 - first] |= uint64_t(1) << (sorted()[k] % 64);
+  }
+  unsigned int n = 0;
+  if (d.kind == BITSET) {
+    const unsigned int off = d.data.bits.first - first;
+    for (unsigned int j = 0; j < d.data.bits.nwords; ++j)
+      w[off + j] |= d.data.bits.words[j];
+  } else
+    for (unsigned int k = 0; k < d.count; ++k)
+      w[d.sorted()[k] / 64 - first] |= uint64_t(1) << (d.sorted()[k] % 64);
+  for (unsigned int j = 0; j < nw; ++j)
+    n += popcount64(w[j]);
+  adopt_bits(w, first, nw, n);
+}
+
+void index_domain::merge_nonempty(const index_domain &d) {
+  const unsigned int lo = std::min(min_index(), d.min_index());
+  const unsigned int hi = std::max(max_index(), d.max_index());
+  /* count + d.count bounds the size of the union from above */
+  if ((kind == BITSET || d.kind == BITSET) &&
+      prefer_bits(count + d.count, lo, hi))
+    merge_bits(d, lo, hi);
+  else
+    merge_sorted(d);
+}
+
 /**************** ADOLC_TRACELESS_SPARSE_PATTERN ****************************/
 int ADOLC_Init_sparse_pattern(adouble *a, int n, unsigned int start_cnt) {
   for (unsigned int i = 0; i < n; i++) {
     a[i].delete_pattern();
-    a[i].pattern.push_back(i + start_cnt);
+    a[i].pattern.insert(i + start_cnt);
   }
   return 3;
 }
@@ -52,17 +298,11 @@ int ADOLC_get_sparse_pattern(const adouble *const b, int m,
                              unsigned int **&pat) {
   pat = (unsigned int **)malloc(m * sizeof(unsigned int *));
   for (int i = 0; i < m; i++) {
-    // const_cast<adouble&>(b[i]).pattern.sort();
-    // const_cast<adouble&>(b[i]).pattern.unique();
     if (b[i].get_pattern_size() > 0) {
       pat[i] = (unsigned int *)malloc(sizeof(unsigned int) *
                                       (b[i].get_pattern_size() + 1));
       pat[i][0] = b[i].get_pattern_size();
-      const list<unsigned int> &tmp_set = b[i].get_pattern();
-      list<unsigned int>::const_iterator it;
-      unsigned int l = 1;
-      for (it = tmp_set.begin(); it != tmp_set.end(); it++, l++)
-        pat[i][l] = *it;
+      b[i].get_pattern().to_array(pat[i] + 1);
     } else {
       pat[i] = (unsigned int *)malloc(sizeof(unsigned int));
       pat[i][0] = 0;
@@ -0,0 +1,149 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adouble_tl_sparse.cpp
+ Revision: $Id$
+ Contents: adouble_tl_sparse.cpp contains the definitions of procedures used
+           by the traceless forward vector mode with sparse derivatives.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include <adolc/adtl_sparse.h>
+#include <adolc/dvlparms.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+using std::cout;
+using std::istream;
+using std::ostream;
+
+extern "C" void adolc_exit(int errorcode, const char *what,
+                           const char *function, const char *file, int line);
+
+namespace adtl_sparse {
+
+size_t adouble::numDir = 1;
+double adouble::denseThreshold = 0.25;
+
+/*******************  i/o operations  ***************************************/
+ostream &operator<<(ostream &out, const adouble &a) {
+  out << "Value: " << a.val;
+  out << " ADValues (" << adouble::numDir << "): ";
+  for (size_t i = 0; i < adouble::numDir; ++i)
+    out << a.getADValue(i) << " ";
+  out << "(a)";
+  return out;
+}
+
+istream &operator>>(istream &in, adouble &a) {
+  char c;
+  do
+    in >> c;
+  while (c != ':' && !in.eof());
+  in >> a.val;
+  unsigned int num;
+  do
+    in >> c;
+  while (c != '(' && !in.eof());
+  in >> num;
+  if (num > adouble::numDir) {
+    cout << "ADOL-C error: to many directions in input\n";
+    adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+  }
+  do
+    in >> c;
+  while (c != ':' && !in.eof());
+  double *adv = new double[adouble::numDir]();
+  for (unsigned int i = 0; i < num; ++i)
+    in >> adv[i];
+  a.setADValue(adv);
+  delete[] adv;
+  do
+    in >> c;
+  while (c != ')' && !in.eof());
+  return in;
+}
+
+} // namespace adtl_sparse
+
+/* All n directions are seeded at once: x[i] carries only direction i, so
+ * the sparse adoubles hold the rows of the Jacobian. No coloring is needed. */
+int ADOLC_get_sparse_jacobian(func_ad<adtl_sparse::adouble> *const fun, int n,
+                              int m, double *basepoints, int *nnz,
+                              unsigned int **rind, unsigned int **cind,
+                              double **values) {
+  int i, ret_val;
+  size_t k, nz;
+  adtl_sparse::adouble *x, *y;
+
+  adtl_sparse::setNumDir(n);
+  x = new adtl_sparse::adouble[n];
+  y = new adtl_sparse::adouble[m];
+  for (i = 0; i < n; i++) {
+    x[i] = basepoints[i];
+    x[i].setADValue(i, 1.0);
+  }
+
+  ret_val = (*fun)(n, x, m, y);
+
+  if (ret_val < 0) {
+    printf(" ADOL-C error in tapeless sparse_jac() \n");
+    delete[] x;
+    delete[] y;
+    return ret_val;
+  }
+
+  nz = 0;
+  for (i = 0; i < m; i++)
+    if (y[i].isDense()) {
+      for (k = 0; k < (size_t)n; k++)
+        if (y[i].getADNonzeros()[k] != 0.0)
+          nz++;
+    } else
+      nz += y[i].getNumNonzeros();
+
+  if (*values != NULL)
+    free(*values);
+  if (*rind != NULL)
+    free(*rind);
+  if (*cind != NULL)
+    free(*cind);
+  *rind = (unsigned int *)malloc(nz * sizeof(unsigned int));
+  *cind = (unsigned int *)malloc(nz * sizeof(unsigned int));
+  *values = (double *)malloc(nz * sizeof(double));
+
+  nz = 0;
+  for (i = 0; i < m; i++) {
+    const double *adv = y[i].getADNonzeros();
+    if (y[i].isDense()) {
+      for (k = 0; k < (size_t)n; k++)
+        if (adv[k] != 0.0) {
+          (*rind)[nz] = i;
+          (*cind)[nz] = k;
+          (*values)[nz++] = adv[k];
+        }
+    } else {
+      const unsigned int *ind = y[i].getADIndices();
+      for (k = 0; k < y[i].getNumNonzeros(); k++) {
+        (*rind)[nz] = i;
+        (*cind)[nz] = ind[k];
+        (*values)[nz++] = adv[k];
+      }
+    }
+  }
+  *nnz = (int)nz;
+
+  delete[] x;
+  delete[] y;
+  return ret_val;
+}
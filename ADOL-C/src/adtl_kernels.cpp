@@ -0,0 +1,282 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_kernels.cpp
+ Revision: $Id$
+ Contents: Elementwise kernels of the traceless forward vector mode and the
+           selection of the instruction set at load time
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#include <adolc/adtl_kernels.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) &&                              \
+    (defined(__GNUC__) || defined(__clang__))
+#define ADTL_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace adtl {
+
+namespace {
+
+/****************************************************************************/
+/*                                                          PORTABLE LOOPS */
+
+void addScalar(size_t n, double *r, const double *a, const double *b) {
+  for (size_t i = 0; i < n; ++i)
+    r[i] = a[i] + b[i];
+}
+
+void subScalar(size_t n, double *r, const double *a, const double *b) {
+  for (size_t i = 0; i < n; ++i)
+    r[i] = a[i] - b[i];
+}
+
+void scaleScalar(size_t n, double *r, double s, const double *a) {
+  for (size_t i = 0; i < n; ++i)
+    r[i] = s * a[i];
+}
+
+void divScalar(size_t n, double *r, const double *a, double s) {
+  for (size_t i = 0; i < n; ++i)
+    r[i] = a[i] / s;
+}
+
+void axpbyScalar(size_t n, double *r, double alpha, const double *a,
+                 double beta, const double *b) {
+  for (size_t i = 0; i < n; ++i)
+    r[i] = alpha * a[i] + beta * b[i];
+}
+
+void axpyScalar(size_t n, double *r, double s, const double *a) {
+  for (size_t i = 0; i < n; ++i)
+    r[i] += s * a[i];
+}
+
+const FovKernels scalarKernels = {addScalar,   subScalar,  scaleScalar,
+                                  divScalar,   axpbyScalar, axpyScalar};
+
+#ifdef ADTL_KERNELS_X86
+/****************************************************************************/
+/*                                                                     AVX2 */
+#define ADTL_AVX2 __attribute__((target("avx2")))
+
+ADTL_AVX2 void addAvx2(size_t n, double *r, const double *a, const double *b) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(r + i, _mm256_add_pd(_mm256_loadu_pd(a + i),
+                                          _mm256_loadu_pd(b + i)));
+  for (; i < n; ++i)
+    r[i] = a[i] + b[i];
+}
+
+ADTL_AVX2 void subAvx2(size_t n, double *r, const double *a, const double *b) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(r + i, _mm256_sub_pd(_mm256_loadu_pd(a + i),
+                                          _mm256_loadu_pd(b + i)));
+  for (; i < n; ++i)
+    r[i] = a[i] - b[i];
+}
+
+ADTL_AVX2 void scaleAvx2(size_t n, double *r, double s, const double *a) {
+  const __m256d vs = _mm256_set1_pd(s);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(r + i, _mm256_mul_pd(vs, _mm256_loadu_pd(a + i)));
+  for (; i < n; ++i)
+    r[i] = s * a[i];
+}
+
+ADTL_AVX2 void divAvx2(size_t n, double *r, const double *a, double s) {
+  const __m256d vs = _mm256_set1_pd(s);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(r + i, _mm256_div_pd(_mm256_loadu_pd(a + i), vs));
+  for (; i < n; ++i)
+    r[i] = a[i] / s;
+}
+
+ADTL_AVX2 void axpbyAvx2(size_t n, double *r, double alpha, const double *a,
+                         double beta, const double *b) {
+  const __m256d va = _mm256_set1_pd(alpha);
+  const __m256d vb = _mm256_set1_pd(beta);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(r + i,
+                     _mm256_add_pd(_mm256_mul_pd(va, _mm256_loadu_pd(a + i)),
+                                   _mm256_mul_pd(vb, _mm256_loadu_pd(b + i))));
+  for (; i < n; ++i)
+    r[i] = alpha * a[i] + beta * b[i];
+}
+
+ADTL_AVX2 void axpyAvx2(size_t n, double *r, double s, const double *a) {
+  const __m256d vs = _mm256_set1_pd(s);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(r + i,
+                     _mm256_add_pd(_mm256_loadu_pd(r + i),
+                                   _mm256_mul_pd(vs, _mm256_loadu_pd(a + i))));
+  for (; i < n; ++i)
+    r[i] += s * a[i];
+}
+
+const FovKernels avx2Kernels = {addAvx2,   subAvx2,   scaleAvx2,
+                                divAvx2,   axpbyAvx2, axpyAvx2};
+
+/****************************************************************************/
+/*                                                                 AVX-512F */
+/* The remainder is handled with a masked load and store */
+#define ADTL_AVX512 __attribute__((target("avx512f")))
+
+ADTL_AVX512 inline __mmask8 tailMask(size_t rest) {
+  return static_cast<__mmask8>((1u << rest) - 1);
+}
+
+ADTL_AVX512 void addAvx512(size_t n, double *r, const double *a,
+                           const double *b) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(r + i, _mm512_add_pd(_mm512_loadu_pd(a + i),
+                                          _mm512_loadu_pd(b + i)));
+  if (i < n) {
+    const __mmask8 m = tailMask(n - i);
+    _mm512_mask_storeu_pd(r + i, m,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(m, a + i),
+                                        _mm512_maskz_loadu_pd(m, b + i)));
+  }
+}
+
+ADTL_AVX512 void subAvx512(size_t n, double *r, const double *a,
+                           const double *b) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(r + i, _mm512_sub_pd(_mm512_loadu_pd(a + i),
+                                          _mm512_loadu_pd(b + i)));
+  if (i < n) {
+    const __mmask8 m = tailMask(n - i);
+    _mm512_mask_storeu_pd(r + i, m,
+                          _mm512_sub_pd(_mm512_maskz_loadu_pd(m, a + i),
+                                        _mm512_maskz_loadu_pd(m, b + i)));
+  }
+}
+
+ADTL_AVX512 void scaleAvx512(size_t n, double *r, double s, const double *a) {
+  const __m512d vs = _mm512_set1_pd(s);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(r + i, _mm512_mul_pd(vs, _mm512_loadu_pd(a + i)));
+  if (i < n) {
+    const __mmask8 m = tailMask(n - i);
+    _mm512_mask_storeu_pd(r + i, m,
+                          _mm512_mul_pd(vs, _mm512_maskz_loadu_pd(m, a + i)));
+  }
+}
+
+ADTL_AVX512 void divAvx512(size_t n, double *r, const double *a, double s) {
+  const __m512d vs = _mm512_set1_pd(s);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(r + i, _mm512_div_pd(_mm512_loadu_pd(a + i), vs));
+  if (i < n) {
+    const __mmask8 m = tailMask(n - i);
+    _mm512_mask_storeu_pd(r + i, m,
+                          _mm512_div_pd(_mm512_maskz_loadu_pd(m, a + i), vs));
+  }
+}
+
+ADTL_AVX512 void axpbyAvx512(size_t n, double *r, double alpha,
+                             const double *a, double beta, const double *b) {
+  const __m512d va = _mm512_set1_pd(alpha);
+  const __m512d vb = _mm512_set1_pd(beta);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(r + i,
+                     _mm512_add_pd(_mm512_mul_pd(va, _mm512_loadu_pd(a + i)),
+                                   _mm512_mul_pd(vb, _mm512_loadu_pd(b + i))));
+  if (i < n) {
+    const __mmask8 m = tailMask(n - i);
+    _mm512_mask_storeu_pd(
+        r + i, m,
+        _mm512_add_pd(_mm512_mul_pd(va, _mm512_maskz_loadu_pd(m, a + i)),
+                      _mm512_mul_pd(vb, _mm512_maskz_loadu_pd(m, b + i))));
+  }
+}
+
+ADTL_AVX512 void axpyAvx512(size_t n, double *r, double s, const double *a) {
+  const __m512d vs = _mm512_set1_pd(s);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm512_storeu_pd(r + i,
+                     _mm512_add_pd(_mm512_loadu_pd(r + i),
+                                   _mm512_mul_pd(vs, _mm512_loadu_pd(a + i))));
+  if (i < n) {
+    const __mmask8 m = tailMask(n - i);
+    const __m512d prod = _mm512_mul_pd(vs, _mm512_maskz_loadu_pd(m, a + i));
+    _mm512_mask_storeu_pd(r + i, m,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(m, r + i), prod));
+  }
+}
+
+const FovKernels avx512Kernels = {addAvx512,   subAvx512,   scaleAvx512,
+                                  divAvx512,   axpbyAvx512, axpyAvx512};
+#endif
+
+const FovKernels *kernelTable(KernelISA isa) {
+  switch (isa) {
+#ifdef ADTL_KERNELS_X86
+  case ADTL_ISA_AVX512:
+    return &avx512Kernels;
+  case ADTL_ISA_AVX2:
+    return &avx2Kernels;
+#endif
+  default:
+    return &scalarKernels;
+  }
+}
+
+KernelISA detectISA() {
+#ifdef ADTL_KERNELS_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return ADTL_ISA_AVX512;
+  if (__builtin_cpu_supports("avx2"))
+    return ADTL_ISA_AVX2;
+#endif
+  return ADTL_ISA_SCALAR;
+}
+
+const KernelISA bestISA = detectISA();
+KernelISA currentISA = bestISA;
+
+} // namespace
+
+/* Scalar until the initializer below has run, e.g. for global adoubles */
+const FovKernels *fovKernels = &scalarKernels;
+
+namespace {
+struct SelectKernels {
+  SelectKernels() { fovKernels = kernelTable(currentISA); }
+} selectKernels;
+} // namespace
+
+KernelISA getBestKernelISA() { return bestISA; }
+
+KernelISA getKernelISA() { return currentISA; }
+
+bool setKernelISA(KernelISA isa) {
+  if (isa > bestISA)
+    return false;
+  currentISA = isa;
+  fovKernels = kernelTable(isa);
+  return true;
+}
+
+} // namespace adtl
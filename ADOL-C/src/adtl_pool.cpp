@@ -0,0 +1,425 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_pool.cpp
+ Revision: $Id$
+ Contents: Thread local slab allocator for the traceless adoubles
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#include <adolc/adtl_pool.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace adtl {
+
+namespace {
+
+const unsigned SLAB_SHIFT = 16;
+const size_t SLAB_BYTES = size_t(1) << SLAB_SHIFT; /* slabs are aligned */
+const size_t HEADER_BYTES = ADTL_POOL_ALIGN;
+const size_t MAX_SMALL_BYTES = SLAB_BYTES / 8;
+/* 16, 32, 48 and 64 bytes, then one class per cache line up to 8 KiB */
+const size_t NUM_CLASSES = 3 + MAX_SMALL_BYTES / ADTL_POOL_ALIGN;
+const size_t MASK_WORDS = (NUM_CLASSES + 63) / 64;
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+/* Owner of the slabs of a thread. Blocks freed by other threads are pushed
+ * onto its remote list, which the owning thread takes back once its own
+ * lists run dry. The owner of a finished thread is orphaned and adopted by
+ * the next thread carving a slab, so there are no more owners than threads
+ * running at once. */
+struct PoolOwner {
+  std::atomic<FreeBlock *> remote{nullptr};
+  PoolOwner *nextOrphan = nullptr;
+};
+
+/* first bytes of every slab */
+struct SlabHeader {
+  size_t cls;        // size class
+  size_t blockBytes; // size of the blocks
+  SlabHeader *next;  // all slabs, so they stay reachable until exit
+  PoolOwner *owner;
+};
+
+/* HEADER_BYTES in front of every large block */
+struct LargeHeader {
+  size_t totalBytes; // of the allocation including this header
+};
+
+inline size_t classOf(size_t bytes) {
+  if (bytes <= ADTL_POOL_ALIGN)
+    return bytes == 0 ? 0 : (bytes - 1) / 16;
+  return 2 + (bytes + ADTL_POOL_ALIGN - 1) / ADTL_POOL_ALIGN;
+}
+
+inline size_t classBytes(size_t cls) {
+  return cls < 4 ? 16 * (cls + 1) : ADTL_POOL_ALIGN * (cls - 2);
+}
+
+inline SlabHeader *slabOf(void *p) {
+  return reinterpret_cast<SlabHeader *>(reinterpret_cast<uintptr_t>(p) &
+                                        ~(uintptr_t)(SLAB_BYTES - 1));
+}
+
+/* bytes must be a multiple of align */
+void *alignedAlloc(size_t bytes, size_t align) {
+#ifdef _MSC_VER
+  void *p = _aligned_malloc(bytes, align);
+#else
+  void *p = std::aligned_alloc(align, bytes);
+#endif
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void alignedFree(void *p) {
+#ifdef _MSC_VER
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+std::atomic<size_t> slabCount(0);
+std::atomic<size_t> reservedBytes(0);
+
+/* Bitmap of the SLAB_BYTES windows of the address space that hold a slab,
+ * so that poolFree tells blocks of slabs from large blocks without reading
+ * memory in front of them. Two levels over 48-bit addresses; leaves are
+ * never freed, just as the slabs. */
+const unsigned ADDRESS_BITS = 48;
+const unsigned LEAF_SHIFT = 16; /* windows per leaf, as a power of 2 */
+const size_t LEAF_WORDS = (size_t(1) << LEAF_SHIFT) / 64;
+const size_t ROOT_SIZE = size_t(1)
+                         << (ADDRESS_BITS - SLAB_SHIFT - LEAF_SHIFT);
+
+struct SlabMapLeaf {
+  std::atomic<uint64_t> words[LEAF_WORDS];
+};
+std::atomic<SlabMapLeaf *> slabMap[ROOT_SIZE];
+
+bool isSlab(const void *p) {
+  const uintptr_t window = reinterpret_cast<uintptr_t>(p) >> SLAB_SHIFT;
+  if ((window >> LEAF_SHIFT) >= ROOT_SIZE)
+    return false;
+  const SlabMapLeaf *leaf =
+      slabMap[window >> LEAF_SHIFT].load(std::memory_order_acquire);
+  if (leaf == nullptr)
+    return false;
+  const size_t bit = window & ((size_t(1) << LEAF_SHIFT) - 1);
+  return (leaf->words[bit / 64].load(std::memory_order_relaxed) >>
+          (bit % 64)) &
+         1;
+}
+
+/* enters a new slab into the map, false if its address is beyond it */
+bool markSlab(const void *slab) {
+  const uintptr_t window = reinterpret_cast<uintptr_t>(slab) >> SLAB_SHIFT;
+  if ((window >> LEAF_SHIFT) >= ROOT_SIZE)
+    return false;
+  std::atomic<SlabMapLeaf *> &root = slabMap[window >> LEAF_SHIFT];
+  SlabMapLeaf *leaf = root.load(std::memory_order_acquire);
+  if (leaf == nullptr) {
+    SlabMapLeaf *fresh = new SlabMapLeaf();
+    if (root.compare_exchange_strong(leaf, fresh, std::memory_order_acq_rel))
+      leaf = fresh;
+    else
+      delete fresh;
+  }
+  const size_t bit = window & ((size_t(1) << LEAF_SHIFT) - 1);
+  leaf->words[bit / 64].fetch_or(uint64_t(1) << (bit % 64),
+                                 std::memory_order_relaxed);
+  return true;
+}
+
+/* Free blocks left behind by finished threads, their owners and the list
+ * of all slabs */
+struct Depot {
+  std::mutex mutex;
+  FreeBlock *freeList[NUM_CLASSES] = {};
+  std::atomic<size_t> freeBlocks{0};
+  PoolOwner *orphans = nullptr;
+  std::atomic<size_t> numOrphans{0};
+  SlabHeader *slabs = nullptr;
+};
+
+Depot &depot() {
+  static Depot *d = new Depot; /* never destroyed, see ThreadCache */
+  return *d;
+}
+
+/* a block of its own, rounded up to whole cache lines only */
+void *allocLarge(size_t bytes) {
+  const size_t total = (HEADER_BYTES + bytes + ADTL_POOL_ALIGN - 1) &
+                       ~size_t(ADTL_POOL_ALIGN - 1);
+  LargeHeader *h =
+      static_cast<LargeHeader *>(alignedAlloc(total, ADTL_POOL_ALIGN));
+  h->totalBytes = total;
+  reservedBytes.fetch_add(total, std::memory_order_relaxed);
+  return reinterpret_cast<char *>(h) + HEADER_BYTES;
+}
+
+void freeLarge(void *p) {
+  LargeHeader *h =
+      reinterpret_cast<LargeHeader *>(static_cast<char *>(p) - HEADER_BYTES);
+  reservedBytes.fetch_sub(h->totalBytes, std::memory_order_relaxed);
+  alignedFree(h);
+}
+
+SlabHeader *newSlab(size_t cls, PoolOwner *owner) {
+  SlabHeader *h =
+      static_cast<SlabHeader *>(alignedAlloc(SLAB_BYTES, SLAB_BYTES));
+  if (!markSlab(h)) {
+    alignedFree(h);
+    throw std::bad_alloc();
+  }
+  h->cls = cls;
+  h->blockBytes = classBytes(cls);
+  h->owner = owner;
+  slabCount.fetch_add(1, std::memory_order_relaxed);
+  reservedBytes.fetch_add(SLAB_BYTES, std::memory_order_relaxed);
+  Depot &d = depot();
+  std::lock_guard<std::mutex> lock(d.mutex);
+  h->next = d.slabs;
+  d.slabs = h;
+  return h;
+}
+
+/* an orphaned owner if there is one, a new one otherwise */
+PoolOwner *adoptOwner() {
+  Depot &d = depot();
+  std::lock_guard<std::mutex> lock(d.mutex);
+  PoolOwner *owner = d.orphans;
+  if (owner == nullptr)
+    return new PoolOwner; /* never destroyed, but adopted */
+  d.orphans = owner->nextOrphan;
+  d.numOrphans.fetch_sub(1, std::memory_order_relaxed);
+  owner->nextOrphan = nullptr;
+  return owner;
+}
+
+/* hands block b back to the owner of its slab */
+void pushRemote(PoolOwner *owner, FreeBlock *b) {
+  FreeBlock *head = owner->remote.load(std::memory_order_relaxed);
+  do
+    b->next = head;
+  while (!owner->remote.compare_exchange_weak(
+      head, b, std::memory_order_release, std::memory_order_relaxed));
+}
+
+/* moves the blocks on the remote list of owner to the depot, the depot
+ * mutex is held */
+void remoteToDepot(Depot &d, PoolOwner *owner) {
+  FreeBlock *b = owner->remote.exchange(nullptr, std::memory_order_acquire);
+  while (b != nullptr) {
+    FreeBlock *next = b->next;
+    const size_t cls = slabOf(b)->cls;
+    b->next = d.freeList[cls];
+    d.freeList[cls] = b;
+    d.freeBlocks.fetch_add(1, std::memory_order_relaxed);
+    b = next;
+  }
+}
+
+struct ThreadCache {
+  PoolOwner *owner = nullptr; /* of the slabs carved by this thread */
+  FreeBlock *freeList[NUM_CLASSES] = {};
+  uint64_t nonEmpty[MASK_WORDS] = {}; /* bit per class with free blocks */
+  char *bump[NUM_CLASSES] = {};       /* unused rest of the current slab */
+  char *bumpEnd[NUM_CLASSES] = {};
+  size_t allocations = 0;
+  size_t deallocations = 0;
+  size_t recycled = 0;
+  size_t returned = 0;
+
+  ~ThreadCache();
+
+  void push(size_t cls, FreeBlock *b) {
+    b->next = freeList[cls];
+    freeList[cls] = b;
+    nonEmpty[cls / 64] |= uint64_t(1) << (cls % 64);
+  }
+
+  void *pop(size_t cls) {
+    FreeBlock *b = freeList[cls];
+    freeList[cls] = b->next;
+    if (freeList[cls] == nullptr)
+      nonEmpty[cls / 64] &= ~(uint64_t(1) << (cls % 64));
+    return b;
+  }
+
+  /* smallest class above cls with a free block, NUM_CLASSES if none */
+  size_t largerFree(size_t cls) const {
+    size_t c = cls + 1;
+    while (c < NUM_CLASSES) {
+      uint64_t w = nonEmpty[c / 64] >> (c % 64);
+      if (w == 0) {
+        c = (c / 64 + 1) * 64;
+        continue;
+      }
+      while ((w & 1) == 0) {
+        w >>= 1;
+        ++c;
+      }
+      return c;
+    }
+    return NUM_CLASSES;
+  }
+
+  /* takes back the blocks other threads freed, of any class */
+  bool fromRemote() {
+    if (owner == nullptr ||
+        owner->remote.load(std::memory_order_relaxed) == nullptr)
+      return false;
+    FreeBlock *b = owner->remote.exchange(nullptr, std::memory_order_acquire);
+    while (b != nullptr) {
+      FreeBlock *next = b->next;
+      push(slabOf(b)->cls, b);
+      ++returned;
+      b = next;
+    }
+    return true;
+  }
+
+  bool fromDepot(size_t cls) {
+    Depot &d = depot();
+    if (d.freeBlocks.load(std::memory_order_relaxed) == 0 &&
+        d.numOrphans.load(std::memory_order_relaxed) == 0)
+      return false;
+    std::lock_guard<std::mutex> lock(d.mutex);
+    for (PoolOwner *o = d.orphans; o != nullptr; o = o->nextOrphan)
+      remoteToDepot(d, o);
+    FreeBlock *b = d.freeList[cls];
+    if (b == nullptr)
+      return false;
+    d.freeList[cls] = nullptr;
+    while (b != nullptr) {
+      FreeBlock *next = b->next;
+      push(cls, b);
+      d.freeBlocks.fetch_sub(1, std::memory_order_relaxed);
+      b = next;
+    }
+    return true;
+  }
+
+  void *alloc(size_t cls) {
+    ++allocations;
+    if (freeList[cls] != nullptr || (fromRemote() && freeList[cls] != nullptr))
+      return pop(cls);
+    const size_t bytes = classBytes(cls);
+    if (bump[cls] != nullptr && bump[cls] + bytes <= bumpEnd[cls]) {
+      void *p = bump[cls];
+      bump[cls] += bytes;
+      return p;
+    }
+    if (fromDepot(cls))
+      return pop(cls);
+    /* e.g. after setNumDir lowered the number of directions */
+    const size_t larger = largerFree(cls);
+    if (larger < NUM_CLASSES) {
+      ++recycled;
+      return pop(larger);
+    }
+    if (owner == nullptr)
+      owner = adoptOwner();
+    char *slab = reinterpret_cast<char *>(newSlab(cls, owner));
+    bump[cls] = slab + HEADER_BYTES + bytes;
+    bumpEnd[cls] = slab + SLAB_BYTES;
+    return slab + HEADER_BYTES;
+  }
+};
+
+/* Set once the cache of a thread is destroyed. Global adoubles are freed
+ * after that and go to the depot instead. */
+thread_local bool cacheGone = false;
+thread_local ThreadCache cache;
+
+ThreadCache::~ThreadCache() {
+  cacheGone = true;
+  Depot &d = depot();
+  std::lock_guard<std::mutex> lock(d.mutex);
+  for (size_t cls = 0; cls < NUM_CLASSES; ++cls) {
+    const size_t bytes = classBytes(cls);
+    for (char *p = bump[cls]; p != nullptr && p + bytes <= bumpEnd[cls];
+         p += bytes)
+      push(cls, reinterpret_cast<FreeBlock *>(p));
+    while (freeList[cls] != nullptr) {
+      FreeBlock *b = freeList[cls];
+      freeList[cls] = b->next;
+      b->next = d.freeList[cls];
+      d.freeList[cls] = b;
+      d.freeBlocks.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  /* blocks freed remotely from now on wait for the thread adopting the
+   * owner, or for the next thread looking into the depot */
+  if (owner != nullptr) {
+    remoteToDepot(d, owner);
+    owner->nextOrphan = d.orphans;
+    d.orphans = owner;
+    d.numOrphans.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+} // namespace
+
+void *poolMalloc(size_t bytes) {
+  if (bytes > MAX_SMALL_BYTES || cacheGone)
+    return allocLarge(bytes);
+  return cache.alloc(classOf(bytes));
+}
+
+void poolFree(void *p) {
+  if (p == nullptr)
+    return;
+  if (!isSlab(p)) {
+    freeLarge(p);
+    return;
+  }
+  SlabHeader *h = slabOf(p);
+  if (cacheGone) {
+    Depot &d = depot();
+    std::lock_guard<std::mutex> lock(d.mutex);
+    FreeBlock *b = static_cast<FreeBlock *>(p);
+    b->next = d.freeList[h->cls];
+    d.freeList[h->cls] = b;
+    d.freeBlocks.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  ++cache.deallocations;
+  if (h->owner != cache.owner) {
+    pushRemote(h->owner, static_cast<FreeBlock *>(p));
+    return;
+  }
+  cache.push(h->cls, static_cast<FreeBlock *>(p));
+}
+
+PoolStats getPoolStats() {
+  PoolStats s = {};
+  if (!cacheGone) {
+    s.allocations = cache.allocations;
+    s.deallocations = cache.deallocations;
+    s.recycled = cache.recycled;
+    s.returned = cache.returned;
+  }
+  s.slabs = slabCount.load(std::memory_order_relaxed);
+  s.reservedBytes = reservedBytes.load(std::memory_order_relaxed);
+  return s;
+}
+
+} // namespace adtl
@@ -478,6 +478,52 @@ void condeqassign(adubref &res, const adouble &cond, const adouble &arg) {
     res.value(arg.value());
 }
 
+advector::advector(size_t n) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  if (n == 0)
+    return;
+
+  data.reserve(n);
+  // the singleton store hands out no blocks, the elements then get a location
+  // each, the destructor frees them one by one as runs of length one
+  if (ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr->storeType() ==
+      ADOLC_LOCATION_SINGLETONS) {
+    for (size_t i = 0; i < n; ++i)
+      data.emplace_back(tape_location{next_loc()});
+  } else {
+    const size_t first = next_loc_block(n);
+    for (size_t i = 0; i < n; ++i)
+      data.emplace_back(tape_location{first + i});
+  }
+
+#if defined(ADOLC_ADOUBLE_STDCZERO)
+  for (auto &a : data)
+    a = 0.0;
+#endif
+}
+
+advector::~advector() {
+  // Elements may have been moved from or assigned other locations meanwhile,
+  // only runs of valid elements with consecutive locations are freed at once
+  size_t i = 0;
+  while (i < data.size()) {
+    if (!data[i].valid) {
+      ++i;
+      continue;
+    }
+    const size_t first = data[i].loc();
+    size_t n = 0;
+    while (i + n < data.size() && data[i + n].valid &&
+           data[i + n].loc() == first + n) {
+      data[i + n].valid = 0;
+      ++n;
+    }
+    free_loc_block(first, n);
+    i += n;
+  }
+}
+
 bool advector::nondecreasing() const {
   bool ret = true;
   double last = -ADOLC_MATH_NSP::numeric_limits<double>::infinity();
@@ -206,6 +206,8 @@ ADOLC_DLL_EXPORT int fp_iteration(size_t sub_tape_num, double_F double_func,
                                   double epsilon_deriv, size_t N_max,
                                   size_t N_max_deriv, adouble *x_0, adouble *u,
                                   adouble *x_fix, size_t dim_x, size_t dim_u) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   // declare extern differentiated function and data
   ext_diff_fct *edf_iteration = reg_ext_fct(&iteration);
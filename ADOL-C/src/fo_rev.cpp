@@ -180,6 +180,15 @@ results   Taylor-Jacobians       ------------          Taylor Jacobians
 #endif
 #endif
 
+/*--------------------------------------------------------------------------*/
+/*                                        kernels over the adjoint directions */
+/* The adjoints of a location are a contiguous row of p doubles, updated as */
+/* a whole by the SIMD kernels of adtl_kernels.h unless the result is also  */
+/* an argument of the operation.                                            */
+#if defined(_FOV_)
+#define _VECTOR_KERNELS_
+#endif
+
 /* END Macros */
 
 /****************************************************************************/
@@ -191,6 +200,7 @@ results   Taylor-Jacobians       ------------          Taylor Jacobians
 #include <adolc/interfaces.h>
 #include <adolc/oplate.h>
 #include <adolc/taping_p.h>
+#include <adolc/adtl_kernels.h>
 
 #include <math.h>
 #include <string.h>
@@ -425,6 +435,9 @@ int int_reverse_safe(short tnum, /* tape id                               */
 
   /* Initialize the Reverse Sweep */
   init_rev_sweep(tnum);
+  /* the operations are read from the packed records or the tape buffers,
+   * as chosen by init_rev_sweep */
+  const bool packedSweep = ADOLC_CURRENT_TAPE_INFOS.currRec != nullptr;
 
   failAdditionalInfo3 = depen;
   failAdditionalInfo4 = indep;
@@ -435,6 +448,22 @@ int int_reverse_safe(short tnum, /* tape id                               */
   indexi = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS] - 1;
   indexd = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS] - 1;
 
+#if (defined(_FOS_) && !defined(_ABS_NORM_) && !defined(_ABS_NORM_SIG_)) ||    \
+    defined(_FOV_)
+  /* tapes taped with ADOLC_TAPE_IO_NATIVE are swept as native code, fov
+   * sweeps of tapes taped with ADOLC_TAPE_IO_PARALLEL by several threads,
+   * from the base point of the last sweep keeping taylors */
+#if defined(_FOS_)
+  if (nativeFosReverse(lagrange, results)) {
+#else
+  if (nativeFovReverse(nrows, lagrange, results) ||
+      parallelFovReverse(nrows, lagrange, results)) {
+#endif
+    end_sweep();
+    return ret_c;
+  }
+#endif
+
 #if defined(_ABS_NORM_) || defined(_ABS_NORM_SIG_)
   if (!ADOLC_CURRENT_TAPE_INFOS.stats[NO_MIN_MAX]) {
     fprintf(DIAG_OUT,
@@ -532,7 +561,7 @@ int int_reverse_safe(short tnum, /* tape id                               */
 
   /****************************************************************************/
   /*                                                            REVERSE SWEEP */
-  operation = get_op_r();
+  operation = packedSweep ? get_rec_r() : get_op_r();
   while (operation != start_of_tape) { /* Switch statement to execute the
                                           operations in Reverse */
 
@@ -754,12 +783,16 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg]);
 
+#if defined(_VECTOR_KERNELS_)
+      adtl::fovAdd(p, Aarg, Aarg, Ares);
+#else
       FOR_0_LE_l_LT_p
 #if defined(_INT_REV_)
           AARG_INC |= ARES_INC;
 #else
           AARG_INC += ARES_INC;
 #endif
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -786,12 +819,16 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
+#if defined(_VECTOR_KERNELS_)
+      adtl::fovSub(p, Aarg, Aarg, Ares);
+#else
       FOR_0_LE_l_LT_p
 #if defined(_INT_REV_)
           AARG_INC |= ARES_INC;
 #else
           AARG_INC -= ARES_INC;
 #endif
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -809,8 +846,12 @@ int int_reverse_safe(short tnum, /* tape id                               */
 #if !defined(_INT_REV_)
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
 
+#if defined(_VECTOR_KERNELS_)
+      adtl::fovScale(p, Ares, coval, Ares);
+#else
       FOR_0_LE_l_LT_p ARES_INC *= coval;
 #endif
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -866,6 +907,13 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
       ASSIGN_A(Aarg2, ADJOINT_BUFFER[arg2])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg1 && res != arg2) {
+        adtl::fovAdd(p, Aarg1, Aarg1, Ares);
+        adtl::fovAdd(p, Aarg2, Aarg2, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -897,6 +945,12 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg) {
+        adtl::fovAdd(p, Aarg, Aarg, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -925,6 +979,13 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
       ASSIGN_A(Aarg2, ADJOINT_BUFFER[arg2])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg1 && res != arg2) {
+        adtl::fovAdd(p, Aarg1, Aarg1, Ares);
+        adtl::fovSub(p, Aarg2, Aarg2, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -956,6 +1017,12 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg) {
+        adtl::fovSub(p, Aarg, Aarg, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -987,6 +1054,13 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Aarg2, ADJOINT_BUFFER[arg2])
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg1 && res != arg2) {
+        adtl::fovAxpy(p, Aarg2, TARG1, Ares);
+        adtl::fovAxpy(p, Aarg1, TARG2, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -1019,6 +1093,11 @@ int int_reverse_safe(short tnum, /* tape id                               */
       TRES -= TARG1 * TARG2;
 #endif /* !_NTIGHT_ */
 
+#if defined(_VECTOR_KERNELS_)
+      /* in this order also if the result is an argument */
+      adtl::fovAxpy(p, Aarg2, TARG1, Ares);
+      adtl::fovAxpy(p, Aarg1, TARG2, Ares);
+#else
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         AARG2_INC |= *Ares;
@@ -1028,6 +1107,7 @@ int int_reverse_safe(short tnum, /* tape id                               */
         AARG1_INC += ARES_INC * TARG2;
 #endif
       }
+#endif
       break;
 
       /*--------------------------------------------------------------------------*/
@@ -1047,6 +1127,11 @@ int int_reverse_safe(short tnum, /* tape id                               */
       TRES += TARG1 * TARG2;
 #endif /* !_NTIGHT_ */
 
+#if defined(_VECTOR_KERNELS_)
+      /* in this order also if the result is an argument */
+      adtl::fovAxpy(p, Aarg2, -TARG1, Ares);
+      adtl::fovAxpy(p, Aarg1, -TARG2, Ares);
+#else
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         AARG2_INC |= *Ares;
@@ -1056,6 +1141,7 @@ int int_reverse_safe(short tnum, /* tape id                               */
         AARG1_INC -= ARES_INC * TARG2;
 #endif
       }
+#endif
       break;
 
       /*--------------------------------------------------------------------------*/
@@ -1070,6 +1156,12 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg) {
+        adtl::fovAxpy(p, Aarg, coval, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -1227,6 +1319,12 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg) {
+        adtl::fovAxpy(p, Aarg, TRES, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -1253,6 +1351,12 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg1) {
+        adtl::fovAxpy(p, Aarg1, TARG2, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -1281,6 +1385,12 @@ int int_reverse_safe(short tnum, /* tape id                               */
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
 
+#if defined(_VECTOR_KERNELS_)
+      if (res != arg1) {
+        adtl::fovAxpy(p, Aarg1, -TARG2, Ares);
+        memset(Ares, 0, p * sizeof(double));
+      } else
+#endif
       FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
         size_t aTmp = *Ares;
@@ -2975,7 +3085,7 @@ int int_reverse_safe(short tnum, /* tape id                               */
     } /* endswitch */
 
     /* Get the next operation */
-    operation = get_op_r();
+    operation = packedSweep ? get_rec_r() : get_op_r();
   } /* endwhile */
 
   /* clean up */
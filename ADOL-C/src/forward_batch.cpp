@@ -0,0 +1,658 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     forward_batch.cpp
+ Revision: $Id$
+ Contents: zos_forward_batch, the zero-order forward mode at many base points
+           in one sweep of the tape
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include <adolc/dvlparms.h>
+#include <adolc/interfaces.h>
+#include <adolc/oplate.h>
+#include <adolc/taping_p.h>
+
+#include <math.h>
+#include <vector>
+
+/****************************************************************************/
+/* zos_forward_batch reads every operation of the tape once and evaluates   */
+/* it at a batch of base points, the lanes. The values of a location at all */
+/* lanes are contiguous, so that every operation is a plain loop over the   */
+/* lanes the compiler vectorizes. Conditional assignments, min, abs and the */
+/* like choose per lane, a lane whose comparison of the tape switches       */
+/* returns -1 as zos_forward does, but is evaluated on along the taped      */
+/* branch. The lanes of a sweep are bounded so that the values of all       */
+/* locations take at most batchBytes, more points are swept in turns.       */
+/* Tapes with operations not known here (external functions, active         */
+/* subscripts, vector operations, quadratures, abs-normal form, ...) are    */
+/* evaluated by zos_forward point by point.                                 */
+/****************************************************************************/
+
+namespace {
+
+const size_t batchMaxLanes = 256;
+const size_t batchBytes = (size_t)64 << 20;
+
+#define TL(loc) (T + (size_t)(loc) * lanes)
+#define FOR_0_LE_j_LT_lanes for (int j = 0; j < lanes; j++)
+
+/* comparison of the tape switching at count of lanes points */
+struct BranchSwitch {
+  const char *opname;
+  int count;
+  int lanes;
+};
+
+/* Notes the lanes at which the comparison opname of the tape switches. */
+void branchSwitch(std::vector<BranchSwitch> &switches, const char *opname,
+                  int count, int lanes) {
+  if (count > 0)
+    switches.push_back({opname, count, lanes});
+}
+
+/* Warns of the switches noted by a sweep, which are only known to be
+ * reported once, by the batch, if the sweep reached the end of the tape. */
+void warnBranchSwitches(const std::vector<BranchSwitch> &switches) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (!ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning)
+    return;
+  for (const BranchSwitch &s : switches)
+    fprintf(DIAG_OUT,
+            "ADOL-C Warning: Branch switch detected in comparison "
+            "(operator %s) at %d of %d points.\n"
+            "Results at these points may be unpredictable! Retaping "
+            "recommended!\n",
+            s.opname, s.count, s.lanes);
+}
+
+/* Sweeps the current tape at the base points x[0], ..., x[lanes - 1], the
+ * values of the locations are kept in T and the switching comparisons are
+ * noted in switches. Returns false at the first operation not known here,
+ * the sweep is then to be ended by the caller. */
+bool batchSweep(int lanes, double *T, double **x, double **y, int &ret_c,
+                std::vector<BranchSwitch> &switches) {
+  unsigned char operation;
+  locint size, arg, arg1, arg2, res;
+  locint indexi = 0, indexd = 0;
+  double coval;
+  const double *d;
+  int count;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  const double *paramstore = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore;
+  /* the operations are read from the packed records or the tape buffers,
+   * as chosen by init_for_sweep */
+  const bool packedSweep = ADOLC_CURRENT_TAPE_INFOS.currRec != nullptr;
+
+  operation = packedSweep ? get_rec_f() : get_op_f();
+  while (operation != end_of_tape) {
+    switch (operation) {
+
+      /****************************************************************************/
+      /*                                                                  MARKERS
+       */
+    case end_of_op:
+      get_op_block_f();
+      operation = get_op_f();
+      /* Skip next operation, it's another end_of_op */
+      break;
+    case end_of_int:
+      get_loc_block_f();
+      break;
+    case end_of_val:
+      get_val_block_f();
+      break;
+    case start_of_tape:
+    case end_of_tape:
+      break;
+
+      /****************************************************************************/
+      /*                                                               COMPARISON
+       */
+    case eq_zero:
+      arg = get_locint_f();
+      count = 0;
+      FOR_0_LE_j_LT_lanes count += TL(arg)[j] != 0;
+      branchSwitch(switches, "eq_zero", count, lanes);
+      MINDEC(ret_c, count > 0 ? -1 : 0);
+      break;
+    case neq_zero:
+      arg = get_locint_f();
+      count = 0;
+      FOR_0_LE_j_LT_lanes count += TL(arg)[j] == 0;
+      branchSwitch(switches, "neq_zero", count, lanes);
+      if (count > 0)
+        MINDEC(ret_c, -1);
+      break;
+    case le_zero:
+      arg = get_locint_f();
+      count = 0;
+      FOR_0_LE_j_LT_lanes {
+        count += TL(arg)[j] > 0;
+        if (TL(arg)[j] == 0)
+          MINDEC(ret_c, 0);
+      }
+      branchSwitch(switches, "le_zero", count, lanes);
+      if (count > 0)
+        MINDEC(ret_c, -1);
+      break;
+    case gt_zero:
+      arg = get_locint_f();
+      count = 0;
+      FOR_0_LE_j_LT_lanes count += TL(arg)[j] <= 0;
+      branchSwitch(switches, "gt_zero", count, lanes);
+      if (count > 0)
+        MINDEC(ret_c, -1);
+      break;
+    case ge_zero:
+      arg = get_locint_f();
+      count = 0;
+      FOR_0_LE_j_LT_lanes {
+        count += TL(arg)[j] < 0;
+        if (TL(arg)[j] == 0)
+          MINDEC(ret_c, 0);
+      }
+      branchSwitch(switches, "ge_zero", count, lanes);
+      if (count > 0)
+        MINDEC(ret_c, -1);
+      break;
+    case lt_zero:
+      arg = get_locint_f();
+      count = 0;
+      FOR_0_LE_j_LT_lanes count += TL(arg)[j] >= 0;
+      branchSwitch(switches, "lt_zero", count, lanes);
+      if (count > 0)
+        MINDEC(ret_c, -1);
+      break;
+
+      /****************************************************************************/
+      /*                                                              ASSIGNMENTS
+       */
+    case assign_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg)[j];
+      break;
+    case assign_d:
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = coval;
+      break;
+    case assign_p:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = paramstore[arg];
+      FOR_0_LE_j_LT_lanes TL(res)[j] = coval;
+      break;
+    case assign_d_zero:
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = 0.0;
+      break;
+    case assign_d_one:
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = 1.0;
+      break;
+    case assign_ind:
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = x[j][indexi];
+      ++indexi;
+      break;
+    case assign_dep:
+      res = get_locint_f();
+      if (y != nullptr)
+        FOR_0_LE_j_LT_lanes y[j][indexd] = TL(res)[j];
+      ++indexd;
+      break;
+
+      /****************************************************************************/
+      /*                                                   OPERATION + ASSIGNMENT
+       */
+    case eq_plus_d:
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] += coval;
+      break;
+    case eq_plus_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] += TL(arg)[j];
+      break;
+    case eq_min_d:
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] -= coval;
+      break;
+    case eq_min_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] -= TL(arg)[j];
+      break;
+    case eq_mult_d:
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] *= coval;
+      break;
+    case eq_mult_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] *= TL(arg)[j];
+      break;
+    case incr_a:
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j]++;
+      break;
+    case decr_a:
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j]--;
+      break;
+
+      /****************************************************************************/
+      /*                                                        BINARY OPERATIONS
+       */
+    case plus_a_a:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg1)[j] + TL(arg2)[j];
+      break;
+    case plus_d_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg)[j] + coval;
+      break;
+    case min_a_a:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg1)[j] - TL(arg2)[j];
+      break;
+    case min_d_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = coval - TL(arg)[j];
+      break;
+    case mult_a_a:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg1)[j] * TL(arg2)[j];
+      break;
+    case eq_plus_prod:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] += TL(arg1)[j] * TL(arg2)[j];
+      break;
+    case eq_min_prod:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] -= TL(arg1)[j] * TL(arg2)[j];
+      break;
+    case mult_d_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg)[j] * coval;
+      break;
+    case div_a_a:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg1)[j] / TL(arg2)[j];
+      break;
+    case div_d_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = coval / TL(arg)[j];
+      break;
+
+      /****************************************************************************/
+      /*                                                         SIGN  OPERATIONS
+       */
+    case pos_sign_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = TL(arg)[j];
+      break;
+    case neg_sign_a:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = -TL(arg)[j];
+      break;
+
+      /****************************************************************************/
+      /*                                                         UNARY OPERATIONS
+       */
+    case exp_op:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = exp(TL(arg)[j]);
+      break;
+    case log_op:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = log(TL(arg)[j]);
+      break;
+    case sqrt_op:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = sqrt(TL(arg)[j]);
+      break;
+    case cbrt_op:
+      arg = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = cbrt(TL(arg)[j]);
+      break;
+    case pow_op:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes TL(res)[j] = pow(TL(arg)[j], coval);
+      break;
+    case sin_op:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes {
+        TL(arg2)[j] = cos(TL(arg1)[j]);
+        TL(res)[j] = sin(TL(arg1)[j]);
+      }
+      break;
+    case cos_op:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      FOR_0_LE_j_LT_lanes {
+        TL(arg2)[j] = sin(TL(arg1)[j]);
+        TL(res)[j] = cos(TL(arg1)[j]);
+      }
+      break;
+
+/* the derivative of these is computed by the operations taped before */
+#define BATCH_UNARY_F(op, f)                                                   \
+  case op:                                                                     \
+    arg1 = get_locint_f();                                                     \
+    arg2 = get_locint_f();                                                     \
+    res = get_locint_f();                                                      \
+    FOR_0_LE_j_LT_lanes TL(res)[j] = f(TL(arg1)[j]);                           \
+    break;
+
+      BATCH_UNARY_F(atan_op, atan)
+      BATCH_UNARY_F(asin_op, asin)
+      BATCH_UNARY_F(acos_op, acos)
+      BATCH_UNARY_F(asinh_op, asinh)
+      BATCH_UNARY_F(acosh_op, acosh)
+      BATCH_UNARY_F(atanh_op, atanh)
+      BATCH_UNARY_F(erf_op, ADOLC_MATH_NSP_ERF::erf)
+      BATCH_UNARY_F(erfc_op, ADOLC_MATH_NSP_ERF::erfc)
+#undef BATCH_UNARY_F
+
+      /****************************************************************************/
+      /*                                                                  MIN/MAX
+       */
+    case min_op:
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        const double a1 = TL(arg1)[j], a2 = TL(arg2)[j];
+        if (a1 > a2) {
+          if (coval)
+            MINDEC(ret_c, 2);
+        } else if (a1 < a2) {
+          if (!coval)
+            MINDEC(ret_c, 2);
+        } else if (arg1 != arg2)
+          MINDEC(ret_c, 1);
+        TL(res)[j] = MIN_ADOLC(a1, a2);
+      }
+      break;
+    case abs_val:
+      /* the switches of the abs-normal form are kept for a single point */
+      if (ADOLC_CURRENT_TAPE_INFOS.stats[NO_MIN_MAX])
+        return false;
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        const double a = TL(arg)[j];
+        if (a < 0.0) {
+          if (coval)
+            MINDEC(ret_c, 2);
+        } else if (a > 0.0) {
+          if (!coval)
+            MINDEC(ret_c, 2);
+        }
+        TL(res)[j] = fabs(a);
+      }
+      break;
+    case ceil_op:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        TL(res)[j] = ceil(TL(arg)[j]);
+        if (coval != TL(res)[j])
+          MINDEC(ret_c, 2);
+      }
+      break;
+    case floor_op:
+      arg = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        TL(res)[j] = floor(TL(arg)[j]);
+        if (coval != TL(res)[j])
+          MINDEC(ret_c, 2);
+      }
+      break;
+
+      /****************************************************************************/
+      /*                                                             CONDITIONALS
+       */
+    case cond_assign:
+      arg = get_locint_f();
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        if (TL(arg)[j] > 0) {
+          if (coval <= 0.0)
+            MINDEC(ret_c, 2);
+          TL(res)[j] = TL(arg1)[j];
+        } else {
+          if (coval > 0.0)
+            MINDEC(ret_c, 2);
+          if (TL(arg)[j] == 0)
+            MINDEC(ret_c, 0);
+          TL(res)[j] = TL(arg2)[j];
+        }
+      }
+      break;
+    case cond_eq_assign:
+      arg = get_locint_f();
+      arg1 = get_locint_f();
+      arg2 = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        if (TL(arg)[j] >= 0) {
+          if (coval < 0.0)
+            MINDEC(ret_c, 2);
+          TL(res)[j] = TL(arg1)[j];
+        } else {
+          if (coval >= 0.0)
+            MINDEC(ret_c, 2);
+          TL(res)[j] = TL(arg2)[j];
+        }
+      }
+      break;
+    case cond_assign_s:
+      arg = get_locint_f();
+      arg1 = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        if (TL(arg)[j] > 0) {
+          if (coval <= 0.0)
+            MINDEC(ret_c, 2);
+          TL(res)[j] = TL(arg1)[j];
+        } else if (TL(arg)[j] == 0)
+          MINDEC(ret_c, 0);
+      }
+      break;
+    case cond_eq_assign_s:
+      arg = get_locint_f();
+      arg1 = get_locint_f();
+      res = get_locint_f();
+      coval = get_val_f();
+      FOR_0_LE_j_LT_lanes {
+        if (TL(arg)[j] >= 0) {
+          if (coval < 0.0)
+            MINDEC(ret_c, 2);
+          TL(res)[j] = TL(arg1)[j];
+        }
+      }
+      break;
+
+#if defined(ADOLC_ADVANCED_BRANCHING)
+/* the comparison op of the tape at every lane, counting the lanes at which
+ * it differs from the taped result coval */
+#define BATCH_COMPARE(op, rel)                                                 \
+  case op:                                                                     \
+    coval = get_val_f();                                                       \
+    arg = get_locint_f();                                                      \
+    arg1 = get_locint_f();                                                     \
+    res = get_locint_f();                                                      \
+    count = 0;                                                                 \
+    FOR_0_LE_j_LT_lanes {                                                      \
+      const double retval = (double)(TL(arg)[j] rel TL(arg1)[j]);              \
+      count += retval != coval;                                                \
+      TL(res)[j] = retval;                                                     \
+    }                                                                          \
+    branchSwitch(switches, #op, count, lanes);                                 \
+    break;
+
+      BATCH_COMPARE(neq_a_a, !=)
+      BATCH_COMPARE(eq_a_a, ==)
+      BATCH_COMPARE(le_a_a, <=)
+      BATCH_COMPARE(ge_a_a, >=)
+      BATCH_COMPARE(lt_a_a, <)
+      BATCH_COMPARE(gt_a_a, >)
+#undef BATCH_COMPARE
+#endif /* ADOLC_ADVANCED_BRANCHING */
+
+      /****************************************************************************/
+      /*                                                          REMAINING STUFF
+       */
+    case take_stock_op:
+      size = get_locint_f();
+      res = get_locint_f();
+      d = get_val_v_f(size);
+      for (locint ls = 0; ls < size; ls++, res++)
+        FOR_0_LE_j_LT_lanes TL(res)[j] = d[ls];
+      break;
+    case death_not:
+      get_locint_f();
+      get_locint_f();
+      break;
+
+    default:
+      return false;
+    }
+    operation = packedSweep ? get_rec_f() : get_op_f();
+  }
+  return true;
+}
+
+#undef TL
+#undef FOR_0_LE_j_LT_lanes
+
+} // namespace
+
+/****************************************************************************/
+/* zos_forward_batch(tag, m, n, K, x[K][n], y[K][m])                        */
+/* evaluates the tape at the K base points x[k] into y[k], y may be nullptr.*/
+/* Returns the least of the return values of zos_forward at the K points.   */
+/****************************************************************************/
+int zos_forward_batch(short tnum, int depcheck, int indcheck, int K,
+                      double **basepoints, double **valuepoints) {
+  int ret_c = 3;
+  bool supported = true;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (K <= 0)
+    return ret_c;
+
+  init_for_sweep(tnum);
+
+  if (((size_t)depcheck != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS]) ||
+      ((size_t)indcheck != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS])) {
+    fprintf(DIAG_OUT,
+            "ADOL-C error: forward sweep on tape %d  aborted!\n"
+            "Number of dependent(%u) and/or independent(%u) variables passed"
+            " to forward is\ninconsistent with number "
+            "recorded on tape (%zu, %zu) \n",
+            tnum, depcheck, indcheck,
+            ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS],
+            ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS]);
+    adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+  }
+
+  const size_t numLocs = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES];
+  size_t maxLanes = batchBytes / ((numLocs > 0 ? numLocs : 1) * sizeof(double));
+  if (maxLanes > batchMaxLanes)
+    maxLanes = batchMaxLanes;
+  if (maxLanes < 1)
+    maxLanes = 1;
+  if (maxLanes > (size_t)K)
+    maxLanes = K;
+  std::vector<double> T(numLocs * maxLanes);
+  std::vector<BranchSwitch> switches;
+
+  for (int k = 0; k < K && supported; k += (int)maxLanes) {
+    const int lanes = (int)MIN_ADOLC((size_t)(K - k), maxLanes);
+    if (k > 0) {
+      end_sweep();
+      init_for_sweep(tnum);
+    }
+    ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_ZOS_FORWARD;
+    switches.clear();
+    supported = batchSweep(lanes, T.data(), basepoints + k,
+                           valuepoints != nullptr ? valuepoints + k : nullptr,
+                           ret_c, switches);
+    /* a tape left to zos_forward warns there */
+    if (supported)
+      warnBranchSwitches(switches);
+  }
+
+  ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_NO_MODE;
+  end_sweep();
+
+  if (!supported) {
+    ret_c = 3;
+    for (int k = 0; k < K; k++)
+      MINDEC(ret_c, zos_forward(tnum, depcheck, indcheck, 0, basepoints[k],
+                                valuepoints != nullptr ? valuepoints[k]
+                                                       : nullptr));
+  }
+  return ret_c;
+}
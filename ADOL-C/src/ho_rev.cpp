@@ -192,6 +192,15 @@ results   Taylor-Jacobians       ------------          Taylor Jacobians
 #define VEC_COMPUTED_END
 #endif
 
+/*--------------------------------------------------------------------------*/
+/*                                         kernels over the adjoint degrees */
+/* Behind the entry tracking the nonzero degrees, the k adjoints of every   */
+/* direction are contiguous. The operations linear in them update them by   */
+/* the SIMD kernels of adtl_kernels.h unless the result is also an argument.*/
+#ifdef _HOV_
+#define _VECTOR_KERNELS_
+#endif
+
 /* END Macros */
 
 /****************************************************************************/
@@ -204,12 +213,10 @@ results   Taylor-Jacobians       ------------          Taylor Jacobians
 #include <adolc/interfaces.h>
 #include <adolc/oplate.h>
 #include <adolc/taping_p.h>
+#include <adolc/adtl_kernels.h>
 
 #include <math.h>
-
-#if defined(ADOLC_DEBUG)
 #include <string.h>
-#endif /* ADOLC_DEBUG */
 
 BEGIN_C_DECLS
 
@@ -397,6 +404,9 @@ int hov_ti_reverse(short tnum,         /* tape id */
 
   /* Initialize the Reverse Sweep */
   init_rev_sweep(tnum);
+  /* the operations are read from the packed records or the tape buffers,
+   * as chosen by init_rev_sweep */
+  const bool packedSweep = ADOLC_CURRENT_TAPE_INFOS.currRec != nullptr;
 
   if ((depen != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS]) ||
       (indep != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS]))
@@ -479,7 +489,7 @@ int hov_ti_reverse(short tnum,         /* tape id */
 #define UPDATE_TAYLORREAD(X)
 #endif /* ADOLC_DEBUG */
 
-  operation = get_op_r();
+  operation = packedSweep ? get_rec_r() : get_op_r();
 #if defined(ADOLC_DEBUG)
   ++countPerOperation[operation];
 #endif /* ADOLC_DEBUG */
@@ -681,8 +691,14 @@ int hov_ti_reverse(short tnum,         /* tape id */
           MAXDEC(AARG, ARES);
           AARG_INC_O;
           ARES_INC_O;
+#if defined(_VECTOR_KERNELS_)
+          adtl::fovAdd(k, Aarg, Aarg, Ares);
+          Aarg += k;
+          Ares += k;
+#else
           for (int i = 0; i < k; i++)
             AARG_INC += ARES_INC;
+#endif
         }
 
       GET_TAYL(res, k, p)
@@ -714,8 +730,14 @@ int hov_ti_reverse(short tnum,         /* tape id */
           MAXDEC(AARG, ARES);
           AARG_INC_O;
           ARES_INC_O;
+#if defined(_VECTOR_KERNELS_)
+          adtl::fovSub(k, Aarg, Aarg, Ares);
+          Aarg += k;
+          Ares += k;
+#else
           for (int i = 0; i < k; i++)
             AARG_INC -= ARES_INC;
+#endif
         }
 
       GET_TAYL(res, k, p)
@@ -807,6 +829,16 @@ int hov_ti_reverse(short tnum,         /* tape id */
           MAXDEC(AARG2, aTmp);
           AARG2_INC_O;
           AARG1_INC_O;
+#if defined(_VECTOR_KERNELS_)
+          if (res != arg1 && res != arg2) {
+            adtl::fovAdd(k, Aarg1, Aarg1, Ares);
+            adtl::fovAdd(k, Aarg2, Aarg2, Ares);
+            memset(Ares, 0, k * sizeof(double));
+            Ares += k;
+            Aarg1 += k;
+            Aarg2 += k;
+          } else
+#endif
           for (int i = 0; i < k; i++) {
             aTmp = ARES;
             ARES_INC = 0.0;
@@ -836,6 +868,14 @@ int hov_ti_reverse(short tnum,         /* tape id */
           ARES_INC = 0.0;
           MAXDEC(AARG, aTmp);
           AARG_INC_O;
+#if defined(_VECTOR_KERNELS_)
+          if (res != arg) {
+            adtl::fovAdd(k, Aarg, Aarg, Ares);
+            memset(Ares, 0, k * sizeof(double));
+            Ares += k;
+            Aarg += k;
+          } else
+#endif
           for (int i = 0; i < k; i++) {
             aTmp = ARES;
             ARES_INC = 0.0;
@@ -869,6 +909,16 @@ int hov_ti_reverse(short tnum,         /* tape id */
           MAXDEC(AARG2, aTmp);
           AARG2_INC_O;
           AARG1_INC_O;
+#if defined(_VECTOR_KERNELS_)
+          if (res != arg1 && res != arg2) {
+            adtl::fovAdd(k, Aarg1, Aarg1, Ares);
+            adtl::fovSub(k, Aarg2, Aarg2, Ares);
+            memset(Ares, 0, k * sizeof(double));
+            Ares += k;
+            Aarg1 += k;
+            Aarg2 += k;
+          } else
+#endif
           for (int i = 0; i < k; i++) {
             aTmp = ARES;
             ARES_INC = 0.0;
@@ -899,6 +949,14 @@ int hov_ti_reverse(short tnum,         /* tape id */
           ARES_INC = 0.0;
           MAXDEC(AARG, aTmp);
           AARG_INC_O;
+#if defined(_VECTOR_KERNELS_)
+          if (res != arg) {
+            adtl::fovSub(k, Aarg, Aarg, Ares);
+            memset(Ares, 0, k * sizeof(double));
+            Ares += k;
+            Aarg += k;
+          } else
+#endif
           for (int i = 0; i < k; i++) {
             aTmp = ARES;
             ARES_INC = 0.0;
@@ -1095,6 +1153,14 @@ int hov_ti_reverse(short tnum,         /* tape id */
           ARES_INC = 0.0;
           MAXDEC(AARG, aTmp);
           AARG_INC_O;
+#if defined(_VECTOR_KERNELS_)
+          if (res != arg) {
+            adtl::fovAxpy(k, Aarg, coval, Ares);
+            memset(Ares, 0, k * sizeof(double));
+            Ares += k;
+            Aarg += k;
+          } else
+#endif
           for (int i = 0; i < k; i++) {
             aTmp = ARES;
             ARES_INC = 0.0;
@@ -2955,7 +3021,7 @@ int hov_ti_reverse(short tnum,         /* tape id */
     } /* endswitch */
 
     /* Get the next operation */
-    operation = get_op_r();
+    operation = packedSweep ? get_rec_r() : get_op_r();
 #if defined(ADOLC_DEBUG)
     ++countPerOperation[operation];
 #endif /* ADOLC_DEBUG */
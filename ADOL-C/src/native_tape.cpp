@@ -0,0 +1,1192 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     native_tape.cpp
+ Revision: $Id$
+ Contents: zos_forward, fos_forward, fov_forward, fos_reverse and
+           fov_reverse sweeps over tapes compiled to native code
+           (ADOLC_TAPE_IO_NATIVE)
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include <adolc/dvlparms.h>
+#include <adolc/taping_p.h>
+
+#include "threaded_tape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(HAVE_DLFCN_H)
+#include <cerrno>
+#include <dlfcn.h>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/****************************************************************************/
+/* A tape held in core whose operations are all known to the threaded      */
+/* sweeps (see threaded_tape.h) has a fixed control flow. On the first      */
+/* sweep of a kind, its decoded operations are written as straight-line C   */
+/* source, one macro call per operation, compiled by the command NATIVE_CC  */
+/* to a shared object in NATIVE_DIR and loaded. NATIVE_DIR has to be set    */
+/* and private to the user, since the objects found in it are loaded into   */
+/* the process. The objects are named after the SHA-256 digest of the       */
+/* decoded tape and the compiler command, which is compiled into them and   */
+/* compared before they are used, so that later runs taping the same        */
+/* function load them without compiling. removeTape deletes them. There is  */
+/* one object per kind of sweep:                                            */
+/*   zos, fos, fov  the forward sweeps over the locations of the tape, with */
+/*                  the operations evaluated as in uni5_for.cpp,            */
+/*   rev            fos_reverse and fov_reverse, which recompute the values */
+/*                  of all operations at the base point of the last forward */
+/*                  sweep keeping taylors, each operation writing a value   */
+/*                  of its own, and propagate the adjoints backwards as in  */
+/*                  fo_rev.cpp.                                             */
+/* The code is split into functions of ADOLC_NATIVE_CHUNK operations each,  */
+/* which keeps compile times of long tapes linear. Forward sweeps keeping   */
+/* taylors are left to uni5_for.cpp, since other reverse sweeps read them.  */
+/* The values and adjoints of the reverse sweeps stay allocated with the    */
+/* tape; every operation clears its adjoints once it has propagated them,   */
+/* so they need not be cleared before the next sweep. Reverse sweeps that   */
+/* would need more than ADOLC_NATIVE_MAX_WORK of them, as well as tapes     */
+/* that cannot be compiled or loaded, fall back to the switch.              */
+/****************************************************************************/
+
+#define ADOLC_NATIVE_CHUNK 1024
+#define ADOLC_NATIVE_MAX_WORK (size_t(1) << 24)
+#define ADOLC_NATIVE_NAME "ADOLC-Native_"
+/* changes whenever the source written for a tape does, part of the digest */
+#define ADOLC_NATIVE_FORMAT 2
+
+namespace {
+
+enum NativeKind { n_zos, n_fos, n_fov, n_rev, n_numKinds };
+
+const char *const kindNames[n_numKinds] = {"zos", "fos", "fov", "rev"};
+
+typedef void (*NativeForward)(const double *X, const void *xd,
+                              const double *P, double *Y, void *yd,
+                              double *T0, double *T, size_t p);
+typedef void (*NativeReverse)(const double *X, const double *P,
+                              const void *u, void *z, double *W, double *A,
+                              size_t q);
+
+} // namespace
+
+struct NativeTape {
+  unsigned char digest[32];   /* of the decoded tape and the compiler */
+  std::string dir;            /* NATIVE_DIR when the tape was decoded */
+  bool privateDir;            /* dir is private to the user */
+  void *handles[n_numKinds];  /* the loaded shared objects */
+  bool failed[n_numKinds];    /* compiling or loading failed */
+  NativeForward forward[n_rev];
+  NativeReverse fosReverse, fovReverse;
+  size_t numSlots;            /* values written by the reverse sweeps */
+  std::vector<double> work;   /* values and adjoints of reverse sweeps,
+                                 the adjoints are left zero */
+};
+
+namespace {
+
+/* Returns the path of the object of kind without its suffix, which is named
+ * after the digest of the tape. */
+std::string objectBase(const NativeTape *native, NativeKind kind) {
+  static const char hex[] = "0123456789abcdef";
+  std::string name = ADOLC_NATIVE_NAME;
+
+  for (unsigned char byte : native->digest) {
+    name += hex[byte >> 4];
+    name += hex[byte & 15];
+  }
+  return native->dir + PATHSEPARATOR + name + "_" + kindNames[kind];
+}
+
+} // namespace
+
+void releaseNativeTape(TapeInfos *tapeInfos) {
+  NativeTape *native = tapeInfos->native;
+
+  if (native == nullptr)
+    return;
+#if defined(HAVE_DLFCN_H)
+  for (int k = 0; k < n_numKinds; k++)
+    if (native->handles[k] != nullptr)
+      dlclose(native->handles[k]);
+#endif
+  delete native;
+  tapeInfos->native = nullptr;
+}
+
+void removeNativeObjects(const TapeInfos *tapeInfos) {
+  const NativeTape *native = tapeInfos->native;
+
+  if (native == nullptr || !native->privateDir)
+    return;
+  for (int k = 0; k < n_numKinds; k++)
+    remove((objectBase(native, (NativeKind)k) + ".so").c_str());
+}
+
+size_t nativeTapeSize(const TapeInfos *tapeInfos) {
+  const NativeTape *native = tapeInfos->native;
+
+  if (native == nullptr)
+    return 0;
+  return native->work.capacity() * sizeof(double);
+}
+
+#if defined(HAVE_DLFCN_H)
+
+namespace {
+
+/****************************************************************************/
+/*                                                    MACROS OF THE SWEEPS  */
+
+/* Operations of the forward sweeps, T0 holds the values and T the tangents
+ * of the locations, t and l are temporaries. */
+const char *const forwardCommon =
+    "#define CST(r, c) T0[r] = c; DT(r, 0)\n"
+    "#define PAR(r, i) T0[r] = P[i]; DT(r, 0)\n"
+    "#define IAD(r, c) T0[r] += c;\n";
+
+const char *const zosMacros =
+    "#define DT(r, x)\n"
+    "#define CPY(r, a) T0[r] = T0[a];\n"
+    "#define IND(r, i) T0[r] = X[i];\n"
+    "#define DEP(i, r) if (Y) Y[i] = T0[r];\n"
+    "#define IAA(r, a) T0[r] += T0[a];\n"
+    "#define ISA(r, a) T0[r] -= T0[a];\n"
+    "#define IMD(r, c) T0[r] *= c;\n"
+    "#define IMA(r, a) T0[r] *= T0[a];\n"
+    "#define ADD(r, a, e) T0[r] = T0[a] + T0[e];\n"
+    "#define ADC(r, a, c) T0[r] = T0[a] + c;\n"
+    "#define SUB(r, a, e) T0[r] = T0[a] - T0[e];\n"
+    "#define SBC(r, a, c) T0[r] = c - T0[a];\n"
+    "#define MUL(r, a, e) T0[r] = T0[a] * T0[e];\n"
+    "#define MLC(r, a, c) T0[r] = T0[a] * c;\n"
+    "#define DIV(r, a, e) T0[r] = T0[a] / T0[e];\n"
+    "#define DVC(r, a, c) T0[r] = c / T0[a];\n"
+    "#define IPP(r, a, e) T0[r] += T0[a] * T0[e];\n"
+    "#define IMP(r, a, e) T0[r] -= T0[a] * T0[e];\n"
+    "#define NEG(r, a) T0[r] = -T0[a];\n"
+    "#define EXP(r, a) T0[r] = exp(T0[a]);\n"
+    "#define SIN(r, a, k) T0[k] = cos(T0[a]); T0[r] = sin(T0[a]);\n"
+    "#define COS(r, a, k) T0[k] = sin(T0[a]); T0[r] = cos(T0[a]);\n"
+    "#define ATN(r, a, k) T0[r] = atan(T0[a]);\n"
+    "#define LOG(r, a) T0[r] = log(T0[a]);\n"
+    "#define SQT(r, a) T0[r] = sqrt(T0[a]);\n";
+
+const char *const fosMacros =
+    "#define XD ((const double *)xd)\n"
+    "#define YD ((double *)yd)\n"
+    "#define DT(r, x) T[r] = x;\n"
+    "#define CPY(r, a) T0[r] = T0[a]; T[r] = T[a];\n"
+    "#define IND(r, i) T0[r] = X[i]; T[r] = XD[i];\n"
+    "#define DEP(i, r) if (Y) Y[i] = T0[r]; if (YD) YD[i] = T[r];\n"
+    "#define IAA(r, a) T0[r] += T0[a]; T[r] += T[a];\n"
+    "#define ISA(r, a) T0[r] -= T0[a]; T[r] -= T[a];\n"
+    "#define IMD(r, c) T0[r] *= c; T[r] *= c;\n"
+    "#define IMA(r, a) T[r] = T0[r] * T[a] + T[r] * T0[a]; T0[r] *= T0[a];\n"
+    "#define ADD(r, a, e) T0[r] = T0[a] + T0[e]; T[r] = T[a] + T[e];\n"
+    "#define ADC(r, a, c) T0[r] = T0[a] + c; T[r] = T[a];\n"
+    "#define SUB(r, a, e) T0[r] = T0[a] - T0[e]; T[r] = T[a] - T[e];\n"
+    "#define SBC(r, a, c) T0[r] = c - T0[a]; T[r] = -T[a];\n"
+    "#define MUL(r, a, e) T[r] = T0[a] * T[e] + T[a] * T0[e]; "
+    "T0[r] = T0[a] * T0[e];\n"
+    "#define MLC(r, a, c) T0[r] = T0[a] * c; T[r] = T[a] * c;\n"
+    "#define DIV(r, a, e) t = 1.0 / T0[e]; T0[r] = T0[a] / T0[e]; "
+    "T[r] = T[a] * t + T0[r] * (-T[e] * t);\n"
+    "#define DVC(r, a, c) t = 1.0 / T0[a]; T0[r] = c / T0[a]; "
+    "T[r] = T0[r] * (-T[a] * t);\n"
+    "#define IPP(r, a, e) T[r] += T0[a] * T[e] + T[a] * T0[e]; "
+    "T0[r] += T0[a] * T0[e];\n"
+    "#define IMP(r, a, e) T[r] -= T0[a] * T[e] + T[a] * T0[e]; "
+    "T0[r] -= T0[a] * T0[e];\n"
+    "#define NEG(r, a) T0[r] = -T0[a]; T[r] = -T[a];\n"
+    "#define EXP(r, a) T0[r] = exp(T0[a]); T[r] = T0[r] * T[a];\n"
+    "#define SIN(r, a, k) T0[k] = cos(T0[a]); T0[r] = sin(T0[a]); "
+    "T[k] = -T0[r] * T[a]; T[r] = T0[k] * T[a];\n"
+    "#define COS(r, a, k) T0[k] = sin(T0[a]); T0[r] = cos(T0[a]); "
+    "T[k] = T0[r] * T[a]; T[r] = -T0[k] * T[a];\n"
+    "#define ATN(r, a, k) T0[r] = atan(T0[a]); T[r] = T0[k] * T[a];\n"
+    "#define LOG(r, a) t = 1.0 / T0[a]; "
+    "if (T0[a] == 0.0 && T[a] < 0.0) t = NAN; "
+    "T[r] = T[a] * t; T0[r] = log(T0[a]);\n"
+    "#define SQT(r, a) T0[r] = sqrt(T0[a]); "
+    "T[r] = (T0[a] == 0.0 ? (T[a] > 0.0 ? INFINITY : T[a] < 0.0 ? NAN : 0.0) "
+    ": 0.5 / T0[r]) * T[a];\n";
+
+const char *const fovMacros =
+    "#define XD ((double *const *)xd)\n"
+    "#define YD ((double *const *)yd)\n"
+    "#define TD(k) (T + (size_t)(k) * p)\n"
+    "#define FOR for (l = 0; l < p; l++)\n"
+    "#define DT(r, x) FOR TD(r)[l] = x;\n"
+    "#define CPY(r, a) T0[r] = T0[a]; FOR TD(r)[l] = TD(a)[l];\n"
+    "#define IND(r, i) T0[r] = X[i]; FOR TD(r)[l] = XD[i][l];\n"
+    "#define DEP(i, r) if (Y) Y[i] = T0[r]; if (YD) FOR YD[i][l] = "
+    "TD(r)[l];\n"
+    "#define IAA(r, a) T0[r] += T0[a]; FOR TD(r)[l] += TD(a)[l];\n"
+    "#define ISA(r, a) T0[r] -= T0[a]; FOR TD(r)[l] -= TD(a)[l];\n"
+    "#define IMD(r, c) T0[r] *= c; FOR TD(r)[l] *= c;\n"
+    "#define IMA(r, a) FOR TD(r)[l] = T0[r] * TD(a)[l] + TD(r)[l] * T0[a]; "
+    "T0[r] *= T0[a];\n"
+    "#define ADD(r, a, e) T0[r] = T0[a] + T0[e]; "
+    "FOR TD(r)[l] = TD(a)[l] + TD(e)[l];\n"
+    "#define ADC(r, a, c) T0[r] = T0[a] + c; FOR TD(r)[l] = TD(a)[l];\n"
+    "#define SUB(r, a, e) T0[r] = T0[a] - T0[e]; "
+    "FOR TD(r)[l] = TD(a)[l] - TD(e)[l];\n"
+    "#define SBC(r, a, c) T0[r] = c - T0[a]; FOR TD(r)[l] = -TD(a)[l];\n"
+    "#define MUL(r, a, e) FOR TD(r)[l] = T0[a] * TD(e)[l] + TD(a)[l] * "
+    "T0[e]; T0[r] = T0[a] * T0[e];\n"
+    "#define MLC(r, a, c) T0[r] = T0[a] * c; FOR TD(r)[l] = TD(a)[l] * c;\n"
+    "#define DIV(r, a, e) t = 1.0 / T0[e]; T0[r] = T0[a] / T0[e]; "
+    "FOR TD(r)[l] = TD(a)[l] * t + T0[r] * (-TD(e)[l] * t);\n"
+    "#define DVC(r, a, c) t = 1.0 / T0[a]; T0[r] = c / T0[a]; "
+    "FOR TD(r)[l] = T0[r] * (-TD(a)[l] * t);\n"
+    "#define IPP(r, a, e) FOR TD(r)[l] += T0[a] * TD(e)[l] + TD(a)[l] * "
+    "T0[e]; T0[r] += T0[a] * T0[e];\n"
+    "#define IMP(r, a, e) FOR TD(r)[l] -= T0[a] * TD(e)[l] + TD(a)[l] * "
+    "T0[e]; T0[r] -= T0[a] * T0[e];\n"
+    "#define NEG(r, a) T0[r] = -T0[a]; FOR TD(r)[l] = -TD(a)[l];\n"
+    "#define EXP(r, a) T0[r] = exp(T0[a]); FOR TD(r)[l] = T0[r] * "
+    "TD(a)[l];\n"
+    "#define SIN(r, a, k) T0[k] = cos(T0[a]); T0[r] = sin(T0[a]); "
+    "FOR { TD(k)[l] = -T0[r] * TD(a)[l]; TD(r)[l] = T0[k] * TD(a)[l]; }\n"
+    "#define COS(r, a, k) T0[k] = sin(T0[a]); T0[r] = cos(T0[a]); "
+    "FOR { TD(k)[l] = T0[r] * TD(a)[l]; TD(r)[l] = -T0[k] * TD(a)[l]; }\n"
+    "#define ATN(r, a, k) T0[r] = atan(T0[a]); FOR TD(r)[l] = T0[k] * "
+    "TD(a)[l];\n"
+    "#define LOG(r, a) t = 1.0 / T0[a]; "
+    "FOR { if (T0[a] == 0.0 && TD(a)[l] < 0.0) t = NAN; "
+    "TD(r)[l] = TD(a)[l] * t; } T0[r] = log(T0[a]);\n"
+    "#define SQT(r, a) T0[r] = sqrt(T0[a]); "
+    "FOR TD(r)[l] = (T0[a] == 0.0 ? (TD(a)[l] > 0.0 ? INFINITY : "
+    "TD(a)[l] < 0.0 ? NAN : 0.0) : 0.5 / T0[r]) * TD(a)[l];\n";
+
+/* Operations of the reverse sweeps, every operation writes a value W of
+ * its own, so that none is overwritten, and their adjoints A are zero
+ * initially. o is the value updated by the operation, k the second value
+ * written by sin and cos or the derivative of atan. */
+const char *const primalMacros =
+    "#define CPY(r, a) W[r] = W[a];\n"
+    "#define CST(r, c) W[r] = c;\n"
+    "#define PAR(r, i) W[r] = P[i];\n"
+    "#define IND(r, i) W[r] = X[i];\n"
+    "#define DEP(i, r)\n"
+    "#define ADD(r, a, e) W[r] = W[a] + W[e];\n"
+    "#define ADC(r, a, c) W[r] = W[a] + c;\n"
+    "#define SUB(r, a, e) W[r] = W[a] - W[e];\n"
+    "#define SBC(r, a, c) W[r] = c - W[a];\n"
+    "#define MUL(r, a, e) W[r] = W[a] * W[e];\n"
+    "#define MLC(r, a, c) W[r] = W[a] * c;\n"
+    "#define DIV(r, a, e) W[r] = W[a] / W[e];\n"
+    "#define DVC(r, a, c) W[r] = c / W[a];\n"
+    "#define PPR(r, o, a, e) W[r] = W[o] + W[a] * W[e];\n"
+    "#define MPR(r, o, a, e) W[r] = W[o] - W[a] * W[e];\n"
+    "#define NEG(r, a) W[r] = -W[a];\n"
+    "#define EXP(r, a) W[r] = exp(W[a]);\n"
+    "#define SIN(r, a, k) W[k] = cos(W[a]); W[r] = sin(W[a]);\n"
+    "#define COS(r, a, k) W[k] = sin(W[a]); W[r] = cos(W[a]);\n"
+    "#define ATN(r, a, k) W[r] = atan(W[a]);\n"
+    "#define LOG(r, a) W[r] = log(W[a]);\n"
+    "#define SQT(r, a) W[r] = sqrt(W[a]);\n";
+
+/* the adjoint updates, in terms of AR(r, a, s, x): A[a] s= A[r] * x, and
+ * CLR(r): A[r] = 0 once the adjoints of r are propagated */
+const char *const adjointMacros =
+    "#define CPY(r, a) AR(r, a, +, 1.0) CLR(r)\n"
+    "#define CST(r, c) CLR(r)\n"
+    "#define PAR(r, i) CLR(r)\n"
+    "#define ADD(r, a, e) AR(r, a, +, 1.0) AR(r, e, +, 1.0) CLR(r)\n"
+    "#define ADC(r, a, c) AR(r, a, +, 1.0) CLR(r)\n"
+    "#define SUB(r, a, e) AR(r, a, +, 1.0) AR(r, e, -, 1.0) CLR(r)\n"
+    "#define SBC(r, a, c) AR(r, a, -, 1.0) CLR(r)\n"
+    "#define MUL(r, a, e) AR(r, a, +, W[e]) AR(r, e, +, W[a]) CLR(r)\n"
+    "#define MLC(r, a, c) AR(r, a, +, c) CLR(r)\n"
+    "#define DIV(r, a, e) t = 1.0 / W[e]; AR(r, a, +, t) "
+    "AR(r, e, +, (-W[r] * t)) CLR(r)\n"
+    "#define DVC(r, a, c) AR(r, a, +, (-W[r] / W[a])) CLR(r)\n"
+    "#define PPR(r, o, a, e) AR(r, o, +, 1.0) AR(r, e, +, W[a]) "
+    "AR(r, a, +, W[e]) CLR(r)\n"
+    "#define MPR(r, o, a, e) AR(r, o, +, 1.0) AR(r, e, -, W[a]) "
+    "AR(r, a, -, W[e]) CLR(r)\n"
+    "#define NEG(r, a) AR(r, a, -, 1.0) CLR(r)\n"
+    "#define EXP(r, a) AR(r, a, +, W[r]) CLR(r)\n"
+    "#define SIN(r, a, k) AR(r, a, +, W[k]) CLR(r)\n"
+    "#define COS(r, a, k) AR(r, a, -, W[k]) CLR(r)\n"
+    "#define ATN(r, a, k) AR(r, a, +, W[k]) CLR(r)\n"
+    "#define LOG(r, a) AR(r, a, +, (1.0 / W[a])) CLR(r)\n"
+    "#define SQT(r, a) AR(r, a, +, (W[r] == 0.0 ? 0.0 : 0.5 / W[r])) "
+    "CLR(r)\n";
+
+const char *const fosAdjointMacros =
+    "#define U ((const double *)u)\n"
+    "#define Z ((double *)z)\n"
+    "#define AR(r, a, s, x) A[a] s## = A[r] * x;\n"
+    "#define CLR(r) A[r] = 0.0;\n"
+    "#define IND(r, i) Z[i] = A[r]; CLR(r)\n"
+    "#define DEP(i, r) A[r] = U[i];\n";
+
+const char *const fovAdjointMacros =
+    "#define U ((double *const *)u)\n"
+    "#define Z ((double *const *)z)\n"
+    "#define AD(k) (A + (size_t)(k) * q)\n"
+    "#define FOR for (l = 0; l < q; l++)\n"
+    "#define AR(r, a, s, x) FOR AD(a)[l] s## = AD(r)[l] * x;\n"
+    "#define CLR(r) FOR AD(r)[l] = 0.0;\n"
+    "#define IND(r, i) FOR Z[l][i] = AD(r)[l]; CLR(r)\n"
+    "#define DEP(i, r) FOR AD(r)[l] = U[l][i];\n";
+
+/****************************************************************************/
+/*                                                       CODE GENERATION    */
+
+/* formats a value of the tape as C constant */
+void putValue(std::string &call, double c) {
+  char buf[40];
+
+  if (std::isnan(c))
+    call += "NAN";
+  else if (std::isinf(c))
+    call += c > 0 ? "INFINITY" : "(-INFINITY)";
+  else {
+    snprintf(buf, sizeof(buf), "(%a)", c);
+    call += buf;
+  }
+}
+
+/* appends the macro call name(args..., c) to calls */
+void putCall(std::vector<std::string> &calls, const char *name, size_t n,
+             const size_t *args, const double *c = nullptr) {
+  std::string call(name);
+  char buf[32];
+
+  for (size_t i = 0; i < n; i++) {
+    snprintf(buf, sizeof(buf), "%c%zu", i == 0 ? '(' : ',', args[i]);
+    call += buf;
+  }
+  if (c != nullptr) {
+    call += ',';
+    putValue(call, *c);
+  }
+  call += ')';
+  calls.push_back(call);
+}
+
+/* The macro calls of the forward sweeps over the locations of the tape */
+void forwardCalls(const ThreadedTape *tape, std::vector<std::string> &calls) {
+  const unsigned char *op = tape->ops.data();
+  const locint *loc = tape->locs.data();
+  const double *val = tape->vals.data();
+  size_t a[3];
+  const char *name;
+
+  calls.reserve(tape->ops.size());
+  for (;; ++op) {
+    switch (*op) {
+    case t_end:
+      return;
+
+      /* the argument, or an index, and the result */
+    case t_assign_a:
+      name = "CPY";
+      goto arg_res;
+    case t_assign_p:
+      name = "PAR";
+      goto arg_res;
+    case t_assign_ind:
+      name = "IND";
+      goto arg_res;
+    case t_eq_plus_a:
+      name = "IAA";
+      goto arg_res;
+    case t_eq_min_a:
+      name = "ISA";
+      goto arg_res;
+    case t_eq_mult_a:
+      name = "IMA";
+      goto arg_res;
+    case t_neg_sign_a:
+      name = "NEG";
+      goto arg_res;
+    case t_exp:
+      name = "EXP";
+      goto arg_res;
+    case t_log:
+      name = "LOG";
+      goto arg_res;
+    case t_sqrt:
+      name = "SQT";
+    arg_res:
+      a[1] = *loc++;
+      a[0] = *loc++;
+      putCall(calls, name, 2, a);
+      break;
+    case t_assign_dep:
+      a[0] = *loc++;
+      a[1] = *loc++;
+      putCall(calls, "DEP", 2, a);
+      break;
+
+      /* two arguments and the result */
+    case t_plus_a_a:
+      name = "ADD";
+      goto arg1_arg2_res;
+    case t_min_a_a:
+      name = "SUB";
+      goto arg1_arg2_res;
+    case t_mult_a_a:
+      name = "MUL";
+      goto arg1_arg2_res;
+    case t_div_a_a:
+      name = "DIV";
+      goto arg1_arg2_res;
+    case t_eq_plus_prod:
+      name = "IPP";
+      goto arg1_arg2_res;
+    case t_eq_min_prod:
+      name = "IMP";
+      goto arg1_arg2_res;
+    case t_sin:
+      name = "SIN";
+      goto arg1_arg2_res;
+    case t_cos:
+      name = "COS";
+      goto arg1_arg2_res;
+    case t_atan:
+      name = "ATN";
+    arg1_arg2_res:
+      a[1] = *loc++;
+      a[2] = *loc++;
+      a[0] = *loc++;
+      putCall(calls, name, 3, a);
+      break;
+
+      /* the argument, the result and a value */
+    case t_plus_d_a:
+      name = "ADC";
+      goto arg_res_val;
+    case t_min_d_a:
+      name = "SBC";
+      goto arg_res_val;
+    case t_mult_d_a:
+      name = "MLC";
+      goto arg_res_val;
+    case t_div_d_a:
+      name = "DVC";
+    arg_res_val:
+      a[1] = *loc++;
+      a[0] = *loc++;
+      putCall(calls, name, 2, a, val++);
+      break;
+
+      /* the result and a value */
+    case t_assign_d:
+      name = "CST";
+      goto res_val;
+    case t_eq_plus_d:
+      name = "IAD";
+      goto res_val;
+    case t_eq_mult_d:
+      name = "IMD";
+    res_val:
+      a[0] = *loc++;
+      putCall(calls, name, 1, a, val++);
+      break;
+    }
+  }
+}
+
+/* The macro calls of the reverse sweeps, whose operations write values of
+ * their own instead of the locations of the tape, so that the arguments of
+ * every operation are still available backwards. Returns false if the tape
+ * reads a location before writing it. */
+bool reverseCalls(const ThreadedTape *tape, std::vector<std::string> &calls,
+                  size_t &numSlots) {
+  const unsigned char *op = tape->ops.data();
+  const locint *loc = tape->locs.data();
+  const double *val = tape->vals.data();
+  const size_t none = (size_t)-1;
+  size_t numLocs = 0;
+  for (locint l : tape->locs)
+    if ((size_t)l >= numLocs)
+      numLocs = (size_t)l + 1;
+  std::vector<size_t> slot(numLocs, none);
+  size_t a[4], arg, res;
+  const char *name;
+
+  numSlots = 0;
+  calls.reserve(tape->ops.size());
+  for (;; ++op) {
+    switch (*op) {
+    case t_end:
+      return true;
+
+      /* an index and the result */
+    case t_assign_p:
+      name = "PAR";
+      goto index_res;
+    case t_assign_ind:
+      name = "IND";
+    index_res:
+      a[1] = *loc++;
+      a[0] = slot[*loc++] = numSlots++;
+      putCall(calls, name, 2, a);
+      break;
+    case t_assign_dep:
+      a[0] = *loc++;
+      a[1] = slot[*loc++];
+      if (a[1] == none)
+        return false;
+      putCall(calls, "DEP", 2, a);
+      break;
+
+      /* the argument and the result */
+    case t_assign_a:
+      name = "CPY";
+      goto arg_res;
+    case t_neg_sign_a:
+      name = "NEG";
+      goto arg_res;
+    case t_exp:
+      name = "EXP";
+      goto arg_res;
+    case t_log:
+      name = "LOG";
+      goto arg_res;
+    case t_sqrt:
+      name = "SQT";
+    arg_res:
+      a[1] = slot[*loc++];
+      if (a[1] == none)
+        return false;
+      a[0] = slot[*loc++] = numSlots++;
+      putCall(calls, name, 2, a);
+      break;
+
+      /* updates of the result by an argument */
+    case t_eq_plus_a:
+      name = "ADD";
+      goto arg_upd;
+    case t_eq_min_a:
+      name = "SUB";
+      goto arg_upd;
+    case t_eq_mult_a:
+      name = "MUL";
+    arg_upd:
+      a[2] = slot[*loc++];
+      res = *loc++;
+      a[1] = slot[res];
+      if (a[1] == none || a[2] == none)
+        return false;
+      a[0] = slot[res] = numSlots++;
+      putCall(calls, name, 3, a);
+      break;
+
+      /* two arguments and the result */
+    case t_plus_a_a:
+      name = "ADD";
+      goto arg1_arg2_res;
+    case t_min_a_a:
+      name = "SUB";
+      goto arg1_arg2_res;
+    case t_mult_a_a:
+      name = "MUL";
+      goto arg1_arg2_res;
+    case t_div_a_a:
+      name = "DIV";
+      goto arg1_arg2_res;
+    case t_atan:
+      name = "ATN";
+    arg1_arg2_res:
+      a[1] = slot[*loc++];
+      a[2] = slot[*loc++];
+      if (a[1] == none || a[2] == none)
+        return false;
+      a[0] = slot[*loc++] = numSlots++;
+      putCall(calls, name, 3, a);
+      break;
+    case t_sin:
+    case t_cos:
+      a[1] = slot[*loc++];
+      if (a[1] == none)
+        return false;
+      a[2] = slot[*loc++] = numSlots++;
+      a[0] = slot[*loc++] = numSlots++;
+      putCall(calls, *op == t_sin ? "SIN" : "COS", 3, a);
+      break;
+    case t_eq_plus_prod:
+    case t_eq_min_prod:
+      a[2] = slot[*loc++];
+      a[3] = slot[*loc++];
+      res = *loc++;
+      a[1] = slot[res];
+      if (a[1] == none || a[2] == none || a[3] == none)
+        return false;
+      a[0] = slot[res] = numSlots++;
+      putCall(calls, *op == t_eq_plus_prod ? "PPR" : "MPR", 4, a);
+      break;
+
+      /* the argument, the result and a value */
+    case t_plus_d_a:
+      name = "ADC";
+      goto arg_res_val;
+    case t_min_d_a:
+      name = "SBC";
+      goto arg_res_val;
+    case t_mult_d_a:
+      name = "MLC";
+      goto arg_res_val;
+    case t_div_d_a:
+      name = "DVC";
+    arg_res_val:
+      a[1] = slot[*loc++];
+      if (a[1] == none)
+        return false;
+      a[0] = slot[*loc++] = numSlots++;
+      putCall(calls, name, 2, a, val++);
+      break;
+
+      /* the result and a value */
+    case t_assign_d:
+      a[0] = slot[*loc++] = numSlots++;
+      putCall(calls, "CST", 1, a, val++);
+      break;
+    case t_eq_plus_d:
+    case t_eq_mult_d:
+      res = *loc++;
+      arg = slot[res];
+      if (arg == none)
+        return false;
+      a[1] = arg;
+      a[0] = slot[res] = numSlots++;
+      putCall(calls, *op == t_eq_plus_d ? "ADC" : "MLC", 2, a, val++);
+      break;
+    }
+  }
+}
+
+#define NATIVE_UNDEF_MACROS                                                    \
+  "#undef CPY\n#undef CST\n#undef PAR\n#undef IND\n#undef DEP\n"               \
+  "#undef ADD\n#undef ADC\n#undef SUB\n#undef SBC\n#undef MUL\n"               \
+  "#undef MLC\n#undef DIV\n#undef DVC\n#undef NEG\n#undef EXP\n"               \
+  "#undef SIN\n#undef COS\n#undef ATN\n#undef LOG\n#undef SQT\n"
+
+/* Writes the calls as functions name_<i> of ADOLC_NATIVE_CHUNK calls each
+ * and a table name of these functions, in reverse order of the calls if
+ * backwards. */
+void putChunks(FILE *source, const char *name, const char *params,
+               const char *args, const std::vector<std::string> &calls,
+               bool backwards) {
+  const size_t numChunks =
+      (calls.size() + ADOLC_NATIVE_CHUNK - 1) / ADOLC_NATIVE_CHUNK;
+
+  for (size_t c = 0; c < numChunks; c++) {
+    const size_t begin = c * ADOLC_NATIVE_CHUNK;
+    const size_t end = begin + ADOLC_NATIVE_CHUNK < calls.size()
+                           ? begin + ADOLC_NATIVE_CHUNK
+                           : calls.size();
+    fprintf(source, "void %s_%zu(%s) {\n  double t; size_t l;\n", name, c,
+            params);
+    fprintf(source, "  (void)t; (void)l; ADOLC_UNUSED(%s);\n", args);
+    if (backwards)
+      for (size_t i = end; i-- > begin;)
+        fprintf(source, "  %s\n", calls[i].c_str());
+    else
+      for (size_t i = begin; i < end; i++)
+        fprintf(source, "  %s\n", calls[i].c_str());
+    fprintf(source, "}\n");
+  }
+  fprintf(source, "static void (*const %s[])(%s) = {\n", name, params);
+  for (size_t c = 0; c < numChunks; c++)
+    fprintf(source, "  %s_%zu,\n",
+            name, backwards ? numChunks - 1 - c : c);
+  fprintf(source, "  0};\n");
+}
+
+/* Writes the C source of the sweeps of kind over tape. Returns false if
+ * the tape cannot be compiled. */
+bool writeSource(FILE *source, const ThreadedTape *tape, NativeKind kind,
+                 const unsigned char *digest) {
+  std::vector<std::string> calls;
+  const char *const forwardParams =
+      "const double *X, const void *xd, const double *P, double *Y, "
+      "void *yd, double *T0, double *T, size_t p";
+  const char *const forwardArgs = "X, xd, P, Y, yd, T0, T, p";
+  const char *const adjointParams =
+      "const void *u, void *z, double *W, double *A, size_t q";
+  const char *const adjointArgs = "u, z, W, A, q";
+  size_t numSlots = 0;
+
+  if (kind == n_rev) {
+    if (!reverseCalls(tape, calls, numSlots))
+      return false;
+  } else
+    forwardCalls(tape, calls);
+
+  fprintf(source,
+          "/* %s sweeps of a tape compiled by ADOL-C, do not edit */\n"
+          "#include <math.h>\n#include <stddef.h>\n\n"
+          "#define ADOLC_UNUSED(...) (void)(__VA_ARGS__)\n"
+          "const unsigned char adolc_native_digest[32] = {",
+          kindNames[kind]);
+  for (int i = 0; i < 32; i++)
+    fprintf(source, "%s0x%02x", i == 0 ? "" : ", ", digest[i]);
+  fputs("};\n", source);
+
+  if (kind != n_rev) {
+    fputs(forwardCommon, source);
+    fputs(kind == n_zos ? zosMacros : kind == n_fos ? fosMacros : fovMacros,
+          source);
+    putChunks(source, "forward", forwardParams, forwardArgs, calls, false);
+    fprintf(source,
+            "void adolc_native_forward(%s) {\n"
+            "  size_t c;\n"
+            "  for (c = 0; forward[c] != 0; c++)\n"
+            "    forward[c](%s);\n}\n",
+            forwardParams, forwardArgs);
+    return ferror(source) == 0;
+  }
+
+  fprintf(source, "const size_t adolc_native_slots = %zu;\n", numSlots);
+  fputs(primalMacros, source);
+  putChunks(source, "primal", "const double *X, const double *P, double *W",
+            "X, P, W", calls, false);
+  fputs(NATIVE_UNDEF_MACROS "#undef PPR\n#undef MPR\n", source);
+  fputs(adjointMacros, source);
+  fputs(fosAdjointMacros, source);
+  putChunks(source, "fos", adjointParams, adjointArgs, calls, true);
+  fputs("#undef U\n#undef Z\n#undef AR\n#undef CLR\n#undef IND\n#undef DEP\n",
+        source);
+  fputs(fovAdjointMacros, source);
+  putChunks(source, "fov", adjointParams, adjointArgs, calls, true);
+  for (int k = 0; k < 2; k++)
+    fprintf(source,
+            "void adolc_native_%s_reverse(const double *X, const double *P, "
+            "%s) {\n"
+            "  size_t c;\n"
+            "  for (c = 0; primal[c] != 0; c++)\n"
+            "    primal[c](X, P, W);\n"
+            "  for (c = 0; %s[c] != 0; c++)\n"
+            "    %s[c](%s);\n}\n",
+            k == 0 ? "fos" : "fov", adjointParams, k == 0 ? "fos" : "fov",
+            k == 0 ? "fos" : "fov", adjointArgs);
+  return ferror(source) == 0;
+}
+
+/****************************************************************************/
+/*                                           COMPILING AND LOADING          */
+
+/* SHA-256 (FIPS 180-4), by which objects compiled from another tape are
+ * told apart from those of the current one */
+class Sha256 {
+public:
+  Sha256();
+  void put(const void *data, size_t n);
+  void finish(unsigned char digest[32]);
+
+private:
+  void block(const unsigned char *bytes);
+
+  uint32_t h[8];
+  unsigned char buffer[64];
+  size_t numBuffered;
+  uint64_t numBytes;
+};
+
+const uint32_t sha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+Sha256::Sha256()
+    : h{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f,
+        0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+      numBuffered(0), numBytes(0) {}
+
+void Sha256::block(const unsigned char *bytes) {
+  auto rotr = [](uint32_t x, int n) { return (x >> n) | (x << (32 - n)); };
+  uint32_t w[64], v[8];
+
+  for (int i = 0; i < 16; i++)
+    w[i] = (uint32_t)bytes[4 * i] << 24 | (uint32_t)bytes[4 * i + 1] << 16 |
+           (uint32_t)bytes[4 * i + 2] << 8 | (uint32_t)bytes[4 * i + 3];
+  for (int i = 16; i < 64; i++)
+    w[i] = w[i - 16] + w[i - 7] +
+           (rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3)) +
+           (rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10));
+  memcpy(v, h, sizeof(v));
+  for (int i = 0; i < 64; i++) {
+    const uint32_t t1 = v[7] +
+                        (rotr(v[4], 6) ^ rotr(v[4], 11) ^ rotr(v[4], 25)) +
+                        ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha256K[i] + w[i];
+    const uint32_t t2 = (rotr(v[0], 2) ^ rotr(v[0], 13) ^ rotr(v[0], 22)) +
+                        ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+    memmove(v + 1, v, 7 * sizeof(uint32_t));
+    v[4] += t1;
+    v[0] = t1 + t2;
+  }
+  for (int i = 0; i < 8; i++)
+    h[i] += v[i];
+}
+
+void Sha256::put(const void *data, size_t n) {
+  const unsigned char *bytes = (const unsigned char *)data;
+
+  numBytes += n;
+  while (n > 0) {
+    const size_t m = std::min(n, sizeof(buffer) - numBuffered);
+    memcpy(buffer + numBuffered, bytes, m);
+    numBuffered += m;
+    bytes += m;
+    n -= m;
+    if (numBuffered == sizeof(buffer)) {
+      block(buffer);
+      numBuffered = 0;
+    }
+  }
+}
+
+void Sha256::finish(unsigned char digest[32]) {
+  const uint64_t numBits = numBytes * 8;
+  unsigned char length[8];
+
+  for (int i = 0; i < 8; i++)
+    length[i] = (unsigned char)(numBits >> (56 - 8 * i));
+  put("\x80", 1);
+  while (numBuffered != 56)
+    put("", 1);
+  put(length, sizeof(length));
+  for (int i = 0; i < 32; i++)
+    digest[i] = (unsigned char)(h[i / 4] >> (24 - 8 * (i % 4)));
+}
+
+/* SHA-256 digest of the decoded tape, the compiler command and the version
+ * of ADOL-C and of the source it writes */
+void tapeDigest(const ThreadedTape *tape, unsigned char digest[32]) {
+  const int version[4] = {ADOLC_VERSION, ADOLC_SUBVERSION, ADOLC_PATCHLEVEL,
+                          ADOLC_NATIVE_FORMAT};
+  const uint64_t sizes[3] = {tape->ops.size(), tape->locs.size(),
+                             tape->vals.size()};
+  Sha256 sha;
+
+  sha.put(version, sizeof(version));
+  sha.put(sizes, sizeof(sizes));
+  sha.put(tape->ops.data(), tape->ops.size());
+  for (locint l : tape->locs) {
+    const uint64_t l64 = l;
+    sha.put(&l64, sizeof(l64));
+  }
+  sha.put(tape->vals.data(), tape->vals.size() * sizeof(double));
+  sha.put(getNativeCompiler().data(), getNativeCompiler().size());
+  sha.finish(digest);
+}
+
+/* Returns whether dir may hold native code. It is created with mode 0700
+ * if missing, and has to be a directory, not a link, owned by the user and
+ * inaccessible to others. */
+bool isPrivateDir(const std::string &dir) {
+  struct stat st;
+
+  if (dir.empty())
+    return false;
+  if (mkdir(dir.c_str(), 0700) != 0 && errno != EEXIST)
+    return false;
+  return lstat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode) &&
+         st.st_uid == geteuid() && (st.st_mode & 077) == 0;
+}
+
+/* Runs the compiler command, split at blanks, with -o object source. It is
+ * not passed to a shell, so that the paths need no quoting. */
+bool compile(const std::string &source, const std::string &object) {
+  std::istringstream command(getNativeCompiler());
+  std::vector<std::string> words;
+  std::vector<char *> argv;
+  std::string word;
+  int status;
+
+  while (command >> word)
+    words.push_back(word);
+  if (words.empty())
+    return false;
+  words.push_back("-o");
+  words.push_back(object);
+  words.push_back(source);
+  for (std::string &w : words)
+    argv.push_back(&w[0]);
+  argv.push_back(nullptr);
+
+  const pid_t pid = fork();
+  if (pid < 0)
+    return false;
+  if (pid == 0) {
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+  while (waitpid(pid, &status, 0) < 0)
+    if (errno != EINTR)
+      return false;
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/* opens the shared object at path and resolves the sweeps of kind */
+bool loadObject(NativeTape *native, NativeKind kind, const std::string &path) {
+  void *handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  const unsigned char *digest;
+
+  if (handle == nullptr)
+    return false;
+  digest = (const unsigned char *)dlsym(handle, "adolc_native_digest");
+  if (digest == nullptr || memcmp(digest, native->digest, 32) != 0) {
+    dlclose(handle);
+    return false;
+  }
+  if (kind == n_rev) {
+    const size_t *numSlots =
+        (const size_t *)dlsym(handle, "adolc_native_slots");
+    native->fosReverse =
+        (NativeReverse)dlsym(handle, "adolc_native_fos_reverse");
+    native->fovReverse =
+        (NativeReverse)dlsym(handle, "adolc_native_fov_reverse");
+    if (numSlots == nullptr || native->fosReverse == nullptr ||
+        native->fovReverse == nullptr) {
+      dlclose(handle);
+      return false;
+    }
+    native->numSlots = *numSlots;
+  } else {
+    native->forward[kind] =
+        (NativeForward)dlsym(handle, "adolc_native_forward");
+    if (native->forward[kind] == nullptr) {
+      dlclose(handle);
+      return false;
+    }
+  }
+  native->handles[kind] = handle;
+  return true;
+}
+
+/* Loads the sweeps of kind, compiling them first unless an object with the
+ * digest of the tape is found in NATIVE_DIR. */
+bool loadKind(NativeTape *native, NativeKind kind) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (native->handles[kind] != nullptr)
+    return true;
+  if (native->failed[kind])
+    return false;
+
+  const std::string base = objectBase(native, kind);
+  const std::string object = base + ".so";
+  if (access(object.c_str(), R_OK) == 0 && loadObject(native, kind, object))
+    return true;
+
+  /* compile to files of this process and move the object in place */
+  const std::string pid = "_" + std::to_string((long)getpid());
+  const std::string source = base + pid + ".c";
+  const std::string tmpObject = base + pid + ".so";
+  bool done = false;
+  FILE *file = fopen(source.c_str(), "w");
+  if (file != nullptr) {
+    done = writeSource(file, ADOLC_CURRENT_TAPE_INFOS.threaded, kind,
+                       native->digest);
+    done = fclose(file) == 0 && done;
+    if (done)
+      done = compile(source, tmpObject) &&
+             rename(tmpObject.c_str(), object.c_str()) == 0 &&
+             loadObject(native, kind, object);
+    remove(source.c_str());
+    remove(tmpObject.c_str());
+  }
+  if (!done) {
+    fprintf(DIAG_OUT,
+            "ADOL-C warning: %s sweeps of tape %d not compiled to native "
+            "code, using the switch\n",
+            kindNames[kind], ADOLC_CURRENT_TAPE_INFOS.tapeID);
+    native->failed[kind] = true;
+  }
+  return done;
+}
+
+/* Returns the native code of the current tape if it was taped with
+ * ADOLC_TAPE_IO_NATIVE and can be compiled, nullptr otherwise. */
+NativeTape *nativeTape() {
+  NativeTape *native;
+  ThreadedTape *tape;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+        ADOLC_TAPE_IO_NATIVE))
+    return nullptr;
+  native = ADOLC_CURRENT_TAPE_INFOS.native;
+  if (native != nullptr)
+    return native;
+  tape = decodedTape();
+  if (tape == nullptr || !tape->supported)
+    return nullptr;
+
+  native = new NativeTape();
+  tapeDigest(tape, native->digest);
+  native->dir = getNativeDir();
+  native->privateDir = isPrivateDir(native->dir);
+  if (!native->privateDir) {
+    fprintf(DIAG_OUT,
+            "ADOL-C warning: NATIVE_DIR \"%s\" is not a private directory, "
+            "tape %d is not compiled to native code, using the switch\n",
+            native->dir.c_str(), ADOLC_CURRENT_TAPE_INFOS.tapeID);
+    for (int k = 0; k < n_numKinds; k++)
+      native->failed[k] = true;
+  }
+  ADOLC_CURRENT_TAPE_INFOS.native = native;
+  return native;
+}
+
+} // namespace
+
+/****************************************************************************/
+/*                                                                SWEEPS    */
+
+int nativeZosForward(const double *basepoint, double *valuepoint,
+                     double *dp_T0) {
+  NativeTape *native = nativeTape();
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (native == nullptr || !loadKind(native, n_zos))
+    return 0;
+  native->forward[n_zos](basepoint, nullptr,
+                         ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore,
+                         valuepoint, nullptr, dp_T0, nullptr, 0);
+  return 1;
+}
+
+int nativeFosForward(const double *basepoint, const double *argument,
+                     double *valuepoint, double *taylors, double *dp_T0,
+                     double *dp_T) {
+  NativeTape *native = nativeTape();
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (native == nullptr || !loadKind(native, n_fos))
+    return 0;
+  native->forward[n_fos](basepoint, argument,
+                         ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore,
+                         valuepoint, taylors, dp_T0, dp_T, 1);
+  return 1;
+}
+
+int nativeFovForward(int p, const double *basepoint, double **argument,
+                     double *valuepoint, double **taylors, double *dp_T0,
+                     double **dpp_T) {
+  NativeTape *native = nativeTape();
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  /* the rows of dpp_T are contiguous (myalloc2) */
+  if (native == nullptr || p <= 0 || !loadKind(native, n_fov))
+    return 0;
+  native->forward[n_fov](basepoint, argument,
+                         ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore,
+                         valuepoint, taylors, dp_T0, dpp_T[0], p);
+  return 1;
+}
+
+namespace {
+
+/* Returns the native code of the current tape for a reverse sweep of q
+ * directions with the values and adjoints prepared, nullptr if the sweep
+ * is left to the switch. */
+NativeTape *nativeReverse(size_t q) {
+  NativeTape *native;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  native = ADOLC_CURRENT_TAPE_INFOS.native;
+  if (native == nullptr || ADOLC_CURRENT_TAPE_INFOS.threaded == nullptr ||
+      !ADOLC_CURRENT_TAPE_INFOS.threaded->haveBase ||
+      ADOLC_CURRENT_TAPE_INFOS.in_nested_ctx ||
+      native->numSlots > ADOLC_NATIVE_MAX_WORK / (1 + q) ||
+      !loadKind(native, n_rev))
+    return nullptr;
+  /* the sweeps leave the adjoints zero, only new ones are cleared */
+  if (native->work.size() < native->numSlots * (1 + q))
+    native->work.resize(native->numSlots * (1 + q), 0.0);
+  return native;
+}
+
+} // namespace
+
+int nativeFosReverse(const double *lagrange, double *results) {
+  NativeTape *native = nativeReverse(1);
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (native == nullptr)
+    return 0;
+  const std::vector<double> &base = ADOLC_CURRENT_TAPE_INFOS.threaded->base;
+  const double *params =
+      base.data() + ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS];
+  double *W = native->work.data();
+  native->fosReverse(base.data(), params, lagrange, results, W,
+                     W + native->numSlots, 1);
+  return 1;
+}
+
+int nativeFovReverse(int q, double **lagrange, double **results) {
+  NativeTape *native = q > 0 ? nativeReverse(q) : nullptr;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (native == nullptr)
+    return 0;
+  const std::vector<double> &base = ADOLC_CURRENT_TAPE_INFOS.threaded->base;
+  const double *params =
+      base.data() + ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS];
+  double *W = native->work.data();
+  native->fovReverse(base.data(), params, lagrange, results, W,
+                     W + native->numSlots, q);
+  return 1;
+}
+
+#else /* HAVE_DLFCN_H */
+
+/* without dlopen all sweeps are left to the switch */
+int nativeZosForward(const double *, double *, double *) { return 0; }
+int nativeFosForward(const double *, const double *, double *, double *,
+                     double *, double *) {
+  return 0;
+}
+int nativeFovForward(int, const double *, double **, double *, double **,
+                     double *, double **) {
+  return 0;
+}
+int nativeFosReverse(const double *, double *) { return 0; }
+int nativeFovReverse(int, double **, double **) { return 0; }
+
+#endif /* HAVE_DLFCN_H */
@@ -0,0 +1,929 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     parallel_fov.cpp
+ Revision: $Id$
+ Contents: fov_forward and fov_reverse sweeps over tapes held in core with
+           the directions split across threads (ADOLC_TAPE_IO_PARALLEL)
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include <adolc/dvlparms.h>
+#include <adolc/taping_p.h>
+
+#include "threaded_tape.h"
+
+#include <condition_variable>
+#include <functional>
+#include <math.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/****************************************************************************/
+/* The directions of fov_forward and fov_reverse are independent of each   */
+/* other. For a tape held in core whose operations are all known to the     */
+/* threaded sweeps (see threaded_tape.h), the directions are split into     */
+/* contiguous slices, one per thread of a pool started on first use. Every  */
+/* thread sweeps the decoded tape, which is only read, over its slice with  */
+/* work arrays of its own:                                                  */
+/*   fov_forward   evaluates the values along with the tangents of its      */
+/*                 slice, as fos_forward does for one direction,            */
+/*   fov_reverse   propagates the adjoints of its slice backwards through   */
+/*                 the partial derivatives of the operations, which are     */
+/*                 computed once from the base point of the last forward    */
+/*                 sweep keeping taylors and kept until the next one.       */
+/* None of the sweeps reads the tape files or the taylor stack, so that the */
+/* threads share no state beyond the decoded tape. Sweeps with fewer than   */
+/* two directions or threads are left to the switch.                        */
+/****************************************************************************/
+
+namespace {
+
+/* locations, values and partial derivatives of the decoded operations, by
+ * which the reverse sweeps step backwards */
+const unsigned char opLocs[t_numOps] = {
+    0, /* t_end */          2, /* t_assign_a */    1, /* t_assign_d */
+    2, /* t_assign_p */     2, /* t_assign_ind */  2, /* t_assign_dep */
+    1, /* t_eq_plus_d */    2, /* t_eq_plus_a */   2, /* t_eq_min_a */
+    1, /* t_eq_mult_d */    2, /* t_eq_mult_a */   3, /* t_plus_a_a */
+    2, /* t_plus_d_a */     3, /* t_min_a_a */     2, /* t_min_d_a */
+    3, /* t_mult_a_a */     2, /* t_mult_d_a */    3, /* t_div_a_a */
+    2, /* t_div_d_a */      3, /* t_eq_plus_prod */ 3, /* t_eq_min_prod */
+    2, /* t_neg_sign_a */   2, /* t_exp */         3, /* t_sin */
+    3, /* t_cos */          3, /* t_atan */        2, /* t_log */
+    2 /* t_sqrt */};
+
+const unsigned char opVals[t_numOps] = {
+    0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0,
+    1, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+const unsigned char opDerivs[t_numOps] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0,
+    0, 2, 0, 2, 1, 2, 2, 0, 1, 1, 1, 1, 1, 1};
+
+/****************************************************************************/
+/*                                                           THREAD POOL    */
+
+/* Threads running the tasks of one sweep at a time, the calling thread
+ * takes part in the sweep. */
+class SweepPool {
+public:
+  explicit SweepPool(int numThreads);
+  ~SweepPool();
+
+  int size() const { return (int)threads.size() + 1; }
+  /* runs task(0), ..., task(numTasks - 1) and waits for all of them,
+   * returns false if one of them threw */
+  bool run(int numTasks, const std::function<void(int)> &task);
+
+private:
+  void work();
+  void stopThreads();
+  void runTask(std::unique_lock<std::mutex> &lock);
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  const std::function<void(int)> *task;
+  int numTasks;
+  int nextTask;
+  int numDone;
+  bool failed;
+  bool stop;
+  std::vector<std::thread> threads;
+};
+
+SweepPool::SweepPool(int numThreads)
+    : task(nullptr), numTasks(0), nextTask(0), numDone(0), failed(false),
+      stop(false) {
+  try {
+    for (int i = 1; i < numThreads; ++i)
+      threads.emplace_back(&SweepPool::work, this);
+  } catch (...) {
+    /* the threads started so far must be joined before they are dropped */
+    stopThreads();
+    throw;
+  }
+}
+
+SweepPool::~SweepPool() { stopThreads(); }
+
+void SweepPool::stopThreads() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  changed.notify_all();
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+bool SweepPool::run(int numTasks, const std::function<void(int)> &task) {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  this->task = &task;
+  this->numTasks = numTasks;
+  nextTask = 0;
+  numDone = 0;
+  failed = false;
+  changed.notify_all();
+  while (nextTask < numTasks)
+    runTask(lock);
+  changed.wait(lock, [&] { return numDone == numTasks; });
+  this->task = nullptr;
+  this->numTasks = 0;
+  return !failed;
+}
+
+void SweepPool::runTask(std::unique_lock<std::mutex> &lock) {
+  const int t = nextTask++;
+  bool threw = false;
+
+  lock.unlock();
+  /* an exception must not leave the pool thread, the sweep is given up */
+  try {
+    (*task)(t);
+  } catch (...) {
+    threw = true;
+  }
+  lock.lock();
+  failed = failed || threw;
+  if (++numDone == numTasks)
+    changed.notify_all();
+}
+
+void SweepPool::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (true) {
+    changed.wait(lock, [&] { return stop || nextTask < numTasks; });
+    if (stop)
+      return;
+    runTask(lock);
+  }
+}
+
+/* Returns the number of slices of p directions, 0 if the sweep is left to
+ * the switch. */
+int numSlices(int p) {
+  int numThreads;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  numThreads = ADOLC_GLOBAL_TAPE_VARS.sweepThreads;
+  if (numThreads <= 0)
+    numThreads = (int)std::thread::hardware_concurrency();
+  if (numThreads > p)
+    numThreads = p;
+  return numThreads < 2 ? 0 : numThreads;
+}
+
+/* Runs slice(0), ..., slice(num - 1) on the pool, which is started or
+ * resized as needed. Sweeps of several threads of the caller take turns.
+ * Returns false if a slice threw. */
+bool runSlices(int num, const std::function<void(int)> &slice) {
+  static std::mutex running;
+  static std::unique_ptr<SweepPool> pool;
+  std::lock_guard<std::mutex> lock(running);
+
+  if (pool == nullptr || pool->size() < num) {
+    pool.reset();
+    try {
+      pool.reset(new SweepPool(num));
+    } catch (...) {
+      return false;
+    }
+  }
+  return pool->run(num, slice);
+}
+
+/****************************************************************************/
+/*                                                          FORWARD SWEEP   */
+
+/* The fov sweep over directions l0, ..., l0 + p - 1 of the decoded tape,
+ * the operations are evaluated as in uni5_for.cpp. The tangents of a
+ * location are contiguous in T. */
+void forwardSlice(const ThreadedTape *tape, size_t numLocs,
+                  const double *paramstore, const double *basepoint,
+                  double **argument, double *valuepoint, double **taylors,
+                  int l0, int p) {
+  const unsigned char *op = tape->ops.data();
+  const locint *loc = tape->locs.data();
+  const double *val = tape->vals.data();
+  std::vector<double> dp_T0(numLocs), dp_T(numLocs * p);
+  double *T0 = dp_T0.data();
+  locint arg1, arg2, res;
+  double coval, divs, r0;
+  double *Tres, *Targ, *Targ1, *Targ2;
+  int l;
+
+#define TD(loc) (dp_T.data() + (size_t)(loc) * p)
+#define FOR_0_LE_l_LT_p for (l = 0; l < p; l++)
+
+  for (;;)
+    switch (*op++) {
+    case t_assign_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1];
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = Targ[l];
+      break;
+    case t_assign_d:
+      res = *loc++;
+      T0[res] = *val++;
+      Tres = TD(res);
+      FOR_0_LE_l_LT_p Tres[l] = 0;
+      break;
+    case t_assign_p:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = paramstore[arg1];
+      Tres = TD(res);
+      FOR_0_LE_l_LT_p Tres[l] = 0;
+      break;
+    case t_assign_ind:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = basepoint[arg1];
+      Tres = TD(res);
+      FOR_0_LE_l_LT_p Tres[l] = argument[arg1][l0 + l];
+      break;
+    case t_assign_dep:
+      arg1 = *loc++;
+      res = *loc++;
+      if (valuepoint != nullptr)
+        valuepoint[arg1] = T0[res];
+      if (taylors != nullptr) {
+        Tres = TD(res);
+        FOR_0_LE_l_LT_p taylors[arg1][l0 + l] = Tres[l];
+      }
+      break;
+    case t_eq_plus_d:
+      res = *loc++;
+      T0[res] += *val++;
+      break;
+    case t_eq_plus_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] += T0[arg1];
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] += Targ[l];
+      break;
+    case t_eq_min_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] -= T0[arg1];
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] -= Targ[l];
+      break;
+    case t_eq_mult_d:
+      res = *loc++;
+      coval = *val++;
+      T0[res] *= coval;
+      Tres = TD(res);
+      FOR_0_LE_l_LT_p Tres[l] *= coval;
+      break;
+    case t_eq_mult_a:
+      arg1 = *loc++;
+      res = *loc++;
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = T0[res] * Targ[l] + Tres[l] * T0[arg1];
+      T0[res] *= T0[arg1];
+      break;
+    case t_plus_a_a:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1] + T0[arg2];
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p Tres[l] = Targ1[l] + Targ2[l];
+      break;
+    case t_plus_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1] + *val++;
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = Targ[l];
+      break;
+    case t_min_a_a:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1] - T0[arg2];
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p Tres[l] = Targ1[l] - Targ2[l];
+      break;
+    case t_min_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = *val++ - T0[arg1];
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = -Targ[l];
+      break;
+    case t_mult_a_a:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p Tres[l] = T0[arg1] * Targ2[l] + Targ1[l] * T0[arg2];
+      T0[res] = T0[arg1] * T0[arg2];
+      break;
+    case t_mult_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      coval = *val++;
+      T0[res] = T0[arg1] * coval;
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = Targ[l] * coval;
+      break;
+    case t_div_a_a:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      divs = 1.0 / T0[arg2];
+      T0[res] = T0[arg1] / T0[arg2];
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p Tres[l] =
+          Targ1[l] * divs + T0[res] * (-Targ2[l] * divs);
+      break;
+    case t_div_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      coval = *val++;
+      divs = 1.0 / T0[arg1];
+      T0[res] = coval / T0[arg1];
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = T0[res] * (-Targ[l] * divs);
+      break;
+    case t_eq_plus_prod:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p Tres[l] += T0[arg1] * Targ2[l] + Targ1[l] * T0[arg2];
+      T0[res] += T0[arg1] * T0[arg2];
+      break;
+    case t_eq_min_prod:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p Tres[l] -= T0[arg1] * Targ2[l] + Targ1[l] * T0[arg2];
+      T0[res] -= T0[arg1] * T0[arg2];
+      break;
+    case t_neg_sign_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = -T0[arg1];
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = -Targ[l];
+      break;
+    case t_exp:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = exp(T0[arg1]);
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = T0[res] * Targ[l];
+      break;
+    case t_sin:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      /* Note: always arg2 != arg1 */
+      T0[arg2] = cos(T0[arg1]);
+      T0[res] = sin(T0[arg1]);
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p {
+        Targ2[l] = -T0[res] * Targ1[l];
+        Tres[l] = T0[arg2] * Targ1[l];
+      }
+      break;
+    case t_cos:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      /* Note: always arg2 != arg1 */
+      T0[arg2] = sin(T0[arg1]);
+      T0[res] = cos(T0[arg1]);
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      Targ2 = TD(arg2);
+      FOR_0_LE_l_LT_p {
+        Targ2[l] = T0[res] * Targ1[l];
+        Tres[l] = -T0[arg2] * Targ1[l];
+      }
+      break;
+    case t_atan:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      T0[res] = atan(T0[arg1]);
+      Tres = TD(res);
+      Targ1 = TD(arg1);
+      FOR_0_LE_l_LT_p Tres[l] = T0[arg2] * Targ1[l];
+      break;
+    case t_log:
+      arg1 = *loc++;
+      res = *loc++;
+      divs = 1.0 / T0[arg1];
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p {
+        if (T0[arg1] == 0.0 && Targ[l] < 0.0)
+          divs = make_nan();
+        Tres[l] = Targ[l] * divs;
+      }
+      T0[res] = log(T0[arg1]);
+      break;
+    case t_sqrt:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = sqrt(T0[arg1]);
+      Tres = TD(res);
+      Targ = TD(arg1);
+      FOR_0_LE_l_LT_p {
+        if (T0[arg1] == 0.0) {
+          /* Note: <=> T0[res] == 0.0 */
+          if (Targ[l] > 0.0)
+            r0 = make_inf();
+          else if (Targ[l] < 0.0)
+            r0 = make_nan();
+          else
+            r0 = 0.0;
+        } else
+          r0 = 0.5 / T0[res];
+        Tres[l] = r0 * Targ[l];
+      }
+      break;
+    case t_end:
+    default:
+      return;
+    }
+}
+
+/****************************************************************************/
+/*                                                          REVERSE SWEEP   */
+
+/* Evaluates the decoded tape at its base point and stores the partial
+ * derivatives of the operations with respect to their arguments, in the
+ * order of the arguments, with the values read as fo_rev.cpp reads them
+ * from the taylor stack. */
+void partialDerivatives(ThreadedTape *tape, size_t numLocs, size_t n) {
+  const unsigned char *op = tape->ops.data();
+  const locint *loc = tape->locs.data();
+  const double *val = tape->vals.data();
+  const double *basepoint = tape->base.data();
+  const double *paramstore = basepoint + n;
+  std::vector<double> dp_T0(numLocs);
+  std::vector<double> &derivs = tape->derivs;
+  double *T0 = dp_T0.data();
+  locint arg1, arg2, res;
+  double r0;
+
+  derivs.clear();
+  for (;;)
+    switch (*op++) {
+    case t_assign_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1];
+      break;
+    case t_assign_d:
+      res = *loc++;
+      T0[res] = *val++;
+      break;
+    case t_assign_p:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = paramstore[arg1];
+      break;
+    case t_assign_ind:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = basepoint[arg1];
+      break;
+    case t_assign_dep:
+      loc += 2;
+      break;
+    case t_eq_plus_d:
+      res = *loc++;
+      T0[res] += *val++;
+      break;
+    case t_eq_plus_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] += T0[arg1];
+      break;
+    case t_eq_min_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] -= T0[arg1];
+      break;
+    case t_eq_mult_d:
+      res = *loc++;
+      T0[res] *= *val++;
+      break;
+    case t_eq_mult_a:
+      arg1 = *loc++;
+      res = *loc++;
+      derivs.push_back(T0[res]);
+      derivs.push_back(T0[arg1]);
+      T0[res] *= T0[arg1];
+      break;
+    case t_plus_a_a:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1] + T0[arg2];
+      break;
+    case t_plus_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1] + *val++;
+      break;
+    case t_min_a_a:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1] - T0[arg2];
+      break;
+    case t_min_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = *val++ - T0[arg1];
+      break;
+    case t_mult_a_a:
+    case t_eq_plus_prod:
+    case t_eq_min_prod:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      derivs.push_back(T0[arg2]);
+      derivs.push_back(T0[arg1]);
+      if (op[-1] == t_mult_a_a)
+        T0[res] = T0[arg1] * T0[arg2];
+      else if (op[-1] == t_eq_plus_prod)
+        T0[res] += T0[arg1] * T0[arg2];
+      else
+        T0[res] -= T0[arg1] * T0[arg2];
+      break;
+    case t_mult_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = T0[arg1] * *val++;
+      break;
+    case t_div_a_a:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      r0 = 1.0 / T0[arg2];
+      T0[res] = T0[arg1] / T0[arg2];
+      derivs.push_back(r0);
+      derivs.push_back(-T0[res] * r0);
+      break;
+    case t_div_d_a:
+      arg1 = *loc++;
+      res = *loc++;
+      r0 = T0[arg1];
+      T0[res] = *val++ / T0[arg1];
+      derivs.push_back(-T0[res] / r0);
+      break;
+    case t_neg_sign_a:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = -T0[arg1];
+      break;
+    case t_exp:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = exp(T0[arg1]);
+      derivs.push_back(T0[res]);
+      break;
+    case t_sin:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      T0[arg2] = cos(T0[arg1]);
+      T0[res] = sin(T0[arg1]);
+      derivs.push_back(T0[arg2]);
+      break;
+    case t_cos:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      T0[arg2] = sin(T0[arg1]);
+      T0[res] = cos(T0[arg1]);
+      derivs.push_back(-T0[arg2]);
+      break;
+    case t_atan:
+      arg1 = *loc++;
+      arg2 = *loc++;
+      res = *loc++;
+      derivs.push_back(T0[arg2]);
+      T0[res] = atan(T0[arg1]);
+      break;
+    case t_log:
+      arg1 = *loc++;
+      res = *loc++;
+      derivs.push_back(1.0 / T0[arg1]);
+      T0[res] = log(T0[arg1]);
+      break;
+    case t_sqrt:
+      arg1 = *loc++;
+      res = *loc++;
+      T0[res] = sqrt(T0[arg1]);
+      derivs.push_back(T0[res] == 0.0 ? 0.0 : 0.5 / T0[res]);
+      break;
+    case t_end:
+    default:
+      tape->haveDerivs = true;
+      return;
+    }
+}
+
+/* The fov sweep backwards over directions l0, ..., l0 + q - 1 of the
+ * decoded tape, the adjoints are updated in the order of fo_rev.cpp. The
+ * adjoints of a location are contiguous in A. */
+void reverseSlice(const ThreadedTape *tape, size_t numLocs, double **lagrange,
+                  double **results, int l0, int q) {
+  const unsigned char *const ops = tape->ops.data();
+  const unsigned char *op = ops + tape->ops.size() - 1; /* t_end */
+  const locint *loc = tape->locs.data() + tape->locs.size();
+  const double *val = tape->vals.data() + tape->vals.size();
+  const double *d = tape->derivs.data() + tape->derivs.size();
+  std::vector<double> rpp_A(numLocs * q, 0.0);
+  double aTmp;
+  double *Ares, *Aarg, *Aarg1, *Aarg2;
+  int l;
+
+#define AD(loc) (rpp_A.data() + (size_t)(loc) * q)
+#define FOR_0_LE_l_LT_q for (l = 0; l < q; l++)
+
+  while (op != ops) {
+    const unsigned char operation = *--op;
+    loc -= opLocs[operation];
+    val -= opVals[operation];
+    d -= opDerivs[operation];
+    switch (operation) {
+    case t_assign_a:
+      Aarg = AD(loc[0]);
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q {
+        Aarg[l] += Ares[l];
+        Ares[l] = 0.0;
+      }
+      break;
+    case t_assign_d:
+      Ares = AD(loc[0]);
+      FOR_0_LE_l_LT_q Ares[l] = 0.0;
+      break;
+    case t_assign_p:
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q Ares[l] = 0.0;
+      break;
+    case t_assign_ind:
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q results[l0 + l][loc[0]] = Ares[l];
+      break;
+    case t_assign_dep:
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q Ares[l] = lagrange[l0 + l][loc[0]];
+      break;
+    case t_eq_plus_d:
+      break;
+    case t_eq_plus_a:
+    case t_eq_min_a:
+      Aarg = AD(loc[0]);
+      Ares = AD(loc[1]);
+      if (operation == t_eq_plus_a)
+        FOR_0_LE_l_LT_q Aarg[l] += Ares[l];
+      else
+        FOR_0_LE_l_LT_q Aarg[l] -= Ares[l];
+      break;
+    case t_eq_mult_d:
+      Ares = AD(loc[0]);
+      FOR_0_LE_l_LT_q Ares[l] *= val[0];
+      break;
+    case t_eq_mult_a:
+      Aarg = AD(loc[0]);
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q {
+        aTmp = Ares[l];
+        Ares[l] = aTmp * d[1];
+        Aarg[l] += aTmp * d[0];
+      }
+      break;
+    case t_plus_a_a:
+    case t_min_a_a:
+      Aarg1 = AD(loc[0]);
+      Aarg2 = AD(loc[1]);
+      Ares = AD(loc[2]);
+      FOR_0_LE_l_LT_q {
+        aTmp = Ares[l];
+        Ares[l] = 0.0;
+        Aarg1[l] += aTmp;
+        if (operation == t_plus_a_a)
+          Aarg2[l] += aTmp;
+        else
+          Aarg2[l] -= aTmp;
+      }
+      break;
+    case t_plus_d_a:
+    case t_min_d_a:
+    case t_neg_sign_a:
+      Aarg = AD(loc[0]);
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q {
+        aTmp = Ares[l];
+        Ares[l] = 0.0;
+        if (operation == t_plus_d_a)
+          Aarg[l] += aTmp;
+        else
+          Aarg[l] -= aTmp;
+      }
+      break;
+    case t_mult_a_a:
+    case t_div_a_a:
+      Aarg1 = AD(loc[0]);
+      Aarg2 = AD(loc[1]);
+      Ares = AD(loc[2]);
+      FOR_0_LE_l_LT_q {
+        aTmp = Ares[l];
+        Ares[l] = 0.0;
+        Aarg2[l] += aTmp * d[1];
+        Aarg1[l] += aTmp * d[0];
+      }
+      break;
+    case t_eq_plus_prod:
+    case t_eq_min_prod:
+      Aarg1 = AD(loc[0]);
+      Aarg2 = AD(loc[1]);
+      Ares = AD(loc[2]);
+      if (operation == t_eq_plus_prod)
+        FOR_0_LE_l_LT_q {
+          Aarg2[l] += Ares[l] * d[1];
+          Aarg1[l] += Ares[l] * d[0];
+        }
+      else
+        FOR_0_LE_l_LT_q {
+          Aarg2[l] -= Ares[l] * d[1];
+          Aarg1[l] -= Ares[l] * d[0];
+        }
+      break;
+    case t_mult_d_a:
+      Aarg = AD(loc[0]);
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q {
+        aTmp = Ares[l];
+        Ares[l] = 0.0;
+        Aarg[l] += val[0] * aTmp;
+      }
+      break;
+    case t_div_d_a:
+    case t_exp:
+    case t_log:
+    case t_sqrt:
+      Aarg = AD(loc[0]);
+      Ares = AD(loc[1]);
+      FOR_0_LE_l_LT_q {
+        aTmp = Ares[l];
+        Ares[l] = 0.0;
+        Aarg[l] += aTmp * d[0];
+      }
+      break;
+    case t_sin:
+    case t_cos:
+    case t_atan:
+      Aarg1 = AD(loc[0]);
+      Ares = AD(loc[2]);
+      FOR_0_LE_l_LT_q {
+        aTmp = Ares[l];
+        Ares[l] = 0.0;
+        Aarg1[l] += aTmp * d[0];
+      }
+      break;
+    }
+  }
+}
+
+#undef TD
+#undef FOR_0_LE_l_LT_p
+#undef AD
+#undef FOR_0_LE_l_LT_q
+
+} // namespace
+
+/****************************************************************************/
+/* Runs fov_forward over the current tape with the p directions split      */
+/* across threads if it was taped with ADOLC_TAPE_IO_PARALLEL and is held   */
+/* in core. Returns 0 if the tape is to be swept by the switch of           */
+/* uni5_for.cpp, also if one of the slices failed.                          */
+/****************************************************************************/
+int parallelFovForward(int p, const double *basepoint, double **argument,
+                       double *valuepoint, double **taylors) {
+  ThreadedTape *tape;
+  int num;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+        ADOLC_TAPE_IO_PARALLEL))
+    return 0;
+  num = numSlices(p);
+  if (num == 0)
+    return 0;
+  tape = decodedTape();
+  if (tape == nullptr || !tape->supported)
+    return 0;
+
+  const size_t numLocs = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES];
+  const double *paramstore = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore;
+  if (!runSlices(num, [&](int s) {
+        const int l0 = (int)((long)s * p / num);
+        const int l1 = (int)((long)(s + 1) * p / num);
+        forwardSlice(tape, numLocs, paramstore, basepoint, argument,
+                     s == 0 ? valuepoint : nullptr, taylors, l0, l1 - l0);
+      })) {
+    fprintf(DIAG_OUT,
+            "ADOL-C warning: parallel fov_forward of tape %d failed, "
+            "using the switch\n",
+            ADOLC_CURRENT_TAPE_INFOS.tapeID);
+    return 0;
+  }
+  return 1;
+}
+
+/****************************************************************************/
+/* Runs fov_reverse over the current tape with the q directions split      */
+/* across threads if it was taped with ADOLC_TAPE_IO_PARALLEL, is held in   */
+/* core and the last forward sweep keeping taylors recorded its base point. */
+/* Returns 0 if the tape is to be swept by the switch of fo_rev.cpp, also   */
+/* if one of the slices failed.                                             */
+/****************************************************************************/
+int parallelFovReverse(int q, double **lagrange, double **results) {
+  ThreadedTape *tape;
+  int num;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+        ADOLC_TAPE_IO_PARALLEL))
+    return 0;
+  tape = ADOLC_CURRENT_TAPE_INFOS.threaded;
+  if (tape == nullptr || !tape->supported || !tape->haveBase ||
+      ADOLC_CURRENT_TAPE_INFOS.in_nested_ctx)
+    return 0;
+  num = numSlices(q);
+  if (num == 0)
+    return 0;
+
+  const size_t numLocs = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES];
+  if (!tape->haveDerivs)
+    partialDerivatives(tape, numLocs,
+                       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS]);
+  if (!runSlices(num, [&](int s) {
+        const int l0 = (int)((long)s * q / num);
+        const int l1 = (int)((long)(s + 1) * q / num);
+        reverseSlice(tape, numLocs, lagrange, results, l0, l1 - l0);
+      })) {
+    fprintf(DIAG_OUT,
+            "ADOL-C warning: parallel fov_reverse of tape %d failed, "
+            "using the switch\n",
+            ADOLC_CURRENT_TAPE_INFOS.tapeID);
+    return 0;
+  }
+  return 1;
+}
@@ -18,14 +18,202 @@
 #include <adolc/revolve.h>
 #include <adolc/taping_p.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring> // For memset
 #include <iostream>
 #include <limits>
+#include <new>
+#include <vector>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
 #include <errno.h>
+#if defined(HAVE_SYS_MMAN_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+/****************************************************************************/
+/* Memory of the location stores. Stores of storeMapBytes and more are      */
+/* private anonymous memory, smaller ones stay on the heap. With OpenMP,    */
+/* the master writes a large serial store into an anonymous file when a     */
+/* parallel region starts (snapshotStore), which costs one copy of the      */
+/* store. The workers map the snapshot copy-on-write instead of copying the */
+/* store each. The snapshot is never written afterwards, so pages a worker  */
+/* did not write yet keep the values of the region start. A header in       */
+/* front of every store holds the size of its mapping, 0 for heap stores.   */
+/****************************************************************************/
+#if defined(_OPENMP) && defined(HAVE_MEMFD_CREATE) && defined(HAVE_UNISTD_H)
+#define ADOLC_STORE_COPY_ON_WRITE 1
+
+namespace {
+struct alignas(16) StoreHeader {
+  size_t mapBytes; // size of the mapping including the first page, 0 if the
+                   // store is on the heap
+};
+
+/* stores of fewer bytes are not worth a mapping of their own */
+const size_t storeMapBytes = size_t(64) << 10;
+
+/* the snapshot of the serial store of the current parallel region */
+struct StoreSnapshot {
+  const double *store = nullptr;
+  size_t n = 0;
+  int fd = -1;
+} storeSnapshot;
+
+size_t storePageSize() {
+  static const size_t pageSize = sysconf(_SC_PAGESIZE);
+  return pageSize;
+}
+
+StoreHeader *storeHeader(const double *store) {
+  return reinterpret_cast<StoreHeader *>(const_cast<double *>(store)) - 1;
+}
+
+/* maps a private store of mapBytes, a copy-on-write view of the file fd or
+ * anonymous memory if fd < 0 */
+double *mapStore(int fd, size_t mapBytes) {
+  void *map =
+      mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE,
+           fd >= 0 ? MAP_PRIVATE : MAP_PRIVATE | MAP_ANONYMOUS, fd, 0);
+  if (map == MAP_FAILED)
+    return nullptr;
+  double *store = reinterpret_cast<double *>(static_cast<char *>(map) +
+                                             storePageSize());
+  storeHeader(store)->mapBytes = mapBytes;
+  return store;
+}
+} // namespace
+#endif
+
+double *allocStore(size_t n) {
+#if defined(ADOLC_STORE_COPY_ON_WRITE)
+  double *store;
+  if (n * sizeof(double) >= storeMapBytes) {
+    store = mapStore(-1, storePageSize() + n * sizeof(double));
+    if (store == nullptr)
+      throw std::bad_alloc();
+  } else {
+    StoreHeader *header = new StoreHeader[1 + (n * sizeof(double) +
+                                               sizeof(StoreHeader) - 1) /
+                                                  sizeof(StoreHeader)];
+    header->mapBytes = 0;
+    store = reinterpret_cast<double *>(header + 1);
+  }
+  return store;
+#else
+  return new double[n];
+#endif
+}
+
+void freeStore(double *store) {
+  if (store == nullptr)
+    return;
+#if defined(ADOLC_STORE_COPY_ON_WRITE)
+  StoreHeader *const header = storeHeader(store);
+  if (header->mapBytes == 0)
+    delete[] header;
+  else
+    munmap(reinterpret_cast<char *>(store) - storePageSize(),
+           header->mapBytes);
+#else
+  delete[] store;
+#endif
+}
+
+size_t snapshotStore(const double *store, size_t n) {
+#if defined(ADOLC_STORE_COPY_ON_WRITE)
+  releaseStoreSnapshot();
+  const size_t bytes = n * sizeof(double);
+  // small stores are copied by the workers
+  if (store == nullptr || bytes < storeMapBytes)
+    return 0;
+  const int fd = memfd_create("adolc-store", MFD_CLOEXEC);
+  if (fd < 0)
+    return 0;
+  bool ok = ftruncate(fd, storePageSize() + bytes) == 0;
+  for (size_t done = 0; ok && done < bytes;) {
+    const ssize_t written =
+        pwrite(fd, reinterpret_cast<const char *>(store) + done, bytes - done,
+               storePageSize() + done);
+    if (written > 0)
+      done += written;
+    else
+      ok = written < 0 && errno == EINTR;
+  }
+  if (!ok) {
+    close(fd);
+    return 0;
+  }
+  storeSnapshot.store = store;
+  storeSnapshot.n = n;
+  storeSnapshot.fd = fd;
+  return bytes;
+#else
+  (void)store;
+  (void)n;
+  return 0;
+#endif
+}
+
+void releaseStoreSnapshot() {
+#if defined(ADOLC_STORE_COPY_ON_WRITE)
+  // the views of the workers keep the file alive
+  if (storeSnapshot.fd >= 0)
+    close(storeSnapshot.fd);
+  storeSnapshot = StoreSnapshot();
+#endif
+}
+
+double *copyStore(const double *store, size_t n, size_t &copiedBytes) {
+#if defined(ADOLC_STORE_COPY_ON_WRITE)
+  if (store != nullptr && store == storeSnapshot.store &&
+      n == storeSnapshot.n) {
+    double *copy =
+        mapStore(storeSnapshot.fd, storePageSize() + n * sizeof(double));
+    if (copy != nullptr) {
+      copiedBytes = 0;
+      return copy;
+    }
+  }
+#endif
+  double *copy = allocStore(n);
+  if (n > 0)
+    memcpy(copy, store, n * sizeof(double));
+  copiedBytes = n * sizeof(double);
+  return copy;
+}
+
+size_t storeBytesWritten(const double *store, size_t n) {
+#if defined(ADOLC_STORE_COPY_ON_WRITE) && defined(__linux__)
+  // pages copied on write are anonymous, unlike those of the snapshot file
+  const size_t pageSize = storePageSize();
+  const size_t first = reinterpret_cast<uintptr_t>(store) / pageSize;
+  const size_t numPages = (n * sizeof(double) + pageSize - 1) / pageSize;
+  const int fd = open("/proc/self/pagemap", O_RDONLY);
+  if (fd >= 0) {
+    std::vector<uint64_t> entries(numPages);
+    const ssize_t bytes = entries.size() * sizeof(uint64_t);
+    const bool ok =
+        pread(fd, entries.data(), bytes, first * sizeof(uint64_t)) == bytes;
+    close(fd);
+    if (ok) {
+      size_t written = 0;
+      for (const uint64_t entry : entries) {
+        const bool inMemory = entry & (uint64_t(3) << 62); // present/swapped
+        const bool filePage = entry & (uint64_t(1) << 61);
+        if (inMemory && !filePage)
+          ++written;
+      }
+      return std::min(written * pageSize, n * sizeof(double));
+    }
+  }
+#endif
+  // unknown, count the store as copied
+  return store != nullptr ? n * sizeof(double) : 0;
+}
 
 #if defined(ADOLC_TRACK_ACTIVITY)
 
@@ -72,7 +260,7 @@ StoreManagerLocint::~StoreManagerLocint() {
   std::cerr << "StoreManagerLocint::~StoreManagerLocint()\n";
 #endif
   if (storePtr) {
-    delete[] storePtr;
+    freeStore(storePtr);
     storePtr = 0;
   }
   if (indexFree) {
@@ -140,6 +328,18 @@ void StoreManagerLocint::ensure_block(size_t n) {
              __FILE__, __LINE__);
 }
 
+locint StoreManagerLocint::next_loc_block(size_t n) {
+  // singleton locations are never handed out as blocks, ensure_block fails
+  // hard, location 0 is never returned
+  ensure_block(n);
+  return 0;
+}
+
+void StoreManagerLocint::free_loc_block(locint loc, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    free_loc(loc + i);
+}
+
 void StoreManagerLocint::grow(size_t mingrow) {
   if (maxsize == 0)
     maxsize += initialSize;
@@ -178,7 +378,7 @@ void StoreManagerLocint::grow(size_t mingrow) {
             << maxsize * sizeof(double) << " B doubles "
             << "and " << maxsize * sizeof(locint) << " B locints\n";
 #endif
-  storePtr = new double[maxsize];
+  storePtr = allocStore(maxsize);
   indexFree = new locint[maxsize];
 #if defined(ADOLC_TRACK_ACTIVITY)
   if (activityTracking)
@@ -213,7 +413,7 @@ void StoreManagerLocint::grow(size_t mingrow) {
               << oldMaxsize * sizeof(double) << " + "
               << oldMaxsize * sizeof(locint) << " B\n";
 #endif
-    delete[] oldStore;
+    freeStore(oldStore);
     delete[] oldIndex;
 #if defined(ADOLC_TRACK_ACTIVITY)
     if (activityTracking)
@@ -248,6 +448,24 @@ void free_loc(locint loc) {
   ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr->free_loc(loc);
 }
 
+/****************************************************************************/
+/* Returns the first of n contiguous free locations in "adouble" memory.    */
+/****************************************************************************/
+locint next_loc_block(size_t n) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  return ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr->next_loc_block(n);
+}
+
+/****************************************************************************/
+/* frees n contiguous locations starting at loc in "adouble" memory         */
+/****************************************************************************/
+void free_loc_block(locint loc, size_t n) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr->free_loc_block(loc, n);
+}
+
 #if defined(ADOLC_TRACK_ACTIVITY)
 
 char const *const StoreManagerLocintBlock::nowhere = NULL;
@@ -315,7 +533,7 @@ StoreManagerLocintBlock::~StoreManagerLocintBlock() {
   std::cerr << "StoreManagerLocintBlock::~StoreManagerLocintBlock()\n";
 #endif
   if (storePtr != NULL) {
-    delete[] storePtr;
+    freeStore(storePtr);
     storePtr = NULL;
   }
   if (!indexFree.empty()) {
@@ -439,27 +657,31 @@ void StoreManagerLocintBlock::grow(size_t minGrow) {
   // first figure out what eventual size we want
   size_t const oldMaxsize = maxsize;
 
+  // locations are indices of type locint, narrow ones (32-bit) overflow
+  // long before size_t does
+  size_t const maxLocints = std::numeric_limits<locint>::max();
+
+  if (oldMaxsize > maxLocints - minGrow) {
+    // encapsulate this error message
+    fprintf(DIAG_OUT, "\nADOL-C error:\n");
+    fprintf(DIAG_OUT,
+            "maximal number (%zu) of live active variables exceeded\n\n",
+            maxLocints);
+    adolc_exit(-3, "", __func__, __FILE__, __LINE__);
+  }
+
   if (maxsize == 0) {
     maxsize = initialSize;
   } else {
-    maxsize *= 2;
+    maxsize = oldMaxsize > maxLocints / 2 ? maxLocints : 2 * oldMaxsize;
   }
 
   if (minGrow > 0) {
     while (maxsize - oldMaxsize < minGrow) {
-      maxsize *= 2;
+      maxsize = maxsize > maxLocints / 2 ? maxLocints : 2 * maxsize;
     }
   }
 
-  if (maxsize > std::numeric_limits<locint>::max()) {
-    // encapsulate this error message
-    fprintf(DIAG_OUT, "\nADOL-C error:\n");
-    fprintf(DIAG_OUT,
-            "maximal number (%zu) of live active variables exceeded\n\n",
-            std::numeric_limits<locint>::max());
-    adolc_exit(-3, "", __func__, __FILE__, __LINE__);
-  }
-
 #ifdef ADOLC_LOCDEBUG
   // index 0 is not used, means one slot less
   std::cerr << "StoreManagerLocintBlock::grow(): increase size from "
@@ -477,7 +699,7 @@ void StoreManagerLocintBlock::grow(size_t minGrow) {
   std::cerr << "StoreManagerLocintBlock::grow(): allocate "
             << maxsize * sizeof(double) << " B doubles\n";
 #endif
-  storePtr = new double[maxsize];
+  storePtr = allocStore(maxsize);
   assert(storePtr);
   memset(storePtr, 0, maxsize * sizeof(double));
 #if defined(ADOLC_TRACK_ACTIVITY)
@@ -503,7 +725,7 @@ void StoreManagerLocintBlock::grow(size_t minGrow) {
     std::cerr << "StoreManagerLocintBlock::grow(): free "
               << oldMaxsize * sizeof(double) << "\n";
 #endif
-    delete[] oldStore;
+    freeStore(oldStore);
 #if defined(ADOLC_TRACK_ACTIVITY)
     if (activityTracking) {
       delete[] oldactStore;
@@ -588,6 +810,62 @@ void StoreManagerLocintBlock::free_loc(locint loc) {
 #endif
 }
 
+locint StoreManagerLocintBlock::next_loc_block(size_t n) {
+  // moves a block of at least n locations to the front
+  ensure_block(n);
+
+  struct FreeBlock &front = indexFree.front();
+  locint const result = front.next;
+  front.size -= n;
+  front.next += n;
+  if (front.size == 0) {
+    // keep the list non-empty, free_loc merges into its front
+    if (next(indexFree.cbegin()) == indexFree.cend())
+      grow();
+    else
+      indexFree.pop_front();
+  }
+
+  currentfill += n;
+
+#ifdef ADOLC_LOCDEBUG
+  std::cerr << "StoreManagerLocintBlock::next_loc_block: result: " << result
+            << " size: " << n << " fill: " << size() << "max: " << maxSize()
+            << endl;
+#endif
+
+  return result;
+}
+
+void StoreManagerLocintBlock::free_loc_block(locint loc, size_t n) {
+  assert(loc + n <= maxsize);
+  if (n == 0)
+    return;
+
+  struct FreeBlock &front = indexFree.front();
+  if ((loc + n == front.next) || (front.next + front.size == loc)) {
+    front.size += n;
+    if (loc + n == front.next)
+      front.next = loc;
+  } else {
+    indexFree.emplace_front(
+#if defined(_MSC_VER) && _MSC_VER <= 1800
+        FreeBlock(
+#endif
+            loc, n
+#if defined(_MSC_VER) && _MSC_VER <= 1800
+            )
+#endif
+    );
+  }
+
+  currentfill -= n;
+#ifdef ADOLC_LOCDEBUG
+  std::cerr << "free_loc_block: " << loc << " size: " << n
+            << " fill: " << size() << "max: " << maxSize() << endl;
+#endif
+}
+
 // helper for creating contiguous adouble locations
 void ensureContiguousLocations(size_t n) {
   ADOLC_OPENMP_THREAD_NUMBER;
@@ -632,6 +910,302 @@ void StoreManagerLocintBlock::consolidateBlocks() {
 #endif
 }
 
+#if defined(ADOLC_TRACK_ACTIVITY)
+
+char const *const StoreManagerLocintSegregated::nowhere = NULL;
+
+StoreManagerLocintSegregated::StoreManagerLocintSegregated(
+    double *&storePtr, char *&actStorePtr, size_t &size, size_t &numlives)
+    : storePtr(storePtr), activityTracking(1), actStorePtr(actStorePtr),
+      nonEmptyBins(0), run{0, 0}, freedSinceCoalesce(false), maxsize(size),
+      currentfill(numlives) {}
+
+StoreManagerLocintSegregated::StoreManagerLocintSegregated(
+    const StoreManagerLocintSegregated *const stm, double *&storePtr,
+    char *&actStorePtr, size_t &size, size_t &numlives)
+    : storePtr(storePtr), activityTracking(1), actStorePtr(actStorePtr),
+      nonEmptyBins(stm->nonEmptyBins), freeBits(stm->freeBits), run(stm->run),
+      freedSinceCoalesce(stm->freedSinceCoalesce), maxsize(size),
+      currentfill(numlives) {
+  for (size_t bin = 0; bin < numBins; ++bin)
+    bins[bin] = stm->bins[bin];
+}
+#endif
+
+StoreManagerLocintSegregated::StoreManagerLocintSegregated(double *&storePtr,
+                                                           size_t &size,
+                                                           size_t &numlives)
+    : storePtr(storePtr),
+#if defined(ADOLC_TRACK_ACTIVITY)
+      activityTracking(0), actStorePtr(const_cast<char *&>(nowhere)),
+#endif
+      nonEmptyBins(0), run{0, 0}, freedSinceCoalesce(false), maxsize(size),
+      currentfill(numlives) {
+}
+
+StoreManagerLocintSegregated::StoreManagerLocintSegregated(
+    const StoreManagerLocintSegregated *const stm, double *&storePtr,
+    size_t &size, size_t &numlives)
+    : storePtr(storePtr),
+#if defined(ADOLC_TRACK_ACTIVITY)
+      activityTracking(0), actStorePtr(const_cast<char *&>(nowhere)),
+#endif
+      nonEmptyBins(stm->nonEmptyBins), freeBits(stm->freeBits), run(stm->run),
+      freedSinceCoalesce(stm->freedSinceCoalesce), maxsize(size),
+      currentfill(numlives) {
+  for (size_t bin = 0; bin < numBins; ++bin)
+    bins[bin] = stm->bins[bin];
+}
+
+StoreManagerLocintSegregated::~StoreManagerLocintSegregated() {
+  if (storePtr != NULL) {
+    freeStore(storePtr);
+    storePtr = NULL;
+  }
+#if defined(ADOLC_TRACK_ACTIVITY)
+  if (activityTracking && actStorePtr) {
+    delete[] actStorePtr;
+  }
+#endif
+  maxsize = 0;
+  currentfill = 0;
+}
+
+size_t StoreManagerLocintSegregated::binOf(size_t size) {
+  size_t bin = 0;
+  while (size >>= 1)
+    ++bin;
+  return bin;
+}
+
+void StoreManagerLocintSegregated::markFree(size_t loc, size_t n,
+                                            bool isFree) {
+  const size_t end = loc + n;
+  while (loc < end) {
+    const size_t bit = loc % 64;
+    const size_t bits = std::min<size_t>(64 - bit, end - loc);
+    const uint64_t mask =
+        (bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1) << bit;
+    if (isFree)
+      freeBits[loc / 64] |= mask;
+    else
+      freeBits[loc / 64] &= ~mask;
+    loc += bits;
+  }
+}
+
+// first location from "from" on whose free bit equals isFree, or maxsize
+size_t StoreManagerLocintSegregated::findBit(size_t from, bool isFree) const {
+  while (from < maxsize) {
+    uint64_t word = freeBits[from / 64];
+    if (!isFree)
+      word = ~word;
+    word >>= from % 64;
+    if (word == 0) {
+      from = (from / 64 + 1) * 64;
+      continue;
+    }
+    while (!(word & 1)) {
+      word >>= 1;
+      ++from;
+    }
+    break;
+  }
+  return std::min(from, maxsize);
+}
+
+void StoreManagerLocintSegregated::pushBlock(locint next, size_t size) {
+  if (size == 0)
+    return;
+  const size_t bin = binOf(size);
+  bins[bin].push_back(FreeBlock{next, size});
+  nonEmptyBins |= size_t(1) << bin;
+}
+
+// takes a block of at least n locations from the bins, preferring the
+// smallest size class any of whose blocks fits
+bool StoreManagerLocintSegregated::popBlock(size_t n, struct FreeBlock &block) {
+  const size_t first = binOf(n);
+  const bool anyFits = (size_t(1) << first) >= n;
+  for (size_t bin = anyFits ? first : first + 1; bin < numBins; ++bin) {
+    if ((nonEmptyBins >> bin) == 0)
+      break;
+    if (!bins[bin].empty()) {
+      block = bins[bin].back();
+      bins[bin].pop_back();
+      if (bins[bin].empty())
+        nonEmptyBins &= ~(size_t(1) << bin);
+      return true;
+    }
+  }
+  if (anyFits)
+    return false;
+
+  // only some of the blocks in the class of n fit, this is a linear search
+  std::vector<struct FreeBlock> &candidates = bins[first];
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (candidates[i].size >= n) {
+      block = candidates[i];
+      candidates[i] = candidates.back();
+      candidates.pop_back();
+      if (candidates.empty())
+        nonEmptyBins &= ~(size_t(1) << first);
+      return true;
+    }
+  }
+  return false;
+}
+
+void StoreManagerLocintSegregated::retireRun() {
+  pushBlock(run.next, run.size);
+  run.size = 0;
+}
+
+// rebuilds the bins from maximal runs of free locations in the bitmap
+void StoreManagerLocintSegregated::coalesce() {
+  for (size_t bin = 0; bin < numBins; ++bin)
+    bins[bin].clear();
+  nonEmptyBins = 0;
+  run.size = 0;
+
+  size_t loc = findBit(0, true);
+  while (loc < maxsize) {
+    const size_t end = findBit(loc, false);
+    pushBlock(loc, end - loc);
+    loc = findBit(end, true);
+  }
+  freedSinceCoalesce = false;
+}
+
+locint StoreManagerLocintSegregated::next_loc() {
+  if (run.size == 0 && !popBlock(1, run))
+    grow();
+
+  locint const result = run.next++;
+  --run.size;
+  freeBits[result / 64] &= ~(uint64_t(1) << (result % 64));
+  ++currentfill;
+  return result;
+}
+
+void StoreManagerLocintSegregated::free_loc(locint loc) {
+  assert(loc < maxsize);
+
+  freeBits[loc / 64] |= uint64_t(1) << (loc % 64);
+  if (loc + 1 == run.next) {
+    run.next = loc;
+    ++run.size;
+  } else if (run.next + run.size == loc)
+    ++run.size;
+  else
+    pushBlock(loc, 1);
+
+  freedSinceCoalesce = true;
+  --currentfill;
+}
+
+void StoreManagerLocintSegregated::ensure_block(size_t n) {
+  if (run.size >= n)
+    return;
+
+  struct FreeBlock block;
+  bool found = popBlock(n, block);
+  if (!found && freedSinceCoalesce && maxSize() - size() > n &&
+      ((double(maxSize()) / double(size())) > gcTriggerRatio() ||
+       maxSize() > gcTriggerMaxSize())) {
+    coalesce();
+    found = popBlock(n, block);
+  }
+
+  if (found) {
+    retireRun();
+    run = block;
+  } else
+    grow(n);
+}
+
+locint StoreManagerLocintSegregated::next_loc_block(size_t n) {
+  ensure_block(n);
+
+  locint const result = run.next;
+  run.next += n;
+  run.size -= n;
+  markFree(result, n, false);
+  currentfill += n;
+  return result;
+}
+
+void StoreManagerLocintSegregated::free_loc_block(locint loc, size_t n) {
+  assert(loc + n <= maxsize);
+  if (n == 0)
+    return;
+
+  markFree(loc, n, true);
+  if (loc + n == run.next) {
+    run.next = loc;
+    run.size += n;
+  } else if (run.next + run.size == loc)
+    run.size += n;
+  else
+    pushBlock(loc, n);
+
+  freedSinceCoalesce = true;
+  currentfill -= n;
+}
+
+void StoreManagerLocintSegregated::grow(size_t minGrow) {
+  size_t const oldMaxsize = maxsize;
+  size_t const maxLocints = std::numeric_limits<locint>::max();
+
+  if (oldMaxsize > maxLocints - minGrow) {
+    fprintf(DIAG_OUT, "\nADOL-C error:\n");
+    fprintf(DIAG_OUT,
+            "maximal number (%zu) of live active variables exceeded\n\n",
+            maxLocints);
+    adolc_exit(-3, "", __func__, __FILE__, __LINE__);
+  }
+
+  if (maxsize == 0) {
+    maxsize = initialSize;
+  } else {
+    maxsize = oldMaxsize > maxLocints / 2 ? maxLocints : 2 * oldMaxsize;
+  }
+  while (maxsize - oldMaxsize < minGrow) {
+    maxsize = maxsize > maxLocints / 2 ? maxLocints : 2 * maxsize;
+  }
+
+  double *const oldStore = storePtr;
+  storePtr = allocStore(maxsize);
+  memset(storePtr, 0, maxsize * sizeof(double));
+#if defined(ADOLC_TRACK_ACTIVITY)
+  char *oldactStore;
+  if (activityTracking) {
+    oldactStore = actStorePtr;
+    actStorePtr = new char[maxsize];
+    memset(actStorePtr, 0, maxsize * sizeof(char));
+  }
+#endif
+  if (oldStore != NULL) {
+    memcpy(storePtr, oldStore, oldMaxsize * sizeof(double));
+    freeStore(oldStore);
+#if defined(ADOLC_TRACK_ACTIVITY)
+    if (activityTracking) {
+      memcpy(actStorePtr, oldactStore, oldMaxsize * sizeof(char));
+      delete[] oldactStore;
+    }
+#endif
+  }
+
+  // the new locations extend the run if it ends at the old store size
+  freeBits.resize((maxsize + 63) / 64, 0);
+  markFree(oldMaxsize, maxsize - oldMaxsize, true);
+  if (run.size == 0 || run.next + run.size != oldMaxsize) {
+    retireRun();
+    run.next = oldMaxsize;
+  }
+  run.size += maxsize - oldMaxsize;
+}
+
 void setStoreManagerType(unsigned char type) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
@@ -29,7 +29,9 @@
 #include <unistd.h>
 #endif
 #include <errno.h>
+#include <list>
 #include <stack>
+#include <unordered_map>
 #include <vector>
 
 #ifdef SPARSE
@@ -55,6 +57,14 @@ GlobalTapeVarsCL::GlobalTapeVarsCL() {
   numparam = 0;
   maxparam = 0;
   initialStoreSize = 0;
+  storeCopyBytes = 0;
+  storeView = nullptr;
+  storeViewSize = 0;
+  tapeIOFlags = ADOLC_TAPE_IO_STDIO;
+  tapePoolSize = 0;
+  maxAdaptiveBufferSize = 0;
+  taylorArenaSize = 0;
+  sweepThreads = 0;
 #if defined(ADOLC_TRACK_ACTIVITY)
   storeManagerPtr =
       new StoreManagerLocintBlock(store, actStore, storeSize, numLives);
@@ -74,6 +84,9 @@ GlobalTapeVarsCL::~GlobalTapeVarsCL() {
 
 const GlobalTapeVarsCL &
 GlobalTapeVarsCL::operator=(const GlobalTapeVarsCL &gtv) {
+  /* the managers free the stores, they are replaced below */
+  delete storeManagerPtr;
+  delete paramStoreMgrPtr;
   storeSize = gtv.storeSize;
   numLives = gtv.numLives;
   maxLoc = gtv.maxLoc;
@@ -82,31 +95,172 @@ GlobalTapeVarsCL::operator=(const GlobalTapeVarsCL &gtv) {
   valueBufferSize = gtv.valueBufferSize;
   taylorBufferSize = gtv.taylorBufferSize;
   maxNumberTaylorBuffers = gtv.maxNumberTaylorBuffers;
+  tapeIOFlags = gtv.tapeIOFlags;
+  tapePoolSize = gtv.tapePoolSize;
+  maxAdaptiveBufferSize = gtv.maxAdaptiveBufferSize;
+  taylorArenaSize = gtv.taylorArenaSize;
+  sweepThreads = gtv.sweepThreads;
   inParallelRegion = gtv.inParallelRegion;
   newTape = gtv.newTape;
   branchSwitchWarning = gtv.branchSwitchWarning;
   currentTapeInfosPtr = gtv.currentTapeInfosPtr;
   initialStoreSize = gtv.initialStoreSize;
-  store = new double[storeSize];
-  memcpy(store, gtv.store, storeSize * sizeof(double));
+  /* workers map the serial store copy-on-write where possible */
+  store = copyStore(gtv.store, storeSize, storeCopyBytes);
+  storeView = storeCopyBytes == 0 ? store : nullptr;
+  storeViewSize = storeSize;
 #if defined(ADOLC_TRACK_ACTIVITY)
   actStore = new char[storeSize];
   memcpy(actStore, gtv.actStore, storeSize * sizeof(char));
 #endif
-  storeManagerPtr = new StoreManagerLocintBlock(
-      dynamic_cast<StoreManagerLocintBlock *>(gtv.storeManagerPtr), store,
+  if (gtv.storeManagerPtr->storeType() == ADOLC_LOCATION_SEGREGATED)
+    storeManagerPtr = new StoreManagerLocintSegregated(
+        dynamic_cast<StoreManagerLocintSegregated *>(gtv.storeManagerPtr),
+        store,
+#if defined(ADOLC_TRACK_ACTIVITY)
+        actStore,
+#endif
+        storeSize, numLives);
+  else
+    storeManagerPtr = new StoreManagerLocintBlock(
+        dynamic_cast<StoreManagerLocintBlock *>(gtv.storeManagerPtr), store,
 #if defined(ADOLC_TRACK_ACTIVITY)
-      actStore,
+        actStore,
 #endif
-      storeSize, numLives);
+        storeSize, numLives);
   paramStoreMgrPtr = new StoreManagerLocintBlock(
       dynamic_cast<StoreManagerLocintBlock *>(gtv.paramStoreMgrPtr), pStore,
       maxparam, numparam);
   return *this;
 }
 
-/* vector of tape infos for all tapes in use */
-std::vector<TapeInfos *> ADOLC_TAPE_INFOS_BUFFER_DECL;
+/****************************************************************************/
+/* Registry of the tape infos of all tapes in use. Tapes are found by their */
+/* ID through a hash map. It also implements the tape pool: tapes not open  */
+/* are kept in least recently used order and evicted from core when their   */
+/* memory exceeds the budget set by setTapePoolSize.                        */
+/****************************************************************************/
+class TapeInfosBuffer {
+public:
+  typedef std::vector<TapeInfos *>::iterator iterator;
+  typedef std::vector<TapeInfos *>::const_iterator const_iterator;
+
+  TapeInfosBuffer() : poolBytes(0) {}
+
+  /* returns the tape infos of tapeID or nullptr if there are none */
+  TapeInfos *find(short tapeID) const {
+    std::unordered_map<short, Entry>::const_iterator it = index.find(tapeID);
+    return it == index.end() ? nullptr : it->second.tapeInfos;
+  }
+
+  void push_back(TapeInfos *tapeInfos) {
+    Entry &entry = index[tapeInfos->tapeID];
+    entry.tapeInfos = tapeInfos;
+    entry.bytes = 0;
+    entry.pins = 0;
+    entry.lru = lru.end();
+    tapes.push_back(tapeInfos);
+  }
+  TapeInfos *&back() { return tapes.back(); }
+  void pop_back() {
+    forget(tapes.back());
+    tapes.pop_back();
+  }
+  void erase(TapeInfos *tapeInfos) {
+    forget(tapeInfos);
+    tapes.erase(std::find(tapes.begin(), tapes.end(), tapeInfos));
+  }
+  bool empty() const { return tapes.empty(); }
+  size_t size() const { return tapes.size(); }
+  iterator begin() { return tapes.begin(); }
+  iterator end() { return tapes.end(); }
+  const_iterator begin() const { return tapes.begin(); }
+  const_iterator end() const { return tapes.end(); }
+
+  /* marks a tape as open, open tapes are never evicted */
+  void pin(TapeInfos *tapeInfos) {
+    Entry &entry = index[tapeInfos->tapeID];
+    if (entry.pins++ == 0 && entry.lru != lru.end()) {
+      lru.erase(entry.lru);
+      entry.lru = lru.end();
+    }
+  }
+
+  /* marks a tape as closed and makes it the most recently used one */
+  void unpin(TapeInfos *tapeInfos, size_t budget) {
+    Entry &entry = index[tapeInfos->tapeID];
+    if (--entry.pins > 0)
+      return;
+    account(entry);
+    entry.lru = lru.insert(lru.begin(), tapeInfos);
+    shrink(budget);
+  }
+
+  /* evicts closed tapes until bytes more fit into budget */
+  bool reserve(size_t bytes, size_t budget) {
+    if (budget == 0 || bytes > budget)
+      return false;
+    while (poolBytes + bytes > budget && !lru.empty())
+      evict(lru.back());
+    return poolBytes + bytes <= budget;
+  }
+
+  /* evicts closed tapes until the pool fits into budget, a budget of 0
+   * only drops the copies of tape files */
+  void shrink(size_t budget) {
+    std::list<TapeInfos *>::iterator it, next;
+    if (budget > 0) {
+      while (poolBytes > budget && !lru.empty())
+        evict(lru.back());
+      return;
+    }
+    for (it = lru.begin(); it != lru.end(); it = next) {
+      next = it;
+      ++next;
+      if ((*it)->mapsInPool)
+        evict(*it);
+    }
+  }
+
+private:
+  struct Entry {
+    TapeInfos *tapeInfos;
+    size_t bytes;                      /* memory held in core */
+    int pins;                          /* number of times the tape is open */
+    std::list<TapeInfos *>::iterator lru; /* lru.end() if open */
+  };
+
+  void account(Entry &entry) {
+    poolBytes -= entry.bytes;
+    entry.bytes = tapeCoreSize(entry.tapeInfos);
+    poolBytes += entry.bytes;
+  }
+  void evict(TapeInfos *tapeInfos) {
+    Entry &entry = index[tapeInfos->tapeID];
+    lru.erase(entry.lru);
+    entry.lru = lru.end();
+    evictTape(tapeInfos);
+    account(entry);
+  }
+  void forget(TapeInfos *tapeInfos) {
+    std::unordered_map<short, Entry>::iterator it =
+        index.find(tapeInfos->tapeID);
+    if (it == index.end() || it->second.tapeInfos != tapeInfos)
+      return;
+    poolBytes -= it->second.bytes;
+    if (it->second.lru != lru.end())
+      lru.erase(it->second.lru);
+    index.erase(it);
+  }
+
+  std::vector<TapeInfos *> tapes; /* in order of creation */
+  std::unordered_map<short, Entry> index;
+  std::list<TapeInfos *> lru; /* closed tapes, most recently used first */
+  size_t poolBytes;           /* memory held by the tapes in the registry */
+};
+
+/* tape infos for all tapes in use */
+TapeInfosBuffer ADOLC_TAPE_INFOS_BUFFER_DECL;
 
 /* stack of pointers to tape infos
  * represents the order of tape usage when doing nested taping */
@@ -120,7 +274,7 @@ TapeInfos ADOLC_CURRENT_TAPE_INFOS_FALLBACK_DECL;
 GlobalTapeVars ADOLC_GLOBAL_TAPE_VARS_DECL;
 
 #if defined(_OPENMP)
-static std::vector<TapeInfos *> *tapeInfosBuffer_s;
+static TapeInfosBuffer *tapeInfosBuffer_s;
 static std::stack<TapeInfos *> *tapeStack_s;
 static TapeInfos *currentTapeInfos_s;
 static TapeInfos *currentTapeInfos_fallBack_s;
@@ -129,7 +283,7 @@ static ADOLC_BUFFER_TYPE *ADOLC_extDiffFctsBuffer_s;
 static std::stack<StackElement> *ADOLC_checkpointsStack_s;
 static revolve_nums *revolve_numbers_s;
 
-static std::vector<TapeInfos *> *tapeInfosBuffer_p;
+static TapeInfosBuffer *tapeInfosBuffer_p;
 static std::stack<TapeInfos *> *tapeStack_p;
 static TapeInfos *currentTapeInfos_p;
 static TapeInfos *currentTapeInfos_fallBack_p;
@@ -169,6 +323,11 @@ void initTapeInfos_keep(TapeInfos *newTapeInfos) {
   revreal *tayBuffer = newTapeInfos->tayBuffer;
   double *signature = newTapeInfos->signature;
   FILE *tay_file = newTapeInfos->tay_file;
+  struct TaylorStack *taylorStack = newTapeInfos->taylorStack;
+  struct TapeBlockIndex *blockIndex = newTapeInfos->blockIndex;
+  struct TapeRecords *records = newTapeInfos->records;
+  struct ThreadedTape *threaded = newTapeInfos->threaded;
+  struct NativeTape *native = newTapeInfos->native;
 
   initTapeInfos(newTapeInfos);
 
@@ -178,6 +337,49 @@ void initTapeInfos_keep(TapeInfos *newTapeInfos) {
   newTapeInfos->tayBuffer = tayBuffer;
   newTapeInfos->signature = signature;
   newTapeInfos->tay_file = tay_file;
+  newTapeInfos->taylorStack = taylorStack;
+  newTapeInfos->blockIndex = blockIndex;
+  newTapeInfos->records = records;
+  newTapeInfos->threaded = threaded;
+  newTapeInfos->native = native;
+}
+
+/* returns the size of a buffer holding numEntries of the previous recording
+ * of a tape and some more, or defaultSize if this exceeds the limit of
+ * adaptive buffer sizes */
+static size_t adaptiveBufferSize(size_t numEntries, size_t defaultSize) {
+  size_t size = numEntries + numEntries / 4;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (numEntries == 0 || size > ADOLC_GLOBAL_TAPE_VARS.maxAdaptiveBufferSize)
+    return defaultSize;
+  return MAX_ADOLC(size, MIN_ADOLC(defaultSize, (size_t)ADAPTIVEBUFMIN));
+}
+
+/* sets the buffer sizes of a tape recorded again from the stats of its
+ * previous recording, buffers kept from it are released if their size
+ * changes */
+static void adaptBufferSizes(TapeInfos *tapeInfos, const size_t *oldStats) {
+  tapeInfos->stats[OP_BUFFER_SIZE] = adaptiveBufferSize(
+      oldStats[NUM_OPERATIONS], tapeInfos->stats[OP_BUFFER_SIZE]);
+  tapeInfos->stats[LOC_BUFFER_SIZE] = adaptiveBufferSize(
+      oldStats[NUM_LOCATIONS], tapeInfos->stats[LOC_BUFFER_SIZE]);
+  tapeInfos->stats[VAL_BUFFER_SIZE] = adaptiveBufferSize(
+      oldStats[NUM_VALUES], tapeInfos->stats[VAL_BUFFER_SIZE]);
+
+  if (tapeInfos->stats[OP_BUFFER_SIZE] != oldStats[OP_BUFFER_SIZE]) {
+    delete[] tapeInfos->opBuffer;
+    tapeInfos->opBuffer = nullptr;
+  }
+  if (tapeInfos->stats[LOC_BUFFER_SIZE] != oldStats[LOC_BUFFER_SIZE]) {
+    delete[] tapeInfos->locBuffer;
+    tapeInfos->locBuffer = nullptr;
+  }
+  if (tapeInfos->stats[VAL_BUFFER_SIZE] != oldStats[VAL_BUFFER_SIZE]) {
+    delete[] tapeInfos->valBuffer;
+    tapeInfos->valBuffer = nullptr;
+  }
 }
 
 /* inits a new tape and updates the tape stack (called from start_trace)
@@ -185,6 +387,7 @@ void initTapeInfos_keep(TapeInfos *newTapeInfos) {
  * - returns 1 if tapeID was already/still in use */
 int initNewTape(short tapeID) {
   TapeInfos *newTapeInfos = nullptr;
+  size_t oldStats[STAT_SIZE];
   bool newTI = false;
   int retval = 0;
 
@@ -192,18 +395,15 @@ int initNewTape(short tapeID) {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   /* check if tape is in use */
-  std::vector<TapeInfos *>::iterator tiIter = std::find_if(
-      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
-      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
-
-  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
-    newTapeInfos = *tiIter;
-    if ((*tiIter)->inUse != 0) {
-      if ((*tiIter)->tapingComplete == 0)
+  newTapeInfos = ADOLC_TAPE_INFOS_BUFFER.find(tapeID);
+
+  if (newTapeInfos != nullptr) {
+    if (newTapeInfos->inUse != 0) {
+      if (newTapeInfos->tapingComplete == 0)
         fail(ADOLC_TAPING_TAPE_STILL_IN_USE);
-      if ((*tiIter)->stats[OP_FILE_ACCESS] == 0 &&
-          (*tiIter)->stats[LOC_FILE_ACCESS] == 0 &&
-          (*tiIter)->stats[VAL_FILE_ACCESS] == 0) {
+      if (newTapeInfos->stats[OP_FILE_ACCESS] == 0 &&
+          newTapeInfos->stats[LOC_FILE_ACCESS] == 0 &&
+          newTapeInfos->stats[VAL_FILE_ACCESS] == 0) {
 #if defined(ADOLC_DEBUG)
         fprintf(DIAG_OUT,
                 "\nADOL-C warning: Tape %d existed in main memory"
@@ -214,10 +414,13 @@ int initNewTape(short tapeID) {
         retval = 1;
       }
     }
-    if ((*tiIter)->tay_file != nullptr)
-      rewind((*tiIter)->tay_file);
-    initTapeInfos_keep(*tiIter);
-    (*tiIter)->tapeID = tapeID;
+    if (newTapeInfos->tay_file != nullptr)
+      rewind(newTapeInfos->tay_file);
+    /* drop copies of the old tape kept by the tape pool */
+    unmapTapeFiles(newTapeInfos);
+    memcpy(oldStats, newTapeInfos->stats, sizeof(oldStats));
+    initTapeInfos_keep(newTapeInfos);
+    newTapeInfos->tapeID = tapeID;
 #ifdef SPARSE
     freeSparseJacInfos(
         newTapeInfos->pTapeInfos.sJinfos.y, newTapeInfos->pTapeInfos.sJinfos.B,
@@ -274,6 +477,8 @@ int initNewTape(short tapeID) {
   newTapeInfos->stats[VAL_BUFFER_SIZE] = ADOLC_GLOBAL_TAPE_VARS.valueBufferSize;
   newTapeInfos->stats[TAY_BUFFER_SIZE] =
       ADOLC_GLOBAL_TAPE_VARS.taylorBufferSize;
+  if (!newTI)
+    adaptBufferSizes(newTapeInfos, oldStats);
 
   /* update tapeStack and save tapeInfos */
   if (ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr != nullptr) {
@@ -285,8 +490,10 @@ int initNewTape(short tapeID) {
   }
   if (newTI)
     ADOLC_TAPE_INFOS_BUFFER.push_back(newTapeInfos);
+  ADOLC_TAPE_INFOS_BUFFER.pin(newTapeInfos);
 
   newTapeInfos->pTapeInfos.skipFileCleanup = 0;
+  newTapeInfos->pTapeInfos.tapeIOFlags = ADOLC_GLOBAL_TAPE_VARS.tapeIOFlags;
 
   /* set the new tape infos as current */
   ADOLC_CURRENT_TAPE_INFOS.copy(*newTapeInfos);
@@ -304,22 +511,20 @@ void openTape(short tapeID, char mode) {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   /* check if tape information exist in memory */
-  std::vector<TapeInfos *>::iterator tiIter = std::find_if(
-      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
-      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+  tempTapeInfos = ADOLC_TAPE_INFOS_BUFFER.find(tapeID);
 
-  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
+  if (tempTapeInfos != nullptr) {
     /* tape has been used before (in the current program) */
-    if ((*tiIter)->inUse == 0) {
+    if (tempTapeInfos->inUse == 0) {
       /* forward sweep */
-      if ((*tiIter)->tay_file != nullptr)
-        rewind((*tiIter)->tay_file);
-      initTapeInfos_keep(*tiIter);
-      (*tiIter)->traceFlag = 1;
-      (*tiIter)->tapeID = tapeID;
-      (*tiIter)->tapingComplete = 1;
-      (*tiIter)->inUse = 1;
-      read_tape_stats(*tiIter);
+      if (tempTapeInfos->tay_file != nullptr)
+        rewind(tempTapeInfos->tay_file);
+      initTapeInfos_keep(tempTapeInfos);
+      tempTapeInfos->traceFlag = 1;
+      tempTapeInfos->tapeID = tapeID;
+      tempTapeInfos->tapingComplete = 1;
+      tempTapeInfos->inUse = 1;
+      read_tape_stats(tempTapeInfos);
     }
     if (ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr != nullptr) {
       ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr->copy(
@@ -329,8 +534,9 @@ void openTape(short tapeID, char mode) {
       ADOLC_CURRENT_TAPE_INFOS_FALLBACK.copy(ADOLC_CURRENT_TAPE_INFOS);
       ADOLC_TAPE_STACK.push(&ADOLC_CURRENT_TAPE_INFOS_FALLBACK);
     }
-    ADOLC_CURRENT_TAPE_INFOS.copy(**tiIter);
-    ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr = *tiIter;
+    ADOLC_TAPE_INFOS_BUFFER.pin(tempTapeInfos);
+    ADOLC_CURRENT_TAPE_INFOS.copy(*tempTapeInfos);
+    ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr = tempTapeInfos;
     return;
   }
 
@@ -346,6 +552,7 @@ void openTape(short tapeID, char mode) {
   tempTapeInfos->inUse = 1;
   tempTapeInfos->tapingComplete = 1;
   ADOLC_TAPE_INFOS_BUFFER.push_back(tempTapeInfos);
+  ADOLC_TAPE_INFOS_BUFFER.pin(tempTapeInfos);
 
   read_tape_stats(tempTapeInfos);
   /* update tapeStack and save tapeInfos */
@@ -367,21 +574,76 @@ void releaseTape() {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
+  TapeInfos *tapeInfos = ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr;
+
   /* if operations, locations and constants tapes have been written and value
-   * stack information have not been created tapeInfos are no longer needed*/
+   * stack information have not been created tapeInfos are no longer needed,
+   * unless the tape pool keeps copies of the tape files or the tape has
+   * packed records */
   if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors == 0 &&
+      ADOLC_CURRENT_TAPE_INFOS.mapsInPool == 0 &&
+      ADOLC_CURRENT_TAPE_INFOS.records == nullptr &&
       ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1 &&
       ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1 &&
       ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1) {
     ADOLC_CURRENT_TAPE_INFOS.inUse = 0;
   }
 
-  ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr->copy(ADOLC_CURRENT_TAPE_INFOS);
+  tapeInfos->copy(ADOLC_CURRENT_TAPE_INFOS);
   ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr = ADOLC_TAPE_STACK.top();
   ADOLC_CURRENT_TAPE_INFOS.copy(*ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr);
   ADOLC_TAPE_STACK.pop();
   if (ADOLC_TAPE_STACK.empty())
     ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr = nullptr;
+  ADOLC_TAPE_INFOS_BUFFER.unpin(tapeInfos, ADOLC_GLOBAL_TAPE_VARS.tapePoolSize);
+}
+
+/* sets the memory budget of the tape pool, evicting tapes if necessary */
+void setTapePoolSize(size_t bytes) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  ADOLC_GLOBAL_TAPE_VARS.tapePoolSize = bytes;
+  ADOLC_TAPE_INFOS_BUFFER.shrink(bytes);
+}
+
+/* sets the limit of the buffer sizes chosen for tapes recorded again */
+void setAdaptiveBufferSize(size_t maxEntries) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  ADOLC_GLOBAL_TAPE_VARS.maxAdaptiveBufferSize = maxEntries;
+}
+
+/* sets the memory ceiling of the taylor stack arena */
+void setTaylorArenaSize(size_t bytes) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  ADOLC_GLOBAL_TAPE_VARS.taylorArenaSize = bytes;
+}
+
+/* sets the number of threads of the parallel fov sweeps */
+void setSweepThreads(int numThreads) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  ADOLC_GLOBAL_TAPE_VARS.sweepThreads = numThreads > 0 ? numThreads : 0;
+}
+
+/* sets the directory of the native code of tapes */
+void setNativeDir(const char *dir) {
+  getNativeDir() = dir != nullptr ? dir : "";
+}
+
+/* makes room for bytes in the tape pool
+ * - returns 1 if they fit into its budget, 0 otherwise */
+int reserveTapePool(size_t bytes) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  return ADOLC_TAPE_INFOS_BUFFER.reserve(bytes,
+                                         ADOLC_GLOBAL_TAPE_VARS.tapePoolSize);
 }
 
 /* updates the tape infos for the given ID - a tapeInfos struct is created
@@ -392,20 +654,17 @@ TapeInfos *getTapeInfos(short tapeID) {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   /* check if TapeInfos for tapeID exist */
-  auto tiIter = std::find_if(
-      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
-      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+  TapeInfos *tapeInfos = ADOLC_TAPE_INFOS_BUFFER.find(tapeID);
 
   // Return the tapeInfos pointer if it has been found.
-  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
-    TapeInfos *tapeInfos = *tiIter;
+  if (tapeInfos != nullptr) {
     if (tapeInfos->inUse == 0)
       read_tape_stats(tapeInfos);
     return tapeInfos;
   }
 
   /* create new TapeInfos, initialize and update tapeInfosBuffer */
-  TapeInfos *tapeInfos = new TapeInfos(tapeID);
+  tapeInfos = new TapeInfos(tapeID);
   ADOLC_TAPE_INFOS_BUFFER.push_back(tapeInfos);
   tapeInfos->traceFlag = 1;
   tapeInfos->inUse = 0;
@@ -430,7 +689,7 @@ char currently_nested(short tag) {
 }
 
 void cachedTraceTags(std::vector<short> &result) {
-  std::vector<TapeInfos *>::const_iterator tiIter;
+  TapeInfosBuffer::const_iterator tiIter;
   std::vector<short>::iterator tIdIter;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
@@ -453,12 +712,9 @@ void setTapeInfoJacSparse(short tapeID, SparseJacInfos sJinfos) {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   /* check if TapeInfos for tapeID exist */
-  std::vector<TapeInfos *>::iterator tiIter = std::find_if(
-      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
-      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+  tapeInfos = ADOLC_TAPE_INFOS_BUFFER.find(tapeID);
 
-  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
-    tapeInfos = *tiIter;
+  if (tapeInfos != nullptr) {
     // free memory of tape entry that had been used previously
     freeSparseJacInfos(
         tapeInfos->pTapeInfos.sJinfos.y, tapeInfos->pTapeInfos.sJinfos.B,
@@ -490,12 +746,9 @@ void setTapeInfoHessSparse(short tapeID, SparseHessInfos sHinfos) {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   /* check if TapeInfos for tapeID exist */
-  std::vector<TapeInfos *>::iterator tiIter = std::find_if(
-      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
-      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+  tapeInfos = ADOLC_TAPE_INFOS_BUFFER.find(tapeID);
 
-  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
-    tapeInfos = *tiIter;
+  if (tapeInfos != nullptr) {
     // free memory of tape entry that had been used previously
     freeSparseHessInfos(
         tapeInfos->pTapeInfos.sHinfos.Hcomp, tapeInfos->pTapeInfos.sHinfos.Xppp,
@@ -524,7 +777,7 @@ static void init_lib() {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
 #if defined(_OPENMP)
-  tapeInfosBuffer = new std::vector<TapeInfos *>;
+  tapeInfosBuffer = new TapeInfosBuffer;
   tapeStack = new std::stack<TapeInfos *>;
   currentTapeInfos = new TapeInfos;
   currentTapeInfos->tapingComplete = 1;
@@ -553,6 +806,8 @@ static void init_lib() {
   adolc_id.locint_size = sizeof(locint);
   adolc_id.revreal_size = sizeof(revreal);
   adolc_id.address_size = sizeof(size_t);
+  adolc_id.tape_format = ADOLC_TAPE_FORMAT;
+  adolc_id.stat_size = STAT_SIZE;
 
   ADOLC_EXT_DIFF_FCTS_BUFFER.init(init_CpInfos);
   readConfigFile();
@@ -582,12 +837,14 @@ void cleanUp() {
       /* close open files though they may be incomplete */
 
       if ((*tiIter)->op_file != nullptr) {
-        fclose((*tiIter)->op_file);
+        if ((*tiIter)->op_file != (*tiIter)->loc_file) /* container */
+          fclose((*tiIter)->op_file);
         (*tiIter)->op_file = nullptr;
       }
 
       if ((*tiIter)->val_file != nullptr) {
-        fclose((*tiIter)->val_file);
+        if ((*tiIter)->val_file != (*tiIter)->loc_file) /* container */
+          fclose((*tiIter)->val_file);
         (*tiIter)->val_file = nullptr;
       }
 
@@ -596,6 +853,7 @@ void cleanUp() {
         (*tiIter)->loc_file = nullptr;
       }
 
+      releaseTaylorStack(*tiIter);
       if ((*tiIter)->tay_file != nullptr &&
           (*tiIter)->pTapeInfos.skipFileCleanup == 0) {
         fclose((*tiIter)->tay_file);
@@ -603,6 +861,14 @@ void cleanUp() {
         remove((*tiIter)->pTapeInfos.tay_fileName);
       }
 
+      unmapTapeFiles(*tiIter);
+      releaseTapeWriter(*tiIter);
+      releaseTapePrefetcher(*tiIter);
+      releaseTapeBlockIndex(*tiIter);
+      releaseTapeRecords(*tiIter);
+      releaseThreadedTape(*tiIter);
+      releaseNativeTape(*tiIter);
+
       delete[] ((*tiIter)->opBuffer);
       (*tiIter)->opBuffer = nullptr;
 
@@ -672,10 +938,10 @@ void cleanUp() {
 
   cp_clearStack();
 
-  delete[] ADOLC_GLOBAL_TAPE_VARS.store;
+  freeStore(ADOLC_GLOBAL_TAPE_VARS.store);
   ADOLC_GLOBAL_TAPE_VARS.store = nullptr;
 
-  delete[] ADOLC_GLOBAL_TAPE_VARS.pStore;
+  freeStore(ADOLC_GLOBAL_TAPE_VARS.pStore);
   ADOLC_GLOBAL_TAPE_VARS.pStore = nullptr;
 
 #if defined(_OPENMP)
@@ -701,15 +967,12 @@ int removeTape(short tapeID, short type) {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   /* check if TapeInfos for tapeID exist */
-  std::vector<TapeInfos *>::iterator tiIter = std::find_if(
-      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
-      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+  tapeInfos = ADOLC_TAPE_INFOS_BUFFER.find(tapeID);
 
-  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
-    tapeInfos = *tiIter;
+  if (tapeInfos != nullptr) {
     if (tapeInfos->tapingComplete == 0)
       return -1;
-    ADOLC_TAPE_INFOS_BUFFER.erase(tiIter);
+    ADOLC_TAPE_INFOS_BUFFER.erase(tapeInfos);
   }
 
   if (tapeInfos == nullptr) { // might be on disk only
@@ -717,6 +980,8 @@ int removeTape(short tapeID, short type) {
     tapeInfos->tapingComplete = 1;
   }
 
+  if (type == ADOLC_REMOVE_COMPLETELY)
+    removeNativeObjects(tapeInfos);
   freeTapeResources(tapeInfos);
 #ifdef SPARSE
   freeSparseJacInfos(
@@ -739,6 +1004,8 @@ int removeTape(short tapeID, short type) {
     remove(tapeInfos->pTapeInfos.op_fileName);
     remove(tapeInfos->pTapeInfos.loc_fileName);
     remove(tapeInfos->pTapeInfos.val_fileName);
+    if (tapeInfos->pTapeInfos.tay_fileName != nullptr)
+      remove(tapeInfos->pTapeInfos.tay_fileName);
   }
 
   free(tapeInfos->pTapeInfos.op_fileName);
@@ -783,7 +1050,7 @@ int trace_on(short tnum, int keepTaylors) {
 }
 
 int trace_on(short tnum, int keepTaylors, uint obs, uint lbs, uint vbs,
-             uint tbs, int skipFileCleanup) {
+             uint tbs, int skipFileCleanup, int tapeIOFlags) {
   int retval = 0;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
@@ -802,6 +1069,8 @@ int trace_on(short tnum, int keepTaylors, uint obs, uint lbs, uint vbs,
   ADOLC_CURRENT_TAPE_INFOS.stats[NO_MIN_MAX] =
       ADOLC_GLOBAL_TAPE_VARS.nominmaxFlag;
   ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.skipFileCleanup = skipFileCleanup;
+  if (tapeIOFlags != ADOLC_TAPE_IO_DEFAULT)
+    ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags = tapeIOFlags;
   if (keepTaylors != 0)
     ADOLC_CURRENT_TAPE_INFOS.deg_save = 1;
   start_trace();
@@ -880,6 +1149,9 @@ int ADOLC_parallel_doCopy;
 static bool waitForMaster_begin = true;
 static bool waitForMaster_end = true;
 static bool firstParallel = true;
+static int numParallelThreads = 0;
+/* bytes the master wrote to the snapshot of the serial store */
+static size_t storeSnapshotBytes = 0;
 
 /****************************************************************************/
 /* Used by OpenMP to create a separate environment for every worker thread. */
@@ -904,7 +1176,8 @@ void beginParallel() {
     revolve_numbers_s = revolve_numbers;
 
     if (firstParallel) {
-      tapeInfosBuffer = new std::vector<TapeInfos *>[numThreads];
+      numParallelThreads = numThreads;
+      tapeInfosBuffer = new TapeInfosBuffer[numThreads];
       tapeStack = new std::stack<TapeInfos *>[numThreads];
       currentTapeInfos = new TapeInfos[numThreads];
       currentTapeInfos_fallBack = new TapeInfos[numThreads];
@@ -923,6 +1196,13 @@ void beginParallel() {
       revolve_numbers = revolve_numbers_p;
     }
 
+    /* workers copying the serial store map a snapshot of it, which stays
+     * unchanged while the serial store is written later on */
+    storeSnapshotBytes = 0;
+    if (firstParallel || ADOLC_parallel_doCopy)
+      storeSnapshotBytes =
+          snapshotStore(globalTapeVars_s->store, globalTapeVars_s->storeSize);
+
     /* - set inParallelRegion for tmpGlobalTapeVars because it is source
      *   for initializing the parallel globalTapeVars structs
      * - inParallelRegion has to be set to one for all workers by master.
@@ -953,24 +1233,49 @@ void beginParallel() {
     ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr = nullptr;
   } else {
     if (ADOLC_parallel_doCopy) {
+      /* deleting the storemanager deletes the store too and resets the
+       * store sizes, so these are copied afterwards */
+      delete ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr;
+
       ADOLC_GLOBAL_TAPE_VARS.storeSize = globalTapeVars_s->storeSize;
       ADOLC_GLOBAL_TAPE_VARS.numLives = globalTapeVars_s->numLives;
 
       ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning =
           globalTapeVars_s->branchSwitchWarning;
 
-      /* deleting the storemanager deletes the store too */
-      delete ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr;
-
       ADOLC_GLOBAL_TAPE_VARS.store =
-          new double[ADOLC_GLOBAL_TAPE_VARS.storeSize];
-      memcpy(ADOLC_GLOBAL_TAPE_VARS.store, globalTapeVars_s->store,
-             ADOLC_GLOBAL_TAPE_VARS.storeSize * sizeof(double));
-      ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr = new StoreManagerLocintBlock(
-          dynamic_cast<StoreManagerLocintBlock *>(
-              globalTapeVars_s->storeManagerPtr),
-          ADOLC_GLOBAL_TAPE_VARS.store, ADOLC_GLOBAL_TAPE_VARS.storeSize,
-          ADOLC_GLOBAL_TAPE_VARS.numLives);
+          copyStore(globalTapeVars_s->store, ADOLC_GLOBAL_TAPE_VARS.storeSize,
+                    ADOLC_GLOBAL_TAPE_VARS.storeCopyBytes);
+      ADOLC_GLOBAL_TAPE_VARS.storeView =
+          ADOLC_GLOBAL_TAPE_VARS.storeCopyBytes == 0
+              ? ADOLC_GLOBAL_TAPE_VARS.store
+              : nullptr;
+      ADOLC_GLOBAL_TAPE_VARS.storeViewSize = ADOLC_GLOBAL_TAPE_VARS.storeSize;
+      if (globalTapeVars_s->storeManagerPtr->storeType() ==
+          ADOLC_LOCATION_SEGREGATED)
+        ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr =
+            new StoreManagerLocintSegregated(
+                dynamic_cast<StoreManagerLocintSegregated *>(
+                    globalTapeVars_s->storeManagerPtr),
+                ADOLC_GLOBAL_TAPE_VARS.store, ADOLC_GLOBAL_TAPE_VARS.storeSize,
+                ADOLC_GLOBAL_TAPE_VARS.numLives);
+      else
+        ADOLC_GLOBAL_TAPE_VARS.storeManagerPtr = new StoreManagerLocintBlock(
+            dynamic_cast<StoreManagerLocintBlock *>(
+                globalTapeVars_s->storeManagerPtr),
+            ADOLC_GLOBAL_TAPE_VARS.store, ADOLC_GLOBAL_TAPE_VARS.storeSize,
+            ADOLC_GLOBAL_TAPE_VARS.numLives);
+    } else if (ADOLC_GLOBAL_TAPE_VARS.storeView != nullptr &&
+               ADOLC_GLOBAL_TAPE_VARS.storeView ==
+                   ADOLC_GLOBAL_TAPE_VARS.store) {
+      /* the store of the last region is kept, a copy-on-write view of the
+       * snapshot of that region becomes a private copy first */
+      double *const view = ADOLC_GLOBAL_TAPE_VARS.store;
+      ADOLC_GLOBAL_TAPE_VARS.store =
+          copyStore(view, ADOLC_GLOBAL_TAPE_VARS.storeSize,
+                    ADOLC_GLOBAL_TAPE_VARS.storeCopyBytes);
+      freeStore(view);
+      ADOLC_GLOBAL_TAPE_VARS.storeView = nullptr;
     }
   }
 }
@@ -1005,6 +1310,8 @@ void endParallel() {
           ++num;
     } while (num != numThreads);
 
+    /* the views of the workers keep the snapshot of the serial store */
+    releaseStoreSnapshot();
     firstParallel = false;
 
     revolve_numbers_p = revolve_numbers;
@@ -1034,17 +1341,39 @@ void endParallel() {
     }
 }
 
+/****************************************************************************/
+/* Bytes of the serial store the worker "thread" copied in the last        */
+/* parallel region, eagerly or by writing to its copy-on-write copy. The    */
+/* master (thread 0) also counts the snapshot of the serial store.          */
+/****************************************************************************/
+size_t getStoreCopyBytes(int thread) {
+  if (firstParallel || thread < 0 || thread >= numParallelThreads)
+    return 0;
+
+  const GlobalTapeVars &gtv = globalTapeVars_p[thread];
+  const size_t snapshotBytes = thread == 0 ? storeSnapshotBytes : 0;
+  if (gtv.storeView == nullptr)
+    return snapshotBytes + gtv.storeCopyBytes;
+  /* growing the copy-on-write copy copied all of it */
+  if (gtv.store != gtv.storeView || gtv.storeSize != gtv.storeViewSize)
+    return snapshotBytes + gtv.storeViewSize * sizeof(double);
+  return snapshotBytes + storeBytesWritten(gtv.store, gtv.storeViewSize);
+}
+
 #endif /* _OPENMP */
 
 TapeInfos::TapeInfos() : pTapeInfos() { initTapeInfos(this); }
 
 TapeInfos::TapeInfos(short _tapeID) : pTapeInfos() {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
   initTapeInfos(this);
   tapeID = _tapeID;
   pTapeInfos.op_fileName = createFileName(tapeID, OPERATIONS_TAPE);
   pTapeInfos.loc_fileName = createFileName(tapeID, LOCATIONS_TAPE);
   pTapeInfos.val_fileName = createFileName(tapeID, VALUES_TAPE);
   pTapeInfos.tay_fileName = nullptr;
+  pTapeInfos.tapeIOFlags = ADOLC_GLOBAL_TAPE_VARS.tapeIOFlags;
 }
 
 void TapeInfos::copy(const TapeInfos &tInfos) {
@@ -1081,8 +1410,27 @@ void TapeInfos::copy(const TapeInfos &tInfos) {
   lastLocP1 = tInfos.lastLocP1;
   numLocs_Tape = tInfos.numLocs_Tape;
 
+  /* tape file mappings */
+  op_map = tInfos.op_map;
+  op_mapSize = tInfos.op_mapSize;
+  loc_map = tInfos.loc_map;
+  loc_mapSize = tInfos.loc_mapSize;
+  val_map = tInfos.val_map;
+  val_mapSize = tInfos.val_mapSize;
+  mapsInPool = tInfos.mapsInPool;
+
+  /* background writer */
+  tapeWriter = tInfos.tapeWriter;
+  tapePrefetcher = tInfos.tapePrefetcher;
+  blockIndex = tInfos.blockIndex;
+  records = tInfos.records;
+  currRec = tInfos.currRec;
+  threaded = tInfos.threaded;
+  native = tInfos.native;
+
   /* taylor stack tape */
   tay_file = tInfos.tay_file;
+  taylorStack = tInfos.taylorStack;
   tayBuffer = tInfos.tayBuffer;
   currTay = tInfos.currTay;
   lastTayP1 = tInfos.lastTayP1;
@@ -1234,6 +1582,15 @@ void GlobalTapeVarsCL::reallocStore(unsigned char type) {
         new StoreManagerLocint(store, actStore, storeSize, numLives);
 #else
     storeManagerPtr = new StoreManagerLocint(store, storeSize, numLives);
+#endif
+    break;
+  case ADOLC_LOCATION_SEGREGATED:
+#if defined(ADOLC_TRACK_ACTIVITY)
+    storeManagerPtr =
+        new StoreManagerLocintSegregated(store, actStore, storeSize, numLives);
+#else
+    storeManagerPtr =
+        new StoreManagerLocintSegregated(store, storeSize, numLives);
 #endif
     break;
   }
@@ -277,6 +277,9 @@ void tape_doc(short tnum,   /* tape id */
   double aDouble;
 #endif
   init_for_sweep(tnum);
+  /* the operations are read from the packed records or the tape buffers,
+   * as chosen by init_for_sweep */
+  const bool packedSweep = ADOLC_CURRENT_TAPE_INFOS.currRec != nullptr;
   tag = tnum;
 
   if ((depcheck != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS]) ||
@@ -298,7 +301,7 @@ void tape_doc(short tnum,   /* tape id */
 
   dp_T0 = myalloc1(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]);
 
-  operation = get_op_f();
+  operation = packedSweep ? get_rec_f() : get_op_f();
   ++op_cnt;
   --rev_op_cnt;
   while (operation != end_of_tape) {
@@ -1585,7 +1588,7 @@ void tape_doc(short tnum,   /* tape id */
     } /* endswitch */
 
     /* Read the next operation */
-    operation = get_op_f();
+    operation = packedSweep ? get_rec_f() : get_op_f();
     ++op_cnt;
     --rev_op_cnt;
   } /* endwhile */
@@ -19,12 +19,30 @@
 #include <adolc/oplate.h>
 #include <adolc/taping_p.h>
 #include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <sys/stat.h>
 
+#if defined(HAVE_SYS_MMAN_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#endif
+
 #ifdef ADOLC_AMPI_SUPPORT
 #include "ampi/ampi.h"
 #include "ampi/tape/support.h"
@@ -49,6 +67,16 @@ ADOLC_ID adolc_id;
 #define ADOLC_NEW_TAPE_SUBVERSION 5
 #define ADOLC_NEW_TAPE_PATCHLEVEL 3
 
+/*--------------------------------------------------------------------------*/
+/* Tape streams handled by the background I/O and the compression of tapes */
+enum TapeStreams { OP_STREAM, LOC_STREAM, VAL_STREAM, NUM_STREAMS };
+
+static void writeTapeBlockIndex(int stream, FILE *file);
+static void readIndexedParams(TapeInfos *tapeInfos);
+static bool readAt(FILE *file, void *data, size_t length, size_t offset);
+static bool writeAt(FILE *file, const void *data, size_t length,
+                    size_t offset);
+
 /****************************************************************************/
 /****************************************************************************/
 /* HELP FUNCTIONS                                                           */
@@ -108,6 +136,14 @@ void fail(int error) {
             ADOLC_CURRENT_TAPE_INFOS.tapeID, failAdditionalInfo1,
             failAdditionalInfo2);
     break;
+  case ADOLC_WRONG_TAPE_FORMAT:
+    fprintf(DIAG_OUT,
+            "ADOL-C error: Used tape (%d) was written in another "
+            "format (%d), format %d required.\n"
+            "              Please retape!\n",
+            ADOLC_CURRENT_TAPE_INFOS.tapeID, failAdditionalInfo1,
+            failAdditionalInfo2);
+    break;
   case ADOLC_MORE_STAT_SPACE_REQUIRED:
     fprintf(DIAG_OUT, "ADOL-C error: Not enough space for stats!\n"
                       "              Please contact the ADOL-C team!\n");
@@ -361,6 +397,17 @@ std::array<std::string, 4> &getTapeBaseNames() {
   return tapeBaseNames;
 }
 
+/* the compiler command and the directory of the native code of tapes */
+std::string &getNativeCompiler() {
+  static std::string nativeCompiler;
+  return nativeCompiler;
+}
+
+std::string &getNativeDir() {
+  static std::string nativeDir;
+  return nativeDir;
+}
+
 /****************************************************************************/
 /* Returns the char*: tapeBaseName+tapeID+.tap+\0 or if parallelization is */
 /* active: tapeBaseName+tapeID+thread-+threadNumber+.tap+\0                 */
@@ -370,6 +417,8 @@ char *createFileName(short tapeID, int tapeType) {
   std::string fileName(getTapeBaseNames()[tapeType]);
 
 #if defined(_OPENMP)
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
   if (ADOLC_GLOBAL_TAPE_VARS.inParallelRegion == 1) {
     fileName += "thread-" + std::to_string(omp_get_thread_num());
   }
@@ -405,6 +454,8 @@ void readConfigFile() {
       std::string(TAPE_DIR) + PATHSEPARATOR + ADOLC_OPERATIONS_NAME;
   getTapeBaseNames()[3] =
       std::string(TAPE_DIR) + PATHSEPARATOR + ADOLC_TAYLORS_NAME;
+  getNativeCompiler() = NATIVECC;
+  getNativeDir() = NATIVEDIR;
 
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
@@ -414,6 +465,11 @@ void readConfigFile() {
   ADOLC_GLOBAL_TAPE_VARS.valueBufferSize = VBUFSIZE;
   ADOLC_GLOBAL_TAPE_VARS.taylorBufferSize = TBUFSIZE;
   ADOLC_GLOBAL_TAPE_VARS.maxNumberTaylorBuffers = TBUFNUM;
+  ADOLC_GLOBAL_TAPE_VARS.tapeIOFlags = TAPEIO;
+  ADOLC_GLOBAL_TAPE_VARS.tapePoolSize = TAPEPOOLSIZE;
+  ADOLC_GLOBAL_TAPE_VARS.maxAdaptiveBufferSize = ADAPTIVEBUFMAX;
+  ADOLC_GLOBAL_TAPE_VARS.taylorArenaSize = TAYLORARENASIZE;
+  ADOLC_GLOBAL_TAPE_VARS.sweepThreads = SWEEPTHREADS;
   if ((configFile = fopen(".adolcrc", "r")) != nullptr) {
     fprintf(DIAG_OUT, "\nFile .adolcrc found! => Try to parse it!\n");
     fprintf(DIAG_OUT, "****************************************\n");
@@ -484,6 +540,15 @@ void readConfigFile() {
                   "ADOL-C warning: TAPE_DIR %s in .adolcrc is not an existing "
                   "directory,\n will continue using %s for writing tapes\n",
                   path, TAPE_DIR);
+          } else if (std::strcmp(pos1 + 1, "NATIVE_CC") == 0) {
+            getNativeCompiler() = pos3 + 1;
+            fprintf(DIAG_OUT, "Found native compiler: %s\n",
+                    getNativeCompiler().c_str());
+          } else if (std::strcmp(pos1 + 1, "NATIVE_DIR") == 0) {
+            /* created and checked to be private when a tape is compiled */
+            getNativeDir() = pos3 + 1;
+            fprintf(DIAG_OUT, "ADOL-C info: using NATIVE_DIR %s\n",
+                    getNativeDir().c_str());
           } else
             fprintf(DIAG_OUT, "ADOL-C warning: Unable to parse number in "
                               ".adolcrc!\n");
@@ -516,6 +581,24 @@ void readConfigFile() {
             fprintf(DIAG_OUT, "Found initial live variable store size : %zu\n",
                     (locint)number);
             checkInitialStoreSize(&ADOLC_GLOBAL_TAPE_VARS);
+          } else if (std::strcmp(pos1 + 1, "TAPEIO") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.tapeIOFlags = (int)number;
+            fprintf(DIAG_OUT, "Found tape I/O flags: %d\n", (int)number);
+          } else if (std::strcmp(pos1 + 1, "TAPEPOOLSIZE") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.tapePoolSize = (size_t)number;
+            fprintf(DIAG_OUT, "Found tape pool size: %zu\n", (size_t)number);
+          } else if (std::strcmp(pos1 + 1, "ADAPTIVEBUFMAX") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.maxAdaptiveBufferSize = (size_t)number;
+            fprintf(DIAG_OUT, "Found adaptive buffer size limit: %zu\n",
+                    (size_t)number);
+          } else if (std::strcmp(pos1 + 1, "TAYLORARENASIZE") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.taylorArenaSize = (size_t)number;
+            fprintf(DIAG_OUT, "Found taylor arena size: %zu\n",
+                    (size_t)number);
+          } else if (std::strcmp(pos1 + 1, "SWEEPTHREADS") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.sweepThreads = (int)number;
+            fprintf(DIAG_OUT, "Found number of sweep threads: %d\n",
+                    (int)number);
           } else {
             fprintf(DIAG_OUT, "ADOL-C warning: Unable to parse "
                               "parameter name in .adolcrc!\n");
@@ -538,6 +621,193 @@ void readConfigFile() {
 
 static unsigned int numTBuffersInUse = 0;
 
+/****************************************************************************/
+/* Taylor stacks. Full blocks of the taylor buffer are copied into an arena */
+/* shared by the taylor stacks of all tapes up to TAYLORARENASIZE bytes.    */
+/* Beyond it, the oldest blocks of a stack, which the reverse sweep needs   */
+/* last, are written to the taylor file at their offsets by a background    */
+/* thread and dropped from core. The reverse sweep copies blocks back from  */
+/* the arena or reads them from the file, reading the next older block of   */
+/* the file ahead.                                                          */
+/****************************************************************************/
+static std::atomic<size_t> taylorArenaBytes(0); /* blocks kept in core */
+
+struct TaylorStack {
+  explicit TaylorStack(size_t blockSize);
+  ~TaylorStack();
+
+  /* appends number taylors of buffer as the next block of the stack,
+   * spilling old blocks to the taylor file of tapeInfos if the arena
+   * exceeds arenaSize bytes */
+  void push(const revreal *buffer, size_t number, TapeInfos *tapeInfos,
+            size_t arenaSize);
+  /* fills buffer with the number taylors of block, buffer may be exchanged
+   * with one of the same size read ahead */
+  void get(size_t block, revreal *&buffer, size_t number);
+
+private:
+  void run();
+  bool read(size_t block, revreal *buffer, size_t number);
+  void readAhead(size_t block);
+
+  const size_t blockSize;
+  std::vector<revreal *> blocks; /* nullptr once written to the file */
+  std::vector<size_t> lengths;   /* # of taylors of the blocks */
+  size_t numSpilled;             /* blocks queued for the file */
+  FILE *file;
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<size_t> jobs;
+  bool stop;
+  bool failed;
+  std::thread thread;
+
+  revreal *ahead; /* buffer of the block read ahead */
+  size_t aheadBlock;
+  std::future<bool> aheadRead;
+};
+
+TaylorStack::TaylorStack(size_t blockSize)
+    : blockSize(blockSize), numSpilled(0), file(nullptr), stop(false),
+      failed(false), ahead(nullptr), aheadBlock(0) {}
+
+TaylorStack::~TaylorStack() {
+  if (aheadRead.valid())
+    aheadRead.wait();
+  if (thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    changed.notify_all();
+    thread.join();
+  }
+  for (revreal *block : blocks)
+    if (block != nullptr) {
+      delete[] block;
+      taylorArenaBytes -= blockSize * sizeof(revreal);
+    }
+  delete[] ahead;
+}
+
+void TaylorStack::push(const revreal *buffer, size_t number,
+                       TapeInfos *tapeInfos, size_t arenaSize) {
+  const size_t bytes = blockSize * sizeof(revreal);
+  const size_t maxQueued = TAPEIOBUFNUM > 2 ? TAPEIOBUFNUM : 2;
+  revreal *block = new revreal[blockSize];
+
+  memcpy(block, buffer, number * sizeof(revreal));
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    blocks.push_back(block);
+    lengths.push_back(number);
+  }
+  taylorArenaBytes += bytes;
+
+  while (taylorArenaBytes > arenaSize && numSpilled < blocks.size()) {
+    if (file == nullptr) {
+      if (tapeInfos->tay_file == nullptr)
+        tapeInfos->tay_file =
+            fopen(tapeInfos->pTapeInfos.tay_fileName, "w+b");
+      if (tapeInfos->tay_file == nullptr)
+        fail(ADOLC_TAPING_TAYLOR_OPEN_FAILED);
+      file = tapeInfos->tay_file;
+      thread = std::thread(&TaylorStack::run, this);
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&] { return jobs.size() < maxQueued || failed; });
+      if (failed) {
+        failAdditionalInfo1 = 0;
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+      }
+      jobs.push_back(numSpilled++);
+    }
+    taylorArenaBytes -= bytes;
+    changed.notify_all();
+  }
+}
+
+void TaylorStack::run() {
+  size_t block, number;
+  revreal *data;
+  bool ok;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&] { return stop || !jobs.empty(); });
+      if (jobs.empty())
+        return;
+      block = jobs.front();
+      data = blocks[block];
+      number = lengths[block];
+    }
+    /* the block stays valid until it is released below */
+    ok = writeAt(file, data, number * sizeof(revreal),
+                 block * blockSize * sizeof(revreal));
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      jobs.pop_front();
+      if (ok) {
+        delete[] blocks[block];
+        blocks[block] = nullptr;
+      } else {
+        /* keep the block in core, the stack stays readable */
+        failed = true;
+        taylorArenaBytes += blockSize * sizeof(revreal);
+      }
+    }
+    changed.notify_all();
+  }
+}
+
+bool TaylorStack::read(size_t block, revreal *buffer, size_t number) {
+  return readAt(file, buffer, number * sizeof(revreal),
+                block * blockSize * sizeof(revreal));
+}
+
+void TaylorStack::readAhead(size_t block) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (block >= blocks.size() || blocks[block] != nullptr)
+      return;
+  }
+  if (ahead == nullptr)
+    ahead = new revreal[blockSize];
+  aheadBlock = block;
+  aheadRead = std::async(std::launch::async, &TaylorStack::read, this, block,
+                         ahead, lengths[block]);
+}
+
+void TaylorStack::get(size_t block, revreal *&buffer, size_t number) {
+  bool found = false;
+
+  if (aheadRead.valid() && aheadRead.get() && aheadBlock == block &&
+      number == lengths[block]) {
+    std::swap(buffer, ahead);
+    found = true;
+  }
+  if (!found) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (block < blocks.size() && blocks[block] != nullptr) {
+      memcpy(buffer, blocks[block], number * sizeof(revreal));
+      found = true;
+    }
+  }
+  if (!found && (block >= blocks.size() || !read(block, buffer, number)))
+    fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  /* reverse sweeps proceed to the next older block */
+  if (block > 0)
+    readAhead(block - 1);
+}
+
+void releaseTaylorStack(TapeInfos *tapeInfos) {
+  delete tapeInfos->taylorStack;
+  tapeInfos->taylorStack = nullptr;
+}
+
 /* record all existing adoubles on the tape
  * - intended to be used in start_trace only */
 void take_stock() {
@@ -636,6 +906,7 @@ void taylor_begin(uint bufferSize, int degreeSave) {
   if (ADOLC_CURRENT_TAPE_INFOS.tayBuffer == nullptr)
     fail(ADOLC_TAPING_TBUFFER_ALLOCATION_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.deg_save = degreeSave;
+  keepBasePoint(nullptr);
   if (degreeSave >= 0)
     ADOLC_CURRENT_TAPE_INFOS.keepTaylors = 1;
   ADOLC_CURRENT_TAPE_INFOS.currTay = ADOLC_CURRENT_TAPE_INFOS.tayBuffer;
@@ -656,6 +927,8 @@ void taylor_close(bool resetData) {
   if (resetData == false) {
     /* enforces failure of reverse => retaping */
     ADOLC_CURRENT_TAPE_INFOS.deg_save = -1;
+    keepBasePoint(nullptr);
+    releaseTaylorStack(&ADOLC_CURRENT_TAPE_INFOS);
     if (ADOLC_CURRENT_TAPE_INFOS.tay_file != nullptr) {
       fclose(ADOLC_CURRENT_TAPE_INFOS.tay_file);
       remove(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tay_fileName);
@@ -664,7 +937,7 @@ void taylor_close(bool resetData) {
     return;
   }
 
-  if (ADOLC_CURRENT_TAPE_INFOS.tay_file != nullptr) {
+  if (ADOLC_CURRENT_TAPE_INFOS.taylorStack != nullptr) {
     if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors)
       put_tay_block(ADOLC_CURRENT_TAPE_INFOS.currTay);
   } else {
@@ -682,9 +955,9 @@ void taylor_close(bool resetData) {
       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS];
 
 #if defined(ADOLC_DEBUG)
-  if (ADOLC_CURRENT_TAPE_INFOS.tay_file != nullptr)
+  if (ADOLC_CURRENT_TAPE_INFOS.taylorStack != nullptr)
     fprintf(DIAG_OUT,
-            "\n ADOL-C debug: Taylor file of length %d bytes "
+            "\n ADOL-C debug: Taylor stack of length %d bytes "
             "completed\n",
             (int)(ADOLC_CURRENT_TAPE_INFOS.numTays_Tape * sizeof(revreal)));
   else
@@ -699,8 +972,7 @@ void taylor_close(bool resetData) {
 /* Initializes a reverse sweep.                                             */
 /****************************************************************************/
 void taylor_back(short tag, int *dep, int *ind, int *degree) {
-  int i, chunks;
-  size_t number, remain, chunkSize;
+  size_t number, bufferSize;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
@@ -717,30 +989,18 @@ void taylor_back(short tag, int *dep, int *ind, int *degree) {
       ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE];
   number = ADOLC_CURRENT_TAPE_INFOS.numTays_Tape %
            ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE];
+  if (ADOLC_CURRENT_TAPE_INFOS.lastTayBlockInCore != 1 && number != 0) {
+    /* the stack may hand over another buffer of the same size */
+    bufferSize =
+        ADOLC_CURRENT_TAPE_INFOS.lastTayP1 - ADOLC_CURRENT_TAPE_INFOS.tayBuffer;
+    ADOLC_CURRENT_TAPE_INFOS.taylorStack->get(
+        ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber,
+        ADOLC_CURRENT_TAPE_INFOS.tayBuffer, number);
+    ADOLC_CURRENT_TAPE_INFOS.lastTayP1 =
+        ADOLC_CURRENT_TAPE_INFOS.tayBuffer + bufferSize;
+  }
   ADOLC_CURRENT_TAPE_INFOS.currTay =
       ADOLC_CURRENT_TAPE_INFOS.tayBuffer + number;
-  if (ADOLC_CURRENT_TAPE_INFOS.lastTayBlockInCore != 1) {
-    if (fseek(ADOLC_CURRENT_TAPE_INFOS.tay_file,
-              sizeof(revreal) * ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber *
-                  ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE],
-              SEEK_SET) == -1)
-      fail(ADOLC_EVAL_SEEK_VALUE_STACK);
-    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(revreal);
-    chunks = number / chunkSize;
-    for (i = 0; i < chunks; ++i)
-      if ((failAdditionalInfo1 =
-               fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + i * chunkSize,
-                     chunkSize * sizeof(revreal), 1,
-                     ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-        fail(ADOLC_TAPING_FATAL_IO_ERROR);
-    remain = number % chunkSize;
-    if (remain != 0)
-      if ((failAdditionalInfo1 =
-               fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + chunks * chunkSize,
-                     remain * sizeof(revreal), 1,
-                     ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-        fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  }
   --ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber;
 }
 
@@ -845,37 +1105,23 @@ void write_scaylors(revreal *x, uint size) {
 }
 
 /****************************************************************************/
-/* Writes the value stack buffer onto hard disk.                            */
+/* Pushes the value stack buffer onto the taylor stack, which keeps it in   */
+/* core or writes it to hard disk.                                          */
 /****************************************************************************/
 void put_tay_block(revreal *lastTayP1) {
-  int i, chunks;
-  size_t number, remain, chunkSize;
+  size_t number;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
-  if (ADOLC_CURRENT_TAPE_INFOS.tay_file == nullptr) {
-    ADOLC_CURRENT_TAPE_INFOS.tay_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tay_fileName, "w+b");
-    if (ADOLC_CURRENT_TAPE_INFOS.tay_file == nullptr)
-      fail(ADOLC_TAPING_TAYLOR_OPEN_FAILED);
-  }
+  if (ADOLC_CURRENT_TAPE_INFOS.taylorStack == nullptr)
+    ADOLC_CURRENT_TAPE_INFOS.taylorStack =
+        new TaylorStack(ADOLC_CURRENT_TAPE_INFOS.lastTayP1 -
+                        ADOLC_CURRENT_TAPE_INFOS.tayBuffer);
   number = lastTayP1 - ADOLC_CURRENT_TAPE_INFOS.tayBuffer;
   if (number != 0) {
-    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(revreal);
-    chunks = number / chunkSize;
-    for (i = 0; i < chunks; ++i)
-      if ((failAdditionalInfo1 =
-               fwrite(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + i * chunkSize,
-                      chunkSize * sizeof(revreal), 1,
-                      ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-        fail(ADOLC_TAPING_FATAL_IO_ERROR);
-    remain = number % chunkSize;
-    if (remain != 0)
-      if ((failAdditionalInfo1 =
-               fwrite(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + chunks * chunkSize,
-                      remain * sizeof(revreal), 1,
-                      ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    ADOLC_CURRENT_TAPE_INFOS.taylorStack->push(
+        ADOLC_CURRENT_TAPE_INFOS.tayBuffer, number, &ADOLC_CURRENT_TAPE_INFOS,
+        ADOLC_GLOBAL_TAPE_VARS.taylorArenaSize);
     ADOLC_CURRENT_TAPE_INFOS.numTays_Tape += number;
   }
   ADOLC_CURRENT_TAPE_INFOS.currTay = ADOLC_CURRENT_TAPE_INFOS.tayBuffer;
@@ -955,37 +1201,114 @@ void get_taylors_p(locint loc, int degree, int numDir) {
 /* Gets the next (previous block) of the value stack                        */
 /****************************************************************************/
 void get_tay_block_r() {
-  int i, chunks;
-  size_t number, remain, chunkSize;
+  size_t number, bufferSize;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   ADOLC_CURRENT_TAPE_INFOS.lastTayBlockInCore = 0;
   number = ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE];
-  if (fseek(ADOLC_CURRENT_TAPE_INFOS.tay_file,
-            sizeof(revreal) * ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber *
-                number,
-            SEEK_SET) == -1)
+  if (ADOLC_CURRENT_TAPE_INFOS.taylorStack == nullptr)
     fail(ADOLC_EVAL_SEEK_VALUE_STACK);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(revreal);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + i * chunkSize,
-                   chunkSize * sizeof(revreal), 1,
-                   ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-      fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + chunks * chunkSize,
-                   remain * sizeof(revreal), 1,
-                   ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-      fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  /* the stack may hand over another buffer of the same size */
+  bufferSize =
+      ADOLC_CURRENT_TAPE_INFOS.lastTayP1 - ADOLC_CURRENT_TAPE_INFOS.tayBuffer;
+  ADOLC_CURRENT_TAPE_INFOS.taylorStack->get(
+      ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber,
+      ADOLC_CURRENT_TAPE_INFOS.tayBuffer, number);
+  ADOLC_CURRENT_TAPE_INFOS.lastTayP1 =
+      ADOLC_CURRENT_TAPE_INFOS.tayBuffer + bufferSize;
   ADOLC_CURRENT_TAPE_INFOS.currTay = ADOLC_CURRENT_TAPE_INFOS.lastTayP1;
   --ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber;
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/* PACKED TAPE RECORDS                                                      */
+/****************************************************************************/
+/****************************************************************************/
+
+/* Records of a tape taped with ADOLC_TAPE_IO_PACKED, see taping_p.h for the
+ * layout. While taping, the record of the last operation stays open, since
+ * its locations may still be updated (upd_resloc). It is packed from the
+ * tape buffers when the next operation is put or a buffer is written. */
+struct TapeRecords {
+  std::vector<uint64_t> words;
+  bool complete;         /* == true once the tape has been finished */
+  unsigned char *opMark; /* opcode of the open record, nullptr if none */
+  locint *locMark;       /* first location of the open record */
+  double *valMark;       /* first value of the open record */
+};
+
+/* packs the open record of the current tape */
+static void closeTapeRecord() {
+  TapeRecords *records;
+  size_t numLocs, numVals, locWords, pos;
+  uint64_t head;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  records = ADOLC_CURRENT_TAPE_INFOS.records;
+  if (records == nullptr || records->opMark == nullptr)
+    return;
+  numLocs = ADOLC_CURRENT_TAPE_INFOS.currLoc - records->locMark;
+  numVals = ADOLC_CURRENT_TAPE_INFOS.currVal - records->valMark;
+  head = *records->opMark | (uint64_t)numLocs << 8 | (uint64_t)numVals << 36;
+  records->opMark = nullptr;
+  if (numLocs > ADOLC_RECORD_MAX_COUNT || numVals > ADOLC_RECORD_MAX_COUNT) {
+    /* sweeps fall back to the tape buffers */
+    releaseTapeRecords(&ADOLC_CURRENT_TAPE_INFOS);
+    return;
+  }
+  locWords = tapeRecordLocWords(head);
+  pos = records->words.size();
+  records->words.resize(pos + locWords + numVals + 2, 0);
+  records->words[pos] = head;
+  if (numLocs > 0)
+    memcpy(&records->words[pos + 1], records->locMark,
+           numLocs * sizeof(locint));
+  if (numVals > 0)
+    memcpy(&records->words[pos + 1 + locWords], records->valMark,
+           numVals * sizeof(double));
+  records->words.back() = head;
+}
+
+/* opens the record of the operation just put */
+static void openTapeRecord() {
+  TapeRecords *records;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  records = ADOLC_CURRENT_TAPE_INFOS.records;
+  if (records == nullptr)
+    return;
+  records->opMark = ADOLC_CURRENT_TAPE_INFOS.currOp - 1;
+  records->locMark = ADOLC_CURRENT_TAPE_INFOS.currLoc;
+  records->valMark = ADOLC_CURRENT_TAPE_INFOS.currVal;
+}
+
+void releaseTapeRecords(TapeInfos *tapeInfos) {
+  delete tapeInfos->records;
+  tapeInfos->records = nullptr;
+  tapeInfos->currRec = nullptr;
+}
+
+/* Sets up a sweep over the packed records of the current tape if they are
+ * complete, the tape buffers are not needed then. Returns false otherwise. */
+static bool initRecordSweep(int mode) {
+  TapeRecords *records;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  records = ADOLC_CURRENT_TAPE_INFOS.records;
+  ADOLC_CURRENT_TAPE_INFOS.currRec = nullptr;
+  if (records == nullptr || !records->complete)
+    return false;
+  ADOLC_CURRENT_TAPE_INFOS.currRec = records->words.data();
+  if (mode == ADOLC_REVERSE)
+    ADOLC_CURRENT_TAPE_INFOS.currRec += records->words.size();
+  return true;
+}
+
 /****************************************************************************/
 /****************************************************************************/
 /* NON-VALUE-STACK FUNCTIONS                                                */
@@ -1038,6 +1361,16 @@ void start_trace() {
   ADOLC_CURRENT_TAPE_INFOS.numSwitches = 0;
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_TAPING;
 
+  /* a new block index is set up by compressed writing */
+  releaseTapeBlockIndex(&ADOLC_CURRENT_TAPE_INFOS);
+  ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_INDEX] = 0;
+  ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_INDEX] = 0;
+  ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_INDEX] = 0;
+  ADOLC_CURRENT_TAPE_INFOS.stats[FILE_CONTAINER] = 0;
+  releaseTapeRecords(&ADOLC_CURRENT_TAPE_INFOS);
+  releaseThreadedTape(&ADOLC_CURRENT_TAPE_INFOS);
+  releaseNativeTape(&ADOLC_CURRENT_TAPE_INFOS);
+
   /* Put operation denoting the start_of_the tape */
   put_op(start_of_tape);
 
@@ -1048,6 +1381,13 @@ void start_trace() {
   for (i = 0; i < statSpace; ++i)
     ADOLC_PUT_LOCINT(0);
 
+  /* the records start with start_of_tape, the stats are not part of it */
+  if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_PACKED) {
+    ADOLC_CURRENT_TAPE_INFOS.records = new TapeRecords;
+    ADOLC_CURRENT_TAPE_INFOS.records->complete = false;
+    openTapeRecord();
+  }
+
   /* initialize value stack if necessary */
   if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors)
     taylor_begin(ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE], 0);
@@ -1107,6 +1447,9 @@ void stop_trace(int flag) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
   put_op(end_of_tape); /* Mark end of tape. */
+  closeTapeRecord();
+  if (ADOLC_CURRENT_TAPE_INFOS.records != nullptr)
+    ADOLC_CURRENT_TAPE_INFOS.records->complete = true;
   save_params();
 
   ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS] =
@@ -1133,7 +1476,7 @@ void stop_trace(int flag) {
    * "keep_stock" even if not written and a second time when actually
    * written by "put_tay_block"). Correction follows here. */
   if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors != 0 &&
-      ADOLC_CURRENT_TAPE_INFOS.tay_file != nullptr) {
+      ADOLC_CURRENT_TAPE_INFOS.taylorStack != nullptr) {
     ADOLC_CURRENT_TAPE_INFOS.stats[TAY_STACK_SIZE] /= 2;
     ADOLC_CURRENT_TAPE_INFOS.numTays_Tape /= 2;
   }
@@ -1142,18 +1485,295 @@ void stop_trace(int flag) {
                        tape stats to the integer tape */
 }
 
+/****************************************************************************/
+/****************************************************************************/
+/* LOCATION COMPACTION                                                      */
+/****************************************************************************/
+/****************************************************************************/
+
+/* Tapes taped with ADOLC_TAPE_IO_COMPACT that stayed in core get new
+ * locations when they are closed. A value written to a location lives from
+ * the operation writing it to its last use. Like registers, these live
+ * ranges are packed into as few locations as possible by a linear scan, so
+ * that NUM_MAX_LIVES, and the memory of all sweeps with it, drops from the
+ * size of the store to the peak number of values live at once. */
+
+/* returns the kinds of the locations of an operation: read ('r'), written
+ * without being read ('w'), read and written ('m') or no location ('n'),
+ * nullptr if its locations cannot be renumbered */
+static const char *tapeLocationKinds(unsigned char op) {
+  switch (op) {
+  case end_of_tape:
+    return "";
+  case assign_ind:
+  case assign_d:
+  case assign_d_zero:
+  case assign_d_one:
+    return "w";
+  case assign_dep:
+  case eq_zero:
+  case neq_zero:
+  case le_zero:
+  case gt_zero:
+  case ge_zero:
+  case lt_zero:
+    return "r";
+  case eq_plus_d:
+  case eq_min_d:
+  case eq_mult_d:
+  case incr_a:
+  case decr_a:
+    return "m";
+  case assign_p:
+    return "nw";
+  case eq_plus_a:
+  case eq_min_a:
+  case eq_mult_a:
+    return "rm";
+  case assign_a:
+  case plus_d_a:
+  case min_d_a:
+  case mult_d_a:
+  case div_d_a:
+  case pos_sign_a:
+  case neg_sign_a:
+  case exp_op:
+  case log_op:
+  case pow_op:
+  case sqrt_op:
+  case cbrt_op:
+  case abs_val:
+  case ceil_op:
+  case floor_op:
+    return "rw";
+  case sin_op:
+  case cos_op:
+    return "rww";
+  case eq_plus_prod:
+  case eq_min_prod:
+  case cond_assign_s:
+  case cond_eq_assign_s:
+    return "rrm";
+  case plus_a_a:
+  case min_a_a:
+  case mult_a_a:
+  case div_a_a:
+  case atan_op:
+  case asin_op:
+  case acos_op:
+  case asinh_op:
+  case acosh_op:
+  case atanh_op:
+  case erf_op:
+  case erfc_op:
+  case gen_quad:
+  case min_op:
+  case eq_a_a:
+  case neq_a_a:
+  case le_a_a:
+  case gt_a_a:
+  case ge_a_a:
+  case lt_a_a:
+    return "rrw";
+  case cond_assign:
+  case cond_eq_assign:
+    return "rrrw";
+  default: /* location ranges, subscripts and external functions */
+    return nullptr;
+  }
+}
+
+/* Renumbers the locations of the current tape, which is kept in core. The
+ * tape stays unchanged if it contains operations that cannot be renumbered
+ * or if no locations are saved. */
+static void compactTapeLocations() {
+  struct LiveRange {
+    size_t start; /* operation writing the value, 0 if read first */
+    size_t end;   /* last operation using the value */
+    locint loc;   /* location of the value while taping */
+  };
+  typedef std::pair<size_t, locint> ActiveRange; /* end, new location */
+  const size_t none = (size_t)-1;
+  TapeInfos *tapeInfos;
+  std::vector<LiveRange> ranges;
+  std::vector<size_t> rangeOf, current;
+  std::vector<locint> newLoc;
+  std::vector<double> stock;
+  std::priority_queue<ActiveRange, std::vector<ActiveRange>,
+                      std::greater<ActiveRange>>
+      active;
+  std::priority_queue<locint, std::vector<locint>, std::greater<locint>>
+      unused;
+  unsigned char *ops;
+  locint *locs, loc;
+  double *vals;
+  const char *kinds;
+  size_t numOps, numLocs, numVals, numLives, numLiveIn = 0, numNew = 0;
+  size_t stockPos = none, deathPos = none, numStock = 0, i, k = 0, r;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  tapeInfos = &ADOLC_CURRENT_TAPE_INFOS;
+  ops = tapeInfos->opBuffer;
+  locs = tapeInfos->locBuffer;
+  vals = tapeInfos->valBuffer;
+  numOps = tapeInfos->currOp - ops;
+  numLocs = tapeInfos->currLoc - locs;
+  numVals = tapeInfos->currVal - vals;
+  numLives = tapeInfos->stats[NUM_MAX_LIVES];
+
+  /* live ranges of all values, the stats after start_of_tape are skipped */
+  rangeOf.assign(numLocs, none);
+  current.assign(numLives, none);
+  for (i = 0; i < numOps; ++i) {
+    if (ops[i] == start_of_tape && i == 0) {
+      k += statSpace;
+      continue;
+    }
+    if (ops[i] == take_stock_op && i == 1 && k + 2 <= numLocs &&
+        locs[k + 1] == 0 && locs[k] <= numVals) {
+      stockPos = k;
+      numStock = locs[k];
+      k += 2;
+      continue;
+    }
+    if (ops[i] == death_not && deathPos == none) {
+      deathPos = k;
+      k += 2;
+      continue;
+    }
+    if ((kinds = tapeLocationKinds(ops[i])) == nullptr ||
+        k + strlen(kinds) > numLocs)
+      return;
+    for (; *kinds != '\0'; ++kinds, ++k) {
+      if (*kinds == 'n')
+        continue;
+      if ((loc = locs[k]) >= numLives)
+        return;
+      /* a value read before being written was recorded by take_stock */
+      if (*kinds == 'w' || current[loc] == none) {
+        current[loc] = ranges.size();
+        ranges.push_back({*kinds == 'w' ? i : 0, i, loc});
+        if (*kinds != 'w')
+          ++numLiveIn;
+      }
+      rangeOf[k] = current[loc];
+      ranges[current[loc]].end = i;
+    }
+  }
+  if (k != numLocs || deathPos == none)
+    return;
+
+  /* Linear scan over the live ranges by their start. Ranges are created in
+   * this order, except for those of the values read first. These come
+   * first and get the lowest locations, take_stock covers just them. A
+   * location is reused only after the operation ending its last range, so
+   * that no operation sees new aliases among its locations. */
+  newLoc.resize(ranges.size());
+  for (int liveIn = 1; liveIn >= 0; --liveIn)
+    for (r = 0; r < ranges.size(); ++r) {
+      if ((ranges[r].start == 0) != (liveIn == 1))
+        continue;
+      while (!active.empty() && active.top().first < ranges[r].start) {
+        unused.push(active.top().second);
+        active.pop();
+      }
+      if (unused.empty()) {
+        newLoc[r] = numNew++;
+      } else {
+        newLoc[r] = unused.top();
+        unused.pop();
+      }
+      active.push(ActiveRange(ranges[r].end, newLoc[r]));
+    }
+  if (numNew == 0 || numNew >= numLives ||
+      (stockPos != none && numLiveIn > numStock))
+    return;
+
+  for (k = 0; k < numLocs; ++k)
+    if (rangeOf[k] != none)
+      locs[k] = newLoc[rangeOf[k]];
+  locs[deathPos] = 0;
+  locs[deathPos + 1] = numNew - 1;
+
+  /* take_stock keeps the values read first only */
+  if (stockPos != none) {
+    stock.assign(numLiveIn, 0.0);
+    for (r = 0; r < ranges.size(); ++r)
+      if (ranges[r].start == 0 && ranges[r].loc < numStock)
+        stock[newLoc[r]] = vals[ranges[r].loc];
+    memmove(vals + numLiveIn, vals + numStock,
+            (numVals - numStock) * sizeof(double));
+    if (numLiveIn > 0)
+      memcpy(vals, stock.data(), numLiveIn * sizeof(double));
+    tapeInfos->currVal -= numStock - numLiveIn;
+    locs[stockPos] = numLiveIn;
+  }
+
+  /* the packed records copy the locations and values of the buffers */
+  if (tapeInfos->records != nullptr) {
+    std::vector<uint64_t> &words = tapeInfos->records->words;
+    std::vector<uint64_t> packed;
+    size_t pos = 0, recLocs, recVals, locWords;
+    const double *recValues;
+    uint64_t head;
+
+    packed.reserve(words.size());
+    k = statSpace;
+    while (pos < words.size()) {
+      head = words[pos];
+      recLocs = (head >> 8) & ADOLC_RECORD_MAX_COUNT;
+      recVals = head >> 36;
+      locWords = tapeRecordLocWords(head);
+      recValues = (const double *)&words[pos + 1 + locWords];
+      pos += locWords + recVals + 2;
+      if ((head & 0xFF) == take_stock_op) {
+        recVals = numLiveIn;
+        recValues = stock.data();
+        head = (head & ((1ULL << 36) - 1)) | (uint64_t)recVals << 36;
+      }
+      packed.resize(packed.size() + locWords + recVals + 2, 0);
+      r = packed.size() - locWords - recVals - 2;
+      packed[r] = head;
+      if (recLocs > 0)
+        memcpy(&packed[r + 1], locs + k, recLocs * sizeof(locint));
+      if (recVals > 0)
+        memcpy(&packed[r + 1 + locWords], recValues, recVals * sizeof(double));
+      packed.back() = head;
+      k += recLocs;
+    }
+    words.swap(packed);
+  }
+
+  tapeInfos->stats[NUM_MAX_LIVES] = numNew;
+  tapeInfos->stats[TAY_STACK_SIZE] -= numLives - numNew;
+  tapeInfos->numTays_Tape -= numLives - numNew;
+}
+
 /****************************************************************************/
 /* Close open tapes, update stats and clean up.                             */
 /****************************************************************************/
 void close_tape(int flag) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
+  /* renumber the locations of a tape kept in core */
+  if (flag == 0 && ADOLC_CURRENT_TAPE_INFOS.op_file == nullptr &&
+      ADOLC_CURRENT_TAPE_INFOS.loc_file == nullptr &&
+      ADOLC_CURRENT_TAPE_INFOS.val_file == nullptr &&
+      ADOLC_CURRENT_TAPE_INFOS.keepTaylors == 0 &&
+      (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+       ADOLC_TAPE_IO_COMPACT))
+    compactTapeLocations();
   /* finish operations tape, close it, update stats */
   if (flag != 0 || ADOLC_CURRENT_TAPE_INFOS.op_file != nullptr) {
     if (ADOLC_CURRENT_TAPE_INFOS.currOp != ADOLC_CURRENT_TAPE_INFOS.opBuffer) {
       put_op_block(ADOLC_CURRENT_TAPE_INFOS.currOp);
     }
-    if (ADOLC_CURRENT_TAPE_INFOS.op_file != nullptr)
+    flushTapeWriter(&ADOLC_CURRENT_TAPE_INFOS);
+    writeTapeBlockIndex(OP_STREAM, ADOLC_CURRENT_TAPE_INFOS.op_file);
+    /* a container is closed with the locations */
+    if (ADOLC_CURRENT_TAPE_INFOS.op_file != nullptr &&
+        ADOLC_CURRENT_TAPE_INFOS.op_file != ADOLC_CURRENT_TAPE_INFOS.loc_file)
       fclose(ADOLC_CURRENT_TAPE_INFOS.op_file);
     ADOLC_CURRENT_TAPE_INFOS.op_file = nullptr;
     ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] = 1;
@@ -1172,7 +1792,11 @@ void close_tape(int flag) {
         ADOLC_CURRENT_TAPE_INFOS.valBuffer) {
       put_val_block(ADOLC_CURRENT_TAPE_INFOS.currVal);
     }
-    if (ADOLC_CURRENT_TAPE_INFOS.val_file != nullptr)
+    flushTapeWriter(&ADOLC_CURRENT_TAPE_INFOS);
+    writeTapeBlockIndex(VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file);
+    /* a container is closed with the locations */
+    if (ADOLC_CURRENT_TAPE_INFOS.val_file != nullptr &&
+        ADOLC_CURRENT_TAPE_INFOS.val_file != ADOLC_CURRENT_TAPE_INFOS.loc_file)
       fclose(ADOLC_CURRENT_TAPE_INFOS.val_file);
     ADOLC_CURRENT_TAPE_INFOS.val_file = nullptr;
     ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] = 1;
@@ -1191,6 +1815,8 @@ void close_tape(int flag) {
         ADOLC_CURRENT_TAPE_INFOS.locBuffer) {
       put_loc_block(ADOLC_CURRENT_TAPE_INFOS.currLoc);
     }
+    flushTapeWriter(&ADOLC_CURRENT_TAPE_INFOS);
+    writeTapeBlockIndex(LOC_STREAM, ADOLC_CURRENT_TAPE_INFOS.loc_file);
     ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] =
         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape;
     ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] = 1;
@@ -1209,12 +1835,20 @@ void close_tape(int flag) {
     ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] =
         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape;
   }
+  releaseTapeWriter(&ADOLC_CURRENT_TAPE_INFOS);
 }
 
 /****************************************************************************/
 /* Free all resources used by a tape before overwriting the tape.           */
 /****************************************************************************/
 void freeTapeResources(TapeInfos *tapeInfos) {
+  unmapTapeFiles(tapeInfos);
+  releaseTapeWriter(tapeInfos);
+  releaseTapePrefetcher(tapeInfos);
+  releaseTapeBlockIndex(tapeInfos);
+  releaseTapeRecords(tapeInfos);
+  releaseThreadedTape(tapeInfos);
+  releaseNativeTape(tapeInfos);
   delete tapeInfos->opBuffer;
   tapeInfos->opBuffer = nullptr;
   delete tapeInfos->locBuffer;
@@ -1226,18 +1860,21 @@ void freeTapeResources(TapeInfos *tapeInfos) {
     tapeInfos->tayBuffer = nullptr;
     --numTBuffersInUse;
   }
+  releaseTaylorStack(tapeInfos);
   if (tapeInfos->op_file != nullptr) {
-    fclose(tapeInfos->op_file);
+    if (tapeInfos->op_file != tapeInfos->loc_file)
+      fclose(tapeInfos->op_file);
     tapeInfos->op_file = nullptr;
   }
+  if (tapeInfos->val_file != nullptr) {
+    if (tapeInfos->val_file != tapeInfos->loc_file)
+      fclose(tapeInfos->val_file);
+    tapeInfos->val_file = nullptr;
+  }
   if (tapeInfos->loc_file != nullptr) {
     fclose(tapeInfos->loc_file);
     tapeInfos->loc_file = nullptr;
   }
-  if (tapeInfos->val_file != nullptr) {
-    fclose(tapeInfos->val_file);
-    tapeInfos->val_file = nullptr;
-  }
   if (tapeInfos->tay_file != nullptr) {
     fclose(tapeInfos->tay_file);
     tapeInfos->tay_file = nullptr;
@@ -1279,8 +1916,10 @@ void tapestats(short tag, size_t *tape_stats) {
 /****************************************************************************/
 void printTapeStats(FILE *stream, short tag) {
   size_t stats[STAT_SIZE];
+  TapeInfos *tapeInfos;
 
   tapestats(tag, (size_t *)&stats);
+  tapeInfos = getTapeInfos(tag);
   fprintf(stream, "\n*** TAPE STATS (tape %d) **********\n", (int)tag);
   fprintf(stream, "Number of independents: %10zu\n", stats[NUM_INDEPENDENTS]);
   fprintf(stream, "Number of dependents:   %10zu\n", stats[NUM_DEPENDENTS]);
@@ -1302,6 +1941,13 @@ void printTapeStats(FILE *stream, short tag) {
   fprintf(stream, "Value buffer size:      %10zu\n", stats[VAL_BUFFER_SIZE]);
   fprintf(stream, "Taylor buffer size:     %10zu\n", stats[TAY_BUFFER_SIZE]);
   fprintf(stream, "\n");
+  fprintf(stream, "Blocks read in sweeps:  %10zu\n",
+          tapeInfos->pTapeInfos.numBlocksLoaded);
+  fprintf(stream, "Blocks prefetched:      %10zu\n",
+          tapeInfos->pTapeInfos.numBlocksPrefetched);
+  fprintf(stream, "Prefetch wait time [s]: %10.4f\n",
+          tapeInfos->pTapeInfos.prefetchWaitTime);
+  fprintf(stream, "\n");
   fprintf(stream, "Operation type size:    %10zu\n",
           (size_t)sizeof(unsigned char));
   fprintf(stream, "Location type size:     %10zu\n", (size_t)sizeof(locint));
@@ -1330,6 +1976,11 @@ static void read_params(TapeInfos *tapeInfos) {
   size_t np, ip, avail, rsize;
   if (tapeInfos->pTapeInfos.paramstore == nullptr)
     tapeInfos->pTapeInfos.paramstore = new double[tapeInfos->stats[NUM_PARAM]];
+  if (tapeInfos->stats[VAL_FILE_INDEX] != 0) {
+    /* compressed values or container */
+    readIndexedParams(tapeInfos);
+    return;
+  }
   valBuffer = new double[tapeInfos->stats[VAL_BUFFER_SIZE]];
   lastValP1 = valBuffer + tapeInfos->stats[VAL_BUFFER_SIZE];
   if (tapeInfos->pTapeInfos.val_fileName != nullptr &&
@@ -1458,6 +2109,15 @@ void read_tape_stats(TapeInfos *tapeInfos) {
     fail(ADOLC_WRONG_LOCINT_SIZE);
   }
 
+  /* tapes of other layouts, in particular of ADOL-C versions before the
+   * format was recorded, are read with wrong stats otherwise */
+  if (tape_ADOLC_ID.tape_format != adolc_id.tape_format ||
+      tape_ADOLC_ID.stat_size != adolc_id.stat_size) {
+    failAdditionalInfo1 = tape_ADOLC_ID.tape_format;
+    failAdditionalInfo2 = adolc_id.tape_format;
+    fail(ADOLC_WRONG_TAPE_FORMAT);
+  }
+
   if (loc_file != nullptr)
     fclose(loc_file);
 
@@ -1471,98 +2131,1307 @@ void skip_tracefile_cleanup(short tnum) {
   tinfo->pTapeInfos.skipFileCleanup = 1;
 }
 
+/* --- Background tape I/O --- */
+
 /****************************************************************************/
-/* Initialize a forward sweep. Get stats, open tapes, fill buffers, ...     */
+/* Helpers shared by the background writer and the prefetching of tape     */
+/* blocks. Buffers are allocated with the types of the tape buffers, as     */
+/* they are exchanged with opBuffer, locBuffer and valBuffer.               */
 /****************************************************************************/
-void init_for_sweep(short tag) {
-  int i = 0, chunks, numLocsForStats;
-  size_t number, remain, chunkSize;
-  ADOLC_OPENMP_THREAD_NUMBER;
-  ADOLC_OPENMP_GET_THREAD_NUMBER;
+static size_t tapeElementSize(int stream) {
+  switch (stream) {
+  case OP_STREAM:
+    return sizeof(unsigned char);
+  case LOC_STREAM:
+    return sizeof(locint);
+  default:
+    return sizeof(double);
+  }
+}
 
-  /* mark possible (hard disk) tape creation */
-  markNewTape();
+static void *newTapeBuffer(int stream, size_t size) {
+  switch (stream) {
+  case OP_STREAM:
+    return new unsigned char[size];
+  case LOC_STREAM:
+    return new locint[size];
+  default:
+    return new double[size];
+  }
+}
 
-  /* make room for tapeInfos and read tape stats if necessary, keep value
-   * stack information */
-  openTape(tag, ADOLC_FORWARD);
-  initTapeBuffers();
+static void deleteTapeBuffer(int stream, void *buffer) {
+  switch (stream) {
+  case OP_STREAM:
+    delete[] (unsigned char *)buffer;
+    break;
+  case LOC_STREAM:
+    delete[] (locint *)buffer;
+    break;
+  default:
+    delete[] (double *)buffer;
+  }
+}
 
-  /* init operations */
-  number = 0;
-  if (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.op_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, "rb");
-    /* how much to read ? */
-    number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
-                       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS]);
-    if (number != 0) {
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-                  chunkSize * sizeof(unsigned char), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-          fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-                  remain * sizeof(unsigned char), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-          fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-    }
-    /* how much remains ? */
-    number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] - number;
+/* --- Tape compression and tape containers --- */
+
+/****************************************************************************/
+/* Compressed tape files (ADOLC_TAPE_IO_COMPRESS). Every block is stored as */
+/* a coding byte followed by the encoded block: locations as zigzag coded   */
+/* deltas of consecutive locints in varint format, operations and values by */
+/* a byte oriented LZ77 codec. Blocks that do not shrink are stored raw.    */
+/* Tape containers (ADOLC_TAPE_IO_CONTAINER) store the blocks of all three  */
+/* streams in the same way, but in the locations file, which also holds the */
+/* tape stats. A tape then consists of a single file.                       */
+/* Narrow tape files (ADOLC_TAPE_IO_NARROW) store blocks of locations below */
+/* 65536 as 16-bit words, which halves (or quarters) the locations stream   */
+/* of small and mid-size tapes while reading stays a plain widening copy.   */
+/* The blocks of these files are located by a block index, which close_tape */
+/* appends to the file and records in the tape stats (*_FILE_INDEX). Blocks */
+/* are read and written at their offsets (pread/pwrite), so that the blocks */
+/* of a container can be loaded concurrently.                               */
+/****************************************************************************/
+enum TapeBlockCodings {
+  TAPE_BLOCK_RAW,
+  TAPE_BLOCK_VARINT,
+  TAPE_BLOCK_LZ,
+  TAPE_BLOCK_NARROW
+};
+
+/* flags of the tapes written in blocks of a block index */
+static const int indexedTapeIO =
+    ADOLC_TAPE_IO_COMPRESS | ADOLC_TAPE_IO_CONTAINER | ADOLC_TAPE_IO_NARROW;
+
+static const int numElementsEntry[NUM_STREAMS] = {
+    NUM_OPERATIONS, NUM_LOCATIONS, NUM_VALUES};
+static const int bufferSizeEntry[NUM_STREAMS] = {
+    OP_BUFFER_SIZE, LOC_BUFFER_SIZE, VAL_BUFFER_SIZE};
+static const int fileIndexEntry[NUM_STREAMS] = {OP_FILE_INDEX, LOC_FILE_INDEX,
+                                                VAL_FILE_INDEX};
+static const int readFailure[NUM_STREAMS] = {ADOLC_EVAL_OP_TAPE_READ_FAILED,
+                                             ADOLC_EVAL_LOC_TAPE_READ_FAILED,
+                                             ADOLC_EVAL_VAL_TAPE_READ_FAILED};
+
+struct TapeBlockIndex {
+  struct Block {
+    size_t offset; /* file offset of the encoded block */
+    size_t length; /* # of bytes of the encoded block */
+  };
+
+  /* blocks of each stream, empty for plain tape files */
+  std::vector<Block> blocks[NUM_STREAMS];
+  size_t blockSize[NUM_STREAMS]; /* # of elements per (full) block */
+  size_t fileEnd[NUM_STREAMS];   /* end of the data written to the files */
+  bool compress;                 /* encode the blocks written */
+  bool narrow;                   /* store small locations in 16 bits */
+  bool container;                /* all streams in the locations file */
+  std::vector<unsigned char> packed[NUM_STREAMS]; /* encoded block */
+
+  /* end of the file holding the blocks of stream */
+  size_t &end(int stream) { return fileEnd[container ? LOC_STREAM : stream]; }
+};
+
+/* returns the name of the file holding the blocks of stream */
+static const char *tapeFileName(TapeInfos *tapeInfos, int stream) {
+  if (stream == LOC_STREAM || tapeInfos->stats[FILE_CONTAINER] != 0)
+    return tapeInfos->pTapeInfos.loc_fileName;
+  if (stream == OP_STREAM)
+    return tapeInfos->pTapeInfos.op_fileName;
+  return tapeInfos->pTapeInfos.val_fileName;
+}
+
+#if !defined(HAVE_UNISTD_H)
+static std::mutex tapeFileMutex; /* serializes positioned file access */
+#endif
+
+/****************************************************************************/
+/* Reads or writes length bytes at offset of file. The position of the      */
+/* stream is not used, so that several threads may access one file.         */
+/****************************************************************************/
+static bool readAt(FILE *file, void *data, size_t length, size_t offset) {
+#if defined(HAVE_UNISTD_H)
+  ssize_t done;
+
+  while (length > 0) {
+    done = pread(fileno(file), data, length, (off_t)offset);
+    if (done < 0 && errno == EINTR)
+      continue;
+    if (done <= 0)
+      return false;
+    data = (char *)data + done;
+    length -= done;
+    offset += done;
   }
-  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape = number;
-  ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+  return true;
+#else
+  std::lock_guard<std::mutex> lock(tapeFileMutex);
+  return fseek(file, (long)offset, SEEK_SET) == 0 &&
+         fread(data, length, 1, file) == 1;
+#endif
+}
 
-  /* init locations */
-  number = 0;
-  if (ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.loc_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
-    /* how much to read ? */
-    number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
-                       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS]);
-    if (number != 0) {
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-                  chunkSize * sizeof(locint), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-          fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-                  remain * sizeof(locint), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-          fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
-    }
-    /* how much remains ? */
-    number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] - number;
+static bool writeAt(FILE *file, const void *data, size_t length,
+                    size_t offset) {
+#if defined(HAVE_UNISTD_H)
+  ssize_t done;
+
+  while (length > 0) {
+    done = pwrite(fileno(file), data, length, (off_t)offset);
+    if (done < 0 && errno == EINTR)
+      continue;
+    if (done <= 0)
+      return false;
+    data = (const char *)data + done;
+    length -= done;
+    offset += done;
   }
-  ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape = number;
+  return true;
+#else
+  std::lock_guard<std::mutex> lock(tapeFileMutex);
+  return fseek(file, (long)offset, SEEK_SET) == 0 &&
+         fwrite(data, length, 1, file) == 1;
+#endif
+}
 
-  /* skip stats */
-  numLocsForStats = statSpace;
-  while (numLocsForStats >= ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]) {
-    get_loc_block_f();
-    numLocsForStats -= ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+static void putVarint(std::vector<unsigned char> &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back((unsigned char)(value | 0x80));
+    value >>= 7;
   }
-  ADOLC_CURRENT_TAPE_INFOS.currLoc =
-      ADOLC_CURRENT_TAPE_INFOS.locBuffer + numLocsForStats;
+  out.push_back((unsigned char)value);
+}
 
-  /* init constants */
-  number = 0;
-  if (ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.val_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, "rb");
+static bool getVarint(const unsigned char *&in, const unsigned char *end,
+                      uint64_t &value) {
+  int shift = 0;
+
+  value = 0;
+  while (in != end && shift < 64) {
+    value |= (uint64_t)(*in & 0x7f) << shift;
+    if (!(*in++ & 0x80))
+      return true;
+    shift += 7;
+  }
+  return false;
+}
+
+static void encodeLocations(std::vector<unsigned char> &out,
+                            const locint *locs, size_t number) {
+  uint64_t previous = 0, delta;
+
+  for (size_t i = 0; i < number; ++i) {
+    delta = (uint64_t)locs[i] - previous;
+    /* zigzag: small negative deltas become small numbers as well */
+    putVarint(out, (delta << 1) ^ (uint64_t)((int64_t)delta >> 63));
+    previous = locs[i];
+  }
+}
+
+static bool decodeLocations(const unsigned char *in, const unsigned char *end,
+                            locint *locs, size_t number) {
+  uint64_t previous = 0, zigzag;
+
+  for (size_t i = 0; i < number; ++i) {
+    if (!getVarint(in, end, zigzag))
+      return false;
+    previous += (zigzag >> 1) ^ (0 - (zigzag & 1));
+    locs[i] = (locint)previous;
+  }
+  return in == end;
+}
+
+/* replaces out by the 16-bit locations, unless a location does not fit */
+static void narrowLocations(std::vector<unsigned char> &out,
+                            const locint *locs, size_t number) {
+  uint16_t narrowLoc;
+
+  for (size_t i = 0; i < number; ++i)
+    if (locs[i] > UINT16_MAX)
+      return;
+  out.resize(1 + number * sizeof(uint16_t));
+  out[0] = TAPE_BLOCK_NARROW;
+  for (size_t i = 0; i < number; ++i) {
+    narrowLoc = (uint16_t)locs[i];
+    memcpy(out.data() + 1 + i * sizeof(uint16_t), &narrowLoc,
+           sizeof(uint16_t));
+  }
+}
+
+static bool widenLocations(const unsigned char *in, const unsigned char *end,
+                           locint *locs, size_t number) {
+  uint16_t narrowLoc;
+
+  if ((size_t)(end - in) != number * sizeof(uint16_t))
+    return false;
+  for (size_t i = 0; i < number; ++i) {
+    memcpy(&narrowLoc, in + i * sizeof(uint16_t), sizeof(uint16_t));
+    locs[i] = narrowLoc;
+  }
+  return true;
+}
+
+/* LZ77 with a single hash table entry per 4 byte prefix. The encoding is a
+ * sequence of (# literals, literals, match length - 4, match distance),
+ * closed by the trailing literals. */
+static const size_t minMatchLength = 4;
+static const int matchHashBits = 12;
+
+static void encodeBytes(std::vector<unsigned char> &out,
+                        const unsigned char *in, size_t size) {
+  std::vector<size_t> table((size_t)1 << matchHashBits, SIZE_MAX);
+  size_t pos = 0, literal = 0, candidate, length, hash;
+  uint32_t prefix;
+
+  while (pos + minMatchLength <= size) {
+    memcpy(&prefix, in + pos, sizeof(prefix));
+    hash = (uint32_t)(prefix * 2654435761u) >> (32 - matchHashBits);
+    candidate = table[hash];
+    table[hash] = pos;
+    if (candidate == SIZE_MAX ||
+        memcmp(in + candidate, in + pos, minMatchLength) != 0) {
+      ++pos;
+      continue;
+    }
+    length = minMatchLength;
+    while (pos + length < size && in[candidate + length] == in[pos + length])
+      ++length;
+    putVarint(out, pos - literal);
+    out.insert(out.end(), in + literal, in + pos);
+    putVarint(out, length - minMatchLength);
+    putVarint(out, pos - candidate);
+    pos += length;
+    literal = pos;
+  }
+  putVarint(out, size - literal);
+  out.insert(out.end(), in + literal, in + size);
+}
+
+static bool decodeBytes(const unsigned char *in, const unsigned char *end,
+                        unsigned char *out, size_t size) {
+  uint64_t literals, length, distance;
+  size_t pos = 0;
+
+  while (true) {
+    if (!getVarint(in, end, literals) || literals > size - pos ||
+        literals > (uint64_t)(end - in))
+      return false;
+    memcpy(out + pos, in, literals);
+    in += literals;
+    pos += literals;
+    if (pos == size)
+      return in == end;
+    if (!getVarint(in, end, length) || !getVarint(in, end, distance))
+      return false;
+    length += minMatchLength;
+    if (distance == 0 || distance > pos || length > size - pos)
+      return false;
+    for (; length > 0; --length, ++pos) /* matches may overlap */
+      out[pos] = out[pos - distance];
+  }
+}
+
+/****************************************************************************/
+/* Writes number elements of a tape stream to file. Given an index, the     */
+/* block is appended as a (compressed) block of the index. Returns false if */
+/* writing fails.                                                           */
+/****************************************************************************/
+static bool writeTapeBlock(int stream, FILE *file, const void *block,
+                           size_t number, TapeBlockIndex *index) {
+  const size_t size = tapeElementSize(stream);
+  size_t i, chunks, remain, chunkSize;
+
+  if (index == nullptr) {
+    chunkSize = ADOLC_IO_CHUNK_SIZE / size;
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fwrite((const char *)block + i * chunkSize * size, chunkSize * size,
+                 1, file) != 1)
+        return false;
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fwrite((const char *)block + chunks * chunkSize * size,
+                 remain * size, 1, file) != 1)
+        return false;
+    return true;
+  }
+
+  std::vector<unsigned char> &packed = index->packed[stream];
+  size_t &end = index->end(stream);
+
+  packed.clear();
+  if (index->compress && stream == LOC_STREAM) {
+    packed.push_back(TAPE_BLOCK_VARINT);
+    encodeLocations(packed, (const locint *)block, number);
+  } else if (index->compress) {
+    packed.push_back(TAPE_BLOCK_LZ);
+    encodeBytes(packed, (const unsigned char *)block, number * size);
+  }
+  if (index->narrow && stream == LOC_STREAM &&
+      (packed.empty() || packed.size() > 1 + number * sizeof(uint16_t)))
+    narrowLocations(packed, (const locint *)block, number);
+  if (packed.empty() || packed.size() > number * size) {
+    packed.assign(1, TAPE_BLOCK_RAW);
+    packed.insert(packed.end(), (const unsigned char *)block,
+                  (const unsigned char *)block + number * size);
+  }
+
+  if (!writeAt(file, packed.data(), packed.size(), end))
+    return false;
+  index->blocks[stream].push_back({end, packed.size()});
+  end += packed.size();
+  return true;
+}
+
+/****************************************************************************/
+/* Reads number elements at offset (in elements) of a tape stream from file */
+/* into buffer, decoding the block if the stream has a block index.         */
+/* Returns false if reading fails.                                          */
+/****************************************************************************/
+static bool readTapeBlock(int stream, FILE *file, void *buffer, size_t offset,
+                          size_t number, TapeBlockIndex *index) {
+  const size_t size = tapeElementSize(stream);
+  size_t i, chunks, remain, chunkSize, block, length;
+
+  if (index == nullptr || index->blocks[stream].empty()) {
+    if (fseek(file, offset * size, SEEK_SET) != 0)
+      return false;
+    chunkSize = ADOLC_IO_CHUNK_SIZE / size;
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread((char *)buffer + i * chunkSize * size, chunkSize * size, 1,
+                file) != 1)
+        return false;
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread((char *)buffer + chunks * chunkSize * size, remain * size, 1,
+                file) != 1)
+        return false;
+    return true;
+  }
+
+  /* sweeps ask for an empty block if the stream ends at a block boundary */
+  if (number == 0)
+    return true;
+
+  std::vector<unsigned char> &packed = index->packed[stream];
+
+  block = offset / index->blockSize[stream];
+  if (block >= index->blocks[stream].size())
+    return false;
+  length = index->blocks[stream][block].length;
+  packed.resize(length);
+  if (length == 0 || !readAt(file, packed.data(), length,
+                             index->blocks[stream][block].offset))
+    return false;
+  switch (packed[0]) {
+  case TAPE_BLOCK_RAW:
+    if (length - 1 != number * size)
+      return false;
+    memcpy(buffer, packed.data() + 1, length - 1);
+    return true;
+  case TAPE_BLOCK_VARINT:
+    return stream == LOC_STREAM &&
+           decodeLocations(packed.data() + 1, packed.data() + length,
+                           (locint *)buffer, number);
+  case TAPE_BLOCK_LZ:
+    return decodeBytes(packed.data() + 1, packed.data() + length,
+                       (unsigned char *)buffer, number * size);
+  case TAPE_BLOCK_NARROW:
+    return stream == LOC_STREAM &&
+           widenLocations(packed.data() + 1, packed.data() + length,
+                          (locint *)buffer, number);
+  default:
+    return false;
+  }
+}
+
+/****************************************************************************/
+/* Returns the block index of the current tape for writing compressed tape  */
+/* files or a container, nullptr for plain tape files.                      */
+/****************************************************************************/
+static TapeBlockIndex *getTapeBlockIndex() {
+  TapeBlockIndex *index;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & indexedTapeIO))
+    return nullptr;
+  if (ADOLC_CURRENT_TAPE_INFOS.blockIndex == nullptr) {
+    index = ADOLC_CURRENT_TAPE_INFOS.blockIndex = new TapeBlockIndex;
+    for (int stream = 0; stream < NUM_STREAMS; ++stream) {
+      index->blockSize[stream] =
+          ADOLC_CURRENT_TAPE_INFOS.stats[bufferSizeEntry[stream]];
+      index->fileEnd[stream] = 0;
+    }
+    /* close_tape writes the tape stats in front of the locations */
+    index->fileEnd[LOC_STREAM] = statSpace * sizeof(locint);
+    index->compress = (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+                       ADOLC_TAPE_IO_COMPRESS) != 0;
+    index->narrow = (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+                     ADOLC_TAPE_IO_NARROW) != 0;
+    index->container = (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+                        ADOLC_TAPE_IO_CONTAINER) != 0;
+  }
+  return ADOLC_CURRENT_TAPE_INFOS.blockIndex;
+}
+
+/****************************************************************************/
+/* Returns the container of the current tape opened for writing. All        */
+/* streams share the file of the locations.                                 */
+/****************************************************************************/
+static FILE *openTapeContainer() {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (ADOLC_CURRENT_TAPE_INFOS.loc_file == nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.loc_file =
+        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "wb");
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_file == nullptr) {
+      failAdditionalInfo1 = 0;
+      fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    }
+  }
+  return ADOLC_CURRENT_TAPE_INFOS.loc_file;
+}
+
+/****************************************************************************/
+/* Opens the file of a stream of the current tape for a sweep. The streams  */
+/* of a container share the file of the locations.                          */
+/****************************************************************************/
+static FILE *openTapeFile(int stream) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[FILE_CONTAINER] == 0)
+    return fopen(tapeFileName(&ADOLC_CURRENT_TAPE_INFOS, stream), "rb");
+  if (ADOLC_CURRENT_TAPE_INFOS.loc_file == nullptr)
+    ADOLC_CURRENT_TAPE_INFOS.loc_file =
+        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
+  return ADOLC_CURRENT_TAPE_INFOS.loc_file;
+}
+
+/****************************************************************************/
+/* Appends the block index of a stream to its file and records its position */
+/* in the tape stats. Called by close_tape after the last block of the      */
+/* stream has been written.                                                 */
+/****************************************************************************/
+static void writeTapeBlockIndex(int stream, FILE *file) {
+  TapeBlockIndex *index;
+  size_t length;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  index = ADOLC_CURRENT_TAPE_INFOS.blockIndex;
+  if (index == nullptr || index->blocks[stream].empty() || file == nullptr)
+    return;
+  size_t &end = index->end(stream);
+  length = index->blocks[stream].size() * sizeof(TapeBlockIndex::Block);
+  if (!writeAt(file, index->blocks[stream].data(), length, end)) {
+    failAdditionalInfo1 = 0;
+    fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.stats[fileIndexEntry[stream]] = end;
+  ADOLC_CURRENT_TAPE_INFOS.stats[FILE_CONTAINER] = index->container;
+  end += length;
+}
+
+/****************************************************************************/
+/* Reads the block indices of a tape from its files, if they are not known  */
+/* from taping it in this run.                                              */
+/****************************************************************************/
+static void readTapeBlockIndex(TapeInfos *tapeInfos) {
+  TapeBlockIndex *index;
+  size_t numBlocks;
+  FILE *file = nullptr;
+  int stream;
+
+  if (tapeInfos->blockIndex != nullptr)
+    return;
+  for (stream = 0; stream < NUM_STREAMS; ++stream)
+    if (tapeInfos->stats[fileIndexEntry[stream]] != 0)
+      break;
+  if (stream == NUM_STREAMS)
+    return;
+
+  index = tapeInfos->blockIndex = new TapeBlockIndex;
+  index->compress = false;
+  index->narrow = false;
+  index->container = tapeInfos->stats[FILE_CONTAINER] != 0;
+  for (stream = 0; stream < NUM_STREAMS; ++stream) {
+    index->blockSize[stream] = tapeInfos->stats[bufferSizeEntry[stream]];
+    index->fileEnd[stream] = 0;
+    if (tapeInfos->stats[fileIndexEntry[stream]] == 0)
+      continue;
+    numBlocks = (tapeInfos->stats[numElementsEntry[stream]] +
+                 index->blockSize[stream] - 1) /
+                index->blockSize[stream];
+    index->blocks[stream].resize(numBlocks);
+    if (file == nullptr &&
+        (file = fopen(tapeFileName(tapeInfos, stream), "rb")) == nullptr)
+      fail(readFailure[stream]);
+    if (!readAt(file, index->blocks[stream].data(),
+                numBlocks * sizeof(TapeBlockIndex::Block),
+                tapeInfos->stats[fileIndexEntry[stream]]))
+      fail(readFailure[stream]);
+    if (!index->container) {
+      fclose(file);
+      file = nullptr;
+    }
+  }
+  if (file != nullptr)
+    fclose(file);
+}
+
+/****************************************************************************/
+/* Reads the parameters of a tape from the end of its values stream, if     */
+/* this is stored in blocks of a block index.                               */
+/****************************************************************************/
+static void readIndexedParams(TapeInfos *tapeInfos) {
+  const size_t numValues = tapeInfos->stats[NUM_VALUES];
+  const size_t first = numValues - tapeInfos->stats[NUM_PARAM];
+  size_t blockSize, begin, number, i;
+  TapeBlockIndex *index;
+  double *valBuffer;
+  FILE *val_file;
+
+  readTapeBlockIndex(tapeInfos);
+  index = tapeInfos->blockIndex;
+  blockSize = index->blockSize[VAL_STREAM];
+  if ((val_file = fopen(tapeFileName(tapeInfos, VAL_STREAM), "rb")) ==
+      nullptr)
+    fail(ADOLC_VALUE_TAPE_FOPEN_FAILED);
+  valBuffer = new double[blockSize];
+  for (begin = first - first % blockSize; begin < numValues;
+       begin += blockSize) {
+    number = MIN_ADOLC(blockSize, numValues - begin);
+    if (!readTapeBlock(VAL_STREAM, val_file, valBuffer, begin, number, index))
+      fail(ADOLC_VALUE_TAPE_FREAD_FAILED);
+    for (i = MAX_ADOLC(begin, first); i < begin + number; ++i)
+      tapeInfos->pTapeInfos.paramstore[i - first] = valBuffer[i - begin];
+  }
+  delete[] valBuffer;
+  fclose(val_file);
+}
+
+void releaseTapeBlockIndex(TapeInfos *tapeInfos) {
+  delete tapeInfos->blockIndex;
+  tapeInfos->blockIndex = nullptr;
+}
+
+/****************************************************************************/
+/* Writer thread of a tape (ADOLC_TAPE_IO_ASYNC). Full blocks of the        */
+/* operations, locations and values tapes are queued and written to disk in */
+/* the order of their arrival, while taping continues in another buffer of  */
+/* the same stream. At most TAPEIOBUFNUM buffers per stream are in use.     */
+/****************************************************************************/
+struct TapeWriter {
+  TapeWriter();
+  ~TapeWriter();
+
+  /* queues number elements starting at block for writing to file
+   * (compressed if index is given) and returns a free buffer of bufferSize
+   * elements to continue taping */
+  void *write(int stream, FILE *file, void *block, size_t number,
+              size_t bufferSize, TapeBlockIndex *index);
+  /* waits until all queued blocks are written */
+  void flush();
+
+private:
+  struct Job {
+    int stream;
+    FILE *file;
+    void *block;
+    size_t number;
+    TapeBlockIndex *index;
+  };
+
+  void run();
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<Job> jobs;
+  std::vector<void *> freeBuffers[NUM_STREAMS];
+  int numQueued[NUM_STREAMS]; /* blocks queued or being written */
+  bool stop;
+  bool failed;
+  std::thread thread;
+};
+
+TapeWriter::TapeWriter() : numQueued(), stop(false), failed(false) {
+  thread = std::thread(&TapeWriter::run, this);
+}
+
+TapeWriter::~TapeWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  changed.notify_all();
+  thread.join();
+  for (int stream = 0; stream < NUM_STREAMS; ++stream)
+    for (void *buffer : freeBuffers[stream])
+      deleteTapeBuffer(stream, buffer);
+}
+
+void *TapeWriter::write(int stream, FILE *file, void *block, size_t number,
+                        size_t bufferSize, TapeBlockIndex *index) {
+  void *buffer = nullptr;
+  const int maxQueued = (TAPEIOBUFNUM > 2 ? TAPEIOBUFNUM : 2) - 1;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return numQueued[stream] < maxQueued || failed; });
+    if (failed) {
+      failAdditionalInfo1 = 0;
+      fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    }
+    jobs.push_back({stream, file, block, number, index});
+    ++numQueued[stream];
+    if (!freeBuffers[stream].empty()) {
+      buffer = freeBuffers[stream].back();
+      freeBuffers[stream].pop_back();
+    }
+  }
+  changed.notify_all();
+  if (buffer == nullptr)
+    buffer = newTapeBuffer(stream, bufferSize);
+  return buffer;
+}
+
+void TapeWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  changed.wait(lock, [&] {
+    return numQueued[OP_STREAM] + numQueued[LOC_STREAM] +
+               numQueued[VAL_STREAM] ==
+           0;
+  });
+  if (failed) {
+    failAdditionalInfo1 = 0;
+    fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
+}
+
+void TapeWriter::run() {
+  bool ok;
+  Job job;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&] { return stop || !jobs.empty(); });
+      if (jobs.empty())
+        return;
+      job = jobs.front();
+      jobs.pop_front();
+    }
+    ok = writeTapeBlock(job.stream, job.file, job.block, job.number,
+                        job.index);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!ok)
+        failed = true;
+      freeBuffers[job.stream].push_back(job.block);
+      --numQueued[job.stream];
+    }
+    changed.notify_all();
+  }
+}
+
+/****************************************************************************/
+/* Returns the background writer of the current tape, which is started with */
+/* the first block written in ADOLC_TAPE_IO_ASYNC mode.                     */
+/****************************************************************************/
+static TapeWriter *getTapeWriter() {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  if (ADOLC_CURRENT_TAPE_INFOS.tapeWriter == nullptr)
+    ADOLC_CURRENT_TAPE_INFOS.tapeWriter = new TapeWriter;
+  return ADOLC_CURRENT_TAPE_INFOS.tapeWriter;
+}
+
+void flushTapeWriter(TapeInfos *tapeInfos) {
+  if (tapeInfos->tapeWriter != nullptr)
+    tapeInfos->tapeWriter->flush();
+}
+
+void releaseTapeWriter(TapeInfos *tapeInfos) {
+  delete tapeInfos->tapeWriter;
+  tapeInfos->tapeWriter = nullptr;
+}
+
+/****************************************************************************/
+/* Read-ahead of tape blocks during sweeps (ADOLC_TAPE_IO_PREFETCH). While  */
+/* a block is interpreted, the block needed next (the following one in a    */
+/* forward, the preceding one in a reverse sweep) is read by a helper       */
+/* thread into a second buffer of the stream.                               */
+/****************************************************************************/
+struct TapePrefetcher {
+  TapePrefetcher();
+  ~TapePrefetcher();
+
+  /* starts reading number elements at offset (in elements) of file */
+  void prefetch(int stream, FILE *file, size_t offset, size_t number,
+                size_t bufferSize, TapeBlockIndex *index);
+  /* exchanges *buffer with the prefetched block, returns false and leaves
+   * the file positioned at offset if this block has not been prefetched */
+  bool fetch(int stream, void **buffer, size_t offset, size_t number,
+             PersistantTapeInfos *pTapeInfos);
+
+private:
+  struct Block {
+    std::future<bool> done;
+    void *buffer;
+    FILE *file;
+    size_t offset;
+    size_t number;
+  };
+
+  Block blocks[NUM_STREAMS];
+  void *spareBuffers[NUM_STREAMS];
+};
+
+TapePrefetcher::TapePrefetcher() {
+  for (int stream = 0; stream < NUM_STREAMS; ++stream) {
+    blocks[stream].buffer = nullptr;
+    spareBuffers[stream] = nullptr;
+  }
+}
+
+TapePrefetcher::~TapePrefetcher() {
+  for (int stream = 0; stream < NUM_STREAMS; ++stream) {
+    if (blocks[stream].done.valid())
+      blocks[stream].done.wait();
+    if (blocks[stream].buffer != nullptr)
+      deleteTapeBuffer(stream, blocks[stream].buffer);
+    if (spareBuffers[stream] != nullptr)
+      deleteTapeBuffer(stream, spareBuffers[stream]);
+  }
+}
+
+void TapePrefetcher::prefetch(int stream, FILE *file, size_t offset,
+                              size_t number, size_t bufferSize,
+                              TapeBlockIndex *index) {
+  Block &block = blocks[stream];
+  void *buffer;
+
+  if (block.done.valid()) /* not used, e.g. by discard_params_r */
+    block.done.wait();
+  if (block.buffer != nullptr)
+    spareBuffers[stream] = block.buffer;
+  if (spareBuffers[stream] == nullptr)
+    spareBuffers[stream] = newTapeBuffer(stream, bufferSize);
+  buffer = block.buffer = spareBuffers[stream];
+  spareBuffers[stream] = nullptr;
+  block.file = file;
+  block.offset = offset;
+  block.number = number;
+  block.done = std::async(std::launch::async, [=] {
+    return readTapeBlock(stream, file, buffer, offset, number, index);
+  });
+}
+
+bool TapePrefetcher::fetch(int stream, void **buffer, size_t offset,
+                           size_t number, PersistantTapeInfos *pTapeInfos) {
+  Block &block = blocks[stream];
+  std::chrono::steady_clock::time_point start;
+  bool success;
+
+  if (!block.done.valid())
+    return false;
+  start = std::chrono::steady_clock::now();
+  success = block.done.get();
+  pTapeInfos->prefetchWaitTime +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count();
+  if (!success || block.offset != offset || block.number != number) {
+    /* not the requested block => read it directly */
+    spareBuffers[stream] = block.buffer;
+    block.buffer = nullptr;
+    fseek(block.file, offset * tapeElementSize(stream), SEEK_SET);
+    return false;
+  }
+  spareBuffers[stream] = *buffer;
+  *buffer = block.buffer;
+  block.buffer = nullptr;
+  ++pTapeInfos->numBlocksPrefetched;
+  return true;
+}
+
+/****************************************************************************/
+/* Provides the requested block of the current tape from the prefetched     */
+/* data or by decompressing it. Returns false if it has to be read directly */
+/* from the (uncompressed) tape file.                                       */
+/****************************************************************************/
+static bool fetchTapeBlock(int stream, void **buffer, size_t offset,
+                           size_t number) {
+  TapeBlockIndex *index;
+  FILE *file;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  ++ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.numBlocksLoaded;
+  if (ADOLC_CURRENT_TAPE_INFOS.tapePrefetcher != nullptr &&
+      ADOLC_CURRENT_TAPE_INFOS.tapePrefetcher->fetch(
+          stream, buffer, offset, number,
+          &ADOLC_CURRENT_TAPE_INFOS.pTapeInfos))
+    return true;
+  index = ADOLC_CURRENT_TAPE_INFOS.blockIndex;
+  if (index == nullptr || index->blocks[stream].empty())
+    return false;
+  switch (stream) {
+  case OP_STREAM:
+    file = ADOLC_CURRENT_TAPE_INFOS.op_file;
+    break;
+  case LOC_STREAM:
+    file = ADOLC_CURRENT_TAPE_INFOS.loc_file;
+    break;
+  default:
+    file = ADOLC_CURRENT_TAPE_INFOS.val_file;
+  }
+  if (!readTapeBlock(stream, file, *buffer, offset, number, index))
+    fail(readFailure[stream]);
+  return true;
+}
+
+/****************************************************************************/
+/* Starts reading the block needed next if ADOLC_TAPE_IO_PREFETCH is set.   */
+/****************************************************************************/
+static void prefetchTapeBlock(int stream, FILE *file, size_t offset,
+                              size_t number, size_t bufferSize) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  /* mapped tapes (ADOLC_TAPE_IO_MMAP) are not opened as files */
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+        ADOLC_TAPE_IO_PREFETCH) ||
+      file == nullptr || number == 0)
+    return;
+  if (ADOLC_CURRENT_TAPE_INFOS.tapePrefetcher == nullptr)
+    ADOLC_CURRENT_TAPE_INFOS.tapePrefetcher = new TapePrefetcher;
+  ADOLC_CURRENT_TAPE_INFOS.tapePrefetcher->prefetch(
+      stream, file, offset, number, bufferSize,
+      ADOLC_CURRENT_TAPE_INFOS.blockIndex);
+}
+
+void releaseTapePrefetcher(TapeInfos *tapeInfos) {
+  delete tapeInfos->tapePrefetcher;
+  tapeInfos->tapePrefetcher = nullptr;
+}
+
+#if defined(HAVE_SYS_MMAN_H)
+/****************************************************************************/
+/* Maps size bytes of the given tape file read-only into memory. Returns    */
+/* nullptr if this is not possible, the sweep then reads the file blockwise.*/
+/****************************************************************************/
+static void *mapTapeFile(const char *fileName, size_t size) {
+  struct stat st;
+  void *map;
+  int fd;
+
+  if (size == 0)
+    return nullptr;
+  fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < size) {
+    close(fd);
+    return nullptr;
+  }
+  map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd); /* the mapping keeps the file referenced */
+  return (map == MAP_FAILED) ? nullptr : map;
+}
+#endif
+
+/****************************************************************************/
+/* Maps the operations, locations and values files of the current tape if   */
+/* requested by ADOLC_TAPE_IO_MMAP. The tape buffers are then only windows  */
+/* into the mappings and block reads reduce to pointer updates. Compressed  */
+/* files are read blockwise.                                                */
+/****************************************************************************/
+static void mapTapeFiles() {
+#if defined(HAVE_SYS_MMAN_H)
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_MMAP))
+    return;
+
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1 &&
+      ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_INDEX] == 0 &&
+      ADOLC_CURRENT_TAPE_INFOS.op_map == nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.op_mapSize =
+        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] * sizeof(unsigned char);
+    ADOLC_CURRENT_TAPE_INFOS.op_map = (unsigned char *)mapTapeFile(
+        ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName,
+        ADOLC_CURRENT_TAPE_INFOS.op_mapSize);
+    if (ADOLC_CURRENT_TAPE_INFOS.op_map != nullptr) {
+      delete[] ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+      ADOLC_CURRENT_TAPE_INFOS.opBuffer = ADOLC_CURRENT_TAPE_INFOS.op_map;
+    }
+  }
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1 &&
+      ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_INDEX] == 0 &&
+      ADOLC_CURRENT_TAPE_INFOS.loc_map == nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.loc_mapSize =
+        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] * sizeof(locint);
+    ADOLC_CURRENT_TAPE_INFOS.loc_map = (locint *)mapTapeFile(
+        ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName,
+        ADOLC_CURRENT_TAPE_INFOS.loc_mapSize);
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_map != nullptr) {
+      delete[] ADOLC_CURRENT_TAPE_INFOS.locBuffer;
+      ADOLC_CURRENT_TAPE_INFOS.locBuffer = ADOLC_CURRENT_TAPE_INFOS.loc_map;
+    }
+  }
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1 &&
+      ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_INDEX] == 0 &&
+      ADOLC_CURRENT_TAPE_INFOS.val_map == nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.val_mapSize =
+        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] * sizeof(double);
+    ADOLC_CURRENT_TAPE_INFOS.val_map = (double *)mapTapeFile(
+        ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName,
+        ADOLC_CURRENT_TAPE_INFOS.val_mapSize);
+    if (ADOLC_CURRENT_TAPE_INFOS.val_map != nullptr) {
+      delete[] ADOLC_CURRENT_TAPE_INFOS.valBuffer;
+      ADOLC_CURRENT_TAPE_INFOS.valBuffer = ADOLC_CURRENT_TAPE_INFOS.val_map;
+    }
+  }
+#endif
+}
+
+/****************************************************************************/
+/* Releases the tape file mappings or the copies of the tape files kept by  */
+/* the tape pool. Buffers pointing into them are reset, so that taping or a */
+/* later sweep allocate fresh ones.                                         */
+/****************************************************************************/
+static void releaseTapeMap(const TapeInfos *tapeInfos, int stream, void *map,
+                           size_t size) {
+  if (tapeInfos->mapsInPool) {
+    deleteTapeBuffer(stream, map);
+    return;
+  }
+#if defined(HAVE_SYS_MMAN_H)
+  munmap(map, size);
+#endif
+}
+
+void unmapTapeFiles(TapeInfos *tapeInfos) {
+  if (tapeInfos->op_map != nullptr) {
+    releaseTapeMap(tapeInfos, OP_STREAM, tapeInfos->op_map,
+                   tapeInfos->op_mapSize);
+    tapeInfos->op_map = nullptr;
+    tapeInfos->op_mapSize = 0;
+    tapeInfos->opBuffer = nullptr;
+    tapeInfos->currOp = nullptr;
+    tapeInfos->lastOpP1 = nullptr;
+  }
+  if (tapeInfos->loc_map != nullptr) {
+    releaseTapeMap(tapeInfos, LOC_STREAM, tapeInfos->loc_map,
+                   tapeInfos->loc_mapSize);
+    tapeInfos->loc_map = nullptr;
+    tapeInfos->loc_mapSize = 0;
+    tapeInfos->locBuffer = nullptr;
+    tapeInfos->currLoc = nullptr;
+    tapeInfos->lastLocP1 = nullptr;
+  }
+  if (tapeInfos->val_map != nullptr) {
+    releaseTapeMap(tapeInfos, VAL_STREAM, tapeInfos->val_map,
+                   tapeInfos->val_mapSize);
+    tapeInfos->val_map = nullptr;
+    tapeInfos->val_mapSize = 0;
+    tapeInfos->valBuffer = nullptr;
+    tapeInfos->currVal = nullptr;
+    tapeInfos->lastValP1 = nullptr;
+  }
+  tapeInfos->mapsInPool = 0;
+}
+
+/****************************************************************************/
+/* Tape pool: complete tapes stay in core across sweeps within the budget   */
+/* set by setTapePoolSize. The streams of a tape written to disk are read   */
+/* in full on its first sweep. These copies take the place of the mappings */
+/* of ADOLC_TAPE_IO_MMAP, later sweeps and read_tape_stats then do not      */
+/* access the tape files any more. The least recently used tapes are        */
+/* evicted by tape_handling.cpp.                                            */
+/****************************************************************************/
+static const int fileAccessEntry[NUM_STREAMS] = {
+    OP_FILE_ACCESS, LOC_FILE_ACCESS, VAL_FILE_ACCESS};
+
+size_t tapeCoreSize(const TapeInfos *tapeInfos) {
+  size_t size = 0;
+
+  if (tapeInfos->mapsInPool)
+    size += tapeInfos->op_mapSize + tapeInfos->loc_mapSize +
+            tapeInfos->val_mapSize;
+  if (tapeInfos->stats[OP_FILE_ACCESS] == 0 && tapeInfos->opBuffer != nullptr)
+    size += tapeInfos->stats[OP_BUFFER_SIZE] * sizeof(unsigned char);
+  if (tapeInfos->stats[LOC_FILE_ACCESS] == 0 &&
+      tapeInfos->locBuffer != nullptr)
+    size += tapeInfos->stats[LOC_BUFFER_SIZE] * sizeof(locint);
+  if (tapeInfos->stats[VAL_FILE_ACCESS] == 0 &&
+      tapeInfos->valBuffer != nullptr)
+    size += tapeInfos->stats[VAL_BUFFER_SIZE] * sizeof(double);
+  if (tapeInfos->records != nullptr)
+    size += tapeInfos->records->words.capacity() * sizeof(uint64_t);
+  size += threadedTapeSize(tapeInfos);
+  size += nativeTapeSize(tapeInfos);
+  return size;
+}
+
+/* Reads the streams of the current tape written to disk into the tape pool
+ * if they fit, the buffers are then set to the start of the copies. */
+static void attachTapePool() {
+  TapeInfos *tapeInfos;
+  void *copies[NUM_STREAMS] = {nullptr, nullptr, nullptr};
+  size_t number[NUM_STREAMS], size = 0, offset, blockSize;
+  FILE *file;
+  int stream;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  tapeInfos = &ADOLC_CURRENT_TAPE_INFOS;
+  if (!tapeInfos->mapsInPool) {
+    for (stream = 0; stream < NUM_STREAMS; ++stream) {
+      number[stream] = 0;
+      if (tapeInfos->stats[fileAccessEntry[stream]] == 1)
+        number[stream] = tapeInfos->stats[numElementsEntry[stream]];
+      size += number[stream] * tapeElementSize(stream);
+    }
+    if (size == 0 || !reserveTapePool(size))
+      return;
+
+    readTapeBlockIndex(tapeInfos);
+    for (stream = 0; stream < NUM_STREAMS; ++stream) {
+      if (number[stream] == 0)
+        continue;
+      blockSize = tapeInfos->stats[bufferSizeEntry[stream]];
+      copies[stream] = newTapeBuffer(stream, number[stream]);
+      if ((file = fopen(tapeFileName(tapeInfos, stream), "rb")) == nullptr)
+        fail(readFailure[stream]);
+      for (offset = 0; offset < number[stream]; offset += blockSize)
+        if (!readTapeBlock(
+                stream, file,
+                (char *)copies[stream] + offset * tapeElementSize(stream),
+                offset, MIN_ADOLC(blockSize, number[stream] - offset),
+                tapeInfos->blockIndex))
+          fail(readFailure[stream]);
+      fclose(file);
+    }
+
+    if (copies[OP_STREAM] != nullptr) {
+      delete[] tapeInfos->opBuffer;
+      tapeInfos->op_map = (unsigned char *)copies[OP_STREAM];
+      tapeInfos->op_mapSize = number[OP_STREAM] * sizeof(unsigned char);
+    }
+    if (copies[LOC_STREAM] != nullptr) {
+      delete[] tapeInfos->locBuffer;
+      tapeInfos->loc_map = (locint *)copies[LOC_STREAM];
+      tapeInfos->loc_mapSize = number[LOC_STREAM] * sizeof(locint);
+    }
+    if (copies[VAL_STREAM] != nullptr) {
+      delete[] tapeInfos->valBuffer;
+      tapeInfos->val_map = (double *)copies[VAL_STREAM];
+      tapeInfos->val_mapSize = number[VAL_STREAM] * sizeof(double);
+    }
+    tapeInfos->mapsInPool = 1;
+  }
+  if (tapeInfos->op_map != nullptr)
+    tapeInfos->opBuffer = tapeInfos->op_map;
+  if (tapeInfos->loc_map != nullptr)
+    tapeInfos->locBuffer = tapeInfos->loc_map;
+  if (tapeInfos->val_map != nullptr)
+    tapeInfos->valBuffer = tapeInfos->val_map;
+}
+
+/* Writes a tape held completely in core to plain tape files. Parameters
+ * set after taping are stored with the values. */
+static void writeTapeFiles(TapeInfos *tapeInfos) {
+  const size_t numParam = tapeInfos->stats[NUM_PARAM];
+  FILE *op_file, *loc_file, *val_file;
+
+  if (numParam > 0 && tapeInfos->pTapeInfos.paramstore != nullptr)
+    memcpy(tapeInfos->valBuffer + tapeInfos->stats[NUM_VALUES] - numParam,
+           tapeInfos->pTapeInfos.paramstore, numParam * sizeof(double));
+  tapeInfos->stats[OP_FILE_ACCESS] = 1;
+  tapeInfos->stats[LOC_FILE_ACCESS] = 1;
+  tapeInfos->stats[VAL_FILE_ACCESS] = 1;
+
+  op_file = fopen(tapeInfos->pTapeInfos.op_fileName, "wb");
+  loc_file = fopen(tapeInfos->pTapeInfos.loc_fileName, "wb");
+  val_file = fopen(tapeInfos->pTapeInfos.val_fileName, "wb");
+  if (op_file == nullptr || loc_file == nullptr || val_file == nullptr ||
+      !writeTapeBlock(OP_STREAM, op_file, tapeInfos->opBuffer,
+                      tapeInfos->stats[NUM_OPERATIONS], nullptr) ||
+      !writeTapeBlock(LOC_STREAM, loc_file, tapeInfos->locBuffer,
+                      tapeInfos->stats[NUM_LOCATIONS], nullptr) ||
+      !writeTapeBlock(VAL_STREAM, val_file, tapeInfos->valBuffer,
+                      tapeInfos->stats[NUM_VALUES], nullptr) ||
+      fseek(loc_file, 0, SEEK_SET) != 0 ||
+      fwrite(&adolc_id, sizeof(ADOLC_ID), 1, loc_file) != 1 ||
+      fwrite(tapeInfos->stats, STAT_SIZE * sizeof(size_t), 1, loc_file) != 1) {
+    failAdditionalInfo1 = tapeInfos->tapeID;
+    fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
+  fclose(op_file);
+  fclose(loc_file);
+  fclose(val_file);
+}
+
+/****************************************************************************/
+/* Evicts a tape from core for the tape pool. Pooled copies of the tape     */
+/* files are dropped, a tape held completely in core is written to disk     */
+/* first. The in-core streams of partially written tapes are kept.         */
+/****************************************************************************/
+void evictTape(TapeInfos *tapeInfos) {
+  unmapTapeFiles(tapeInfos);
+  releaseTapeRecords(tapeInfos);
+  releaseThreadedTape(tapeInfos);
+  releaseNativeTape(tapeInfos);
+  if (tapeInfos->stats[OP_FILE_ACCESS] == 0 &&
+      tapeInfos->stats[LOC_FILE_ACCESS] == 0 &&
+      tapeInfos->stats[VAL_FILE_ACCESS] == 0 &&
+      tapeInfos->opBuffer != nullptr && tapeInfos->locBuffer != nullptr &&
+      tapeInfos->valBuffer != nullptr) {
+    writeTapeFiles(tapeInfos);
+    delete[] tapeInfos->opBuffer;
+    tapeInfos->opBuffer = nullptr;
+    tapeInfos->currOp = nullptr;
+    tapeInfos->lastOpP1 = nullptr;
+    delete[] tapeInfos->locBuffer;
+    tapeInfos->locBuffer = nullptr;
+    tapeInfos->currLoc = nullptr;
+    tapeInfos->lastLocP1 = nullptr;
+    delete[] tapeInfos->valBuffer;
+    tapeInfos->valBuffer = nullptr;
+    tapeInfos->currVal = nullptr;
+    tapeInfos->lastValP1 = nullptr;
+  }
+  /* as in releaseTape, the stats are read again from disk on the next use */
+  if (tapeInfos->keepTaylors == 0 && tapeInfos->stats[OP_FILE_ACCESS] == 1 &&
+      tapeInfos->stats[LOC_FILE_ACCESS] == 1 &&
+      tapeInfos->stats[VAL_FILE_ACCESS] == 1)
+    tapeInfos->inUse = 0;
+}
+
+/****************************************************************************/
+/* Initialize a forward sweep. Get stats, open tapes, fill buffers, ...     */
+/****************************************************************************/
+void init_for_sweep(short tag) {
+  int i = 0, chunks, numLocsForStats;
+  size_t number, remain, chunkSize;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  /* mark possible (hard disk) tape creation */
+  markNewTape();
+
+  /* make room for tapeInfos and read tape stats if necessary, keep value
+   * stack information */
+  openTape(tag, ADOLC_FORWARD);
+  if (initRecordSweep(ADOLC_FORWARD)) {
+#ifdef ADOLC_AMPI_SUPPORT
+    TAPE_AMPI_resetBottom();
+#endif
+    return;
+  }
+  attachTapePool();
+  readTapeBlockIndex(&ADOLC_CURRENT_TAPE_INFOS);
+  mapTapeFiles();
+  initTapeBuffers();
+
+  /* init operations */
+  number = 0;
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1) {
+    if (ADOLC_CURRENT_TAPE_INFOS.op_map == nullptr)
+      ADOLC_CURRENT_TAPE_INFOS.op_file = openTapeFile(OP_STREAM);
+    /* how much to read ? */
+    number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
+                       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS]);
+    if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.op_map == nullptr &&
+        !fetchTapeBlock(OP_STREAM,
+                        (void **)&ADOLC_CURRENT_TAPE_INFOS.opBuffer, 0,
+                        number)) {
+      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+      chunks = number / chunkSize;
+      for (i = 0; i < chunks; ++i)
+        if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                  chunkSize * sizeof(unsigned char), 1,
+                  ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+          fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+      remain = number % chunkSize;
+      if (remain != 0)
+        if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                  remain * sizeof(unsigned char), 1,
+                  ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+          fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    }
+    /* how much remains ? */
+    number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] - number;
+  }
+  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape = number;
+  prefetchTapeBlock(OP_STREAM, ADOLC_CURRENT_TAPE_INFOS.op_file,
+                    ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] - number,
+                    MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
+                              number),
+                    ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE]);
+  ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+
+  /* init locations */
+  number = 0;
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1) {
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_map == nullptr)
+      ADOLC_CURRENT_TAPE_INFOS.loc_file = openTapeFile(LOC_STREAM);
+    /* how much to read ? */
+    number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
+                       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS]);
+    if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.loc_map == nullptr &&
+        !fetchTapeBlock(LOC_STREAM,
+                        (void **)&ADOLC_CURRENT_TAPE_INFOS.locBuffer, 0,
+                        number)) {
+      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+      chunks = number / chunkSize;
+      for (i = 0; i < chunks; ++i)
+        if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                  chunkSize * sizeof(locint), 1,
+                  ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+          fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+      remain = number % chunkSize;
+      if (remain != 0)
+        if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                  remain * sizeof(locint), 1,
+                  ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+          fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    }
+    /* how much remains ? */
+    number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] - number;
+  }
+  ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape = number;
+  prefetchTapeBlock(LOC_STREAM, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                    ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] - number,
+                    MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
+                              number),
+                    ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]);
+
+  /* skip stats */
+  numLocsForStats = statSpace;
+  while (numLocsForStats >= ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]) {
+    get_loc_block_f();
+    numLocsForStats -= ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+  }
+  ADOLC_CURRENT_TAPE_INFOS.currLoc =
+      ADOLC_CURRENT_TAPE_INFOS.locBuffer + numLocsForStats;
+
+  /* init constants */
+  number = 0;
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1) {
+    if (ADOLC_CURRENT_TAPE_INFOS.val_map == nullptr)
+      ADOLC_CURRENT_TAPE_INFOS.val_file = openTapeFile(VAL_STREAM);
     /* how much to read ? */
     number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
                        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES]);
-    if (number != 0) {
+    if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.val_map == nullptr &&
+        !fetchTapeBlock(VAL_STREAM,
+                        (void **)&ADOLC_CURRENT_TAPE_INFOS.valBuffer, 0,
+                        number)) {
       chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
       chunks = number / chunkSize;
       for (i = 0; i < chunks; ++i)
@@ -1581,6 +3450,11 @@ void init_for_sweep(short tag) {
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] - number;
   }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape = number;
+  prefetchTapeBlock(VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file,
+                    ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] - number,
+                    MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
+                              number),
+                    ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE]);
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
 #ifdef ADOLC_AMPI_SUPPORT
   TAPE_AMPI_resetBottom();
@@ -1602,21 +3476,41 @@ void init_rev_sweep(short tag) {
   /* make room for tapeInfos and read tape stats if necessary, keep value
    * stack information */
   openTape(tag, ADOLC_REVERSE);
+  if (initRecordSweep(ADOLC_REVERSE)) {
+#ifdef ADOLC_AMPI_SUPPORT
+    TAPE_AMPI_resetTop();
+#endif
+    return;
+  }
+  attachTapePool();
+  readTapeBlockIndex(&ADOLC_CURRENT_TAPE_INFOS);
+  mapTapeFiles();
   initTapeBuffers();
 
   /* init operations */
   number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS];
   if (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.op_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, "rb");
     number = (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] /
               ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE]) *
              ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
-    fseek(ADOLC_CURRENT_TAPE_INFOS.op_file, number * sizeof(unsigned char),
-          SEEK_SET);
+    if (ADOLC_CURRENT_TAPE_INFOS.op_map != nullptr) {
+      ADOLC_CURRENT_TAPE_INFOS.opBuffer =
+          ADOLC_CURRENT_TAPE_INFOS.op_map + number;
+      ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+          ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+          ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+    } else {
+      ADOLC_CURRENT_TAPE_INFOS.op_file = openTapeFile(OP_STREAM);
+      fseek(ADOLC_CURRENT_TAPE_INFOS.op_file, number * sizeof(unsigned char),
+            SEEK_SET);
+    }
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] %
              ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
-    if (number != 0) {
+    if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.op_map == nullptr &&
+        !fetchTapeBlock(OP_STREAM,
+                        (void **)&ADOLC_CURRENT_TAPE_INFOS.opBuffer,
+                        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] - number,
+                        number)) {
       chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
       chunks = number / chunkSize;
       for (i = 0; i < chunks; ++i)
@@ -1634,20 +3528,38 @@ void init_rev_sweep(short tag) {
   }
   ADOLC_CURRENT_TAPE_INFOS.numOps_Tape =
       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] - number;
+  if (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape != 0)
+    prefetchTapeBlock(OP_STREAM, ADOLC_CURRENT_TAPE_INFOS.op_file,
+                      ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -
+                          ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
+                      ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
+                      ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE]);
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
 
   /* init locations */
   number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS];
   if (ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.loc_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
     number = (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] /
               ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]) *
              ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
-    fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file, number * sizeof(locint), SEEK_SET);
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_map != nullptr) {
+      ADOLC_CURRENT_TAPE_INFOS.locBuffer =
+          ADOLC_CURRENT_TAPE_INFOS.loc_map + number;
+      ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+          ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+          ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+    } else {
+      ADOLC_CURRENT_TAPE_INFOS.loc_file = openTapeFile(LOC_STREAM);
+      fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file, number * sizeof(locint),
+            SEEK_SET);
+    }
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] %
              ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
-    if (number != 0) {
+    if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.loc_map == nullptr &&
+        !fetchTapeBlock(LOC_STREAM,
+                        (void **)&ADOLC_CURRENT_TAPE_INFOS.locBuffer,
+                        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] - number,
+                        number)) {
       chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
       chunks = number / chunkSize;
       for (i = 0; i < chunks; ++i)
@@ -1665,21 +3577,39 @@ void init_rev_sweep(short tag) {
   }
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape =
       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] - number;
+  if (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape != 0)
+    prefetchTapeBlock(LOC_STREAM, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                      ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -
+                          ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
+                      ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
+                      ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]);
   ADOLC_CURRENT_TAPE_INFOS.currLoc =
       ADOLC_CURRENT_TAPE_INFOS.locBuffer + number;
 
   /* init constants */
   number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES];
   if (ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.val_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, "rb");
     number = (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] /
               ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE]) *
              ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-    fseek(ADOLC_CURRENT_TAPE_INFOS.val_file, number * sizeof(double), SEEK_SET);
+    if (ADOLC_CURRENT_TAPE_INFOS.val_map != nullptr) {
+      ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+          ADOLC_CURRENT_TAPE_INFOS.val_map + number;
+      ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+          ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+          ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
+    } else {
+      ADOLC_CURRENT_TAPE_INFOS.val_file = openTapeFile(VAL_STREAM);
+      fseek(ADOLC_CURRENT_TAPE_INFOS.val_file, number * sizeof(double),
+            SEEK_SET);
+    }
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] %
              ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-    if (number != 0) {
+    if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.val_map == nullptr &&
+        !fetchTapeBlock(VAL_STREAM,
+                        (void **)&ADOLC_CURRENT_TAPE_INFOS.valBuffer,
+                        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] - number,
+                        number)) {
       chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
       chunks = number / chunkSize;
       for (i = 0; i < chunks; ++i)
@@ -1697,6 +3627,12 @@ void init_rev_sweep(short tag) {
   }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape =
       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] - number;
+  if (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape != 0)
+    prefetchTapeBlock(VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file,
+                      ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -
+                          ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
+                      ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
+                      ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE]);
   ADOLC_CURRENT_TAPE_INFOS.currVal =
       ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
 #ifdef ADOLC_AMPI_SUPPORT
@@ -1710,18 +3646,24 @@ void init_rev_sweep(short tag) {
 void end_sweep() {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
+  releaseTapePrefetcher(&ADOLC_CURRENT_TAPE_INFOS);
   if (ADOLC_CURRENT_TAPE_INFOS.op_file != nullptr) {
-    fclose(ADOLC_CURRENT_TAPE_INFOS.op_file);
+    if (ADOLC_CURRENT_TAPE_INFOS.op_file != ADOLC_CURRENT_TAPE_INFOS.loc_file)
+      fclose(ADOLC_CURRENT_TAPE_INFOS.op_file);
     ADOLC_CURRENT_TAPE_INFOS.op_file = nullptr;
   }
+  if (ADOLC_CURRENT_TAPE_INFOS.val_file != nullptr) {
+    if (ADOLC_CURRENT_TAPE_INFOS.val_file != ADOLC_CURRENT_TAPE_INFOS.loc_file)
+      fclose(ADOLC_CURRENT_TAPE_INFOS.val_file);
+    ADOLC_CURRENT_TAPE_INFOS.val_file = nullptr;
+  }
   if (ADOLC_CURRENT_TAPE_INFOS.loc_file != nullptr) {
     fclose(ADOLC_CURRENT_TAPE_INFOS.loc_file);
     ADOLC_CURRENT_TAPE_INFOS.loc_file = nullptr;
   }
-  if (ADOLC_CURRENT_TAPE_INFOS.val_file != nullptr) {
-    fclose(ADOLC_CURRENT_TAPE_INFOS.val_file);
-    ADOLC_CURRENT_TAPE_INFOS.val_file = nullptr;
-  }
+  /* copies kept by the tape pool serve the next sweeps */
+  if (!ADOLC_CURRENT_TAPE_INFOS.mapsInPool)
+    unmapTapeFiles(&ADOLC_CURRENT_TAPE_INFOS);
   if (ADOLC_CURRENT_TAPE_INFOS.deg_save > 0)
     releaseTape(); /* keep value stack */
   else
@@ -1739,6 +3681,8 @@ const int maxLocsPerOp = 10;
 void put_op_reserve(unsigned char op, unsigned int reserveExtraLocations) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
+  if (ADOLC_CURRENT_TAPE_INFOS.records != nullptr)
+    closeTapeRecord();
   /* make sure we have enough slots to write the locs */
   if (ADOLC_CURRENT_TAPE_INFOS.currLoc + maxLocsPerOp + reserveExtraLocations >
       ADOLC_CURRENT_TAPE_INFOS.lastLocP1) {
@@ -1792,6 +3736,8 @@ void put_op_reserve(unsigned char op, unsigned int reserveExtraLocations) {
   }
   *ADOLC_CURRENT_TAPE_INFOS.currOp = op;
   ++ADOLC_CURRENT_TAPE_INFOS.currOp;
+  if (ADOLC_CURRENT_TAPE_INFOS.records != nullptr)
+    openTapeRecord();
 }
 
 /****************************************************************************/
@@ -1804,6 +3750,9 @@ void put_op_block(unsigned char *lastOpP1) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
+  if (ADOLC_CURRENT_TAPE_INFOS.op_file == nullptr &&
+      ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_CONTAINER)
+    ADOLC_CURRENT_TAPE_INFOS.op_file = openTapeContainer();
   if (ADOLC_CURRENT_TAPE_INFOS.op_file == nullptr) {
     ADOLC_CURRENT_TAPE_INFOS.op_file =
         fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, "rb");
@@ -1826,21 +3775,38 @@ void put_op_block(unsigned char *lastOpP1) {
   }
 
   number = lastOpP1 - ADOLC_CURRENT_TAPE_INFOS.opBuffer;
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-                    chunkSize * sizeof(unsigned char), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
-      fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-                    remain * sizeof(unsigned char), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
+  if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_ASYNC) {
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer = (unsigned char *)getTapeWriter()->write(
+        OP_STREAM, ADOLC_CURRENT_TAPE_INFOS.op_file,
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer, number,
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE], getTapeBlockIndex());
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+  } else if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & indexedTapeIO) {
+    if (!writeTapeBlock(OP_STREAM, ADOLC_CURRENT_TAPE_INFOS.op_file,
+                        ADOLC_CURRENT_TAPE_INFOS.opBuffer, number,
+                        getTapeBlockIndex())) {
+      failAdditionalInfo1 = 0;
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    }
+  } else {
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                      chunkSize * sizeof(unsigned char), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                      remain * sizeof(unsigned char), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numOps_Tape += number;
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
   ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
@@ -1857,20 +3823,46 @@ void get_op_block_f() {
 
   number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
                      ADOLC_CURRENT_TAPE_INFOS.numOps_Tape);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-              chunkSize * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-              remain * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= remain;
+  if (ADOLC_CURRENT_TAPE_INFOS.op_map != nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.op_map +
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numOps_Tape);
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+    ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+    return;
+  }
+  if (!fetchTapeBlock(OP_STREAM, (void **)&ADOLC_CURRENT_TAPE_INFOS.opBuffer,
+                      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+                          ADOLC_CURRENT_TAPE_INFOS.numOps_Tape,
+                      number)) {
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                chunkSize * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                remain * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+      ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+      ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+  prefetchTapeBlock(OP_STREAM, ADOLC_CURRENT_TAPE_INFOS.op_file,
+                    ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+                        ADOLC_CURRENT_TAPE_INFOS.numOps_Tape,
+                    MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
+                              ADOLC_CURRENT_TAPE_INFOS.numOps_Tape),
+                    ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE]);
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
 }
 
@@ -1884,23 +3876,39 @@ void get_op_block_r() {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
-  fseek(ADOLC_CURRENT_TAPE_INFOS.op_file,
-        sizeof(unsigned char) * (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number),
-        SEEK_SET);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-              chunkSize * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-              remain * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.op_map != nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.op_map +
+        (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number);
+  } else if (!fetchTapeBlock(OP_STREAM,
+                             (void **)&ADOLC_CURRENT_TAPE_INFOS.opBuffer,
+                             ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number,
+                             number)) {
+    fseek(ADOLC_CURRENT_TAPE_INFOS.op_file,
+          sizeof(unsigned char) *
+              (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number),
+          SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                chunkSize * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                remain * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+      ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
   ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+  if (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape >= number)
+    prefetchTapeBlock(OP_STREAM, ADOLC_CURRENT_TAPE_INFOS.op_file,
+                      ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number, number,
+                      number);
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
 }
 
@@ -1916,6 +3924,9 @@ void put_loc_block(locint *lastLocP1) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
+  if (ADOLC_CURRENT_TAPE_INFOS.loc_file == nullptr &&
+      ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_CONTAINER)
+    ADOLC_CURRENT_TAPE_INFOS.loc_file = openTapeContainer();
   if (ADOLC_CURRENT_TAPE_INFOS.loc_file == nullptr) {
     ADOLC_CURRENT_TAPE_INFOS.loc_file =
         fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
@@ -1938,21 +3949,38 @@ void put_loc_block(locint *lastLocP1) {
   }
 
   number = lastLocP1 - ADOLC_CURRENT_TAPE_INFOS.locBuffer;
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-                    chunkSize * sizeof(locint), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
-      fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-                    remain * sizeof(locint), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
+  if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_ASYNC) {
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer = (locint *)getTapeWriter()->write(
+        LOC_STREAM, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer, number,
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE], getTapeBlockIndex());
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+  } else if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & indexedTapeIO) {
+    if (!writeTapeBlock(LOC_STREAM, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                        ADOLC_CURRENT_TAPE_INFOS.locBuffer, number,
+                        getTapeBlockIndex())) {
+      failAdditionalInfo1 = 0;
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    }
+  } else {
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                      chunkSize * sizeof(locint), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                      remain * sizeof(locint), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape += number;
   ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
   ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
@@ -1969,20 +3997,46 @@ void get_loc_block_f() {
 
   number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
                      ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-              chunkSize * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-              remain * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.loc_map != nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.loc_map +
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape);
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+    ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
+    return;
+  }
+  if (!fetchTapeBlock(LOC_STREAM, (void **)&ADOLC_CURRENT_TAPE_INFOS.locBuffer,
+                      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+                          ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape,
+                      number)) {
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                chunkSize * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                remain * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+      ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+      ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -= number;
+  prefetchTapeBlock(LOC_STREAM, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                    ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+                        ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape,
+                    MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
+                              ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape),
+                    ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]);
   ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
 }
 
@@ -1996,24 +4050,39 @@ void get_loc_block_r() {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
-  fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file,
-        sizeof(locint) * (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number),
-        SEEK_SET);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-              chunkSize * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-              remain * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.loc_map != nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.loc_map +
+        (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number);
+  } else if (!fetchTapeBlock(LOC_STREAM,
+                             (void **)&ADOLC_CURRENT_TAPE_INFOS.locBuffer,
+                             ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number,
+                             number)) {
+    fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+          sizeof(locint) * (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number),
+          SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                chunkSize * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                remain * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+      ADOLC_CURRENT_TAPE_INFOS.locBuffer + number;
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -=
       ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+  if (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape >= number)
+    prefetchTapeBlock(LOC_STREAM, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                      ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number, number,
+                      number);
   ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.lastLocP1 -
                                      *(ADOLC_CURRENT_TAPE_INFOS.lastLocP1 - 1);
 }
@@ -2033,6 +4102,8 @@ void put_vals_writeBlock(double *vals, locint numVals) {
     *ADOLC_CURRENT_TAPE_INFOS.currVal = vals[i];
     ++ADOLC_CURRENT_TAPE_INFOS.currVal;
   }
+  /* the record ends before the buffer is written */
+  closeTapeRecord();
   ADOLC_PUT_LOCINT(ADOLC_CURRENT_TAPE_INFOS.lastValP1 -
                    ADOLC_CURRENT_TAPE_INFOS.currVal);
   put_val_block(ADOLC_CURRENT_TAPE_INFOS.lastValP1);
@@ -2072,6 +4143,9 @@ void put_val_block(double *lastValP1) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
+  if (ADOLC_CURRENT_TAPE_INFOS.val_file == nullptr &&
+      ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_CONTAINER)
+    ADOLC_CURRENT_TAPE_INFOS.val_file = openTapeContainer();
   if (ADOLC_CURRENT_TAPE_INFOS.val_file == nullptr) {
     ADOLC_CURRENT_TAPE_INFOS.val_file =
         fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, "rb");
@@ -2094,21 +4168,38 @@ void put_val_block(double *lastValP1) {
   }
 
   number = lastValP1 - ADOLC_CURRENT_TAPE_INFOS.valBuffer;
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-                    chunkSize * sizeof(double), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
-      fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-                    remain * sizeof(double), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
+  if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & ADOLC_TAPE_IO_ASYNC) {
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer = (double *)getTapeWriter()->write(
+        VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file,
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer, number,
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE], getTapeBlockIndex());
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
+  } else if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags & indexedTapeIO) {
+    if (!writeTapeBlock(VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file,
+                        ADOLC_CURRENT_TAPE_INFOS.valBuffer, number,
+                        getTapeBlockIndex())) {
+      failAdditionalInfo1 = 0;
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    }
+  } else {
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                      chunkSize * sizeof(double), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                      remain * sizeof(double), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape += number;
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
   ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
@@ -2125,20 +4216,47 @@ void get_val_block_f() {
 
   number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
                      ADOLC_CURRENT_TAPE_INFOS.numVals_Tape);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-              chunkSize * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-              remain * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.val_map != nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.val_map +
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+         ADOLC_CURRENT_TAPE_INFOS.numVals_Tape);
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
+    ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
+    ++ADOLC_CURRENT_TAPE_INFOS.currLoc;
+    return;
+  }
+  if (!fetchTapeBlock(VAL_STREAM, (void **)&ADOLC_CURRENT_TAPE_INFOS.valBuffer,
+                      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+                          ADOLC_CURRENT_TAPE_INFOS.numVals_Tape,
+                      number)) {
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                chunkSize * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                remain * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+      ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+      ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+  prefetchTapeBlock(VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file,
+                    ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+                        ADOLC_CURRENT_TAPE_INFOS.numVals_Tape,
+                    MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
+                              ADOLC_CURRENT_TAPE_INFOS.numVals_Tape),
+                    ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE]);
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
   /* get_locint_f(); value used in reverse only */
   ++ADOLC_CURRENT_TAPE_INFOS.currLoc;
@@ -2155,23 +4273,38 @@ void get_val_block_r() {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-  fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
-        sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
-        SEEK_SET);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-              chunkSize * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-              remain * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.val_map != nullptr) {
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.val_map +
+        (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number);
+  } else if (!fetchTapeBlock(VAL_STREAM,
+                             (void **)&ADOLC_CURRENT_TAPE_INFOS.valBuffer,
+                             ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number,
+                             number)) {
+    fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
+          sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
+          SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                chunkSize * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                remain * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+      ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+  if (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape >= number)
+    prefetchTapeBlock(VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file,
+                      ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number, number,
+                      number);
   --ADOLC_CURRENT_TAPE_INFOS.currLoc;
   temp = *ADOLC_CURRENT_TAPE_INFOS.currLoc;
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.lastValP1 - temp;
@@ -2186,6 +4319,7 @@ locint get_val_space(void) {
   ADOLC_OPENMP_GET_THREAD_NUMBER;
   if (ADOLC_CURRENT_TAPE_INFOS.lastValP1 - 5 <
       ADOLC_CURRENT_TAPE_INFOS.currVal) {
+    closeTapeRecord();
     ADOLC_PUT_LOCINT(ADOLC_CURRENT_TAPE_INFOS.lastValP1 -
                      ADOLC_CURRENT_TAPE_INFOS.currVal);
     put_val_block(ADOLC_CURRENT_TAPE_INFOS.lastValP1);
@@ -2212,6 +4346,9 @@ void discard_params_r(void) {
   size_t number, remain, chunkSize;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
+  /* parameters are not part of packed records */
+  if (ADOLC_CURRENT_TAPE_INFOS.currRec != nullptr)
+    return;
   np = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM];
   ip = np;
   while (ip > 0) {
@@ -2222,23 +4359,37 @@ void discard_params_r(void) {
     ADOLC_CURRENT_TAPE_INFOS.currVal -= rsize;
     if (ip > 0) {
       number = ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-      fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
-            sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
-            SEEK_SET);
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-                  chunkSize * sizeof(double), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-          fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-                  remain * sizeof(double), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-          fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+      if (ADOLC_CURRENT_TAPE_INFOS.val_map != nullptr) {
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+            ADOLC_CURRENT_TAPE_INFOS.val_map +
+            (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number);
+      } else if (!fetchTapeBlock(
+                     VAL_STREAM, (void **)&ADOLC_CURRENT_TAPE_INFOS.valBuffer,
+                     ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number, number)) {
+        fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
+              sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
+              SEEK_SET);
+        chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+        chunks = number / chunkSize;
+        for (i = 0; i < chunks; ++i)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                    chunkSize * sizeof(double), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+            fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+        remain = number % chunkSize;
+        if (remain != 0)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                    remain * sizeof(double), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+            fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+      }
+      ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+          ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
       ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+      if (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape >= number)
+        prefetchTapeBlock(VAL_STREAM, ADOLC_CURRENT_TAPE_INFOS.val_file,
+                          ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number,
+                          number, number);
       ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.lastValP1;
     }
   }
@@ -2401,6 +4552,28 @@ unsigned char get_op_r() {
   return temp;
 }
 
+/*--------------------------------------------------------------------------*/
+unsigned char get_rec_f() {
+  unsigned char temp;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  temp = nextTapeRecord(&ADOLC_CURRENT_TAPE_INFOS);
+  fprintf(DIAG_OUT, "f_op: %i\n", temp - '\0');
+  return temp;
+}
+
+/*--------------------------------------------------------------------------*/
+unsigned char get_rec_r() {
+  unsigned char temp;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  temp = prevTapeRecord(&ADOLC_CURRENT_TAPE_INFOS);
+  fprintf(DIAG_OUT, "r_op: %i\n", temp - '\0');
+  return temp;
+}
+
 /*--------------------------------------------------------------------------*/
 locint get_locint_f() {
   locint temp;
@@ -0,0 +1,654 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     threaded_forward.cpp
+ Revision: $Id$
+ Contents: zos_forward and fos_forward sweeps over tapes held in core as
+           threaded code (ADOLC_TAPE_IO_THREADED)
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include <adolc/dvlparms.h>
+#include <adolc/oplate.h>
+#include <adolc/taping_p.h>
+
+#include "threaded_tape.h"
+
+#include <math.h>
+
+/****************************************************************************/
+/* The forward sweeps of uni5_for.cpp dispatch every operation read from    */
+/* the tapes through one switch, whose single indirect jump is mispredicted */
+/* whenever the next operation differs from the last. A tape held in core   */
+/* is decoded once instead into streams of operations, locations and values */
+/* like the tapes, but without buffer markers, with the operations          */
+/* renumbered densely and their operands resolved: the indices of           */
+/* independents and dependents are stored as locations, take_stock_op is    */
+/* split into single assignments, death_not is dropped and some operations  */
+/* are mapped onto others (assign_d_zero onto assign_d, incr_a onto         */
+/* eq_plus_d, ...). With GCC and clang each handler jumps on to the handler */
+/* of the next operation through a table of label addresses, so that every  */
+/* handler has its own indirect jump, otherwise a switch over the decoded   */
+/* operations is used. Tapes containing other operations are left to        */
+/* uni5_for.cpp.                                                            */
+/*                                                                          */
+/* The streams are as compact as the tapes on purpose: sweeps over large    */
+/* tapes are bound by memory bandwidth, so that instructions with a handler */
+/* address and all operands in place run slower than the switch.            */
+/****************************************************************************/
+
+#if defined(__GNUC__)
+#define ADOLC_THREADED_GOTO 1
+#endif
+
+void releaseThreadedTape(TapeInfos *tapeInfos) {
+  delete tapeInfos->threaded;
+  tapeInfos->threaded = nullptr;
+}
+
+size_t threadedTapeSize(const TapeInfos *tapeInfos) {
+  const ThreadedTape *tape = tapeInfos->threaded;
+
+  if (tape == nullptr)
+    return 0;
+  return tape->ops.capacity() * sizeof(unsigned char) +
+         tape->locs.capacity() * sizeof(locint) +
+         (tape->vals.capacity() + tape->base.capacity() +
+          tape->derivs.capacity()) *
+             sizeof(double);
+}
+
+namespace {
+
+/* Decodes the current tape from the start of a forward sweep. Returns
+ * false at the first operation without threaded handler. */
+bool decodeTape(ThreadedTape *tape) {
+  std::vector<unsigned char> &ops = tape->ops;
+  std::vector<locint> &locs = tape->locs;
+  std::vector<double> &vals = tape->vals;
+  unsigned char operation;
+  locint size, res, indexi = 0, indexd = 0;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  ops.reserve(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS]);
+  locs.reserve(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS]);
+  vals.reserve(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES]);
+  /* the operations are read from the packed records or the tape buffers,
+   * as chosen by init_for_sweep */
+  const bool packedSweep = ADOLC_CURRENT_TAPE_INFOS.currRec != nullptr;
+  for (;;) {
+    operation = packedSweep ? get_rec_f() : get_op_f();
+    switch (operation) {
+    case start_of_tape:
+      break;
+    case end_of_tape:
+      ops.push_back(t_end);
+      return true;
+    case death_not: /* nothing to keep without taylors */
+      (void)get_locint_f();
+      (void)get_locint_f();
+      break;
+
+      /* one argument and the result */
+    case assign_a:
+    case pos_sign_a:
+      ops.push_back(t_assign_a);
+      goto arg_res;
+    case neg_sign_a:
+      ops.push_back(t_neg_sign_a);
+      goto arg_res;
+    case exp_op:
+      ops.push_back(t_exp);
+      goto arg_res;
+    case log_op:
+      ops.push_back(t_log);
+      goto arg_res;
+    case sqrt_op:
+      ops.push_back(t_sqrt);
+      goto arg_res;
+    case eq_plus_a:
+      ops.push_back(t_eq_plus_a);
+      goto arg_res;
+    case eq_min_a:
+      ops.push_back(t_eq_min_a);
+      goto arg_res;
+    case eq_mult_a:
+      ops.push_back(t_eq_mult_a);
+      goto arg_res;
+    case assign_p: /* the parameters may change between sweeps */
+      ops.push_back(t_assign_p);
+    arg_res:
+      locs.push_back(get_locint_f());
+      locs.push_back(get_locint_f());
+      break;
+
+      /* two arguments and the result */
+    case plus_a_a:
+      ops.push_back(t_plus_a_a);
+      goto arg1_arg2_res;
+    case min_a_a:
+      ops.push_back(t_min_a_a);
+      goto arg1_arg2_res;
+    case mult_a_a:
+      ops.push_back(t_mult_a_a);
+      goto arg1_arg2_res;
+    case div_a_a:
+      ops.push_back(t_div_a_a);
+      goto arg1_arg2_res;
+    case eq_plus_prod:
+      ops.push_back(t_eq_plus_prod);
+      goto arg1_arg2_res;
+    case eq_min_prod:
+      ops.push_back(t_eq_min_prod);
+      goto arg1_arg2_res;
+    case sin_op:
+      ops.push_back(t_sin);
+      goto arg1_arg2_res;
+    case cos_op:
+      ops.push_back(t_cos);
+      goto arg1_arg2_res;
+    case atan_op:
+      ops.push_back(t_atan);
+    arg1_arg2_res:
+      locs.push_back(get_locint_f());
+      locs.push_back(get_locint_f());
+      locs.push_back(get_locint_f());
+      break;
+
+      /* one argument, the result and a value */
+    case plus_d_a:
+      ops.push_back(t_plus_d_a);
+      goto arg_res_val;
+    case min_d_a:
+      ops.push_back(t_min_d_a);
+      goto arg_res_val;
+    case mult_d_a:
+      ops.push_back(t_mult_d_a);
+      goto arg_res_val;
+    case div_d_a:
+      ops.push_back(t_div_d_a);
+    arg_res_val:
+      locs.push_back(get_locint_f());
+      locs.push_back(get_locint_f());
+      vals.push_back(get_val_f());
+      break;
+
+      /* the result and a value */
+    case assign_d:
+      ops.push_back(t_assign_d);
+      goto res_val;
+    case eq_plus_d:
+      ops.push_back(t_eq_plus_d);
+      goto res_val;
+    case eq_mult_d:
+      ops.push_back(t_eq_mult_d);
+    res_val:
+      locs.push_back(get_locint_f());
+      vals.push_back(get_val_f());
+      break;
+    case eq_min_d:
+      ops.push_back(t_eq_plus_d);
+      locs.push_back(get_locint_f());
+      vals.push_back(-get_val_f());
+      break;
+    case assign_d_zero:
+    case assign_d_one:
+      ops.push_back(t_assign_d);
+      locs.push_back(get_locint_f());
+      vals.push_back(operation == assign_d_one ? 1.0 : 0.0);
+      break;
+    case incr_a:
+    case decr_a:
+      ops.push_back(t_eq_plus_d);
+      locs.push_back(get_locint_f());
+      vals.push_back(operation == incr_a ? 1.0 : -1.0);
+      break;
+    case take_stock_op:
+      size = get_locint_f();
+      res = get_locint_f();
+      for (locint ls = 0; ls < size; ls++) {
+        ops.push_back(t_assign_d);
+        locs.push_back(res++);
+        vals.push_back(get_val_f());
+      }
+      break;
+
+      /* independents and dependents by their index */
+    case assign_ind:
+      ops.push_back(t_assign_ind);
+      locs.push_back(indexi++);
+      locs.push_back(get_locint_f());
+      break;
+    case assign_dep:
+      ops.push_back(t_assign_dep);
+      locs.push_back(indexd++);
+      locs.push_back(get_locint_f());
+      break;
+
+    default: /* including the buffer markers of tapes not in core */
+      return false;
+    }
+  }
+}
+
+#if defined(ADOLC_THREADED_GOTO)
+#define THREADED_OP(name) L_##name:
+#define THREADED_NEXT goto *labels[*op++]
+#else
+#define THREADED_OP(name) case name:
+#define THREADED_NEXT continue
+#endif
+
+/* The zos (FOS == false) or fos sweep over the decoded tape, the operations
+ * are evaluated as in uni5_for.cpp for the same mode, including the order
+ * of the updates that allows arguments and results to coincide. */
+template <bool FOS>
+void threadedSweep(const ThreadedTape *tape, double *dp_T0, double *dp_T,
+                   const double *paramstore, const double *basepoint,
+                   const double *argument, double *valuepoint,
+                   double *taylors) {
+  const unsigned char *op = tape->ops.data();
+  const locint *loc = tape->locs.data();
+  const double *val = tape->vals.data();
+  locint arg1, arg2, res;
+  double coval, divs, r0;
+
+#if defined(ADOLC_THREADED_GOTO)
+  static const void *const labels[t_numOps] = {
+      &&L_t_end,          &&L_t_assign_a,     &&L_t_assign_d,
+      &&L_t_assign_p,     &&L_t_assign_ind,   &&L_t_assign_dep,
+      &&L_t_eq_plus_d,    &&L_t_eq_plus_a,    &&L_t_eq_min_a,
+      &&L_t_eq_mult_d,    &&L_t_eq_mult_a,    &&L_t_plus_a_a,
+      &&L_t_plus_d_a,     &&L_t_min_a_a,      &&L_t_min_d_a,
+      &&L_t_mult_a_a,     &&L_t_mult_d_a,     &&L_t_div_a_a,
+      &&L_t_div_d_a,      &&L_t_eq_plus_prod, &&L_t_eq_min_prod,
+      &&L_t_neg_sign_a,   &&L_t_exp,          &&L_t_sin,
+      &&L_t_cos,          &&L_t_atan,         &&L_t_log,
+      &&L_t_sqrt};
+
+  THREADED_NEXT;
+#else
+  for (;;)
+    switch (*op++) {
+#endif
+
+  THREADED_OP(t_assign_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = dp_T0[arg1];
+    if (FOS)
+      dp_T[res] = dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_assign_d) {
+    res = *loc++;
+    dp_T0[res] = *val++;
+    if (FOS)
+      dp_T[res] = 0;
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_assign_p) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = paramstore[arg1];
+    if (FOS)
+      dp_T[res] = 0;
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_assign_ind) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = basepoint[arg1];
+    if (FOS)
+      dp_T[res] = argument[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_assign_dep) {
+    arg1 = *loc++;
+    res = *loc++;
+    if (valuepoint != nullptr)
+      valuepoint[arg1] = dp_T0[res];
+    if (FOS && taylors != nullptr)
+      taylors[arg1] = dp_T[res];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_eq_plus_d) {
+    res = *loc++;
+    dp_T0[res] += *val++;
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_eq_plus_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] += dp_T0[arg1];
+    if (FOS)
+      dp_T[res] += dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_eq_min_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] -= dp_T0[arg1];
+    if (FOS)
+      dp_T[res] -= dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_eq_mult_d) {
+    res = *loc++;
+    coval = *val++;
+    dp_T0[res] *= coval;
+    if (FOS)
+      dp_T[res] *= coval;
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_eq_mult_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    if (FOS)
+      dp_T[res] = dp_T0[res] * dp_T[arg1] + dp_T[res] * dp_T0[arg1];
+    dp_T0[res] *= dp_T0[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_plus_a_a) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    dp_T0[res] = dp_T0[arg1] + dp_T0[arg2];
+    if (FOS)
+      dp_T[res] = dp_T[arg1] + dp_T[arg2];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_plus_d_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = dp_T0[arg1] + *val++;
+    if (FOS)
+      dp_T[res] = dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_min_a_a) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    dp_T0[res] = dp_T0[arg1] - dp_T0[arg2];
+    if (FOS)
+      dp_T[res] = dp_T[arg1] - dp_T[arg2];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_min_d_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = *val++ - dp_T0[arg1];
+    if (FOS)
+      dp_T[res] = -dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_mult_a_a) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    if (FOS)
+      dp_T[res] = dp_T0[arg1] * dp_T[arg2] + dp_T[arg1] * dp_T0[arg2];
+    dp_T0[res] = dp_T0[arg1] * dp_T0[arg2];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_mult_d_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    coval = *val++;
+    dp_T0[res] = dp_T0[arg1] * coval;
+    if (FOS)
+      dp_T[res] = dp_T[arg1] * coval;
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_div_a_a) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    if (FOS) {
+      divs = 1.0 / dp_T0[arg2];
+      dp_T0[res] = dp_T0[arg1] / dp_T0[arg2];
+      dp_T[res] = dp_T[arg1] * divs + dp_T0[res] * (-dp_T[arg2] * divs);
+    } else
+      dp_T0[res] = dp_T0[arg1] / dp_T0[arg2];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_div_d_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    coval = *val++;
+    if (FOS) {
+      divs = 1.0 / dp_T0[arg1];
+      dp_T0[res] = coval / dp_T0[arg1];
+      dp_T[res] = dp_T0[res] * (-dp_T[arg1] * divs);
+    } else
+      dp_T0[res] = coval / dp_T0[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_eq_plus_prod) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    if (FOS)
+      dp_T[res] += dp_T0[arg1] * dp_T[arg2] + dp_T[arg1] * dp_T0[arg2];
+    dp_T0[res] += dp_T0[arg1] * dp_T0[arg2];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_eq_min_prod) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    if (FOS)
+      dp_T[res] -= dp_T0[arg1] * dp_T[arg2] + dp_T[arg1] * dp_T0[arg2];
+    dp_T0[res] -= dp_T0[arg1] * dp_T0[arg2];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_neg_sign_a) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = -dp_T0[arg1];
+    if (FOS)
+      dp_T[res] = -dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_exp) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = exp(dp_T0[arg1]);
+    if (FOS)
+      dp_T[res] = dp_T0[res] * dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_sin) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    /* Note: always arg2 != arg1 */
+    dp_T0[arg2] = cos(dp_T0[arg1]);
+    dp_T0[res] = sin(dp_T0[arg1]);
+    if (FOS) {
+      dp_T[arg2] = -dp_T0[res] * dp_T[arg1];
+      dp_T[res] = dp_T0[arg2] * dp_T[arg1];
+    }
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_cos) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    /* Note: always arg2 != arg1 */
+    dp_T0[arg2] = sin(dp_T0[arg1]);
+    dp_T0[res] = cos(dp_T0[arg1]);
+    if (FOS) {
+      dp_T[arg2] = dp_T0[res] * dp_T[arg1];
+      dp_T[res] = -dp_T0[arg2] * dp_T[arg1];
+    }
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_atan) {
+    arg1 = *loc++;
+    arg2 = *loc++;
+    res = *loc++;
+    dp_T0[res] = atan(dp_T0[arg1]);
+    if (FOS)
+      dp_T[res] = dp_T0[arg2] * dp_T[arg1];
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_log) {
+    arg1 = *loc++;
+    res = *loc++;
+    if (FOS) {
+      divs = 1.0 / dp_T0[arg1];
+      if (dp_T0[arg1] == 0.0 && dp_T[arg1] < 0.0)
+        divs = make_nan();
+      dp_T[res] = dp_T[arg1] * divs;
+    }
+    dp_T0[res] = log(dp_T0[arg1]);
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_sqrt) {
+    arg1 = *loc++;
+    res = *loc++;
+    dp_T0[res] = sqrt(dp_T0[arg1]);
+    if (FOS) {
+      if (dp_T0[arg1] == 0.0) {
+        /* Note: <=> dp_T0[res] == 0.0 */
+        if (dp_T[arg1] > 0.0)
+          r0 = make_inf();
+        else if (dp_T[arg1] < 0.0)
+          r0 = make_nan();
+        else
+          r0 = 0.0;
+      } else
+        r0 = 0.5 / dp_T0[res];
+      dp_T[res] = r0 * dp_T[arg1];
+    }
+    THREADED_NEXT;
+  }
+  THREADED_OP(t_end) { return; }
+
+#if !defined(ADOLC_THREADED_GOTO)
+    default:
+      return;
+    }
+#endif
+}
+
+#undef THREADED_OP
+#undef THREADED_NEXT
+
+} // namespace
+
+/****************************************************************************/
+/* Returns the decoded current tape, decoding it if necessary. Decoding     */
+/* reads the tape from the start of the sweep and resets the reading        */
+/* position afterwards, so that the switch can still sweep it.              */
+/****************************************************************************/
+ThreadedTape *decodedTape() {
+  ThreadedTape *tape;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  tape = ADOLC_CURRENT_TAPE_INFOS.threaded;
+  if (tape != nullptr)
+    return tape;
+  if (ADOLC_CURRENT_TAPE_INFOS.currRec == nullptr &&
+      (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] != 0 ||
+       ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] != 0 ||
+       ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] != 0))
+    return nullptr;
+
+  unsigned char *currOp = ADOLC_CURRENT_TAPE_INFOS.currOp;
+  locint *currLoc = ADOLC_CURRENT_TAPE_INFOS.currLoc;
+  double *currVal = ADOLC_CURRENT_TAPE_INFOS.currVal;
+  uint64_t *currRec = ADOLC_CURRENT_TAPE_INFOS.currRec;
+
+  tape = new ThreadedTape;
+  tape->supported = decodeTape(tape);
+  if (!tape->supported) {
+    std::vector<unsigned char>().swap(tape->ops);
+    std::vector<locint>().swap(tape->locs);
+    std::vector<double>().swap(tape->vals);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.threaded = tape;
+
+  ADOLC_CURRENT_TAPE_INFOS.currOp = currOp;
+  ADOLC_CURRENT_TAPE_INFOS.currLoc = currLoc;
+  ADOLC_CURRENT_TAPE_INFOS.currVal = currVal;
+  ADOLC_CURRENT_TAPE_INFOS.currRec = currRec;
+  return tape;
+}
+
+/****************************************************************************/
+/* Sweeps the current tape as threaded code if it was taped with            */
+/* ADOLC_TAPE_IO_THREADED and is held in core, as zos_forward if dp_T is    */
+/* nullptr and as fos_forward otherwise. Returns 0 if the tape is to be     */
+/* swept by the switch of uni5_for.cpp.                                     */
+/****************************************************************************/
+int threadedForward(double *dp_T0, double *dp_T, const double *basepoint,
+                    const double *argument, double *valuepoint,
+                    double *taylors) {
+  ThreadedTape *tape;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+        ADOLC_TAPE_IO_THREADED))
+    return 0;
+  tape = decodedTape();
+  if (tape == nullptr || !tape->supported)
+    return 0;
+
+  if (dp_T == nullptr)
+    threadedSweep<false>(tape, dp_T0, nullptr,
+                         ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore,
+                         basepoint, nullptr, valuepoint, nullptr);
+  else
+    threadedSweep<true>(tape, dp_T0, dp_T,
+                        ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore,
+                        basepoint, argument, valuepoint, taylors);
+  return 1;
+}
+
+/****************************************************************************/
+/* Records the base point of a forward sweep keeping taylors, from which    */
+/* the native (ADOLC_TAPE_IO_NATIVE) and parallel (ADOLC_TAPE_IO_PARALLEL)  */
+/* reverse sweeps recompute the values of the tape instead of reading the   */
+/* taylor stack. nullptr forgets it when another sweep starts writing       */
+/* taylors.                                                                 */
+/****************************************************************************/
+void keepBasePoint(const double *basepoint) {
+  ThreadedTape *tape;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  tape = ADOLC_CURRENT_TAPE_INFOS.threaded;
+  if (basepoint == nullptr) {
+    if (tape != nullptr)
+      tape->haveBase = tape->haveDerivs = false;
+    return;
+  }
+  if (!(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeIOFlags &
+        (ADOLC_TAPE_IO_NATIVE | ADOLC_TAPE_IO_PARALLEL)))
+    return;
+  tape = decodedTape();
+  if (tape == nullptr || !tape->supported)
+    return;
+
+  const size_t n = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS];
+  const size_t np = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM];
+  const double *paramstore = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore;
+  tape->base.assign(basepoint, basepoint + n);
+  if (np > 0)
+    tape->base.insert(tape->base.end(), paramstore, paramstore + np);
+  tape->haveBase = true;
+  tape->haveDerivs = false;
+}
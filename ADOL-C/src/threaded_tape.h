@@ -0,0 +1,76 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     threaded_tape.h
+ Revision: $Id$
+ Contents: The decoded operations of tapes held in core, swept as threaded
+           code (threaded_forward.cpp), compiled to native code
+           (native_tape.cpp) and swept in parallel (parallel_fov.cpp)
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#if !defined(ADOLC_THREADED_TAPE_H)
+#define ADOLC_THREADED_TAPE_H 1
+
+#include <adolc/taping_p.h>
+
+#include <vector>
+
+/* the operations of the decoded tape, their operands follow in the order
+ * of the tapes: arguments, result, then the value if any. The index of an
+ * independent or dependent precedes its location. */
+enum ThreadedOp {
+  t_end,
+  t_assign_a,
+  t_assign_d,
+  t_assign_p,
+  t_assign_ind,
+  t_assign_dep,
+  t_eq_plus_d,
+  t_eq_plus_a,
+  t_eq_min_a,
+  t_eq_mult_d,
+  t_eq_mult_a,
+  t_plus_a_a,
+  t_plus_d_a,
+  t_min_a_a,
+  t_min_d_a,
+  t_mult_a_a,
+  t_mult_d_a,
+  t_div_a_a,
+  t_div_d_a,
+  t_eq_plus_prod,
+  t_eq_min_prod,
+  t_neg_sign_a,
+  t_exp,
+  t_sin,
+  t_cos,
+  t_atan,
+  t_log,
+  t_sqrt,
+  t_numOps
+};
+
+struct ThreadedTape {
+  bool supported; /* == false if the tape contains other operations */
+  std::vector<unsigned char> ops;
+  std::vector<locint> locs;
+  std::vector<double> vals;
+  bool haveBase = false;     /* base point of a sweep keeping taylors */
+  std::vector<double> base;  /* its independents, then the parameters */
+  bool haveDerivs = false;   /* partial derivatives at the base point */
+  std::vector<double> derivs; /* of the operations (parallel_fov.cpp) */
+};
+
+/* returns the decoded current tape, decoding it at the start of a sweep if
+ * necessary, or nullptr if the tape is not held in core */
+ThreadedTape *decodedTape();
+
+#endif
@@ -38,6 +38,7 @@ and _NTIGHT__
 #include <adolc/oplate.h>
 #include <adolc/taping.h>
 #include <adolc/taping_p.h>
+#include <adolc/adtl_kernels.h>
 
 #include <math.h>
 #include <string.h>
@@ -479,6 +480,22 @@ END_C_DECLS
 #define HOV_INC(T, inc)
 #endif
 
+/*--------------------------------------------------------------------------*/
+/*                                         kernels over blocks of directions */
+/* The Taylor coefficients of a location are a contiguous row of p (FOV) or */
+/* p*k (HOV) doubles. Operations linear in them are applied to the whole    */
+/* row by the SIMD kernels of adtl_kernels.h, the first-order operations of */
+/* the FOV mode also by the kernels for products.                           */
+#if !defined(_INT_FOR_) && !defined(_INDO_) &&                               \
+    (defined(_FOV_) || defined(_HOV_) || defined(_HOV_WK_))
+#define _VECTOR_KERNELS_
+#if defined(_FOV_)
+#define VEC_BLOCK p
+#else
+#define VEC_BLOCK pk
+#endif
+#endif
+
 /*--------------------------------------------------------------------------*/
 /*                                                        higher order case */
 #if defined(_HIGHER_ORDER_)
@@ -1068,6 +1085,9 @@ int hov_forward(
   /* Initialize the Forward Sweep */
 
   init_for_sweep(tnum);
+  /* the operations are read from the packed records or the tape buffers,
+   * as chosen by init_for_sweep */
+  const bool packedSweep = ADOLC_CURRENT_TAPE_INFOS.currRec != nullptr;
 
   if ((depcheck != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS]) ||
       (indcheck != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS])) {
@@ -1279,7 +1299,39 @@ int hov_forward(
 #define UPDATE_TAYLORWRITTEN(X)
 #endif /* ADOLC_DEBUG */
 
-  operation = get_op_f();
+#if (defined(_ZOS_) || defined(_FOS_) || defined(_FOV_)) &&                  \
+    !defined(_ABS_NORM_) && !defined(_ABS_NORM_SIG_) && !defined(_CHUNKED_)
+#if defined(_KEEP_)
+  /* the native and parallel reverse sweeps start from the base point of the
+   * last sweep keeping taylors */
+  if (keep)
+    keepBasePoint(basepoint);
+#endif
+  /* tapes in core taped with ADOLC_TAPE_IO_NATIVE are swept as native code,
+   * with ADOLC_TAPE_IO_THREADED as threaded code and fov_forward with
+   * ADOLC_TAPE_IO_PARALLEL by several threads, unless taylors are to be
+   * kept */
+  if (
+#if defined(_KEEP_)
+      keep == 0 &&
+#endif
+#if defined(_ZOS_)
+      (nativeZosForward(basepoint, valuepoint, dp_T0) ||
+       threadedForward(dp_T0, nullptr, basepoint, nullptr, valuepoint,
+                       nullptr)))
+#elif defined(_FOS_)
+      (nativeFosForward(basepoint, argument, valuepoint, taylors, dp_T0,
+                        dp_T) ||
+       threadedForward(dp_T0, dp_T, basepoint, argument, valuepoint, taylors)))
+#else
+      (nativeFovForward(p, basepoint, argument, valuepoint, taylors, dp_T0,
+                        dpp_T) ||
+       parallelFovForward(p, basepoint, argument, valuepoint, taylors)))
+#endif
+    operation = end_of_tape;
+  else
+#endif
+    operation = packedSweep ? get_rec_f() : get_op_f();
 #if defined(ADOLC_DEBUG)
   ++countPerOperation[operation];
 #endif /* ADOLC_DEBUG */
@@ -1718,6 +1770,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovAdd(VEC_BLOCK, Tres, Tres, Targ);
 #else
       FOR_0_LE_l_LT_pk TRES_INC += TARG_INC;
 #endif
@@ -1770,6 +1824,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovSub(VEC_BLOCK, Tres, Tres, Targ);
 #else
       FOR_0_LE_l_LT_pk TRES_INC -= TARG_INC;
 #endif
@@ -1796,9 +1852,13 @@ int hov_forward(
 #if !defined(_ZOS_) /* BREAK_ZOS */
 #if !defined(_INT_FOR_)
 
-      FOR_0_LE_l_LT_pk ASSIGN_T(Tres, TAYLOR_BUFFER[res])
+      ASSIGN_T(Tres, TAYLOR_BUFFER[res])
 
-          FOR_0_LE_l_LT_pk TRES_INC *= coval;
+#if defined(_VECTOR_KERNELS_)
+      adtl::fovScale(VEC_BLOCK, Tres, coval, Tres);
+#else
+      FOR_0_LE_l_LT_pk TRES_INC *= coval;
+#endif
 #endif
 #endif
 #endif /* ALL_TOGETHER_AGAIN */
@@ -1834,6 +1894,9 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
+#if defined(_VECTOR_KERNELS_) && defined(_FOV_)
+      adtl::fovAxpby(p, Tres, dp_T0[arg], Tres, dp_T0[res], Targ);
+#else
       INC_pk_1(Tres) INC_pk_1(Targ)
 
 #ifdef _INT_FOR_
@@ -1853,6 +1916,7 @@ int hov_forward(
       }
 #endif
 #endif
+#endif
 #endif /* ALL_TOGETHER_AGAIN */
 #if !defined(_NTIGHT_)
       dp_T0[res] *= dp_T0[arg];
@@ -1915,6 +1979,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC | TARG2_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovAdd(VEC_BLOCK, Tres, Targ1, Targ2);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC + TARG2_INC;
 #endif
@@ -1986,6 +2052,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC | TARG2_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovSub(VEC_BLOCK, Tres, Targ1, Targ2);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC - TARG2_INC;
 #endif
@@ -2023,6 +2091,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC = TARG_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovScale(VEC_BLOCK, Tres, -1.0, Targ);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = -TARG_INC;
 #endif
@@ -2063,6 +2133,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_p TRES_FOINC = TARG2_INC | TARG1_INC;
+#elif defined(_VECTOR_KERNELS_) && defined(_FOV_)
+      adtl::fovAxpby(p, Tres, dp_T0[arg2], Targ1, dp_T0[arg1], Targ2);
 #else
       /* olvo 980915 now in reverse order to allow x = x*x etc. */
       INC_pk_1(Tres) INC_pk_1(Targ1) INC_pk_1(Targ2)
@@ -2251,6 +2323,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC = TARG_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovScale(VEC_BLOCK, Tres, coval, Targ);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = TARG_INC * coval;
 #endif
@@ -2301,6 +2375,14 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_p TRES_FOINC = TARG1_INC | TARG2_FOINC;
+#elif defined(_VECTOR_KERNELS_) && defined(_FOV_)
+      /* -Targ2 * divs first, as in the loop below */
+      if (res != arg1) {
+        adtl::fovScale(p, Tres, -divs, Targ2);
+        adtl::fovAxpby(p, Tres, divs, Targ1, dp_T0[res], Tres);
+      } else
+        for (int l = 0; l < p; l++)
+          Tres[l] = Targ1[l] * divs + dp_T0[res] * (-Targ2[l] * divs);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980922 changed order to allow x = y/x */
@@ -2445,6 +2527,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC = TARG_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovScale(VEC_BLOCK, Tres, -1.0, Targ);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = -TARG_INC;
 #endif
@@ -2491,6 +2575,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_p TRES_FOINC = TARG_FOINC;
+#elif defined(_VECTOR_KERNELS_) && defined(_FOV_)
+      adtl::fovScale(p, Tres, dp_T0[res], Targ);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980915 changed order to allow x = exp(x) */
@@ -2559,6 +2645,10 @@ int hov_forward(
         TARG2_FOINC = TARG1;
         TRES_FOINC = TARG1_FOINC;
       }
+#elif defined(_VECTOR_KERNELS_) && defined(_FOV_)
+      /* Note: always arg2 != arg1 */
+      adtl::fovScale(p, Targ2, -dp_T0[res], Targ1);
+      adtl::fovScale(p, Tres, dp_T0[arg2], Targ1);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980921 changed order to allow x = sin(x) */
@@ -2634,6 +2724,10 @@ int hov_forward(
         TARG2_FOINC = TARG1;
         TRES_FOINC = TARG1_FOINC;
       }
+#elif defined(_VECTOR_KERNELS_) && defined(_FOV_)
+      /* Note: always arg2 != arg1 */
+      adtl::fovScale(p, Targ2, dp_T0[res], Targ1);
+      adtl::fovScale(p, Tres, -dp_T0[arg2], Targ1);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980921 changed order to allow x = cos(x) */
@@ -4862,6 +4956,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovAdd(VEC_BLOCK, Tres, Tres, Targ);
 #else
       FOR_0_LE_l_LT_pk TRES_INC += TARG_INC;
 #endif
@@ -4920,6 +5016,8 @@ int hov_forward(
 
 #ifdef _INT_FOR_
       FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+#elif defined(_VECTOR_KERNELS_)
+      adtl::fovSub(VEC_BLOCK, Tres, Tres, Targ);
 #else
       FOR_0_LE_l_LT_pk TRES_INC -= TARG_INC;
 #endif
@@ -4948,9 +5046,13 @@ int hov_forward(
 #if !defined(_ZOS_) /* BREAK_ZOS */
 #if !defined(_INT_FOR_)
 
-      FOR_0_LE_l_LT_pk ASSIGN_T(Tres, TAYLOR_BUFFER[res])
+      ASSIGN_T(Tres, TAYLOR_BUFFER[res])
 
-          FOR_0_LE_l_LT_pk TRES_INC *= coval;
+#if defined(_VECTOR_KERNELS_)
+      adtl::fovScale(VEC_BLOCK, Tres, coval, Tres);
+#else
+      FOR_0_LE_l_LT_pk TRES_INC *= coval;
+#endif
 #endif
 #endif
 #endif
@@ -4991,6 +5093,9 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
+#if defined(_VECTOR_KERNELS_) && defined(_FOV_)
+      adtl::fovAxpby(p, Tres, dp_T0[arg], Tres, dp_T0[res], Targ);
+#else
       INC_pk_1(Tres) INC_pk_1(Targ)
 
 #ifdef _INT_FOR_
@@ -5010,6 +5115,7 @@ int hov_forward(
       }
 #endif
 #endif
+#endif
 #endif
       dp_T0[res] *= dp_T0[arg];
 #else
@@ -5940,7 +6046,7 @@ int hov_forward(
     } /* endswitch */
 
     /* Read the next operation */
-    operation = get_op_f();
+    operation = packedSweep ? get_rec_f() : get_op_f();
 #if defined(ADOLC_DEBUG)
     ++countPerOperation[operation];
 #endif /* ADOLC_DEBUG */